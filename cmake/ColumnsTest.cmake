@@ -0,0 +1,57 @@
+#------------------------------------------------------------------------------
+# Compare one rocket station column of the CSV output against the text output
+#------------------------------------------------------------------------------
+# usage: cmake -DCEA=<cea executable> -DDECK=<deck name> -DCOLUMN=<csv column>
+#              -DLABEL=<text row label> -P ColumnsTest.cmake
+#
+# The first equilibrium row LABEL of DECK.out must match, to the four decimals the
+# text output prints, the COLUMN values of the first equilibrium stations in
+# DECK_p1.csv. Values are expected in [1, 10), as for gamma_s.
+
+foreach(format text csv)
+    execute_process(COMMAND ${CEA} -f ${format} ${DECK} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "cea -f ${format} ${DECK} exited with ${result}")
+    endif()
+endforeach()
+
+# Text values: the first row with the label
+file(STRINGS ${DECK}.out rows REGEX "^ ${LABEL} ")
+list(GET rows 0 row)
+string(REGEX REPLACE "^ ${LABEL} +" "" row "${row}")
+string(REGEX REPLACE " +" ";" expected "${row}")
+list(LENGTH expected num_expected)
+
+# CSV values: the equilibrium rows of the first table, rounded to four decimals
+file(STRINGS ${DECK}_p1.csv lines)
+list(POP_FRONT lines header)
+string(REPLACE "," ";" header "${header}")
+list(FIND header ${COLUMN} column_idx)
+list(FIND header frozen frozen_idx)
+if(column_idx LESS 0 OR frozen_idx LESS 0)
+    message(FATAL_ERROR "Column ${COLUMN} or frozen missing from ${DECK}_p1.csv")
+endif()
+
+set(actual)
+foreach(line IN LISTS lines)
+    string(REPLACE "," ";" fields "${line}")
+    list(GET fields ${frozen_idx} frozen)
+    if(NOT frozen EQUAL 0)
+        continue()
+    endif()
+    list(GET fields ${column_idx} value)
+    if(NOT value MATCHES "^([1-9])\\.([0-9][0-9][0-9][0-9][0-9])[0-9]*E\\+000$")
+        message(FATAL_ERROR "${COLUMN} value ${value} is outside [1, 10)")
+    endif()
+    math(EXPR rounded "(${CMAKE_MATCH_1}${CMAKE_MATCH_2} + 5) / 10")
+    string(REGEX REPLACE "^(.)(....)$" "\\1.\\2" rounded "${rounded}")
+    list(APPEND actual ${rounded})
+    list(LENGTH actual num_actual)
+    if(num_actual EQUAL num_expected)
+        break()
+    endif()
+endforeach()
+
+if(NOT actual STREQUAL expected)
+    message(FATAL_ERROR "${COLUMN} from CSV (${actual}) does not match ${LABEL} from text (${expected})")
+endif()
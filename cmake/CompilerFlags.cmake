@@ -21,3 +21,14 @@ function(project_enable_fortran_std target)
 endfunction()
 
 
+
+# Keep all local arrays on the stack so that independent solver objects can be
+# driven from separate threads (the Python binding releases the GIL in solves).
+function(project_enable_fortran_reentrant target)
+  target_compile_options(${target} PRIVATE
+    $<$<COMPILE_LANG_AND_ID:Fortran,GNU>:-frecursive>
+    $<$<COMPILE_LANG_AND_ID:Fortran,Intel,IntelLLVM>:
+      $<IF:$<PLATFORM_ID:Windows>,/recursive,-recursive>
+    >
+  )
+endfunction()
@@ -0,0 +1,35 @@
+#------------------------------------------------------------------------------
+# Drive the --serve protocol: pipe a request file to the server and check frames
+#------------------------------------------------------------------------------
+# usage: cmake -DCEA=<cea executable> -DINPUT=<request file> -P ServeTest.cmake
+#
+# Every request in INPUT is labelled; those labelled bad_* must be answered with an
+# error frame, the rest with an ok frame, and the server must exit cleanly.
+
+execute_process(
+    COMMAND ${CEA} --serve
+    INPUT_FILE ${INPUT}
+    OUTPUT_VARIABLE output
+    RESULT_VARIABLE result
+)
+message("${output}")
+
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "cea --serve exited with ${result}")
+endif()
+
+file(STRINGS ${INPUT} labels REGEX "^@id ")
+foreach(label IN LISTS labels)
+    string(REGEX REPLACE "^@id +" "" label "${label}")
+    if(label MATCHES "^bad_")
+        set(status error)
+    else()
+        set(status ok)
+    endif()
+    if(NOT output MATCHES "@begin ${label} ${status} [0-9]+\n")
+        message(FATAL_ERROR "No ${status} frame for request ${label}")
+    endif()
+    if(NOT output MATCHES "\n@end ${label}\n")
+        message(FATAL_ERROR "Unterminated frame for request ${label}")
+    endif()
+endforeach()
@@ -4,6 +4,16 @@
 ! This module provides a basic abiltiy to add logging statements throughout the
 ! program. The module is modeled on Python's logging module and provides five
 ! logging levels: log_debug, log_info, log_warning, log_error and log_critical.
+!
+! Messages below the current level are dropped before anything is written.
+! Callers that build a message (concatenation, to_str, internal writes) should
+! guard the call with log_enabled so the formatting is skipped as well:
+!
+!     if (log_enabled(log_levels%debug)) call log_debug('iter '//to_str(iter))
+!
+! A log sink may be installed to receive messages in place of the log unit.
+! Messages are assembled on the caller's stack and handed over in one piece,
+! so concurrent callers never share a buffer.
 !-------------------------------------------------------------------------------
 
 module fb_logging
@@ -14,7 +24,7 @@ module fb_logging
     ! Unit where logging is written
     integer :: lunit = stdout
 
-    ! Current logging level
+    ! Current logging level; messages below it are dropped
     integer :: current_level = 30
 
     ! Defined logging levels
@@ -28,7 +38,19 @@ module fb_logging
     end type
     type(log_level_enum), parameter :: log_levels = log_level_enum()
 
+    ! Receiver for messages that pass the level check
+    abstract interface
+        subroutine log_sink_interface(level, message)
+            integer, intent(in) :: level
+            character(len=*), intent(in) :: message
+        end subroutine
+    end interface
+
+    ! Installed sink; when null, messages are written to lunit
+    procedure(log_sink_interface), pointer :: sink => null()
+
     ! Scratch area for writing formatted log messages
+    ! Shared by all callers; only use it from single-threaded code
     character(len=512) :: log_buffer
 
     ! Public interface
@@ -39,16 +61,41 @@ module fb_logging
                log_warning,  &
                log_error,    &
                log_critical, &
+               log_enabled,  &
+               log_sink_interface, &
                set_log_unit, &
-               set_log_level
+               set_log_level, &
+               set_log_sink
 
 contains
 
     subroutine set_log_level(level)
+        ! Set the minimum level that is logged; log_levels%none turns logging off
         integer, intent(in) :: level
-        current_level = level
+        if (level <= log_levels%none) then
+            current_level = huge(level)
+        else
+            current_level = level
+        end if
+    end subroutine
+
+    subroutine set_log_sink(proc)
+        ! Route messages to proc instead of the log unit; call with no argument to restore the unit
+        procedure(log_sink_interface), optional :: proc
+        if (present(proc)) then
+            sink => proc
+        else
+            nullify(sink)
+        end if
     end subroutine
 
+    pure function log_enabled(level) result(enabled)
+        ! True if a message at this level would be logged
+        integer, intent(in) :: level
+        logical :: enabled
+        enabled = (level >= current_level)
+    end function
+
     subroutine set_log_unit(unit)
         integer, intent(in) :: unit
         lunit = unit
@@ -82,7 +129,10 @@ contains
     subroutine log(level, prefix, message)
         integer, intent(in) :: level
         character(len=*), intent(in) :: prefix, message
-        if (level >= current_level) then
+        if (level < current_level) return
+        if (associated(sink)) then
+            call sink(level, message)
+        else
             write(lunit,'(a)') prefix // message
         end if
     end subroutine
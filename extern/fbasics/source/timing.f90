@@ -1,5 +1,6 @@
 module fb_timing
 
+    use iso_fortran_env, only: int64
     use fb_parameters, only: wp
     use fb_logging
     implicit none
@@ -20,6 +21,54 @@ module fb_timing
         procedure :: tock => timer_tock
     end type
 
+    ! A hierarchical wall-clock profiler. Scopes are entered and left in nested
+    ! pairs with enter(name) and leave(); each distinct call path gets a node
+    ! holding its call count and total time, and each scope is also kept as an
+    ! event for trace export, up to profile_max_events. A profiler is meant to
+    ! be owned by one thread (e.g. one solver), so timing takes no lock.
+    ! Profilers from several owners can be combined with merge().
+    integer, parameter :: profile_name_len   = 24
+    integer, parameter :: profile_max_depth  = 32
+    integer, parameter :: profile_max_events = 100000
+
+    type :: profile_node
+        character(profile_name_len) :: name = ''
+        integer :: parent = 0
+        integer :: calls = 0
+        integer(int64) :: total = 0     ! Clock ticks inside the scope
+        integer(int64) :: children = 0  ! Clock ticks inside child scopes
+    end type
+
+    type :: profile_event
+        integer :: node = 0
+        integer(int64) :: start = 0
+        integer(int64) :: finish = 0
+    end type
+
+    type :: profiler
+        integer :: num_nodes = 0
+        type(profile_node), allocatable :: nodes(:)
+        integer :: depth = 0
+        integer :: stack(profile_max_depth) = 0
+        integer(int64) :: started(profile_max_depth) = 0
+        integer(int64) :: rate = 0
+        integer :: num_events = 0
+        integer :: dropped_events = 0
+        type(profile_event), allocatable :: events(:)
+    contains
+        procedure :: enter => profiler_enter
+        procedure :: leave => profiler_leave
+        procedure :: reset => profiler_reset
+        procedure :: merge => profiler_merge
+        procedure :: total_time => profiler_total_time
+        procedure :: write_totals => profiler_write_totals
+        procedure :: write_collapsed => profiler_write_collapsed
+        procedure :: write_chrome_trace => profiler_write_chrome_trace
+    end type
+
+    ! Whether newly constructed owners should allocate a profiler
+    logical, private :: profiling = .false.
+
 contains
 
     subroutine timer_tick(self)
@@ -55,4 +104,292 @@ contains
         return
     end subroutine
 
+    !-----------------------------------------------------------------------
+    ! Profiler
+    !-----------------------------------------------------------------------
+
+    subroutine set_profiling(enabled)
+        ! Set whether newly constructed owners allocate a profiler
+        logical, intent(in) :: enabled
+        profiling = enabled
+    end subroutine
+
+    function profiling_enabled() result(enabled)
+        logical :: enabled
+        enabled = profiling
+    end function
+
+    subroutine profile_enter(prof, name)
+        ! Enter a scope if profiling is on, i.e. prof is allocated
+        type(profiler), allocatable, intent(inout) :: prof
+        character(*), intent(in) :: name
+        if (.not. allocated(prof)) return
+        call prof%enter(name)
+    end subroutine
+
+    subroutine profile_leave(prof)
+        ! Leave the innermost scope if profiling is on
+        type(profiler), allocatable, intent(inout) :: prof
+        if (.not. allocated(prof)) return
+        call prof%leave()
+    end subroutine
+
+    subroutine profiler_enter(self, name)
+        class(profiler), intent(inout) :: self
+        character(*), intent(in) :: name
+        integer :: node
+        integer(int64) :: now
+
+        self%depth = self%depth + 1
+        if (self%depth > profile_max_depth) return
+
+        if (self%depth > 1) then
+            node = profiler_find_node(self, self%stack(self%depth-1), name)
+        else
+            node = profiler_find_node(self, 0, name)
+        end if
+        self%stack(self%depth) = node
+
+        call system_clock(now)
+        self%started(self%depth) = now
+    end subroutine
+
+    subroutine profiler_leave(self)
+        class(profiler), intent(inout) :: self
+        integer :: node
+        integer(int64) :: now, elapsed
+
+        if (self%depth < 1) then
+            call log_error("fb-profiler: leave() without a matching enter(). Ignoring leave().")
+            return
+        end if
+        if (self%depth > profile_max_depth) then
+            self%depth = self%depth - 1
+            return
+        end if
+
+        call system_clock(now)
+        node = self%stack(self%depth)
+        elapsed = now - self%started(self%depth)
+        self%nodes(node)%calls = self%nodes(node)%calls + 1
+        self%nodes(node)%total = self%nodes(node)%total + elapsed
+        if (self%depth > 1) then
+            associate(parent => self%nodes(self%stack(self%depth-1)))
+                parent%children = parent%children + elapsed
+            end associate
+        end if
+        call profiler_add_event(self, node, self%started(self%depth), now)
+
+        self%depth = self%depth - 1
+    end subroutine
+
+    subroutine profiler_reset(self)
+        ! Drop all recorded timings; scopes still open are dropped too
+        class(profiler), intent(inout) :: self
+        self%num_nodes = 0
+        self%depth = 0
+        self%num_events = 0
+        self%dropped_events = 0
+    end subroutine
+
+    subroutine profiler_merge(self, other)
+        ! Add the timings and events of other to self, matching nodes by call path
+        class(profiler), intent(inout) :: self
+        class(profiler), intent(in) :: other
+        integer :: i, parent, map(other%num_nodes)
+
+        ! Parents are always created before their children
+        do i = 1, other%num_nodes
+            parent = 0
+            if (other%nodes(i)%parent > 0) parent = map(other%nodes(i)%parent)
+            map(i) = profiler_find_node(self, parent, other%nodes(i)%name)
+            associate(node => self%nodes(map(i)))
+                node%calls    = node%calls + other%nodes(i)%calls
+                node%total    = node%total + other%nodes(i)%total
+                node%children = node%children + other%nodes(i)%children
+            end associate
+        end do
+
+        do i = 1, other%num_events
+            call profiler_add_event(self, map(other%events(i)%node), other%events(i)%start, other%events(i)%finish)
+        end do
+        self%dropped_events = self%dropped_events + other%dropped_events
+    end subroutine
+
+    function profiler_total_time(self, path) result(seconds)
+        ! Total wall-clock time [s] spent in the scope at path, e.g. "rocket;equilibrium"
+        class(profiler), intent(in) :: self
+        character(*), intent(in) :: path
+        real(wp) :: seconds
+        integer :: i
+        seconds = 0.0d0
+        do i = 1, self%num_nodes
+            if (profiler_path(self, i) == path) then
+                seconds = real(self%nodes(i)%total, wp)/real(self%rate, wp)
+                return
+            end if
+        end do
+    end function
+
+    subroutine profiler_write_totals(self, unit)
+        ! Write a table of calls, total and self time per call path
+        class(profiler), intent(in) :: self
+        integer, intent(in) :: unit
+        integer :: i
+        integer(int64) :: root_total
+
+        root_total = 0
+        do i = 1, self%num_nodes
+            if (self%nodes(i)%parent == 0) root_total = root_total + self%nodes(i)%total
+        end do
+
+        write(unit, '(a)') ''
+        write(unit, '(a)') ' PROFILE (wall clock)'
+        write(unit, '(a)') ''
+        write(unit, '(1x,a40,a10,3a12)') 'SCOPE', 'CALLS', 'TOTAL, ms', 'SELF, ms', '% TOTAL'
+        do i = 1, self%num_nodes
+            if (self%nodes(i)%parent == 0) call write_node(i, 0)
+        end do
+        if (self%dropped_events > 0) then
+            write(unit, '(a,i0,a)') ' (', self%dropped_events, ' trace events dropped)'
+        end if
+
+    contains
+
+        recursive subroutine write_node(node, level)
+            integer, intent(in) :: node, level
+            integer :: j
+            real(wp) :: total_ms, self_ms, percent
+            character(40) :: label
+
+            associate(n => self%nodes(node))
+                total_ms = 1.0d3*real(n%total, wp)/real(self%rate, wp)
+                self_ms  = 1.0d3*real(n%total - n%children, wp)/real(self%rate, wp)
+                percent  = 0.0d0
+                if (root_total > 0) percent = 1.0d2*real(n%total, wp)/real(root_total, wp)
+                label = repeat('  ', level)//n%name
+                write(unit, '(1x,a40,i10,3f12.3)') label, n%calls, total_ms, self_ms, percent
+            end associate
+
+            do j = node+1, self%num_nodes
+                if (self%nodes(j)%parent == node) call write_node(j, level+1)
+            end do
+        end subroutine
+
+    end subroutine
+
+    subroutine profiler_write_collapsed(self, unit)
+        ! Write self time per call path in microseconds, one "a;b;c 123" line per path,
+        ! the collapsed-stack format read by flame graph tools
+        class(profiler), intent(in) :: self
+        integer, intent(in) :: unit
+        integer :: i
+        integer(int64) :: self_us
+
+        do i = 1, self%num_nodes
+            self_us = nint(1.0d6*real(self%nodes(i)%total - self%nodes(i)%children, wp)/real(self%rate, wp), int64)
+            if (self_us <= 0) cycle
+            write(unit, '(a,1x,i0)') profiler_path(self, i), self_us
+        end do
+    end subroutine
+
+    subroutine profiler_write_chrome_trace(self, unit)
+        ! Write the recorded events in the Chrome trace event format (chrome://tracing, Perfetto)
+        class(profiler), intent(in) :: self
+        integer, intent(in) :: unit
+        integer :: i
+        integer(int64) :: origin
+        real(wp) :: ts, dur
+        character(2) :: sep
+
+        origin = 0
+        if (self%num_events > 0) origin = minval(self%events(:self%num_events)%start)
+
+        write(unit, '(a)') '{"traceEvents": ['
+        do i = 1, self%num_events
+            ts  = 1.0d6*real(self%events(i)%start - origin, wp)/real(self%rate, wp)
+            dur = 1.0d6*real(self%events(i)%finish - self%events(i)%start, wp)/real(self%rate, wp)
+            sep = ','
+            if (i == self%num_events) sep = ''
+            write(unit, '(8a)') &
+                '  {"name": "', trim(self%nodes(self%events(i)%node)%name), &
+                '", "cat": "cea", "ph": "X", "ts": ', json_number(ts), ', "dur": ', json_number(dur), &
+                ', "pid": 1, "tid": 1}', trim(sep)
+        end do
+        write(unit, '(a)') '], "displayTimeUnit": "ms"}'
+
+    contains
+
+        function json_number(x) result(str)
+            ! Microseconds with three decimals; JSON needs the leading zero that f0.3 drops
+            real(wp), intent(in) :: x
+            character(:), allocatable :: str
+            character(32) :: buf
+            write(buf, '(f0.3)') x
+            str = trim(adjustl(buf))
+            if (str(1:1) == '.') str = '0'//str
+        end function
+
+    end subroutine
+
+    function profiler_find_node(self, parent, name) result(node)
+        ! Index of the child of parent called name, added if it does not exist yet
+        type(profiler), intent(inout) :: self
+        integer, intent(in) :: parent
+        character(*), intent(in) :: name
+        integer :: node
+        type(profile_node), allocatable :: tmp(:)
+
+        do node = parent+1, self%num_nodes
+            if (self%nodes(node)%parent == parent .and. self%nodes(node)%name == name) return
+        end do
+
+        if (self%rate == 0) call system_clock(count_rate=self%rate)
+        if (.not. allocated(self%nodes)) allocate(self%nodes(16))
+        if (self%num_nodes == size(self%nodes)) then
+            allocate(tmp(2*size(self%nodes)))
+            tmp(:self%num_nodes) = self%nodes(:self%num_nodes)
+            call move_alloc(tmp, self%nodes)
+        end if
+
+        self%num_nodes = self%num_nodes + 1
+        node = self%num_nodes
+        self%nodes(node) = profile_node(name=name, parent=parent)
+    end function
+
+    subroutine profiler_add_event(self, node, start, finish)
+        type(profiler), intent(inout) :: self
+        integer, intent(in) :: node
+        integer(int64), intent(in) :: start, finish
+        type(profile_event), allocatable :: tmp(:)
+
+        if (self%num_events == profile_max_events) then
+            self%dropped_events = self%dropped_events + 1
+            return
+        end if
+        if (.not. allocated(self%events)) allocate(self%events(256))
+        if (self%num_events == size(self%events)) then
+            allocate(tmp(min(2*size(self%events), profile_max_events)))
+            tmp(:self%num_events) = self%events(:self%num_events)
+            call move_alloc(tmp, self%events)
+        end if
+
+        self%num_events = self%num_events + 1
+        self%events(self%num_events) = profile_event(node, start, finish)
+    end subroutine
+
+    function profiler_path(self, node) result(path)
+        ! Names from the root scope down to node, joined by ';'
+        type(profiler), intent(in) :: self
+        integer, intent(in) :: node
+        character(:), allocatable :: path
+        integer :: i
+        i = node
+        path = trim(self%nodes(i)%name)
+        do while (self%nodes(i)%parent > 0)
+            i = self%nodes(i)%parent
+            path = trim(self%nodes(i)%name)//';'//path
+        end do
+    end function
+
 end module
@@ -0,0 +1,1033 @@
+module cea_batch
+    !! Lockstep solution of many equilibrium problems
+    !!
+    !! An EqBatchSolver solves a batch of independent equilibrium problems that
+    !! share one EqSolver (one product mixture), for example the points of a
+    !! property table. Up to `width` problems are iterated together, one per lane.
+    !! Every work array stores the lane as its first (fastest) index, so the gas
+    !! curve fits, the Newton matrix assembly, the Gaussian elimination and the
+    !! Newton update are loops over lanes that the compiler vectorizes.
+    !!
+    !! Each lane repeats the gas-phase iteration of EqSolver_solve_point. When a
+    !! lane converges, its state is copied into an EqSolution and finished there:
+    !! the condensed-species test, partials, transport properties and
+    !! post-processing are those of EqSolver. The lane is then refilled with the
+    !! next point, which starts from the state the lane just converged to. A
+    !! point is re-solved from its starting guess by EqSolver_solve if it needs a
+    !! condensed species, hits a singular matrix, or does not converge in
+    !! max_iterations. Problems other than tp, hp and sp, and solvers with ions,
+    !! smooth truncation or inserted species, are solved one point at a time.
+
+    use cea_param, only: dp
+    use cea_equilibrium, only: EqSolver, EqSolution, EqPartials, EqResult, EqConstraints, &
+                               EqSolution_save_seed
+    use fb_logging
+    use fb_utils
+    implicit none
+
+    integer, parameter :: batch_num_coeffs = 17
+        !! Coefficients stored per curve-fit interval (see EqBatchSolver_setup)
+
+    type :: EqBatchSolver
+        !! Lockstep equilibrium solver for batches of problems
+
+        ! Settings
+        integer :: width = 16
+            !! Number of lanes (problems iterated together)
+
+        ! Counters of the last solve
+        integer :: num_points = 0
+            !! Points solved
+        integer :: num_lockstep = 0
+            !! Points converged in lockstep
+        integer :: num_fallback = 0
+            !! Points solved one at a time by EqSolver_solve
+        integer :: num_sweeps = 0
+            !! Lockstep iterations; each one advances every lane
+
+        ! Gas curve fits and stoichiometry, copied from the EqSolver
+        integer :: num_gas = 0
+            !! Number of gas species
+        integer :: num_elements = 0
+            !! Number of elements
+        integer :: num_equations = 0
+            !! Size of the Newton system
+        real(dp), allocatable :: T_low(:, :)
+            !! Lower bound of each fit interval (interval, species); unused intervals are huge
+        real(dp), allocatable :: fits(:, :, :)
+            !! Scaled fit coefficients (coefficient, interval, species)
+        real(dp), allocatable :: A(:, :)
+            !! Gas stoichiometric matrix (species, element)
+
+        ! Lane state; the lane is the first index of every array
+        integer, allocatable :: point(:)
+            !! Point solved in each lane; 0 if the lane is idle
+        integer, allocatable :: iter(:)
+            !! Newton iterations of the current point
+        integer, allocatable :: ierr(:)
+            !! Nonzero if the last elimination found a singular matrix
+        logical, allocatable :: converged(:)
+            !! True if the last iteration converged
+        real(dp), allocatable :: state1(:)
+            !! Assigned temperature, enthalpy/R, or entropy/R
+        real(dp), allocatable :: P(:)
+            !! Assigned pressure (bar)
+        real(dp), allocatable :: b0(:, :)
+            !! Assigned element amounts (lane, element)
+        real(dp), allocatable :: T(:)
+            !! Temperature (K)
+        real(dp), allocatable :: n(:)
+            !! Total moles
+        real(dp), allocatable :: tsize(:)
+            !! Truncation size (see EqSolver%tsize)
+        real(dp), allocatable :: ln_nj(:, :)
+            !! Log of the gas species amounts (lane, species)
+        real(dp), allocatable :: nj(:, :)
+            !! Gas species amounts above the truncation threshold
+        real(dp), allocatable :: w(:, :)
+            !! Newton weights: amounts above the threshold at the current n
+        real(dp), allocatable :: mu(:, :)
+            !! Gas chemical potentials [unitless]
+        real(dp), allocatable :: dln_nj(:, :)
+            !! Newton update of ln_nj
+        real(dp), allocatable :: h(:, :)
+            !! Gas enthalpies [unitless]
+        real(dp), allocatable :: s(:, :)
+            !! Gas entropies [unitless]
+        real(dp), allocatable :: cp(:, :)
+            !! Gas heat capacities [unitless]
+        real(dp), allocatable :: G(:, :, :)
+            !! Augmented Newton matrices (lane, row, column)
+        real(dp), allocatable :: pi(:, :)
+            !! Modified Lagrange multipliers (lane, element)
+        real(dp), allocatable :: pi_prev(:, :)
+            !! Multipliers of the previous iteration
+        real(dp), allocatable :: dln_n(:)
+            !! Newton update of ln(n)
+        real(dp), allocatable :: dln_T(:)
+            !! Newton update of ln(T)
+
+        ! Starting guess of the current point, for the EqSolver_solve fallback
+        real(dp), allocatable :: T0(:)
+        real(dp), allocatable :: n0(:)
+        real(dp), allocatable :: ln_nj0(:, :)
+        real(dp), allocatable :: nj0(:, :)
+
+    contains
+
+        procedure :: solve => EqBatchSolver_solve
+        procedure :: setup => EqBatchSolver_setup
+        procedure :: load => EqBatchSolver_load
+        procedure :: eval_thermo => EqBatchSolver_eval_thermo
+        procedure :: assemble => EqBatchSolver_assemble
+        procedure :: factor => EqBatchSolver_factor
+        procedure :: update => EqBatchSolver_update
+        procedure :: check_convergence => EqBatchSolver_check_convergence
+        procedure :: finish => EqBatchSolver_finish
+        procedure :: fallback => EqBatchSolver_fallback
+
+    end type
+    interface EqBatchSolver
+        module procedure :: EqBatchSolver_init
+    end interface
+
+contains
+
+    function EqBatchSolver_init(width) result(self)
+
+        ! Arguments
+        integer, intent(in), optional :: width
+
+        ! Result
+        type(EqBatchSolver) :: self
+
+        if (present(width)) self%width = width
+        call assert(self%width > 0, 'EqBatchSolver_init: width must be positive')
+
+    end function
+
+    subroutine EqBatchSolver_solve(self, solver, soln, type, state1, state2, weights, results, partials)
+        ! Solve one equilibrium problem per point. state1 and state2 hold one value per
+        ! point or a single value for every point; weights holds one column of reactant
+        ! weights per point, or a single column. The gas-phase state of soln is the
+        ! starting guess of the first points, and soln is the workspace that each point
+        ! is finished in. If partials is present, it is computed for every point and
+        ! supplies the partial derivatives stored in results.
+
+        ! Arguments
+        class(EqBatchSolver), intent(inout) :: self
+        type(EqSolver), intent(inout) :: solver
+        type(EqSolution), intent(inout) :: soln
+        character(2), intent(in) :: type
+        real(dp), intent(in) :: state1(:)
+        real(dp), intent(in) :: state2(:)
+        real(dp), intent(in) :: weights(:, :)
+        type(EqResult), allocatable, intent(out) :: results(:)
+        type(EqPartials), intent(inout), optional :: partials
+
+        ! Locals
+        integer :: npts, next, k, l, ng
+        logical :: const_t, const_s, lockstep
+        type(EqConstraints) :: cons
+
+        ! Number of points; single values broadcast
+        npts = max(size(state1), size(state2), size(weights, 2))
+        call assert(size(state1) == npts .or. size(state1) == 1, 'EqBatchSolver_solve: size of state1')
+        call assert(size(state2) == npts .or. size(state2) == 1, 'EqBatchSolver_solve: size of state2')
+        call assert(size(weights, 2) == npts .or. size(weights, 2) == 1, 'EqBatchSolver_solve: size of weights')
+        call assert(size(weights, 1) == solver%num_reactants, 'EqBatchSolver_solve: weights must have num_reactants rows')
+
+        allocate(results(npts))
+        self%num_points = npts
+        self%num_lockstep = 0
+        self%num_fallback = 0
+        self%num_sweeps = 0
+        if (npts == 0) return
+
+        ! Problem type, with the state values in the default order
+        cons = EqConstraints(solver%num_elements)
+        call cons%set(type, state1(1), state2(1), solver%reactants%element_amounts_from_weights(weights(:, 1)))
+        const_t = cons%is_constant_temperature()
+        const_s = cons%is_constant_entropy()
+
+        ! Lockstep covers the gas-phase Newton iteration at constant pressure
+        lockstep = cons%is_constant_pressure() .and. solver%num_gas > 0 .and. solver%num_elements > 0 &
+                   .and. .not. solver%ions .and. .not. solver%smooth_truncation
+        if (allocated(solver%insert)) lockstep = lockstep .and. size(solver%insert) == 0
+        if (lockstep) lockstep = all([(allocated(solver%products%species(k)%fits), k = 1, solver%num_gas)])
+
+        if (.not. lockstep) then
+            do k = 1, npts
+                call solver%solve(soln, type, state1(min(k, size(state1))), state2(min(k, size(state2))), &
+                                  weights(:, min(k, size(weights, 2))), partials)
+                results(k) = EqResult(soln, partials)
+            end do
+            self%num_fallback = npts
+            return
+        end if
+
+        ! Start every lane from the gas-phase state of soln
+        call self%setup(solver, const_t)
+        ng = self%num_gas
+        do l = 1, self%width
+            self%T(l) = soln%T
+            self%n(l) = soln%n
+            self%ln_nj(l, :) = soln%ln_nj
+            self%nj(l, :) = soln%nj(:ng)
+            self%pi_prev(l, :) = soln%pi_prev
+        end do
+
+        ! Fill the lanes
+        self%point = 0
+        next = 1
+        do l = 1, min(self%width, npts)
+            call self%load(solver, l, next, type, state1, state2, weights)
+            next = next + 1
+        end do
+
+        ! Iterate all lanes together until every point is done
+        do while (any(self%point > 0))
+            self%num_sweeps = self%num_sweeps + 1
+
+            call self%assemble(const_t, const_s)
+            call self%factor()
+            call self%update(solver, const_t)
+            call self%check_convergence(solver, const_t, const_s)
+
+            do l = 1, self%width
+                k = self%point(l)
+                if (k == 0) cycle
+                self%iter(l) = self%iter(l) + 1
+
+                if (self%ierr(l) /= 0) then
+                    call self%fallback(solver, soln, l, type, state1, state2, weights, results, partials)
+                else if (self%converged(l)) then
+                    call self%finish(solver, soln, l, type, state1, state2, weights, results, partials)
+                else if (self%iter(l) >= solver%max_iterations) then
+                    call self%fallback(solver, soln, l, type, state1, state2, weights, results, partials)
+                else
+                    cycle
+                end if
+
+                ! The lane is done; give it the next point
+                self%point(l) = 0
+                if (next <= npts) then
+                    call self%load(solver, l, next, type, state1, state2, weights)
+                    next = next + 1
+                end if
+            end do
+        end do
+
+    end subroutine
+
+    subroutine EqBatchSolver_setup(self, solver, const_t)
+        ! Copy the gas curve fits and stoichiometry of the solver, and size the lane arrays
+
+        ! Arguments
+        class(EqBatchSolver), intent(inout) :: self
+        type(EqSolver), intent(in) :: solver
+        logical, intent(in) :: const_t
+
+        ! Locals
+        integer :: W, ng, ne, neq, nint, i, j
+
+        W = self%width
+        ng = solver%num_gas
+        ne = solver%num_elements
+        neq = ne + 1
+        if (.not. const_t) neq = neq + 1
+        self%num_gas = ng
+        self%num_elements = ne
+        self%num_equations = neq
+
+        ! Fit coefficients, pre-divided as in cea_fits so that the polynomials
+        ! below are evaluated with the same operations:
+        !   cp: a1..a7 (1-7)
+        !   h:  a7/5, a6/4, a5/3, a4/2, b1 (8-12), with a3, a1, a2
+        !   s:  a7/4, a6/3, a5/2, b2, a1/2 (13-17), with a4, a2, a3
+        nint = maxval([(solver%products%species(j)%num_intervals, j = 1, ng)])
+        if (allocated(self%T_low)) deallocate(self%T_low, self%fits)
+        allocate(self%T_low(nint, ng), source=huge(1.0d0))
+        allocate(self%fits(batch_num_coeffs, nint, ng), source=0.0d0)
+        do j = 1, ng
+            associate(sp => solver%products%species(j))
+                do i = 1, sp%num_intervals
+                    self%T_low(i, j) = sp%T_fit(i, 1)
+                    associate(f => sp%fits(i))
+                        self%fits(:, i, j) = [f%a1, f%a2, f%a3, f%a4, f%a5, f%a6, f%a7, &
+                                              f%a7/5.0d0, f%a6/4.0d0, f%a5/3.0d0, f%a4/2.0d0, f%b1, &
+                                              f%a7/4.0d0, f%a6/3.0d0, f%a5/2.0d0, f%b2, f%a1/2.0d0]
+                    end associate
+                end do
+            end associate
+        end do
+        self%A = solver%stoich_matrix(:ng, :ne)
+
+        ! Lane arrays
+        if (allocated(self%point)) then
+            if (size(self%point) == W .and. size(self%ln_nj, 2) == ng .and. size(self%b0, 2) == ne &
+                .and. size(self%G, 2) == neq) return
+            deallocate(self%point, self%iter, self%ierr, self%converged, self%state1, self%P, self%b0, &
+                       self%T, self%n, self%tsize, self%ln_nj, self%nj, self%w, self%mu, self%dln_nj, &
+                       self%h, self%s, self%cp, self%G, self%pi, self%pi_prev, self%dln_n, self%dln_T, &
+                       self%T0, self%n0, self%ln_nj0, self%nj0)
+        end if
+        allocate(self%point(W), self%iter(W), self%ierr(W), self%converged(W))
+        allocate(self%state1(W), self%P(W), self%b0(W, ne), self%T(W), self%n(W), self%tsize(W))
+        allocate(self%ln_nj(W, ng), self%nj(W, ng), self%w(W, ng), self%mu(W, ng), self%dln_nj(W, ng))
+        allocate(self%h(W, ng), self%s(W, ng), self%cp(W, ng))
+        allocate(self%G(W, neq, neq+1), self%pi(W, ne), self%pi_prev(W, ne), self%dln_n(W), self%dln_T(W))
+        allocate(self%T0(W), self%n0(W), self%ln_nj0(W, ng), self%nj0(W, ng))
+        self%G = 0.0d0
+
+    end subroutine
+
+    subroutine EqBatchSolver_load(self, solver, l, k, type, state1, state2, weights)
+        ! Start point k in lane l from the state the lane holds
+
+        ! Arguments
+        class(EqBatchSolver), intent(inout) :: self
+        type(EqSolver), intent(in) :: solver
+        integer, intent(in) :: l
+        integer, intent(in) :: k
+        character(2), intent(in) :: type
+        real(dp), intent(in) :: state1(:)
+        real(dp), intent(in) :: state2(:)
+        real(dp), intent(in) :: weights(:, :)
+
+        ! Locals
+        type(EqConstraints) :: cons
+
+        cons = EqConstraints(solver%num_elements)
+        call cons%set(type, state1(min(k, size(state1))), state2(min(k, size(state2))), &
+                      solver%reactants%element_amounts_from_weights(weights(:, min(k, size(weights, 2)))))
+
+        self%point(l) = k
+        self%iter(l) = 0
+        self%state1(l) = cons%state1
+        self%P(l) = cons%state2
+        self%b0(l, :) = cons%b0
+        self%tsize(l) = 18.420681d0  ! As in EqSolver_solve_point
+        if (cons%is_constant_temperature()) self%T(l) = cons%state1
+
+        self%T0(l) = self%T(l)
+        self%n0(l) = self%n(l)
+        self%ln_nj0(l, :) = self%ln_nj(l, :)
+        self%nj0(l, :) = self%nj(l, :)
+
+        call self%eval_thermo(l, l)
+
+    end subroutine
+
+    subroutine EqBatchSolver_eval_thermo(self, l1, l2)
+        ! Gas enthalpy, entropy and heat capacity of lanes l1..l2, as in Mixture%calc_thermo
+
+        ! Arguments
+        class(EqBatchSolver), intent(inout), target :: self
+        integer, intent(in) :: l1, l2
+
+        ! Locals
+        integer :: j, l, i, nint, i_lo, i_hi
+        integer :: idx(l1:l2)
+        real(dp) :: T_min, T_max, Tl, logT(l1:l2), c(batch_num_coeffs), ch, cs, cc
+        real(dp), pointer :: f(:, :)
+
+        nint = size(self%T_low, 1)
+        T_min = minval(self%T(l1:l2))
+        T_max = maxval(self%T(l1:l2))
+        do l = l1, l2
+            logT(l) = log(self%T(l))
+        end do
+
+        do j = 1, self%num_gas
+            f => self%fits(:, :, j)
+
+            ! Fit interval: the last one whose lower bound is below T
+            i_lo = 1
+            i_hi = 1
+            do i = 1, nint
+                if (T_min > self%T_low(i, j)) i_lo = i
+                if (T_max > self%T_low(i, j)) i_hi = i
+            end do
+
+            if (i_lo == i_hi) then
+                ! Every lane uses the same interval
+                c = f(:, i_lo)
+                do l = l1, l2
+                    Tl = self%T(l)
+                    cc = c(7)
+                    cc = Tl*cc + c(6)
+                    cc = Tl*cc + c(5)
+                    cc = Tl*cc + c(4)
+                    cc = Tl*cc + c(3)
+                    cc = Tl*cc + c(2)
+                    cc = Tl*cc + c(1)
+                    self%cp(l, j) = cc/(Tl*Tl)
+                    ch = c(8)
+                    ch = Tl*ch + c(9)
+                    ch = Tl*ch + c(10)
+                    ch = Tl*ch + c(11)
+                    ch = Tl*ch + c(3)
+                    ch = Tl*ch + c(12)
+                    ch = Tl*ch - c(1)
+                    ch = ch/Tl + c(2)*logT(l)
+                    self%h(l, j) = ch/Tl
+                    cs = c(13)
+                    cs = Tl*cs + c(14)
+                    cs = Tl*cs + c(15)
+                    cs = Tl*cs + c(4)
+                    cs = Tl*cs + c(16)
+                    cs = Tl*cs - c(2)
+                    cs = Tl*cs - c(17)
+                    self%s(l, j) = cs/(Tl*Tl) + c(3)*logT(l)
+                end do
+            else
+                do l = l1, l2
+                    idx(l) = 1
+                    do i = 1, nint
+                        if (self%T(l) > self%T_low(i, j)) idx(l) = i
+                    end do
+                end do
+                do l = l1, l2
+                    Tl = self%T(l)
+                    i = idx(l)
+                    cc = f(7, i)
+                    cc = Tl*cc + f(6, i)
+                    cc = Tl*cc + f(5, i)
+                    cc = Tl*cc + f(4, i)
+                    cc = Tl*cc + f(3, i)
+                    cc = Tl*cc + f(2, i)
+                    cc = Tl*cc + f(1, i)
+                    self%cp(l, j) = cc/(Tl*Tl)
+                    ch = f(8, i)
+                    ch = Tl*ch + f(9, i)
+                    ch = Tl*ch + f(10, i)
+                    ch = Tl*ch + f(11, i)
+                    ch = Tl*ch + f(3, i)
+                    ch = Tl*ch + f(12, i)
+                    ch = Tl*ch - f(1, i)
+                    ch = ch/Tl + f(2, i)*logT(l)
+                    self%h(l, j) = ch/Tl
+                    cs = f(13, i)
+                    cs = Tl*cs + f(14, i)
+                    cs = Tl*cs + f(15, i)
+                    cs = Tl*cs + f(4, i)
+                    cs = Tl*cs + f(16, i)
+                    cs = Tl*cs - f(2, i)
+                    cs = Tl*cs - f(17, i)
+                    self%s(l, j) = cs/(Tl*Tl) + f(3, i)*logT(l)
+                end do
+            end if
+        end do
+
+    end subroutine
+
+    subroutine EqBatchSolver_assemble(self, const_t, const_s)
+        ! Newton matrices of all lanes, as in EqSolver_assemble_matrix without condensed species
+
+        ! Arguments
+        class(EqBatchSolver), intent(inout), target :: self
+        logical, intent(in) :: const_t
+        logical, intent(in) :: const_s
+
+        ! Locals
+        integer :: W, ng, ne, neq, r, i, j, k, l, m
+        integer :: act(self%num_gas)
+        real(dp) :: ln_P_n(self%width), thresh(self%width)
+        real(dp) :: n_delta(self%width), hsu_delta(self%width), sum_w(self%width), ssum(self%width)
+        real(dp) :: t(self%width, self%num_elements), tmp(self%width)
+        real(dp) :: wh(self%width), wmu(self%width), wcp(self%width)
+        real(dp) :: th(self%width), tmu(self%width), tsum(self%width)
+        real(dp) :: t_a(self%width, self%num_elements)
+        real(dp), pointer :: G(:, :, :)
+
+        W = self%width
+        ng = self%num_gas
+        ne = self%num_elements
+        neq = self%num_equations
+        G => self%G
+
+        ! Chemical potentials and Newton weights
+        do l = 1, W
+            ln_P_n(l) = log(self%P(l)/self%n(l))
+            thresh(l) = log(self%n(l)) - self%tsize(l)
+        end do
+        do j = 1, ng
+            do l = 1, W
+                self%mu(l, j) = self%h(l, j) - self%s(l, j) + self%ln_nj(l, j) + ln_P_n(l)
+                self%w(l, j) = merge(exp(self%ln_nj(l, j)), 0.0d0, self%ln_nj(l, j) > thresh(l))
+            end do
+        end do
+
+        ! Species above the threshold in any lane; the others have zero weight and add exact zeros
+        m = 0
+        do j = 1, ng
+            if (.not. any(self%ln_nj(:, j) > thresh)) cycle
+            m = m + 1
+            act(m) = j
+        end do
+
+        ! Element rows: pi, delta ln(n) and delta ln(T) columns, and the right hand side
+        do i = 1, ne
+            do j = 1, ne
+                G(:, i, j) = 0.0d0
+            end do
+        end do
+        t_a = 0.0d0
+        G(:, :ne, ne+1) = 0.0d0
+        if (.not. const_t) G(:, :ne, ne+2) = 0.0d0
+        G(:, :ne, neq+1) = 0.0d0
+        sum_w = 0.0d0
+        wh = 0.0d0
+        wmu = 0.0d0
+        wcp = 0.0d0
+        do k = 1, m
+            j = act(k)
+            do i = 1, ne
+                do l = 1, W
+                    t(l, i) = self%w(l, j)*self%A(j, i)
+                end do
+            end do
+            do r = 1, ne
+                do i = 1, ne
+                    do l = 1, W
+                        G(l, i, r) = G(l, i, r) + t(l, i)*self%A(j, r)
+                    end do
+                end do
+            end do
+            do i = 1, ne
+                do l = 1, W
+                    G(l, i, ne+1) = G(l, i, ne+1) + t(l, i)
+                    t_a(l, i) = t_a(l, i) + self%A(j, i)*self%w(l, j)
+                    G(l, i, neq+1) = G(l, i, neq+1) + t(l, i)*self%mu(l, j)
+                end do
+            end do
+            if (.not. const_t) then
+                do i = 1, ne
+                    do l = 1, W
+                        G(l, i, ne+2) = G(l, i, ne+2) + t(l, i)*self%h(l, j)
+                    end do
+                end do
+            end if
+            do l = 1, W
+                sum_w(l) = sum_w(l) + self%w(l, j)
+                wh(l) = wh(l) + self%w(l, j)*self%h(l, j)
+                wmu(l) = wmu(l) + self%w(l, j)*self%mu(l, j)
+                wcp(l) = wcp(l) + self%w(l, j)*self%cp(l, j)
+            end do
+        end do
+
+        ! Residuals of the element, moles and energy constraints
+        do i = 1, ne
+            do l = 1, W
+                G(l, i, neq+1) = (self%b0(l, i) - t_a(l, i)) + G(l, i, neq+1)
+                G(l, ne+1, i) = G(l, i, ne+1)
+            end do
+        end do
+        do l = 1, W
+            n_delta(l) = self%n(l) - sum_w(l)
+        end do
+        if (const_s) then
+            ssum = 0.0d0
+            do j = 1, ng
+                do l = 1, W
+                    ssum(l) = ssum(l) + self%nj(l, j)*(self%s(l, j) - self%ln_nj(l, j) - ln_P_n(l))
+                end do
+            end do
+            hsu_delta = self%state1 - ssum
+        else if (.not. const_t) then
+            hsu_delta = self%state1/self%T - wh
+        end if
+
+        ! Equation (2.26)
+        do l = 1, W
+            G(l, ne+1, ne+1) = -n_delta(l)
+        end do
+        if (.not. const_t) G(:, ne+1, ne+2) = wh
+        G(:, ne+1, neq+1) = n_delta + wmu
+
+        ! Equation (2.27)/(2.28): energy constraint
+        if (.not. const_t) then
+            r = ne + 2
+            t_a = 0.0d0
+            tsum = 0.0d0
+            th = 0.0d0
+            tmu = 0.0d0
+            do k = 1, m
+                j = act(k)
+                if (const_s) then
+                    tmp = self%w(:, j)*(self%h(:, j) - self%mu(:, j))
+                else
+                    tmp = self%w(:, j)*self%h(:, j)
+                end if
+                do i = 1, ne
+                    do l = 1, W
+                        t_a(l, i) = t_a(l, i) + tmp(l)*self%A(j, i)
+                    end do
+                end do
+                do l = 1, W
+                    tsum(l) = tsum(l) + tmp(l)
+                    th(l) = th(l) + tmp(l)*self%h(l, j)
+                    tmu(l) = tmu(l) + tmp(l)*self%mu(l, j)
+                end do
+            end do
+            do i = 1, ne
+                G(:, r, i) = t_a(:, i)
+            end do
+            G(:, r, ne+1) = tsum
+            G(:, r, ne+2) = wcp + th
+            G(:, r, neq+1) = hsu_delta + tmu
+            if (const_s) G(:, r, neq+1) = G(:, r, neq+1) + n_delta
+        end if
+
+    end subroutine
+
+    subroutine EqBatchSolver_factor(self)
+        ! Solve the Newton system of every lane in place, as in gauss (cea_equilibrium).
+        ! ierr is set for lanes whose matrix is singular.
+
+        ! Arguments
+        class(EqBatchSolver), intent(inout), target :: self
+
+        ! Locals
+        integer :: W, nrow, i, j, k, l, nn
+        integer :: ipivot(self%width)
+        real(dp) :: gn, ratio(self%width), min_ratio(self%width), t1, t2
+        real(dp), parameter :: bigno = 1.d25
+        real(dp), pointer :: a(:, :, :)
+
+        W = self%width
+        nrow = self%num_equations
+        a => self%G
+        self%ierr = 0
+
+        do nn = 1, nrow-1
+
+            ! Partial pivoting: the row with the smallest ratio of its largest entry to the pivot
+            min_ratio = bigno
+            ipivot = 0
+            do i = nn, nrow
+                ratio = 0.0d0
+                do j = nn+1, nrow+1
+                    do l = 1, W
+                        ratio(l) = max(ratio(l), abs(a(l, i, j)))
+                    end do
+                end do
+                do l = 1, W
+                    gn = abs(a(l, i, nn))
+                    ratio(l) = merge(ratio(l)/gn, bigno, gn > 0.0d0)
+                    if (ratio(l) < min_ratio(l)) then
+                        min_ratio(l) = ratio(l)
+                        ipivot(l) = i
+                    end if
+                end do
+            end do
+            do l = 1, W
+                if (ipivot(l) == 0) then
+                    if (self%ierr(l) == 0) self%ierr(l) = nn
+                    ipivot(l) = nn
+                end if
+            end do
+
+            ! Swap the pivot row into place
+            do i = nn+1, nrow
+                do j = nn, nrow+1
+                    do l = 1, W
+                        t1 = a(l, i, j)
+                        t2 = a(l, nn, j)
+                        a(l, i, j) = merge(t2, t1, ipivot(l) == i)
+                        a(l, nn, j) = merge(t1, t2, ipivot(l) == i)
+                    end do
+                end do
+            end do
+
+            ! Eliminate the nn-th unknown from the remaining rows
+            do j = nn+1, nrow+1
+                do l = 1, W
+                    a(l, nn, j) = a(l, nn, j)/a(l, nn, nn)
+                end do
+            end do
+            do j = nn+1, nrow+1
+                do i = nn+1, nrow
+                    do l = 1, W
+                        a(l, i, j) = a(l, i, j) - a(l, i, nn)*a(l, nn, j)
+                    end do
+                end do
+            end do
+
+        end do
+
+        ! Back substitution
+        do l = 1, W
+            a(l, nrow, nrow+1) = a(l, nrow, nrow+1)/a(l, nrow, nrow)
+            a(l, nrow, nrow) = 1.0d0
+        end do
+        do k = nrow-1, 1, -1
+            do i = k+1, nrow
+                do l = 1, W
+                    a(l, k, nrow+1) = a(l, k, nrow+1) - a(l, k, i)*a(l, i, nrow+1)
+                end do
+            end do
+        end do
+
+    end subroutine
+
+    subroutine EqBatchSolver_update(self, solver, const_t)
+        ! Damped Newton update of all lanes, as in EqSolver_update_solution
+
+        ! Arguments
+        class(EqBatchSolver), intent(inout), target :: self
+        type(EqSolver), intent(in) :: solver
+        logical, intent(in) :: const_t
+
+        ! Locals
+        integer :: W, ng, ne, neq, i, j, l
+        real(dp) :: ln_n(self%width), thresh(self%width), lambda(self%width)
+        real(dp) :: l1_denom(self%width), lambda2(self%width)
+        real(dp) :: d, l2_denom, size_
+        real(dp), parameter :: FACTOR = -9.2103404d0  ! log(1.d-4)
+        real(dp), pointer :: x(:, :)
+
+        W = self%width
+        ng = self%num_gas
+        ne = self%num_elements
+        neq = self%num_equations
+        x => self%G(:, :, neq+1)
+        size_ = solver%size
+
+        ! Solution variables
+        do i = 1, ne
+            self%pi(:, i) = x(:, i)
+        end do
+        self%dln_n = x(:, ne+1)
+        if (const_t) then
+            self%dln_T = 0.0d0
+        else
+            self%dln_T = x(:, ne+2)
+        end if
+        do j = 1, ng
+            do l = 1, W
+                d = 0.0d0
+                do i = 1, ne
+                    d = d + self%A(j, i)*self%pi(l, i)
+                end do
+                self%dln_nj(l, j) = -self%mu(l, j) + self%dln_n(l) + d + self%dln_T(l)*self%h(l, j)
+            end do
+        end do
+
+        ! Damped update factor (Eqs. 3.1-3.3)
+        do l = 1, W
+            ln_n(l) = log(self%n(l))
+            l1_denom(l) = max(5.0d0*abs(self%dln_T(l)), 5.0d0*abs(self%dln_n(l)))
+            lambda2(l) = 1.0d0
+        end do
+        do j = 1, ng
+            do l = 1, W
+                if (self%dln_nj(l, j) > 0.0d0) then
+                    if (self%ln_nj(l, j) - ln_n(l) + size_ <= 0.0d0) then
+                        l2_denom = abs(self%dln_nj(l, j) - self%dln_n(l))
+                        if (l2_denom >= size_ + FACTOR) then
+                            lambda2(l) = min(lambda2(l), abs(FACTOR - self%ln_nj(l, j) + ln_n(l))/l2_denom)
+                        end if
+                    else
+                        l1_denom(l) = max(l1_denom(l), self%dln_nj(l, j))
+                    end if
+                end if
+            end do
+        end do
+        do l = 1, W
+            lambda(l) = 1.0d0
+            if (l1_denom(l) > 2.0d0) lambda(l) = 2.0d0/l1_denom(l)
+            lambda(l) = min(1.0d0, lambda(l), lambda2(l))
+            thresh(l) = ln_n(l) - self%tsize(l)
+        end do
+
+        ! Species amounts, total moles and temperature
+        do j = 1, ng
+            do l = 1, W
+                self%ln_nj(l, j) = self%ln_nj(l, j) + lambda(l)*self%dln_nj(l, j)
+                self%nj(l, j) = merge(exp(self%ln_nj(l, j)), 0.0d0, self%ln_nj(l, j) > thresh(l))
+            end do
+        end do
+        do l = 1, W
+            self%n(l) = exp(ln_n(l) + lambda(l)*self%dln_n(l))
+        end do
+        if (.not. const_t) then
+            do l = 1, W
+                self%T(l) = exp(log(self%T(l)) + lambda(l)*self%dln_T(l))
+            end do
+            call self%eval_thermo(1, W)
+        end if
+
+    end subroutine
+
+    subroutine EqBatchSolver_check_convergence(self, solver, const_t, const_s)
+        ! Convergence test of all lanes, as in EqSolver_check_convergence
+
+        ! Arguments
+        class(EqBatchSolver), intent(inout) :: self
+        type(EqSolver), intent(in) :: solver
+        logical, intent(in) :: const_t
+        logical, intent(in) :: const_s
+
+        ! Locals
+        integer :: W, ng, ne, i, j, l
+        real(dp) :: sum_nj(self%width), ln_P_n(self%width), thresh(self%width), b(self%width)
+        real(dp) :: ssum(self%width), b_max(self%width), gas_max(self%width)
+        logical :: ok(self%width)
+        real(dp), parameter :: nj_tol = 0.5d-5   ! Tolerances of EqSolver_check_convergence
+        real(dp), parameter :: b_tol = 1.0d-6
+        real(dp), parameter :: T_tol = 1.0d-4
+        real(dp), parameter :: s_tol = 0.5d-4
+        real(dp), parameter :: pi_tol = 1.0d-3
+
+        W = self%width
+        ng = self%num_gas
+        ne = self%num_elements
+
+        ! Species and total moles updates (Eq. 3.5)
+        sum_nj = 0.0d0
+        gas_max = 0.0d0
+        do j = 1, ng
+            do l = 1, W
+                sum_nj(l) = sum_nj(l) + self%nj(l, j)
+                gas_max(l) = max(gas_max(l), self%nj(l, j)*abs(self%dln_nj(l, j)))
+            end do
+        end do
+        do l = 1, W
+            ok(l) = gas_max(l)/sum_nj(l) <= nj_tol
+            ok(l) = ok(l) .and. abs(self%n(l)*self%dln_n(l)/sum_nj(l)) <= nj_tol
+        end do
+
+        ! Element amounts (Eq. 3.6a)
+        b_max = maxval(self%b0, dim=2)
+        do i = 1, ne
+            b = 0.0d0
+            do j = 1, ng
+                do l = 1, W
+                    b(l) = b(l) + self%A(j, i)*self%nj(l, j)
+                end do
+            end do
+            do l = 1, W
+                if (self%b0(l, i) > b_tol) ok(l) = ok(l) .and. abs(self%b0(l, i) - b(l)) <= b_tol*b_max(l)
+            end do
+        end do
+
+        ! Temperature (Eq. 3.6b) and entropy (Eq. 3.6c)
+        if (.not. const_t) then
+            do l = 1, W
+                ok(l) = ok(l) .and. abs(self%dln_T(l)) <= T_tol
+            end do
+        end if
+        if (const_s) then
+            ssum = 0.0d0
+            do l = 1, W
+                ln_P_n(l) = log(self%P(l)/self%n(l))
+            end do
+            do j = 1, ng
+                do l = 1, W
+                    ssum(l) = ssum(l) + self%nj(l, j)*(self%s(l, j) - self%ln_nj(l, j) - ln_P_n(l))
+                end do
+            end do
+            do l = 1, W
+                ok(l) = ok(l) .and. abs(self%state1(l) - ssum(l)) <= s_tol
+            end do
+        end if
+
+        ! Modified Lagrange multipliers (Eq. 3.6d)
+        if (solver%trace > 0.0d0) then
+            do i = 1, ne
+                do l = 1, W
+                    if (abs(self%pi(l, i)) > tiny(1.0d0)) then
+                        ok(l) = ok(l) .and. abs((self%pi_prev(l, i) - self%pi(l, i))/self%pi(l, i)) <= pi_tol
+                    end if
+                end do
+            end do
+        end if
+        self%pi_prev = self%pi
+        self%converged = ok
+
+        ! Converged lanes switch to the final truncation size
+        if (.not. any(ok)) return
+        do l = 1, W
+            if (ok(l)) self%tsize(l) = solver%xsize
+            thresh(l) = log(self%n(l)) - self%tsize(l)
+        end do
+        do j = 1, ng
+            do l = 1, W
+                if (ok(l)) self%nj(l, j) = merge(exp(self%ln_nj(l, j)), 0.0d0, self%ln_nj(l, j) > thresh(l))
+            end do
+        end do
+
+    end subroutine
+
+    subroutine EqBatchSolver_finish(self, solver, soln, l, type, state1, state2, weights, results, partials)
+        ! Finish the converged point in lane l in soln, as EqSolver_solve_point does after
+        ! convergence. Falls back to EqSolver_solve if a condensed species should be added.
+
+        ! Arguments
+        class(EqBatchSolver), intent(inout) :: self
+        type(EqSolver), intent(inout) :: solver
+        type(EqSolution), intent(inout) :: soln
+        integer, intent(in) :: l
+        character(2), intent(in) :: type
+        real(dp), intent(in) :: state1(:)
+        real(dp), intent(in) :: state2(:)
+        real(dp), intent(in) :: weights(:, :)
+        type(EqResult), intent(inout) :: results(:)
+        type(EqPartials), intent(inout), optional :: partials
+
+        ! Locals
+        integer :: i, k, ng, iter
+
+        k = self%point(l)
+        ng = self%num_gas
+
+        ! Gas-only solution state of the lane
+        call soln%constraints%set(type, state1(min(k, size(state1))), state2(min(k, size(state2))), self%b0(l, :))
+        soln%w0 = weights(:, min(k, size(weights, 2)))
+        call clear_condensed(soln)
+        soln%T = self%T(l)
+        soln%n = self%n(l)
+        soln%ln_nj = self%ln_nj(l, :)
+        soln%nj(:ng) = self%nj(l, :)
+        soln%nj(ng+1:) = 0.0d0
+        soln%pi = self%pi(l, :)
+        soln%pi_prev = self%pi(l, :)
+        soln%dln_nj = self%dln_nj(l, :)
+        soln%dln_n = self%dln_n(l)
+        soln%dln_T = self%dln_T(l)
+        soln%converged = .true.
+        soln%times_converged = 1
+        solver%tsize = solver%xsize
+        solver%active_ions = solver%ions
+        solver%reduced_elements = 0
+        call solver%products%calc_thermo(soln%thermo, soln%T, condensed=.true.)
+
+        ! Check on adding condensed species
+        iter = self%iter(l)
+        call solver%test_condensed(soln, iter)
+        if (.not. soln%converged) then
+            call self%fallback(solver, soln, l, type, state1, state2, weights, results, partials)
+            return
+        end if
+
+        ! Final species amounts, with the post-processing threshold
+        do i = 1, ng
+            if (soln%ln_nj(i) > solver%log_min) soln%nj(i) = exp(soln%ln_nj(i))
+        end do
+
+        ! Partials, transport properties and post-processing, as the output mask selects
+        call solver%finish_outputs(soln, partials)
+
+        if (soln%T > solver%T_max .or. soln%T < solver%T_min) then
+            call log_warning("Mixture temperature outside of allowable bounds.")
+            soln%converged = .false.
+        end if
+        if (soln%converged) call EqSolution_save_seed(soln)
+
+        results(k) = EqResult(soln, partials)
+        self%nj(l, :) = soln%nj(:ng)
+        self%num_lockstep = self%num_lockstep + 1
+
+    end subroutine
+
+    subroutine EqBatchSolver_fallback(self, solver, soln, l, type, state1, state2, weights, results, partials)
+        ! Solve the point in lane l with EqSolver_solve, from the starting guess of the lane
+
+        ! Arguments
+        class(EqBatchSolver), intent(inout) :: self
+        type(EqSolver), intent(inout) :: solver
+        type(EqSolution), intent(inout) :: soln
+        integer, intent(in) :: l
+        character(2), intent(in) :: type
+        real(dp), intent(in) :: state1(:)
+        real(dp), intent(in) :: state2(:)
+        real(dp), intent(in) :: weights(:, :)
+        type(EqResult), intent(inout) :: results(:)
+        type(EqPartials), intent(inout), optional :: partials
+
+        ! Locals
+        integer :: k, ng
+
+        k = self%point(l)
+        ng = self%num_gas
+        if (log_enabled(log_levels%debug)) then
+            call log_debug('EqBatchSolver: solving point '//to_str(k)//' with EqSolver_solve')
+        end if
+
+        call clear_condensed(soln)
+        soln%T = self%T0(l)
+        soln%n = self%n0(l)
+        soln%ln_nj = self%ln_nj0(l, :)
+        soln%nj(:ng) = self%nj0(l, :)
+        soln%nj(ng+1:) = 0.0d0
+        soln%converged = .true.
+        call EqSolution_save_seed(soln)
+
+        call solver%solve(soln, type, state1(min(k, size(state1))), state2(min(k, size(state2))), &
+                          weights(:, min(k, size(weights, 2))), partials)
+        results(k) = EqResult(soln, partials)
+        self%num_fallback = self%num_fallback + 1
+
+        ! The next point in this lane starts from the same guess
+        self%T(l) = self%T0(l)
+        self%n(l) = self%n0(l)
+        self%ln_nj(l, :) = self%ln_nj0(l, :)
+        self%nj(l, :) = self%nj0(l, :)
+
+    end subroutine
+
+    subroutine clear_condensed(soln)
+        ! Deactivate every condensed species of soln
+        type(EqSolution), intent(inout) :: soln
+
+        soln%is_active = .false.
+        soln%active_rank = 0
+        soln%j_liq = 0
+        soln%j_sol = 0
+        soln%j_switch = 0
+
+    end subroutine
+
+end module
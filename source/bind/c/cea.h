@@ -1,6 +1,10 @@
 #include "stdbool.h"
 #include "cea_enum.h"
 
+// Log capture limits, per thread
+#define CEA_LOG_CAPTURE_MAX_RECORDS 64
+#define CEA_LOG_CAPTURE_RECORD_LEN  256
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -32,6 +36,14 @@ extern "C"
     CEA_EQDERIV_MATRIX_ENUM
   } cea_eqderiv_matrix;
   typedef enum
+  {
+    CEA_EQDERIV_OUTPUT_ENUM
+  } cea_eqderiv_output;
+  typedef enum
+  {
+    CEA_SOLVER_OUTPUT_ENUM
+  } cea_solver_output;
+  typedef enum
   {
     CEA_EQUILIBRIUM_SIZE_ENUM
   } cea_equilibrium_size;
@@ -52,6 +64,42 @@ extern "C"
     CEA_DETONATION_PROPERTY_TYPE_ENUM
   } cea_detonation_property_type;
   typedef enum
+  {
+    CEA_PROFILE_FORMAT_ENUM
+  } cea_profile_format;
+  typedef enum
+  {
+    CEA_INPUT_SCHEDULE_ENUM
+  } cea_input_schedule;
+  typedef enum
+  {
+    CEA_INPUT_REACTANT_SCHEDULE_ENUM
+  } cea_input_reactant_schedule;
+  typedef enum
+  {
+    CEA_INPUT_SPECIES_LIST_ENUM
+  } cea_input_species_list;
+  typedef enum
+  {
+    CEA_MC_INPUT_ENUM
+  } cea_mc_input;
+  typedef enum
+  {
+    CEA_MC_DISTRIBUTION_ENUM
+  } cea_mc_distribution;
+  typedef enum
+  {
+    CEA_MC_SAMPLING_ENUM
+  } cea_mc_sampling;
+  typedef enum
+  {
+    CEA_OF_OBJECTIVE_ENUM
+  } cea_of_objective;
+  typedef enum
+  {
+    CEA_JOB_STATE_ENUM
+  } cea_job_state;
+  typedef enum
   {
     CEA_ERROR_CODE_ENUM
   } cea_error_code;
@@ -60,21 +108,30 @@ extern "C"
   typedef struct cea_mixture_t *cea_reactant;
   typedef struct cea_mixture_t *cea_mixture;
   typedef struct cea_eqsolver_t *cea_eqsolver;
-  typedef struct cea_eqsolution *cea_eqsolution;
-  typedef struct cea_eqpartials *cea_eqpartials;
-  typedef struct cea_eqderivatives *cea_eqderivatives;
-  typedef struct cea_rocket_solver *cea_rocket_solver;
-  typedef struct cea_rocket_solution *cea_rocket_solution;
-  typedef struct cea_shock_solver *cea_shock_solver;
-  typedef struct cea_shock_solution *cea_shock_solution;
-  typedef struct cea_detonation_solver *cea_detonation_solver;
-  typedef struct cea_detonation_solution *cea_detonation_solution;
+  typedef struct cea_eqsolution_t *cea_eqsolution;
+  typedef struct cea_eqpartials_t *cea_eqpartials;
+  typedef struct cea_eqderivatives_t *cea_eqderivatives;
+  typedef struct cea_isat_table_t *cea_isat_table;
+  typedef struct cea_mc_driver_t *cea_mc_driver;
+  typedef struct cea_of_optimizer_t *cea_of_optimizer;
+  typedef struct cea_rocket_solver_t *cea_rocket_solver;
+  typedef struct cea_rocket_solution_t *cea_rocket_solution;
+  typedef struct cea_shock_solver_t *cea_shock_solver;
+  typedef struct cea_shock_solution_t *cea_shock_solution;
+  typedef struct cea_detonation_solver_t *cea_detonation_solver;
+  typedef struct cea_detonation_solution_t *cea_detonation_solution;
+  typedef struct cea_input_deck_t *cea_input_deck;
+  typedef struct cea_job_pool_t *cea_job_pool;
+  typedef struct cea_job_t *cea_job;
   typedef cea_error_code cea_err;
   typedef const char *cea_string;
   typedef int cea_int;
   typedef double cea_real;
   typedef double *cea_array;
 
+  // Completion callback of an asynchronous job; status is the return value of the solve, or CEA_CANCELLED
+  typedef void (*cea_job_callback)(cea_job job, cea_err status, void *user_data);
+
   typedef struct
   {
     cea_string name;
@@ -89,6 +146,9 @@ extern "C"
     bool has_temperature;
     cea_real temperature;
     cea_string temperature_units;
+    bool has_id;                 // take the name from species ID id instead of name
+    cea_int id;
+    const cea_int *element_ids;  // optional: num_elements element IDs, used instead of elements
   } cea_reactant_input;
 
   // Struct types for optional arguments
@@ -102,6 +162,10 @@ extern "C"
     const cea_string *insert;
     bool smooth_truncation;    // enable smooth logistic truncation instead of hard cutoff (default false)
     cea_real truncation_width; // gate width in log-space; <= 0 means use solver default (0.25)
+    const cea_int *insert_ids; // optional: ninsert species IDs, used instead of insert
+    cea_int outputs;           // OR of cea_solver_output flags computed in the solver's internal iterations
+                               // (default CEA_OUTPUT_ALL); the others are computed once before the solve
+                               // call returns. Equilibrium and rocket solvers only.
   } cea_solver_opts;
 
   // Initialize optional arguments
@@ -123,14 +187,67 @@ extern "C"
   cea_err cea_version_patch(cea_int *patch);
 
   // Logging Control
+  // CEA_LOG_NONE turns logging off. Messages below the level are dropped before they are formatted.
   cea_err cea_set_log_level(const cea_log_level level);
 
+  // Log capture
+  // While the capture is on, messages that pass the log level are kept in memory instead of being written
+  // to stdout. Each thread keeps its own ring of the latest max_records messages, and the getters read the
+  // calling thread's ring, oldest record first. Messages longer than CEA_LOG_CAPTURE_RECORD_LEN-1 are
+  // truncated. Starting the capture discards records held by every thread. Start and stop are not thread
+  // safe; call them while no solves are running.
+  cea_err cea_log_capture_start(const cea_int max_records);
+  cea_err cea_log_capture_stop();
+  cea_err cea_log_capture_get_count(cea_int *count);
+  cea_err cea_log_capture_get_dropped(cea_int *dropped);
+  cea_err cea_log_capture_get_record_buf(
+      const cea_int i,
+      cea_log_level *level,
+      char *message,
+      const cea_int buf_len);
+  cea_err cea_log_capture_clear();
+
+  // Profiling
+  // While profiling is on, each solver created afterwards records the wall-clock time of its phases (thermo,
+  // matrix assembly, gauss, condensed tests, partials, transport, post-processing, and the rocket, shock
+  // and detonation outer loops). Each solver keeps its own profile, so profiled solvers can run on separate
+  // threads. The _write_profile functions write per-phase totals, collapsed stacks, or a Chrome trace of a
+  // solver's profile to filename; a solver created while profiling was off writes an empty profile.
+  cea_err cea_set_profiling(const bool enabled);
+
   // Initialization (not thread safe)
   cea_err cea_init();
   cea_err cea_init_thermo(const cea_string thermofile);
   cea_err cea_init_trans(const cea_string transfile);
   cea_err cea_is_initialized(cea_int *initialized);
 
+  // Species and element IDs
+  // IDs index the loaded thermo database and do not change while it stays loaded. Species IDs count the
+  // database products first, then the reactant-only entries, so a name in both lists resolves to its
+  // product ID. Unknown names get an ID of -1 and the call returns CEA_INVALID_INDEX.
+  cea_err cea_num_species_ids(cea_int *num_ids);
+  cea_err cea_num_element_ids(cea_int *num_ids);
+
+  cea_err cea_species_ids(
+      const cea_int n,
+      const cea_string names[],
+      cea_int ids[]);
+
+  cea_err cea_element_ids(
+      const cea_int n,
+      const cea_string names[],
+      cea_int ids[]);
+
+  cea_err cea_species_id_name_buf(
+      const cea_int id,
+      char *name,
+      const cea_int buf_len);
+
+  cea_err cea_element_id_name_buf(
+      const cea_int id,
+      char *name,
+      const cea_int buf_len);
+
   //----------------------------------------------------------------------
   // Mixture API
   //----------------------------------------------------------------------
@@ -184,6 +301,31 @@ extern "C"
       const cea_int nomit,
       const cea_string omit[]);
 
+  // Species-ID forms of cea_mixture_create and cea_mixture_create_from_reactants
+  cea_err cea_mixture_create_by_ids(
+      cea_mixture *mix,
+      const cea_int nspecies,
+      const cea_int species_ids[]);
+
+  cea_err cea_mixture_create_by_ids_w_ions(
+      cea_mixture *mix,
+      const cea_int nspecies,
+      const cea_int species_ids[]);
+
+  cea_err cea_mixture_create_from_reactant_ids(
+      cea_mixture *mix,
+      const cea_int nreactants,
+      const cea_int reactant_ids[],
+      const cea_int nomit,
+      const cea_int omit_ids[]);
+
+  cea_err cea_mixture_create_from_reactant_ids_w_ions(
+      cea_mixture *mix,
+      const cea_int nreactants,
+      const cea_int reactant_ids[],
+      const cea_int nomit,
+      const cea_int omit_ids[]);
+
   cea_err cea_mixture_destroy(
       cea_mixture *mix);
 
@@ -192,6 +334,22 @@ extern "C"
       const cea_mixture mix,
       cea_int *num_species);
 
+  cea_err cea_mixture_get_num_elements(
+      const cea_mixture mix,
+      cea_int *num_elements);
+
+  // Database IDs of the mixture's species; custom reactants not in the database get -1
+  cea_err cea_mixture_get_species_ids(
+      const cea_mixture mix,
+      const cea_int nspecies,
+      cea_int ids[]);
+
+  // Database IDs of the mixture's elements; elements in no database product (e.g. E) get -1
+  cea_err cea_mixture_get_element_ids(
+      const cea_mixture mix,
+      const cea_int nelements,
+      cea_int ids[]);
+
   // Deprecated: returns a heap-allocated string that must be freed with cea_string_free.
   cea_err cea_mixture_get_species_name(
       const cea_mixture *mix,
@@ -327,6 +485,16 @@ extern "C"
       const cea_mixture products,
       const cea_solver_opts options);
 
+  // Copy of an existing solver with its own working state; the read-only product and
+  // transport data are shared by reference and freed with the last solver that uses them
+  cea_err cea_eqsolver_clone(
+      cea_eqsolver *clone,
+      const cea_eqsolver solver);
+  cea_err cea_eqsolver_write_profile(
+      const cea_eqsolver solver,
+      const cea_profile_format format,
+      const cea_string filename);
+
   cea_err cea_eqsolver_destroy(
       cea_eqsolver *solver);
 
@@ -348,6 +516,32 @@ extern "C"
       cea_eqsolution soln,
       cea_eqpartials eqpartials);
 
+  // Solves npts problems, iterating up to 16 of them together where the problem is at constant pressure
+  // (see EqBatchSolver). state1, state2 and amounts hold npts entries or a single entry used for every
+  // point; amounts holds rows of num_reactants weights. soln is the working storage and eqpartials may be
+  // NULL. Property prop_types[k] of point i is written to prop_values[i*nprops + k]. converged (npts flags)
+  // and species (npts rows of num_products fractions) may be NULL. Returns CEA_NOT_CONVERGED if any point
+  // did not converge; num_failed counts them.
+  cea_err cea_eqsolver_solve_batch(
+      const cea_eqsolver solver,
+      const cea_equilibrium_type type,
+      const cea_int npts,
+      const cea_int num_state1,
+      const cea_real state1[],
+      const cea_int num_state2,
+      const cea_real state2[],
+      const cea_int num_amounts,
+      const cea_real amounts[],
+      cea_eqsolution soln,
+      cea_eqpartials eqpartials,
+      const cea_int nprops,
+      const cea_property_type prop_types[],
+      cea_real prop_values[],
+      bool converged[],
+      cea_real species[],
+      const bool mass_fractions,
+      cea_int *num_failed);
+
   // Querry functions
   cea_err cea_eqsolver_get_size(
       const cea_eqsolver solver,
@@ -389,6 +583,13 @@ extern "C"
       const cea_property_type type,
       cea_real *value);
 
+  // values[i] receives property types[i]; invalid entries are set to the empty value
+  cea_err cea_eqsolution_get_properties(
+      const cea_eqsolution soln,
+      const cea_int nprops,
+      const cea_property_type types[],
+      cea_real values[]);
+
   cea_err cea_eqsolution_get_weights(
       const cea_eqsolution soln,
       const cea_int np,
@@ -441,6 +642,15 @@ extern "C"
       const cea_eqsolver solver,
       const cea_eqsolution soln);
 
+  // outputs is an OR of cea_eqderiv_output flags, e.g. CEA_DERIV_OUT_T | CEA_DERIV_WRT_W0. Only those
+  // derivatives, and the terms they depend on, are computed. A mask with no CEA_DERIV_OUT_* (or no
+  // CEA_DERIV_WRT_*) flag selects all of them. Getters for other outputs return CEA_INVALID_PROPERTY_TYPE.
+  cea_err cea_eqderivatives_create_with_outputs(
+      cea_eqderivatives *derivs,
+      const cea_eqsolver solver,
+      const cea_eqsolution soln,
+      const cea_int outputs);
+
   cea_err cea_eqderivatives_destroy(
       cea_eqderivatives *derivs);
 
@@ -486,6 +696,185 @@ extern "C"
       const cea_int cols,
       cea_real out[]);
 
+  //----------------------------------------------------------------------
+  // Equilibrium ISAT Cache API
+  //----------------------------------------------------------------------
+
+  // A table caches solutions of a single solver; it must not be shared across solvers.
+  // max_records <= 0 and tolerance/max_radius <= 0 select the defaults.
+  cea_err cea_isat_create(
+      cea_isat_table *isat,
+      const cea_int max_records,
+      const cea_real tolerance,
+      const cea_real max_radius);
+
+  cea_err cea_isat_destroy(
+      cea_isat_table *isat);
+
+  cea_err cea_isat_clear(
+      const cea_isat_table isat);
+
+  // Same contract as cea_eqsolver_solve, answered from the table when possible
+  cea_err cea_isat_solve(
+      const cea_isat_table isat,
+      const cea_eqsolver solver,
+      const cea_equilibrium_type type,
+      const cea_real state1,
+      const cea_real state2,
+      const cea_real amounts[],
+      cea_eqsolution soln);
+
+  cea_err cea_isat_get_stats(
+      const cea_isat_table isat,
+      cea_int *num_queries,
+      cea_int *num_hits,
+      cea_int *num_misses,
+      cea_int *num_grows,
+      cea_int *num_adds,
+      cea_int *num_evictions);
+
+  cea_err cea_isat_get_num_records(
+      const cea_isat_table isat,
+      cea_int *num_records);
+
+  //----------------------------------------------------------------------
+  // Monte Carlo Uncertainty API
+  //----------------------------------------------------------------------
+
+  // Results depend only on seed and num_threads; num_threads <= 0 selects 1.
+  // Statistics cover the converged samples of the last run.
+  cea_err cea_mc_create(
+      cea_mc_driver *mc,
+      const cea_int num_samples,
+      const cea_mc_sampling sampling,
+      const cea_int seed,
+      const cea_int num_threads);
+
+  cea_err cea_mc_destroy(
+      cea_mc_driver *mc);
+
+  // Probabilities of the estimated quantiles; default {0.05, 0.5, 0.95}
+  cea_err cea_mc_set_quantiles(
+      const cea_mc_driver mc,
+      const cea_int n,
+      const cea_real probabilities[]);
+
+  // width is the half-width (uniform, triangular) or standard deviation (normal)
+  // in the units of the input; enthalpy in J/mol. reactant is zero-based and
+  // ignored for state inputs.
+  cea_err cea_mc_add_input(
+      const cea_mc_driver mc,
+      const cea_mc_input input,
+      const cea_mc_distribution distribution,
+      const cea_real width,
+      const cea_int reactant);
+
+  // reactant_temps may be NULL; if given, state1 of an hp problem is recomputed
+  // per sample from the perturbed weights and enthalpies.
+  cea_err cea_mc_run_eq(
+      const cea_mc_driver mc,
+      const cea_eqsolver solver,
+      const cea_equilibrium_type type,
+      const cea_real state1,
+      const cea_real state2,
+      const cea_real weights[],
+      const cea_real reactant_temps[]);
+
+  // Infinite-area combustor; hc is used when use_hc, otherwise reactant_temps
+  cea_err cea_mc_run_rocket(
+      const cea_mc_driver mc,
+      const cea_rocket_solver solver,
+      const cea_real weights[],
+      const cea_real pc,
+      const cea_real pi_p[],
+      const cea_int n_pi_p,
+      const cea_real subar[],
+      const cea_int nsubar,
+      const cea_real supar[],
+      const cea_int nsupar,
+      const cea_real hc,
+      const bool use_hc,
+      const cea_real reactant_temps[]);
+
+  cea_err cea_mc_get_num_outputs(
+      const cea_mc_driver mc,
+      cea_int *num_outputs);
+
+  cea_err cea_mc_get_num_converged(
+      const cea_mc_driver mc,
+      cea_int *num_converged);
+
+  cea_err cea_mc_get_output_name_buf(
+      const cea_mc_driver mc,
+      const cea_int i_output,
+      char *name,
+      const cea_int buf_len);
+
+  cea_err cea_mc_get_stats(
+      const cea_mc_driver mc,
+      const cea_int i_output,
+      cea_real *mean,
+      cea_real *variance,
+      cea_real *min_value,
+      cea_real *max_value);
+
+  cea_err cea_mc_get_quantiles(
+      const cea_mc_driver mc,
+      const cea_int i_output,
+      const cea_int n,
+      cea_real quantiles[]);
+
+  //----------------------------------------------------------------------
+  // Mixture Ratio Optimizer API
+  //----------------------------------------------------------------------
+
+  // Maximizes the objective at the last station over o/f; tolerance is relative
+  // to o/f. tolerance <= 0 and max_solves <= 0 select the defaults (1e-4, 60).
+  cea_err cea_of_optimizer_create(
+      cea_of_optimizer *opt,
+      const cea_of_objective objective,
+      const cea_real tolerance,
+      const cea_int max_solves);
+
+  cea_err cea_of_optimizer_destroy(
+      cea_of_optimizer *opt);
+
+  // Cap the temperature [K] at a zero-based station; station 0 is the chamber
+  cea_err cea_of_optimizer_add_constraint(
+      const cea_of_optimizer opt,
+      const cea_int station,
+      const cea_real T_max);
+
+  // Infinite-area combustor. oxidant_weights and fuel_weights are per reactant;
+  // hc is used when use_hc, otherwise hc is computed for each o/f from
+  // reactant_temps. soln receives the solution at the optimum.
+  cea_err cea_of_optimizer_run_iac(
+      const cea_of_optimizer opt,
+      const cea_rocket_solver solver,
+      cea_rocket_solution soln,
+      const cea_real oxidant_weights[],
+      const cea_real fuel_weights[],
+      const cea_real of_min,
+      const cea_real of_max,
+      const cea_real pc,
+      const cea_real pi_p[],
+      const cea_int n_pi_p,
+      const cea_real subar[],
+      const cea_int nsubar,
+      const cea_real supar[],
+      const cea_int nsupar,
+      const cea_int n_frz,
+      const cea_real hc,
+      const bool use_hc,
+      const cea_real reactant_temps[]);
+
+  cea_err cea_of_optimizer_get_result(
+      const cea_of_optimizer opt,
+      cea_real *of_ratio,
+      cea_real *value,
+      cea_int *num_solves,
+      bool *constrained);
+
   //----------------------------------------------------------------------
   // Rocket Solver API
   //----------------------------------------------------------------------
@@ -505,6 +894,16 @@ extern "C"
       const cea_mixture products,
       const cea_solver_opts options);
 
+  // Copy of an existing solver with its own working state; the read-only product and
+  // transport data are shared by reference and freed with the last solver that uses them
+  cea_err cea_rocket_solver_clone(
+      cea_rocket_solver *clone,
+      const cea_rocket_solver solver);
+  cea_err cea_rocket_solver_write_profile(
+      const cea_rocket_solver solver,
+      const cea_profile_format format,
+      const cea_string filename);
+
   cea_err cea_rocket_solver_destroy(
       cea_rocket_solver *solver);
 
@@ -576,6 +975,14 @@ extern "C"
       const cea_int len,
       cea_real *value);
 
+  // values[i*len + j] receives property types[i] at station j
+  cea_err cea_rocket_solution_get_properties(
+      const cea_rocket_solution soln,
+      const cea_int nprops,
+      const cea_rocket_property_type types[],
+      const cea_int len,
+      cea_real values[]);
+
   cea_err cea_rocket_solution_get_weights(
       const cea_rocket_solution soln,
       const cea_int np,
@@ -590,6 +997,14 @@ extern "C"
       cea_real amounts[],
       const bool mass);
 
+  // amounts[j*np + k] receives species k at station j, for all len >= num_pts stations
+  cea_err cea_rocket_solution_get_all_species_amounts(
+      const cea_rocket_solution soln,
+      const cea_int np,
+      const cea_int len,
+      cea_real amounts[],
+      const bool mass);
+
   cea_err cea_rocket_solution_get_moles(
       const cea_rocket_solution soln,
       cea_real *moles);
@@ -629,6 +1044,16 @@ extern "C"
       const cea_mixture products,
       const cea_solver_opts options);
 
+  // Copy of an existing solver with its own working state; the read-only product and
+  // transport data are shared by reference and freed with the last solver that uses them
+  cea_err cea_shock_solver_clone(
+      cea_shock_solver *clone,
+      const cea_shock_solver solver);
+  cea_err cea_shock_solver_write_profile(
+      const cea_shock_solver solver,
+      const cea_profile_format format,
+      const cea_string filename);
+
   cea_err cea_shock_solver_destroy(
       cea_shock_solver *solver);
 
@@ -669,6 +1094,14 @@ extern "C"
       const cea_int len,
       cea_real *value);
 
+  // values[i*len + j] receives property types[i] at point j
+  cea_err cea_shock_solution_get_properties(
+      const cea_shock_solution soln,
+      const cea_int nprops,
+      const cea_shock_property_type types[],
+      const cea_int len,
+      cea_real values[]);
+
   cea_err cea_shock_solution_get_scalar_property(
       const cea_shock_solution soln,
       const cea_shock_property_type type,
@@ -688,6 +1121,14 @@ extern "C"
       cea_real amounts[],
       const bool mass);
 
+  // amounts[j*np + k] receives species k at point j, for all len >= num_pts points
+  cea_err cea_shock_solution_get_all_species_amounts(
+      const cea_shock_solution soln,
+      const cea_int np,
+      const cea_int len,
+      cea_real amounts[],
+      const bool mass);
+
   cea_err cea_shock_solution_get_moles(
       const cea_shock_solution soln,
       cea_real *moles);
@@ -715,6 +1156,16 @@ extern "C"
       const cea_mixture products,
       const cea_solver_opts options);
 
+  // Copy of an existing solver with its own working state; the read-only product and
+  // transport data are shared by reference and freed with the last solver that uses them
+  cea_err cea_detonation_solver_clone(
+      cea_detonation_solver *clone,
+      const cea_detonation_solver solver);
+  cea_err cea_detonation_solver_write_profile(
+      const cea_detonation_solver solver,
+      const cea_profile_format format,
+      const cea_string filename);
+
   cea_err cea_detonation_solver_destroy(
       cea_detonation_solver *solver);
 
@@ -751,6 +1202,13 @@ extern "C"
       const cea_int len,
       cea_real *value);
 
+  // values[i] receives property types[i]
+  cea_err cea_detonation_solution_get_properties(
+      const cea_detonation_solution soln,
+      const cea_int nprops,
+      const cea_detonation_property_type types[],
+      cea_real values[]);
+
   cea_err cea_detonation_solution_get_weights(
       const cea_detonation_solution soln,
       const cea_int np,
@@ -771,6 +1229,280 @@ extern "C"
       const cea_detonation_solution soln,
       int *converged);
 
+  //----------------------------------------------------------------------
+  // Input Deck API
+  //----------------------------------------------------------------------
+
+  // Parse every problem of a legacy input file (.inp) in one pass.
+  // Problems and reactants are indexed from 0. Malformed input aborts, as in the CLI.
+  cea_err cea_input_deck_create(
+      cea_input_deck *deck,
+      cea_string filename);
+
+  // Same as cea_input_deck_create for a deck held in memory; text need not be null-terminated
+  cea_err cea_input_deck_create_from_text(
+      cea_input_deck *deck,
+      const char *text,
+      const cea_int len);
+
+  cea_err cea_input_deck_destroy(
+      cea_input_deck *deck);
+
+  cea_err cea_input_deck_get_num_problems(
+      const cea_input_deck deck,
+      cea_int *num_problems);
+
+  cea_err cea_input_deck_get_problem_name_buf(
+      const cea_input_deck deck,
+      const cea_int problem,
+      char *name,
+      const cea_int buf_len);
+
+  // Problem type as written in the deck: tp, hp, sp, tv, uv, sv, det, rkt or shk
+  cea_err cea_input_deck_get_problem_type_buf(
+      const cea_input_deck deck,
+      const cea_int problem,
+      char *type,
+      const cea_int buf_len);
+
+  // Schedules keep the deck's units; a schedule the problem does not assign has size 0
+  cea_err cea_input_deck_get_schedule_size(
+      const cea_input_deck deck,
+      const cea_int problem,
+      const cea_input_schedule which,
+      cea_int *num_values);
+
+  cea_err cea_input_deck_get_schedule(
+      const cea_input_deck deck,
+      const cea_int problem,
+      const cea_input_schedule which,
+      const cea_int len,
+      cea_real values[]);
+
+  // Schedule keyword, e.g. o/f, phi or %f for CEA_INPUT_OF
+  cea_err cea_input_deck_get_schedule_name_buf(
+      const cea_input_deck deck,
+      const cea_int problem,
+      const cea_input_schedule which,
+      char *name,
+      const cea_int buf_len);
+
+  cea_err cea_input_deck_get_schedule_units_buf(
+      const cea_input_deck deck,
+      const cea_int problem,
+      const cea_input_schedule which,
+      char *units,
+      const cea_int buf_len);
+
+  cea_err cea_input_deck_get_num_reactants(
+      const cea_input_deck deck,
+      const cea_int problem,
+      cea_int *num_reactants);
+
+  cea_err cea_input_deck_get_reactant_name_buf(
+      const cea_input_deck deck,
+      const cea_int problem,
+      const cea_int reactant,
+      char *name,
+      const cea_int buf_len);
+
+  // Reactant type: fu, ox or na
+  cea_err cea_input_deck_get_reactant_type_buf(
+      const cea_input_deck deck,
+      const cea_int problem,
+      const cea_int reactant,
+      char *type,
+      const cea_int buf_len);
+
+  cea_err cea_input_deck_get_reactant_schedule_size(
+      const cea_input_deck deck,
+      const cea_int problem,
+      const cea_int reactant,
+      const cea_input_reactant_schedule which,
+      cea_int *num_values);
+
+  cea_err cea_input_deck_get_reactant_schedule(
+      const cea_input_deck deck,
+      const cea_int problem,
+      const cea_int reactant,
+      const cea_input_reactant_schedule which,
+      const cea_int len,
+      cea_real values[]);
+
+  // The amount schedule is named mole_frac or weight_frac
+  cea_err cea_input_deck_get_reactant_schedule_name_buf(
+      const cea_input_deck deck,
+      const cea_int problem,
+      const cea_int reactant,
+      const cea_input_reactant_schedule which,
+      char *name,
+      const cea_int buf_len);
+
+  cea_err cea_input_deck_get_reactant_schedule_units_buf(
+      const cea_input_deck deck,
+      const cea_int problem,
+      const cea_int reactant,
+      const cea_input_reactant_schedule which,
+      char *units,
+      const cea_int buf_len);
+
+  // Species from the only, omit or insert dataset; 0 when the problem has none
+  cea_err cea_input_deck_get_num_species(
+      const cea_input_deck deck,
+      const cea_int problem,
+      const cea_input_species_list which,
+      cea_int *num_species);
+
+  cea_err cea_input_deck_get_species_name_buf(
+      const cea_input_deck deck,
+      const cea_int problem,
+      const cea_input_species_list which,
+      const cea_int i_species,
+      char *name,
+      const cea_int buf_len);
+
+  //----------------------------------------------------------------------
+  // Asynchronous Job API
+  //----------------------------------------------------------------------
+
+  // A pool runs submitted solves on num_workers threads of its own. Up to queue_capacity jobs wait in a FIFO
+  // queue; cea_submit_* blocks while the queue is full. Jobs on the same solver run one at a time in
+  // submission order, and jobs on different solvers run concurrently. The input arrays are copied at
+  // submission; the solver and solution must stay alive, and the solution unread, until the job finishes.
+  // The submitting thread must not call the solver itself while it has unfinished jobs. Messages logged by a
+  // job go to the worker thread's capture ring, so cea_log_capture_* on the submitting thread does not see them.
+  cea_err cea_job_pool_create(
+      cea_job_pool *pool,
+      const cea_int num_workers,
+      const cea_int queue_capacity);
+
+  // Cancels the queued jobs, waits for the running ones, and stops the workers. Job handles stay valid.
+  cea_err cea_job_pool_destroy(
+      cea_job_pool *pool);
+
+  // Wait until no job is queued or running
+  cea_err cea_job_pool_wait(
+      const cea_job_pool pool);
+
+  // Each submit function takes the arguments of the matching solve call. job may be NULL when only the
+  // callback is needed; callback may be NULL. The callback runs once, on a worker thread after the solve or
+  // on the cancelling thread, before cea_job_wait returns. It must not wait on its own job or pool, or
+  // submit to a full queue of its own pool.
+  cea_err cea_submit_eqsolve(
+      cea_job *job,
+      const cea_job_pool pool,
+      const cea_eqsolver solver,
+      const cea_equilibrium_type type,
+      const cea_real state1,
+      const cea_real state2,
+      const cea_real amounts[],
+      cea_eqsolution soln,
+      const cea_job_callback callback,
+      void *user_data);
+
+  cea_err cea_submit_eqsolve_with_partials(
+      cea_job *job,
+      const cea_job_pool pool,
+      const cea_eqsolver solver,
+      const cea_equilibrium_type type,
+      const cea_real state1,
+      const cea_real state2,
+      const cea_real amounts[],
+      cea_eqsolution soln,
+      cea_eqpartials eqpartials,
+      const cea_job_callback callback,
+      void *user_data);
+
+  cea_err cea_submit_rocket_solve_iac(
+      cea_job *job,
+      const cea_job_pool pool,
+      const cea_rocket_solver solver,
+      cea_rocket_solution soln,
+      const cea_real weights[],
+      const cea_real pc,
+      const cea_real pi_p[],
+      const cea_int n_pi_p,
+      const cea_real subar[],
+      const cea_int nsubar,
+      const cea_real supar[],
+      const cea_int nsupar,
+      const cea_int n_frz,
+      const cea_real hc_or_tc,
+      const bool use_hc,
+      const cea_real tc_est,
+      const bool use_tc_est,
+      const cea_job_callback callback,
+      void *user_data);
+
+  cea_err cea_submit_rocket_solve_fac(
+      cea_job *job,
+      const cea_job_pool pool,
+      const cea_rocket_solver solver,
+      cea_rocket_solution soln,
+      const cea_real weights[],
+      const cea_real pc,
+      const cea_real pi_p[],
+      const cea_int n_pi_p,
+      const cea_real subar[],
+      const cea_int nsubar,
+      const cea_real supar[],
+      const cea_int nsupar,
+      const cea_int n_frz,
+      const cea_real hc_or_tc,
+      const bool use_hc,
+      const cea_real mdot_or_acat,
+      const bool use_mdot,
+      const cea_real tc_est,
+      const bool use_tc_est,
+      const cea_job_callback callback,
+      void *user_data);
+
+  cea_err cea_submit_shock_solve(
+      cea_job *job,
+      const cea_job_pool pool,
+      const cea_shock_solver solver,
+      cea_shock_solution soln,
+      const cea_real weights[],
+      const cea_real T0,
+      const cea_real p0,
+      const cea_real mach1_or_u1,
+      const bool use_mach,
+      const bool refl,
+      const bool incd_froz,
+      const bool refl_froz,
+      const cea_job_callback callback,
+      void *user_data);
+
+  cea_err cea_submit_detonation_solve(
+      cea_job *job,
+      const cea_job_pool pool,
+      const cea_detonation_solver solver,
+      cea_detonation_solution soln,
+      const cea_real weights[],
+      const cea_real T1,
+      const cea_real p1,
+      const bool frozen,
+      const cea_job_callback callback,
+      void *user_data);
+
+  // Poll, wait for, or cancel a job. status receives the solve's return value, or CEA_CANCELLED.
+  // Only queued jobs can be cancelled; cancelled reports whether this call cancelled the job.
+  cea_err cea_job_get_state(
+      const cea_job job,
+      cea_job_state *state);
+
+  cea_err cea_job_wait(
+      const cea_job job,
+      cea_err *status);
+
+  cea_err cea_job_cancel(
+      const cea_job job,
+      bool *cancelled);
+
+  // Release the handle; a job still queued or running is finished by its pool
+  cea_err cea_job_destroy(
+      cea_job *job);
+
 #ifdef __cplusplus
 }
 #endif
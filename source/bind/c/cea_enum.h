@@ -45,6 +45,32 @@
 #define CEA_EQDERIV_MATRIX_ENUM \
     CEA_DERIV_DNJ_DW0 = 0
 
+#define CEA_EQDERIV_OUTPUT_ENUM \
+    CEA_DERIV_OUT_T      = 1, \
+    CEA_DERIV_OUT_N      = 2, \
+    CEA_DERIV_OUT_NJ     = 4, \
+    CEA_DERIV_OUT_H      = 8, \
+    CEA_DERIV_OUT_U      = 16, \
+    CEA_DERIV_OUT_G      = 32, \
+    CEA_DERIV_OUT_S      = 64, \
+    CEA_DERIV_WRT_STATE1 = 256, \
+    CEA_DERIV_WRT_STATE2 = 512, \
+    CEA_DERIV_WRT_W0     = 2048, \
+    CEA_DERIV_OUT_ALL    = 4095
+
+#define CEA_SOLVER_OUTPUT_ENUM \
+    CEA_OUTPUT_PROPERTIES  = 1, \
+    CEA_OUTPUT_PARTIALS    = 2, \
+    CEA_OUTPUT_TRANSPORT   = 4, \
+    CEA_OUTPUT_PERFORMANCE = 8, \
+    CEA_OUTPUT_ALL         = 15
+
+#define CEA_JOB_STATE_ENUM \
+    CEA_JOB_QUEUED    = 0, \
+    CEA_JOB_RUNNING   = 1, \
+    CEA_JOB_DONE      = 2, \
+    CEA_JOB_CANCELLED = 3
+
 #define CEA_FUEL_RATIO_TYPE_ENUM \
     CEA_RATIO_NONE = 0, \
     CEA_OF_RATIO = 1, \
@@ -180,6 +206,57 @@
     CEA_DETONATION_FROZEN_PRANDTL           = 30, \
     CEA_DETONATION_EQUILIBRIUM_PRANDTL      = 31
 
+#define CEA_PROFILE_FORMAT_ENUM \
+    CEA_PROFILE_TOTALS       = 0, \
+    CEA_PROFILE_COLLAPSED    = 1, \
+    CEA_PROFILE_CHROME_TRACE = 2
+
+#define CEA_INPUT_SCHEDULE_ENUM \
+    CEA_INPUT_OF    = 0, \
+    CEA_INPUT_T     = 1, \
+    CEA_INPUT_H     = 2, \
+    CEA_INPUT_U     = 3, \
+    CEA_INPUT_S     = 4, \
+    CEA_INPUT_P     = 5, \
+    CEA_INPUT_V     = 6, \
+    CEA_INPUT_U1    = 7, \
+    CEA_INPUT_MACH1 = 8, \
+    CEA_INPUT_PCP   = 9, \
+    CEA_INPUT_SUBAR = 10, \
+    CEA_INPUT_SUPAR = 11
+
+#define CEA_INPUT_REACTANT_SCHEDULE_ENUM \
+    CEA_INPUT_REACTANT_AMOUNT      = 0, \
+    CEA_INPUT_REACTANT_TEMPERATURE = 1, \
+    CEA_INPUT_REACTANT_ENTHALPY    = 2, \
+    CEA_INPUT_REACTANT_DENSITY     = 3
+
+#define CEA_INPUT_SPECIES_LIST_ENUM \
+    CEA_INPUT_ONLY   = 0, \
+    CEA_INPUT_OMIT   = 1, \
+    CEA_INPUT_INSERT = 2
+
+#define CEA_MC_INPUT_ENUM \
+    CEA_MC_STATE1   = 0, \
+    CEA_MC_STATE2   = 1, \
+    CEA_MC_WEIGHT   = 2, \
+    CEA_MC_ENTHALPY = 3
+
+#define CEA_MC_DISTRIBUTION_ENUM \
+    CEA_MC_UNIFORM    = 0, \
+    CEA_MC_NORMAL     = 1, \
+    CEA_MC_TRIANGULAR = 2
+
+#define CEA_MC_SAMPLING_ENUM \
+    CEA_MC_RANDOM = 0, \
+    CEA_MC_LHS    = 1, \
+    CEA_MC_HALTON = 2
+
+#define CEA_OF_OBJECTIVE_ENUM \
+    CEA_OF_ISP   = 0, \
+    CEA_OF_IVAC  = 1, \
+    CEA_OF_CSTAR = 2
+
 #define CEA_ERROR_CODE_ENUM \
     CEA_SUCCESS                  = 0, \
     CEA_INVALID_FILENAME         = 1, \
@@ -189,4 +266,5 @@
     CEA_INVALID_EQUILIBRIUM_SIZE_TYPE = 5, \
     CEA_INVALID_INDEX            = 6, \
     CEA_INVALID_SIZE             = 7, \
-    CEA_NOT_CONVERGED            = 8
+    CEA_NOT_CONVERGED            = 8, \
+    CEA_CANCELLED                = 9
@@ -0,0 +1,818 @@
+// Asynchronous solve jobs for the C API
+//
+// cea_submit_* copies the arguments of a solve into a job and appends it to a
+// bounded FIFO queue, blocking while the queue is full. A fixed set of worker
+// threads takes jobs from the front of the queue. A solver holds its own
+// workspace, so jobs on the same solver run one at a time in submission order;
+// a worker skips past them to the first job whose solver is idle.
+//
+// A job is finished exactly once: by a worker after its solve, or by
+// cea_job_cancel / cea_job_pool_destroy while it is still queued. Finishing
+// runs the callback, then releases cea_job_wait. The pool and the caller each
+// hold a reference to a job, so a handle stays valid until cea_job_destroy.
+//
+// Lock order: pool lock, then job lock.
+
+#include <stdlib.h>
+#include <string.h>
+#include "cea.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef HANDLE job_thread;
+typedef SRWLOCK job_mutex;
+typedef CONDITION_VARIABLE job_cond;
+#define job_mutex_init(m)    InitializeSRWLock(m)
+#define job_mutex_destroy(m) ((void)(m))
+#define job_mutex_lock(m)    AcquireSRWLockExclusive(m)
+#define job_mutex_unlock(m)  ReleaseSRWLockExclusive(m)
+#define job_cond_init(c)     InitializeConditionVariable(c)
+#define job_cond_destroy(c)  ((void)(c))
+#define job_cond_wait(c, m)  SleepConditionVariableSRW(c, m, INFINITE, 0)
+#define job_cond_signal(c)   WakeConditionVariable(c)
+#define job_cond_broadcast(c) WakeAllConditionVariable(c)
+#else
+#include <pthread.h>
+typedef pthread_t job_thread;
+typedef pthread_mutex_t job_mutex;
+typedef pthread_cond_t job_cond;
+#define job_mutex_init(m)    pthread_mutex_init(m, NULL)
+#define job_mutex_destroy(m) pthread_mutex_destroy(m)
+#define job_mutex_lock(m)    pthread_mutex_lock(m)
+#define job_mutex_unlock(m)  pthread_mutex_unlock(m)
+#define job_cond_init(c)     pthread_cond_init(c, NULL)
+#define job_cond_destroy(c)  pthread_cond_destroy(c)
+#define job_cond_wait(c, m)  pthread_cond_wait(c, m)
+#define job_cond_signal(c)   pthread_cond_signal(c)
+#define job_cond_broadcast(c) pthread_cond_broadcast(c)
+#endif
+
+// Worker stack size; the solvers keep sizeable work arrays on the stack, and
+// the Windows default of 1 MB is too small for large product sets
+#define JOB_STACK_SIZE (16u * 1024u * 1024u)
+
+typedef enum
+{
+  JOB_EQ,
+  JOB_EQ_PARTIALS,
+  JOB_ROCKET_IAC,
+  JOB_ROCKET_FAC,
+  JOB_SHOCK,
+  JOB_DETONATION
+} job_kind;
+
+struct cea_job_t
+{
+  job_kind kind;
+  const void *solver;      // jobs on one solver run one at a time
+  cea_job_callback callback;
+  void *user_data;
+
+  job_mutex lock;
+  job_cond finished;
+  cea_job_state state;     // guarded by lock
+  cea_err status;          // guarded by lock
+  int refs;                // guarded by lock
+  cea_job_pool pool;       // guarded by lock; NULL once finished
+  struct cea_job_t *next;  // queue link, guarded by the pool lock
+
+  cea_real *data;          // copies of the input arrays
+  union
+  {
+    struct
+    {
+      cea_eqsolver solver;
+      cea_eqsolution soln;
+      cea_eqpartials partials;
+      cea_equilibrium_type type;
+      cea_real state1, state2;
+      const cea_real *amounts;
+    } eq;
+    struct
+    {
+      cea_rocket_solver solver;
+      cea_rocket_solution soln;
+      const cea_real *weights, *pi_p, *subar, *supar;
+      cea_int n_pi_p, nsubar, nsupar, n_frz;
+      cea_real pc, hc_or_tc, mdot_or_acat, tc_est;
+      bool use_hc, use_mdot, use_tc_est;
+    } rocket;
+    struct
+    {
+      cea_shock_solver solver;
+      cea_shock_solution soln;
+      const cea_real *weights;
+      cea_real T0, p0, mach1_or_u1;
+      bool use_mach, refl, incd_froz, refl_froz;
+    } shock;
+    struct
+    {
+      cea_detonation_solver solver;
+      cea_detonation_solution soln;
+      const cea_real *weights;
+      cea_real T1, p1;
+      bool frozen;
+    } detonation;
+  } args;
+};
+
+struct cea_job_pool_t
+{
+  job_mutex lock;
+  job_cond not_full;        // submitters wait for room in the queue
+  job_cond work;            // workers wait for a job they can run
+  job_cond idle;            // cea_job_pool_wait waits for an empty pool
+  struct cea_job_t *head;   // queued jobs, oldest first
+  struct cea_job_t *tail;
+  cea_int num_queued;
+  cea_int capacity;
+  cea_int num_running;
+  cea_int num_workers;
+  const void **running;     // solver of each worker's job, NULL when idle
+  job_thread *threads;
+  cea_int num_threads;      // threads started
+  bool stopping;
+};
+
+typedef struct
+{
+  cea_job_pool pool;
+  cea_int index;
+} worker_arg;
+
+//----------------------------------------------------------------------
+// Jobs
+//----------------------------------------------------------------------
+
+static cea_job job_alloc(job_kind kind, const void *solver, size_t num_reals,
+                         const cea_job_callback callback, void *user_data)
+{
+  cea_job job = calloc(1, sizeof(*job));
+  if (job == NULL)
+    return NULL;
+  if (num_reals > 0)
+  {
+    job->data = malloc(num_reals * sizeof(cea_real));
+    if (job->data == NULL)
+    {
+      free(job);
+      return NULL;
+    }
+  }
+  job->kind = kind;
+  job->solver = solver;
+  job->callback = callback;
+  job->user_data = user_data;
+  job->state = CEA_JOB_QUEUED;
+  job->status = CEA_SUCCESS;
+  job_mutex_init(&job->lock);
+  job_cond_init(&job->finished);
+  return job;
+}
+
+static void job_free(cea_job job)
+{
+  job_cond_destroy(&job->finished);
+  job_mutex_destroy(&job->lock);
+  free(job->data);
+  free(job);
+}
+
+static void job_release(cea_job job)
+{
+  int refs;
+  job_mutex_lock(&job->lock);
+  refs = --job->refs;
+  job_mutex_unlock(&job->lock);
+  if (refs == 0)
+    job_free(job);
+}
+
+// Copy n values to the next free slot of the job's array storage
+static const cea_real *job_copy(cea_real **slot, const cea_real *values, cea_int n)
+{
+  cea_real *dest = *slot;
+  if (n <= 0 || values == NULL)
+    return NULL;
+  memcpy(dest, values, (size_t)n * sizeof(cea_real));
+  *slot += n;
+  return dest;
+}
+
+static cea_err job_run(cea_job job)
+{
+  switch (job->kind)
+  {
+  case JOB_EQ:
+    return cea_eqsolver_solve(job->args.eq.solver, job->args.eq.type, job->args.eq.state1,
+                              job->args.eq.state2, job->args.eq.amounts, job->args.eq.soln);
+  case JOB_EQ_PARTIALS:
+    return cea_eqsolver_solve_with_partials(job->args.eq.solver, job->args.eq.type, job->args.eq.state1,
+                                            job->args.eq.state2, job->args.eq.amounts, job->args.eq.soln,
+                                            job->args.eq.partials);
+  case JOB_ROCKET_IAC:
+    return cea_rocket_solver_solve_iac(
+        job->args.rocket.solver, job->args.rocket.soln, job->args.rocket.weights, job->args.rocket.pc,
+        job->args.rocket.pi_p, job->args.rocket.n_pi_p, job->args.rocket.subar, job->args.rocket.nsubar,
+        job->args.rocket.supar, job->args.rocket.nsupar, job->args.rocket.n_frz, job->args.rocket.hc_or_tc,
+        job->args.rocket.use_hc, job->args.rocket.tc_est, job->args.rocket.use_tc_est);
+  case JOB_ROCKET_FAC:
+    return cea_rocket_solver_solve_fac(
+        job->args.rocket.solver, job->args.rocket.soln, job->args.rocket.weights, job->args.rocket.pc,
+        job->args.rocket.pi_p, job->args.rocket.n_pi_p, job->args.rocket.subar, job->args.rocket.nsubar,
+        job->args.rocket.supar, job->args.rocket.nsupar, job->args.rocket.n_frz, job->args.rocket.hc_or_tc,
+        job->args.rocket.use_hc, job->args.rocket.mdot_or_acat, job->args.rocket.use_mdot,
+        job->args.rocket.tc_est, job->args.rocket.use_tc_est);
+  case JOB_SHOCK:
+    return cea_shock_solver_solve(job->args.shock.solver, job->args.shock.soln, job->args.shock.weights,
+                                  job->args.shock.T0, job->args.shock.p0, job->args.shock.mach1_or_u1,
+                                  job->args.shock.use_mach, job->args.shock.refl, job->args.shock.incd_froz,
+                                  job->args.shock.refl_froz);
+  case JOB_DETONATION:
+    return cea_detonation_solver_solve(job->args.detonation.solver, job->args.detonation.soln,
+                                       job->args.detonation.weights, job->args.detonation.T1,
+                                       job->args.detonation.p1, job->args.detonation.frozen);
+  }
+  return CEA_INVALID_INDEX;
+}
+
+// Run the callback, release the waiters, and drop the pool's reference
+static void job_finish(cea_job job, cea_err status, cea_job_state state)
+{
+  if (job->callback)
+    job->callback(job, status, job->user_data);
+
+  job_mutex_lock(&job->lock);
+  job->status = status;
+  job->state = state;
+  job->pool = NULL;
+  job_cond_broadcast(&job->finished);
+  job_mutex_unlock(&job->lock);
+
+  job_release(job);
+}
+
+//----------------------------------------------------------------------
+// Pool
+//----------------------------------------------------------------------
+
+// Unlink the oldest queued job whose solver is idle; called with the pool lock held
+static cea_job pool_take(cea_job_pool pool)
+{
+  struct cea_job_t *prev = NULL;
+  struct cea_job_t *job;
+  cea_int i;
+
+  for (job = pool->head; job != NULL; prev = job, job = job->next)
+  {
+    for (i = 0; i < pool->num_workers; ++i)
+      if (pool->running[i] == job->solver)
+        break;
+    if (i < pool->num_workers)
+      continue;
+
+    if (prev)
+      prev->next = job->next;
+    else
+      pool->head = job->next;
+    if (pool->tail == job)
+      pool->tail = prev;
+    job->next = NULL;
+    pool->num_queued--;
+    return job;
+  }
+  return NULL;
+}
+
+// Unlink a given queued job; called with the pool lock held
+static bool pool_remove(cea_job_pool pool, cea_job target)
+{
+  struct cea_job_t *prev = NULL;
+  struct cea_job_t *job;
+
+  for (job = pool->head; job != NULL; prev = job, job = job->next)
+  {
+    if (job != target)
+      continue;
+    if (prev)
+      prev->next = job->next;
+    else
+      pool->head = job->next;
+    if (pool->tail == job)
+      pool->tail = prev;
+    job->next = NULL;
+    pool->num_queued--;
+    return true;
+  }
+  return false;
+}
+
+static void pool_work(cea_job_pool pool, cea_int index)
+{
+  cea_job job;
+  cea_err status;
+
+  job_mutex_lock(&pool->lock);
+  for (;;)
+  {
+    job = NULL;
+    while (!pool->stopping && (job = pool_take(pool)) == NULL)
+      job_cond_wait(&pool->work, &pool->lock);
+    if (job == NULL)
+      break;
+
+    pool->running[index] = job->solver;
+    pool->num_running++;
+    job_cond_signal(&pool->not_full);
+    job_mutex_lock(&job->lock);
+    job->state = CEA_JOB_RUNNING;
+    job_mutex_unlock(&job->lock);
+    job_mutex_unlock(&pool->lock);
+
+    status = job_run(job);
+    job_finish(job, status, CEA_JOB_DONE);
+
+    job_mutex_lock(&pool->lock);
+    pool->running[index] = NULL;
+    pool->num_running--;
+    // Jobs queued behind this one's solver may now run
+    job_cond_broadcast(&pool->work);
+    if (pool->num_queued == 0 && pool->num_running == 0)
+      job_cond_broadcast(&pool->idle);
+  }
+  job_mutex_unlock(&pool->lock);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI pool_worker(LPVOID arg)
+{
+  worker_arg *w = arg;
+  pool_work(w->pool, w->index);
+  free(w);
+  return 0;
+}
+
+static bool thread_start(job_thread *thread, worker_arg *arg)
+{
+  *thread = CreateThread(NULL, JOB_STACK_SIZE, pool_worker, arg, STACK_SIZE_PARAM_IS_A_RESERVATION, NULL);
+  return *thread != NULL;
+}
+
+static void thread_join(job_thread thread)
+{
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);
+}
+#else
+static void *pool_worker(void *arg)
+{
+  worker_arg *w = arg;
+  pool_work(w->pool, w->index);
+  free(w);
+  return NULL;
+}
+
+static bool thread_start(job_thread *thread, worker_arg *arg)
+{
+  pthread_attr_t attr;
+  int ierr;
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, JOB_STACK_SIZE);
+  ierr = pthread_create(thread, &attr, pool_worker, arg);
+  pthread_attr_destroy(&attr);
+  return ierr == 0;
+}
+
+static void thread_join(job_thread thread)
+{
+  pthread_join(thread, NULL);
+}
+#endif
+
+// Queue a job, blocking while the queue is full
+static cea_err pool_submit(cea_job_pool pool, cea_job *handle, cea_job job)
+{
+  if (job == NULL)
+    return CEA_INVALID_SIZE;
+
+  job->refs = handle ? 2 : 1;
+  job->pool = pool;
+
+  job_mutex_lock(&pool->lock);
+  while (!pool->stopping && pool->num_queued >= pool->capacity)
+    job_cond_wait(&pool->not_full, &pool->lock);
+  if (pool->stopping)
+  {
+    job_mutex_unlock(&pool->lock);
+    job_free(job);
+    return CEA_CANCELLED;
+  }
+  if (pool->tail)
+    pool->tail->next = job;
+  else
+    pool->head = job;
+  pool->tail = job;
+  pool->num_queued++;
+  job_cond_signal(&pool->work);
+  job_mutex_unlock(&pool->lock);
+
+  if (handle)
+    *handle = job;
+  return CEA_SUCCESS;
+}
+
+cea_err cea_job_pool_create(cea_job_pool *pool, const cea_int num_workers, const cea_int queue_capacity)
+{
+  cea_job_pool p;
+  worker_arg *arg;
+  cea_int i;
+
+  *pool = NULL;
+  if (num_workers < 1 || queue_capacity < 1)
+    return CEA_INVALID_SIZE;
+
+  p = calloc(1, sizeof(*p));
+  if (p == NULL)
+    return CEA_INVALID_SIZE;
+  p->capacity = queue_capacity;
+  p->num_workers = num_workers;
+  p->running = calloc((size_t)num_workers, sizeof(*p->running));
+  p->threads = calloc((size_t)num_workers, sizeof(*p->threads));
+  if (p->running == NULL || p->threads == NULL)
+  {
+    free(p->running);
+    free(p->threads);
+    free(p);
+    return CEA_INVALID_SIZE;
+  }
+  job_mutex_init(&p->lock);
+  job_cond_init(&p->not_full);
+  job_cond_init(&p->work);
+  job_cond_init(&p->idle);
+
+  for (i = 0; i < num_workers; ++i)
+  {
+    arg = malloc(sizeof(*arg));
+    if (arg == NULL)
+      break;
+    arg->pool = p;
+    arg->index = i;
+    if (!thread_start(&p->threads[i], arg))
+    {
+      free(arg);
+      break;
+    }
+    p->num_threads++;
+  }
+  *pool = p;
+  if (p->num_threads < num_workers)
+  {
+    cea_job_pool_destroy(pool);
+    return CEA_INVALID_SIZE;
+  }
+  return CEA_SUCCESS;
+}
+
+cea_err cea_job_pool_wait(const cea_job_pool pool)
+{
+  job_mutex_lock(&pool->lock);
+  while (pool->num_queued > 0 || pool->num_running > 0)
+    job_cond_wait(&pool->idle, &pool->lock);
+  job_mutex_unlock(&pool->lock);
+  return CEA_SUCCESS;
+}
+
+cea_err cea_job_pool_destroy(cea_job_pool *pool)
+{
+  cea_job_pool p = *pool;
+  struct cea_job_t *job, *next;
+  cea_int i;
+
+  if (p == NULL)
+    return CEA_SUCCESS;
+
+  // Cancel the queued jobs and stop the workers once their current jobs finish
+  job_mutex_lock(&p->lock);
+  p->stopping = true;
+  job = p->head;
+  p->head = p->tail = NULL;
+  p->num_queued = 0;
+  job_cond_broadcast(&p->work);
+  job_cond_broadcast(&p->not_full);
+  job_mutex_unlock(&p->lock);
+
+  for (; job != NULL; job = next)
+  {
+    next = job->next;
+    job->next = NULL;
+    job_finish(job, CEA_CANCELLED, CEA_JOB_CANCELLED);
+  }
+  for (i = 0; i < p->num_threads; ++i)
+    thread_join(p->threads[i]);
+
+  job_cond_destroy(&p->idle);
+  job_cond_destroy(&p->work);
+  job_cond_destroy(&p->not_full);
+  job_mutex_destroy(&p->lock);
+  free(p->threads);
+  free((void *)p->running);
+  free(p);
+  *pool = NULL;
+  return CEA_SUCCESS;
+}
+
+//----------------------------------------------------------------------
+// Job handles
+//----------------------------------------------------------------------
+
+cea_err cea_job_get_state(const cea_job job, cea_job_state *state)
+{
+  job_mutex_lock(&job->lock);
+  *state = job->state;
+  job_mutex_unlock(&job->lock);
+  return CEA_SUCCESS;
+}
+
+cea_err cea_job_wait(const cea_job job, cea_err *status)
+{
+  job_mutex_lock(&job->lock);
+  while (job->state == CEA_JOB_QUEUED || job->state == CEA_JOB_RUNNING)
+    job_cond_wait(&job->finished, &job->lock);
+  if (status)
+    *status = job->status;
+  job_mutex_unlock(&job->lock);
+  return CEA_SUCCESS;
+}
+
+cea_err cea_job_cancel(const cea_job job, bool *cancelled)
+{
+  cea_job_pool pool;
+  bool removed = false;
+
+  job_mutex_lock(&job->lock);
+  pool = job->pool;
+  job_mutex_unlock(&job->lock);
+
+  if (pool != NULL)
+  {
+    job_mutex_lock(&pool->lock);
+    removed = pool_remove(pool, job);
+    if (removed)
+    {
+      job_cond_signal(&pool->not_full);
+      if (pool->num_queued == 0 && pool->num_running == 0)
+        job_cond_broadcast(&pool->idle);
+    }
+    job_mutex_unlock(&pool->lock);
+  }
+  if (removed)
+    job_finish(job, CEA_CANCELLED, CEA_JOB_CANCELLED);
+  if (cancelled)
+    *cancelled = removed;
+  return CEA_SUCCESS;
+}
+
+cea_err cea_job_destroy(cea_job *job)
+{
+  if (*job != NULL)
+    job_release(*job);
+  *job = NULL;
+  return CEA_SUCCESS;
+}
+
+//----------------------------------------------------------------------
+// Submission
+//----------------------------------------------------------------------
+
+static cea_job eq_job(job_kind kind, const cea_eqsolver solver, const cea_equilibrium_type type,
+                      const cea_real state1, const cea_real state2, const cea_real amounts[],
+                      cea_eqsolution soln, cea_eqpartials partials,
+                      const cea_job_callback callback, void *user_data)
+{
+  cea_job job;
+  cea_real *slot;
+  cea_int nr = 0;
+
+  if (cea_eqsolver_get_size(solver, CEA_NUM_REACTANTS, &nr) != CEA_SUCCESS || nr < 1)
+    return NULL;
+  job = job_alloc(kind, solver, (size_t)nr, callback, user_data);
+  if (job == NULL)
+    return NULL;
+  slot = job->data;
+  job->args.eq.solver = solver;
+  job->args.eq.soln = soln;
+  job->args.eq.partials = partials;
+  job->args.eq.type = type;
+  job->args.eq.state1 = state1;
+  job->args.eq.state2 = state2;
+  job->args.eq.amounts = job_copy(&slot, amounts, nr);
+  return job;
+}
+
+cea_err cea_submit_eqsolve(
+    cea_job *job,
+    const cea_job_pool pool,
+    const cea_eqsolver solver,
+    const cea_equilibrium_type type,
+    const cea_real state1,
+    const cea_real state2,
+    const cea_real amounts[],
+    cea_eqsolution soln,
+    const cea_job_callback callback,
+    void *user_data)
+{
+  return pool_submit(pool, job, eq_job(JOB_EQ, solver, type, state1, state2, amounts, soln, NULL,
+                                       callback, user_data));
+}
+
+cea_err cea_submit_eqsolve_with_partials(
+    cea_job *job,
+    const cea_job_pool pool,
+    const cea_eqsolver solver,
+    const cea_equilibrium_type type,
+    const cea_real state1,
+    const cea_real state2,
+    const cea_real amounts[],
+    cea_eqsolution soln,
+    cea_eqpartials eqpartials,
+    const cea_job_callback callback,
+    void *user_data)
+{
+  return pool_submit(pool, job, eq_job(JOB_EQ_PARTIALS, solver, type, state1, state2, amounts, soln,
+                                       eqpartials, callback, user_data));
+}
+
+static cea_job rocket_job(job_kind kind, const cea_rocket_solver solver, cea_rocket_solution soln,
+                          const cea_real weights[], const cea_real pc,
+                          const cea_real pi_p[], const cea_int n_pi_p,
+                          const cea_real subar[], const cea_int nsubar,
+                          const cea_real supar[], const cea_int nsupar,
+                          const cea_job_callback callback, void *user_data)
+{
+  cea_job job;
+  cea_real *slot;
+  cea_int nr = 0;
+  cea_int n_pi = n_pi_p > 0 ? n_pi_p : 0;
+  cea_int nsub = nsubar > 0 ? nsubar : 0;
+  cea_int nsup = nsupar > 0 ? nsupar : 0;
+
+  if (cea_rocket_solver_get_size(solver, CEA_NUM_REACTANTS, &nr) != CEA_SUCCESS || nr < 1)
+    return NULL;
+  job = job_alloc(kind, solver, (size_t)(nr + n_pi + nsub + nsup), callback, user_data);
+  if (job == NULL)
+    return NULL;
+  slot = job->data;
+  job->args.rocket.solver = solver;
+  job->args.rocket.soln = soln;
+  job->args.rocket.pc = pc;
+  job->args.rocket.weights = job_copy(&slot, weights, nr);
+  job->args.rocket.pi_p = job_copy(&slot, pi_p, n_pi);
+  job->args.rocket.n_pi_p = n_pi_p;
+  job->args.rocket.subar = job_copy(&slot, subar, nsub);
+  job->args.rocket.nsubar = nsubar;
+  job->args.rocket.supar = job_copy(&slot, supar, nsup);
+  job->args.rocket.nsupar = nsupar;
+  return job;
+}
+
+cea_err cea_submit_rocket_solve_iac(
+    cea_job *job,
+    const cea_job_pool pool,
+    const cea_rocket_solver solver,
+    cea_rocket_solution soln,
+    const cea_real weights[],
+    const cea_real pc,
+    const cea_real pi_p[],
+    const cea_int n_pi_p,
+    const cea_real subar[],
+    const cea_int nsubar,
+    const cea_real supar[],
+    const cea_int nsupar,
+    const cea_int n_frz,
+    const cea_real hc_or_tc,
+    const bool use_hc,
+    const cea_real tc_est,
+    const bool use_tc_est,
+    const cea_job_callback callback,
+    void *user_data)
+{
+  cea_job j = rocket_job(JOB_ROCKET_IAC, solver, soln, weights, pc, pi_p, n_pi_p, subar, nsubar,
+                         supar, nsupar, callback, user_data);
+  if (j != NULL)
+  {
+    j->args.rocket.n_frz = n_frz;
+    j->args.rocket.hc_or_tc = hc_or_tc;
+    j->args.rocket.use_hc = use_hc;
+    j->args.rocket.tc_est = tc_est;
+    j->args.rocket.use_tc_est = use_tc_est;
+  }
+  return pool_submit(pool, job, j);
+}
+
+cea_err cea_submit_rocket_solve_fac(
+    cea_job *job,
+    const cea_job_pool pool,
+    const cea_rocket_solver solver,
+    cea_rocket_solution soln,
+    const cea_real weights[],
+    const cea_real pc,
+    const cea_real pi_p[],
+    const cea_int n_pi_p,
+    const cea_real subar[],
+    const cea_int nsubar,
+    const cea_real supar[],
+    const cea_int nsupar,
+    const cea_int n_frz,
+    const cea_real hc_or_tc,
+    const bool use_hc,
+    const cea_real mdot_or_acat,
+    const bool use_mdot,
+    const cea_real tc_est,
+    const bool use_tc_est,
+    const cea_job_callback callback,
+    void *user_data)
+{
+  cea_job j = rocket_job(JOB_ROCKET_FAC, solver, soln, weights, pc, pi_p, n_pi_p, subar, nsubar,
+                         supar, nsupar, callback, user_data);
+  if (j != NULL)
+  {
+    j->args.rocket.n_frz = n_frz;
+    j->args.rocket.hc_or_tc = hc_or_tc;
+    j->args.rocket.use_hc = use_hc;
+    j->args.rocket.mdot_or_acat = mdot_or_acat;
+    j->args.rocket.use_mdot = use_mdot;
+    j->args.rocket.tc_est = tc_est;
+    j->args.rocket.use_tc_est = use_tc_est;
+  }
+  return pool_submit(pool, job, j);
+}
+
+cea_err cea_submit_shock_solve(
+    cea_job *job,
+    const cea_job_pool pool,
+    const cea_shock_solver solver,
+    cea_shock_solution soln,
+    const cea_real weights[],
+    const cea_real T0,
+    const cea_real p0,
+    const cea_real mach1_or_u1,
+    const bool use_mach,
+    const bool refl,
+    const bool incd_froz,
+    const bool refl_froz,
+    const cea_job_callback callback,
+    void *user_data)
+{
+  cea_job j = NULL;
+  cea_real *slot;
+  cea_int nr = 0;
+
+  if (cea_shock_solver_get_size(solver, CEA_NUM_REACTANTS, &nr) == CEA_SUCCESS && nr > 0)
+    j = job_alloc(JOB_SHOCK, solver, (size_t)nr, callback, user_data);
+  if (j != NULL)
+  {
+    slot = j->data;
+    j->args.shock.solver = solver;
+    j->args.shock.soln = soln;
+    j->args.shock.weights = job_copy(&slot, weights, nr);
+    j->args.shock.T0 = T0;
+    j->args.shock.p0 = p0;
+    j->args.shock.mach1_or_u1 = mach1_or_u1;
+    j->args.shock.use_mach = use_mach;
+    j->args.shock.refl = refl;
+    j->args.shock.incd_froz = incd_froz;
+    j->args.shock.refl_froz = refl_froz;
+  }
+  return pool_submit(pool, job, j);
+}
+
+cea_err cea_submit_detonation_solve(
+    cea_job *job,
+    const cea_job_pool pool,
+    const cea_detonation_solver solver,
+    cea_detonation_solution soln,
+    const cea_real weights[],
+    const cea_real T1,
+    const cea_real p1,
+    const bool frozen,
+    const cea_job_callback callback,
+    void *user_data)
+{
+  cea_job j = NULL;
+  cea_real *slot;
+  cea_int nr = 0;
+
+  if (cea_detonation_solver_get_size(solver, CEA_NUM_REACTANTS, &nr) == CEA_SUCCESS && nr > 0)
+    j = job_alloc(JOB_DETONATION, solver, (size_t)nr, callback, user_data);
+  if (j != NULL)
+  {
+    slot = j->data;
+    j->args.detonation.solver = solver;
+    j->args.detonation.soln = soln;
+    j->args.detonation.weights = job_copy(&slot, weights, nr);
+    j->args.detonation.T1 = T1;
+    j->args.detonation.p1 = p1;
+    j->args.detonation.frozen = frozen;
+  }
+  return pool_submit(pool, job, j);
+}
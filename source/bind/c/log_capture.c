@@ -0,0 +1,134 @@
+// In-memory log capture for the C API
+//
+// Each thread keeps its own fixed-size ring of records, so capturing messages
+// from parallel solves takes no lock and never mixes records across threads.
+// The ring is reset lazily when cea_log_capture_start bumps the generation.
+// Like cea_set_log_level, starting or stopping the capture should not race
+// with running solves.
+
+#include <string.h>
+#include "cea.h"
+
+#if defined(_MSC_VER)
+#define CEA_THREAD_LOCAL __declspec(thread)
+#else
+#define CEA_THREAD_LOCAL _Thread_local
+#endif
+
+typedef struct
+{
+  cea_log_level level;
+  char message[CEA_LOG_CAPTURE_RECORD_LEN];
+} log_record;
+
+typedef struct
+{
+  long generation;  // capture generation the records belong to
+  cea_int head;     // index of the oldest record
+  cea_int count;    // number of records held
+  cea_int dropped;  // records overwritten since the last clear
+  log_record records[CEA_LOG_CAPTURE_MAX_RECORDS];
+} log_ring;
+
+static cea_int capture_limit = 0;
+static long capture_generation = 0;
+static CEA_THREAD_LOCAL log_ring thread_ring;
+
+static log_ring *current_ring(void)
+{
+  log_ring *ring = &thread_ring;
+  if (ring->generation != capture_generation)
+  {
+    ring->generation = capture_generation;
+    ring->head = 0;
+    ring->count = 0;
+    ring->dropped = 0;
+  }
+  return ring;
+}
+
+// Called from bindc.F90 when the capture is started
+cea_err cea_bindc_log_capture_reset(const cea_int max_records)
+{
+  if (max_records < 1 || max_records > CEA_LOG_CAPTURE_MAX_RECORDS)
+    return CEA_INVALID_SIZE;
+  capture_limit = max_records;
+  capture_generation++;
+  return CEA_SUCCESS;
+}
+
+// Log sink installed by cea_log_capture_start; message is not null-terminated
+void cea_bindc_log_capture_push(const cea_int level, const char *message, const cea_int len)
+{
+  log_ring *ring = current_ring();
+  log_record *rec;
+  cea_int n;
+
+  if (capture_limit < 1)
+    return;
+
+  if (ring->count < capture_limit)
+  {
+    rec = &ring->records[(ring->head + ring->count) % capture_limit];
+    ring->count++;
+  }
+  else
+  {
+    rec = &ring->records[ring->head];
+    ring->head = (ring->head + 1) % capture_limit;
+    ring->dropped++;
+  }
+
+  n = len < CEA_LOG_CAPTURE_RECORD_LEN - 1 ? len : CEA_LOG_CAPTURE_RECORD_LEN - 1;
+  if (n < 0)
+    n = 0;
+  memcpy(rec->message, message, (size_t)n);
+  rec->message[n] = '\0';
+  rec->level = (cea_log_level)level;
+}
+
+cea_err cea_log_capture_get_count(cea_int *count)
+{
+  *count = current_ring()->count;
+  return CEA_SUCCESS;
+}
+
+cea_err cea_log_capture_get_dropped(cea_int *dropped)
+{
+  *dropped = current_ring()->dropped;
+  return CEA_SUCCESS;
+}
+
+cea_err cea_log_capture_get_record_buf(
+    const cea_int i,
+    cea_log_level *level,
+    char *message,
+    const cea_int buf_len)
+{
+  log_ring *ring = current_ring();
+  const log_record *rec;
+  size_t len, ncopy;
+
+  if (i < 0 || i >= ring->count)
+    return CEA_INVALID_INDEX;
+  if (buf_len <= 0)
+    return CEA_INVALID_SIZE;
+
+  rec = &ring->records[(ring->head + i) % capture_limit];
+  len = strlen(rec->message);
+  ncopy = len < (size_t)(buf_len - 1) ? len : (size_t)(buf_len - 1);
+  memcpy(message, rec->message, ncopy);
+  message[ncopy] = '\0';
+  if (level)
+    *level = rec->level;
+  return (len + 1 > (size_t)buf_len) ? CEA_INVALID_SIZE : CEA_SUCCESS;
+}
+
+cea_err cea_log_capture_clear(void)
+{
+  log_ring *ring = current_ring();
+  ring->head = 0;
+  ring->count = 0;
+  ring->dropped = 0;
+  return CEA_SUCCESS;
+}
@@ -0,0 +1,142 @@
+#include "math.h"
+#include "stdio.h"
+#include "cea.h"
+
+#define LEN(x)  (sizeof(x) / sizeof((x)[0]))
+#define NJOBS   12
+
+// Counts the completions of each job; a job is finished exactly once
+static void on_done(cea_job job, cea_err status, void *user_data) {
+    int *count = (int *)user_data;
+    (void)job;
+    (void)status;
+    *count += 1;
+}
+
+int main(void) {
+
+    //------------------------------------------------------------------
+    // Problem Specification
+    //------------------------------------------------------------------
+
+    const cea_string reactants[] = { "H2", "O2" };
+    const cea_real moles[]       = { 2.0,  1.0 };
+    const cea_string products[]  = { "H", "H2", "H2O", "O", "O2", "OH" };
+
+    cea_set_log_level(CEA_LOG_WARNING);
+    cea_init();
+
+    cea_mixture reac, prod;
+    cea_mixture_create(&reac, LEN(reactants), reactants);
+    cea_mixture_create(&prod, LEN(products),  products);
+
+    cea_real weights[LEN(reactants)];
+    cea_mixture_moles_to_weights(reac, LEN(reactants), moles, weights);
+
+    // Two solvers, so jobs on different solvers overlap
+    cea_eqsolver solvers[2];
+    cea_eqsolver_create_with_reactants(&solvers[0], prod, reac);
+    cea_eqsolver_clone(&solvers[1], solvers[0]);
+
+    // Reference solves use a solver of their own; a solver with unfinished jobs belongs to the pool
+    cea_eqsolver reference;
+    cea_eqsolver_clone(&reference, solvers[0]);
+
+    cea_eqsolution solns[NJOBS];
+    cea_real temperatures[NJOBS];
+    for (int i=0; i < NJOBS; ++i) {
+        cea_eqsolution_create(&solns[i], solvers[i % 2]);
+        temperatures[i] = 1500.0 + 100.0*i;
+    }
+
+    //------------------------------------------------------------------
+    // Submit, then wait; results match the blocking solves to convergence tolerance
+    //------------------------------------------------------------------
+
+    int failures = 0;
+    int done[NJOBS] = { 0 };
+    cea_job jobs[NJOBS];
+
+    // A queue shorter than the number of jobs makes submission block
+    cea_job_pool pool;
+    cea_job_pool_create(&pool, 2, 2);
+
+    for (int i=0; i < NJOBS; ++i) {
+        cea_submit_eqsolve(&jobs[i], pool, solvers[i % 2], CEA_TP, temperatures[i], 10.0, weights,
+                           solns[i], on_done, &done[i]);
+    }
+
+    cea_eqsolution check;
+    cea_eqsolution_create(&check, reference);
+    for (int i=0; i < NJOBS; ++i) {
+        cea_err status;
+        cea_job_state state;
+        cea_job_wait(jobs[i], &status);
+        cea_job_get_state(jobs[i], &state);
+
+        cea_real T, h, h_check;
+        cea_eqsolver_solve(reference, CEA_TP, temperatures[i], 10.0, weights, check);
+        cea_eqsolution_get_property(solns[i], CEA_TEMPERATURE, &T);
+        cea_eqsolution_get_property(solns[i], CEA_ENTHALPY, &h);
+        cea_eqsolution_get_property(check, CEA_ENTHALPY, &h_check);
+        printf("%10.2f  %14.6e  %14.6e\n", T, h, h_check);
+
+        if (status != CEA_SUCCESS || state != CEA_JOB_DONE || done[i] != 1 || fabs(h - h_check) > 1e-8*fabs(h_check)) {
+            printf("job %d: status %d, state %d, callbacks %d\n", i, status, state, done[i]);
+            failures++;
+        }
+        cea_job_destroy(&jobs[i]);
+    }
+    cea_job_pool_wait(pool);
+
+    //------------------------------------------------------------------
+    // Cancellation
+    //------------------------------------------------------------------
+
+    // Jobs on one solver run one at a time, so the later ones wait in the queue
+    for (int i=0; i < NJOBS; ++i) {
+        done[i] = 0;
+        cea_submit_eqsolve(&jobs[i], pool, solvers[0], CEA_TP, temperatures[i], 1.0, weights,
+                           solns[i], on_done, &done[i]);
+        if (i == 1) {
+            bool cancelled;
+            cea_job_cancel(jobs[i], &cancelled);
+        }
+    }
+
+    // Destroying the pool cancels whatever is still queued
+    cea_job_pool_destroy(&pool);
+    int num_cancelled = 0;
+    for (int i=0; i < NJOBS; ++i) {
+        cea_err status;
+        cea_job_state state;
+        bool cancelled;
+        cea_job_get_state(jobs[i], &state);
+        cea_job_wait(jobs[i], &status);
+        cea_job_cancel(jobs[i], &cancelled);
+        if (state == CEA_JOB_CANCELLED) num_cancelled++;
+
+        if (done[i] != 1 || cancelled ||
+            (state == CEA_JOB_CANCELLED) != (status == CEA_CANCELLED) ||
+            (state != CEA_JOB_CANCELLED && state != CEA_JOB_DONE)) {
+            printf("job %d: status %d, state %d, callbacks %d\n", i, status, state, done[i]);
+            failures++;
+        }
+        cea_job_destroy(&jobs[i]);
+    }
+    printf("%d of %d jobs cancelled\n", num_cancelled, NJOBS);
+
+    //----------------------------------------------------------------
+    // CEA Cleanup
+    //----------------------------------------------------------------
+    cea_eqsolution_destroy(&check);
+    cea_eqsolver_destroy(&reference);
+    for (int i=0; i < NJOBS; ++i) cea_eqsolution_destroy(&solns[i]);
+    cea_eqsolver_destroy(&solvers[1]);
+    cea_eqsolver_destroy(&solvers[0]);
+    cea_mixture_destroy(&prod);
+    cea_mixture_destroy(&reac);
+
+    return failures;
+
+}
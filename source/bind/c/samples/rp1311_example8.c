@@ -72,24 +72,22 @@ int main(void) {
 
     cea_rocket_solver_solve_iac(solver, soln, weights, pc, pip, 1, subar, 1, supar, 1, 0, hc, TRUE, 0.0, FALSE);
 
-    cea_real* temperature = calloc(num_pts, sizeof(cea_real));
-    cea_real* pressure = calloc(num_pts, sizeof(cea_real));
-    cea_real* gamma = calloc(num_pts, sizeof(cea_real));
-    cea_real* mw = calloc(num_pts, sizeof(cea_real));
-    cea_real* mach = calloc(num_pts, sizeof(cea_real));
-    cea_real* area_ratio = calloc(num_pts, sizeof(cea_real));
-    cea_real* isp = calloc(num_pts, sizeof(cea_real));
-    cea_real* cstar = calloc(num_pts, sizeof(cea_real));
-    cea_real* cf = calloc(num_pts, sizeof(cea_real));
-    cea_rocket_solution_get_property(soln, CEA_ROCKET_TEMPERATURE, num_pts, temperature);
-    cea_rocket_solution_get_property(soln, CEA_ROCKET_PRESSURE, num_pts, pressure);
-    cea_rocket_solution_get_property(soln, CEA_ROCKET_GAMMA_S, num_pts, gamma);
-    cea_rocket_solution_get_property(soln, CEA_ROCKET_M, num_pts, mw);
-    cea_rocket_solution_get_property(soln, CEA_MACH, num_pts, mach);
-    cea_rocket_solution_get_property(soln, CEA_AE_AT, num_pts, area_ratio);
-    cea_rocket_solution_get_property(soln, CEA_ISP, num_pts, isp);
-    cea_rocket_solution_get_property(soln, CEA_C_STAR, num_pts, cstar);
-    cea_rocket_solution_get_property(soln, CEA_COEFFICIENT_OF_THRUST, num_pts, cf);
+    // Fetch every reported property for all stations in one call
+    const cea_rocket_property_type props[] = {
+        CEA_ROCKET_TEMPERATURE, CEA_ROCKET_PRESSURE, CEA_ROCKET_GAMMA_S, CEA_ROCKET_M, CEA_MACH,
+        CEA_AE_AT, CEA_ISP, CEA_C_STAR, CEA_COEFFICIENT_OF_THRUST
+    };
+    cea_real* values = calloc(LEN(props)*num_pts, sizeof(cea_real));
+    cea_rocket_solution_get_properties(soln, LEN(props), props, num_pts, values);
+    const cea_real* temperature = &values[0*num_pts];
+    const cea_real* pressure    = &values[1*num_pts];
+    const cea_real* gamma       = &values[2*num_pts];
+    const cea_real* mw          = &values[3*num_pts];
+    const cea_real* mach        = &values[4*num_pts];
+    const cea_real* area_ratio  = &values[5*num_pts];
+    const cea_real* isp         = &values[6*num_pts];
+    const cea_real* cstar       = &values[7*num_pts];
+    const cea_real* cf          = &values[8*num_pts];
 
     printf(
         "%10s %10s %10s %10s %10s %10s %10s %10s %10s \n",
@@ -112,15 +110,7 @@ int main(void) {
     cea_mixture_destroy(&prod);
     cea_mixture_destroy(&reac);
     free(weights);
-    free(temperature);
-    free(pressure);
-    free(gamma);
-    free(mw);
-    free(mach);
-    free(area_ratio);
-    free(isp);
-    free(cstar);
-    free(cf);
+    free(values);
 
     return 0;
 
@@ -0,0 +1,1580 @@
+// CEA C++ binding
+//
+// Header-only C++17 wrapper over the C API in cea.h:
+//   - handles are move-only RAII objects; destruction calls the matching cea_*_destroy
+//   - array results are written to caller buffers or returned as cea::span views over
+//     storage owned by the solution object, so steady-state calls do not allocate
+//   - species names are read once per mixture into a flat table of string_views
+//   - errors other than CEA_NOT_CONVERGED are raised as cea::error
+//
+// Threading follows the C API: a solver and its solutions must not be used from two threads
+// at once. Use clone() to give each thread its own solver.
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cea.h"
+
+namespace cea
+{
+
+    //------------------------------------------------------------------
+    // Errors
+    //------------------------------------------------------------------
+
+    inline const char *error_name(cea_err code) noexcept
+    {
+        switch (code)
+        {
+        case CEA_SUCCESS: return "CEA_SUCCESS";
+        case CEA_INVALID_FILENAME: return "CEA_INVALID_FILENAME";
+        case CEA_INVALID_PROPERTY_TYPE: return "CEA_INVALID_PROPERTY_TYPE";
+        case CEA_INVALID_EQUILIBRIUM_TYPE: return "CEA_INVALID_EQUILIBRIUM_TYPE";
+        case CEA_INVALID_ROCKET_TYPE: return "CEA_INVALID_ROCKET_TYPE";
+        case CEA_INVALID_EQUILIBRIUM_SIZE_TYPE: return "CEA_INVALID_EQUILIBRIUM_SIZE_TYPE";
+        case CEA_INVALID_INDEX: return "CEA_INVALID_INDEX";
+        case CEA_INVALID_SIZE: return "CEA_INVALID_SIZE";
+        case CEA_NOT_CONVERGED: return "CEA_NOT_CONVERGED";
+        case CEA_CANCELLED: return "CEA_CANCELLED";
+        }
+        return "CEA_UNKNOWN_ERROR";
+    }
+
+    class error : public std::runtime_error
+    {
+    public:
+        explicit error(cea_err code) : std::runtime_error(error_name(code)), code_(code) {}
+        cea_err code() const noexcept { return code_; }
+
+    private:
+        cea_err code_;
+    };
+
+    namespace detail
+    {
+        inline void check(cea_err ierr)
+        {
+            if (ierr != CEA_SUCCESS) throw error(ierr);
+        }
+
+        // Solve calls report non-convergence through the return value instead of throwing
+        inline bool check_solve(cea_err ierr)
+        {
+            if (ierr == CEA_NOT_CONVERGED) return false;
+            check(ierr);
+            return true;
+        }
+
+        inline void check_size(bool ok)
+        {
+            if (!ok) throw error(CEA_INVALID_SIZE);
+        }
+
+        inline cea_int as_int(std::size_t n) { return static_cast<cea_int>(n); }
+    }
+
+    //------------------------------------------------------------------
+    // span: non-owning view of a contiguous array
+    //------------------------------------------------------------------
+
+    // Minimal stand-in for C++20 std::span so the binding builds as C++17. It converts
+    // implicitly from pointer/size pairs, C arrays, and any container with data() and
+    // size() (std::vector, std::array, std::span).
+    template <typename T>
+    class span
+    {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = std::size_t;
+        using iterator = T *;
+
+        constexpr span() noexcept = default;
+        constexpr span(T *data, size_type size) noexcept : data_(data), size_(size) {}
+
+        template <std::size_t N>
+        constexpr span(T (&arr)[N]) noexcept : data_(arr), size_(N) {}
+
+        template <typename C,
+                  typename = std::enable_if_t<
+                      !std::is_array_v<std::remove_reference_t<C>> &&
+                      std::is_convertible_v<decltype(std::declval<C &>().data()), T *>>>
+        constexpr span(C &&c) noexcept(noexcept(c.data())) : data_(c.data()), size_(c.size()) {}
+
+        // Lets braced lists be passed as arguments; the list only lives until the end of the call
+        template <typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+        constexpr span(std::initializer_list<value_type> il) noexcept : data_(il.begin()), size_(il.size()) {}
+
+        constexpr T *data() const noexcept { return data_; }
+        constexpr size_type size() const noexcept { return size_; }
+        constexpr bool empty() const noexcept { return size_ == 0; }
+        constexpr T &operator[](size_type i) const noexcept { return data_[i]; }
+        constexpr iterator begin() const noexcept { return data_; }
+        constexpr iterator end() const noexcept { return data_ + size_; }
+
+        constexpr span subspan(size_type offset, size_type count) const noexcept
+        {
+            return span(data_ + offset, count);
+        }
+
+    private:
+        T *data_ = nullptr;
+        size_type size_ = 0;
+    };
+
+    //------------------------------------------------------------------
+    // Library setup
+    //------------------------------------------------------------------
+
+    struct version_info
+    {
+        int major;
+        int minor;
+        int patch;
+    };
+
+    inline version_info version()
+    {
+        version_info v{};
+        detail::check(cea_version_major(&v.major));
+        detail::check(cea_version_minor(&v.minor));
+        detail::check(cea_version_patch(&v.patch));
+        return v;
+    }
+
+    inline void set_log_level(cea_log_level level) { detail::check(cea_set_log_level(level)); }
+
+    // Solvers created while profiling is on record time per solve phase; see write_profile()
+    inline void set_profiling(bool enabled) { detail::check(cea_set_profiling(enabled)); }
+
+    // Log capture; records are kept per thread, see cea.h
+    struct log_record
+    {
+        cea_log_level level;
+        std::string message;
+    };
+
+    inline void start_log_capture(int max_records = CEA_LOG_CAPTURE_MAX_RECORDS)
+    {
+        detail::check(cea_log_capture_start(max_records));
+    }
+    inline void stop_log_capture() { detail::check(cea_log_capture_stop()); }
+    inline void clear_log_records() { detail::check(cea_log_capture_clear()); }
+
+    // Records captured on the calling thread, oldest first
+    inline std::vector<log_record> log_records()
+    {
+        cea_int count = 0;
+        detail::check(cea_log_capture_get_count(&count));
+        std::vector<log_record> out;
+        out.reserve(static_cast<std::size_t>(count));
+        char buf[CEA_LOG_CAPTURE_RECORD_LEN];
+        for (cea_int i = 0; i < count; ++i)
+        {
+            cea_log_level level;
+            detail::check(cea_log_capture_get_record_buf(i, &level, buf, CEA_LOG_CAPTURE_RECORD_LEN));
+            out.push_back({level, buf});
+        }
+        return out;
+    }
+
+    // Not thread safe; call once before creating any mixtures
+    inline void init() { detail::check(cea_init()); }
+    inline void init(const char *thermofile) { detail::check(cea_init_thermo(thermofile)); }
+    inline void init(const char *thermofile, const char *transfile)
+    {
+        detail::check(cea_init_thermo(thermofile));
+        detail::check(cea_init_trans(transfile));
+    }
+
+    inline bool is_initialized()
+    {
+        cea_int initialized = 0;
+        detail::check(cea_is_initialized(&initialized));
+        return initialized != 0;
+    }
+
+    //------------------------------------------------------------------
+    // Species and element IDs
+    //------------------------------------------------------------------
+
+    // Database IDs are resolved once from names at setup time; unknown names throw
+    inline int num_species_ids()
+    {
+        cea_int n = 0;
+        detail::check(cea_num_species_ids(&n));
+        return n;
+    }
+
+    inline int num_element_ids()
+    {
+        cea_int n = 0;
+        detail::check(cea_num_element_ids(&n));
+        return n;
+    }
+
+    inline void species_ids(span<const cea_string> names, span<cea_int> ids)
+    {
+        detail::check_size(ids.size() >= names.size());
+        detail::check(cea_species_ids(detail::as_int(names.size()), names.data(), ids.data()));
+    }
+
+    inline void element_ids(span<const cea_string> names, span<cea_int> ids)
+    {
+        detail::check_size(ids.size() >= names.size());
+        detail::check(cea_element_ids(detail::as_int(names.size()), names.data(), ids.data()));
+    }
+
+    inline cea_solver_opts solver_options()
+    {
+        cea_solver_opts opts;
+        detail::check(cea_solver_opts_init(&opts));
+        return opts;
+    }
+
+    //------------------------------------------------------------------
+    // Handle ownership
+    //------------------------------------------------------------------
+
+    namespace detail
+    {
+        // Move-only owner of a C handle; Destroy is the matching cea_*_destroy function
+        template <typename H, cea_err (*Destroy)(H *)>
+        class handle
+        {
+        public:
+            handle() noexcept = default;
+            explicit handle(H ptr) noexcept : ptr_(ptr) {}
+            ~handle() { reset(); }
+
+            handle(const handle &) = delete;
+            handle &operator=(const handle &) = delete;
+            handle(handle &&other) noexcept : ptr_(std::exchange(other.ptr_, nullptr)) {}
+            handle &operator=(handle &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    reset();
+                    ptr_ = std::exchange(other.ptr_, nullptr);
+                }
+                return *this;
+            }
+
+            H get() const noexcept { return ptr_; }
+            explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+            void reset() noexcept
+            {
+                if (ptr_ != nullptr) Destroy(&ptr_);
+                ptr_ = nullptr;
+            }
+
+        private:
+            H ptr_ = nullptr;
+        };
+
+        template <typename H>
+        using size_getter = cea_err (*)(H, cea_equilibrium_size, cea_int *);
+
+        // Problem sizes are fixed at solver creation, so they are read once
+        struct solver_sizes
+        {
+            int num_reactants = 0;
+            int num_products = 0;
+            int num_gas = 0;
+            int num_condensed = 0;
+            int num_elements = 0;
+            int max_equations = 0;
+
+            template <typename H>
+            static solver_sizes read(H ptr, size_getter<H> get)
+            {
+                solver_sizes s;
+                check(get(ptr, CEA_NUM_REACTANTS, &s.num_reactants));
+                check(get(ptr, CEA_NUM_PRODUCTS, &s.num_products));
+                check(get(ptr, CEA_NUM_GAS, &s.num_gas));
+                check(get(ptr, CEA_NUM_CONDENSED, &s.num_condensed));
+                check(get(ptr, CEA_NUM_ELEMENTS, &s.num_elements));
+                check(get(ptr, CEA_MAX_EQUATIONS, &s.max_equations));
+                return s;
+            }
+        };
+    }
+
+    //------------------------------------------------------------------
+    // Species names
+    //------------------------------------------------------------------
+
+    // Names of a mixture's species, read once into one flat buffer
+    class species_names
+    {
+    public:
+        species_names() = default;
+
+        explicit species_names(cea_mixture mix)
+        {
+            cea_int nspecies = 0;
+            detail::check(cea_mixture_get_num_species(mix, &nspecies));
+            detail::check(cea_species_name_len(&stride_));
+            stride_ += 1;
+            count_ = static_cast<std::size_t>(nspecies);
+            buf_.assign(count_ * static_cast<std::size_t>(stride_), '\0');
+            if (count_ > 0)
+            {
+                detail::check(cea_mixture_get_species_names_buf(&mix, nspecies, buf_.data(), stride_));
+            }
+        }
+
+        std::size_t size() const noexcept { return count_; }
+
+        std::string_view operator[](std::size_t i) const noexcept
+        {
+            return std::string_view(buf_.data() + i * static_cast<std::size_t>(stride_));
+        }
+
+        // Index of a species, or -1 if it is not in the mixture
+        int find(std::string_view name) const noexcept
+        {
+            for (std::size_t i = 0; i < count_; ++i)
+            {
+                if ((*this)[i] == name) return static_cast<int>(i);
+            }
+            return -1;
+        }
+
+    private:
+        std::vector<char> buf_;
+        cea_int stride_ = 0;
+        std::size_t count_ = 0;
+    };
+
+    //------------------------------------------------------------------
+    // Mixture
+    //------------------------------------------------------------------
+
+    class mixture
+    {
+    public:
+        // Products or reactants named explicitly
+        explicit mixture(span<const cea_string> species, bool ions = false)
+        {
+            cea_mixture ptr = nullptr;
+            const cea_int n = detail::as_int(species.size());
+            detail::check(ions ? cea_mixture_create_w_ions(&ptr, n, species.data())
+                               : cea_mixture_create(&ptr, n, species.data()));
+            reset(ptr);
+        }
+
+        // All products that can form from the given reactants
+        static mixture products_from_reactants(span<const cea_string> reactants,
+                                               span<const cea_string> omit = {},
+                                               bool ions = false)
+        {
+            cea_mixture ptr = nullptr;
+            const cea_int nr = detail::as_int(reactants.size());
+            const cea_int no = detail::as_int(omit.size());
+            detail::check(ions ? cea_mixture_create_from_reactants_w_ions(&ptr, nr, reactants.data(), no, omit.data())
+                               : cea_mixture_create_from_reactants(&ptr, nr, reactants.data(), no, omit.data()));
+            return mixture(ptr);
+        }
+
+        // ID forms of the two constructors above
+        static mixture from_ids(span<const cea_int> ids, bool ions = false)
+        {
+            cea_mixture ptr = nullptr;
+            const cea_int n = detail::as_int(ids.size());
+            detail::check(ions ? cea_mixture_create_by_ids_w_ions(&ptr, n, ids.data())
+                               : cea_mixture_create_by_ids(&ptr, n, ids.data()));
+            return mixture(ptr);
+        }
+
+        static mixture products_from_reactant_ids(span<const cea_int> reactants,
+                                                  span<const cea_int> omit = {},
+                                                  bool ions = false)
+        {
+            cea_mixture ptr = nullptr;
+            const cea_int nr = detail::as_int(reactants.size());
+            const cea_int no = detail::as_int(omit.size());
+            detail::check(ions ? cea_mixture_create_from_reactant_ids_w_ions(&ptr, nr, reactants.data(), no, omit.data())
+                               : cea_mixture_create_from_reactant_ids(&ptr, nr, reactants.data(), no, omit.data()));
+            return mixture(ptr);
+        }
+
+        // Reactants defined by input records (custom formulas, enthalpies, temperatures)
+        static mixture from_input_reactants(span<const cea_reactant_input> reactants, bool ions = false)
+        {
+            cea_mixture ptr = nullptr;
+            const cea_int n = detail::as_int(reactants.size());
+            detail::check(ions ? cea_mixture_create_from_input_reactants_w_ions(&ptr, n, reactants.data())
+                               : cea_mixture_create_from_input_reactants(&ptr, n, reactants.data()));
+            return mixture(ptr);
+        }
+
+        static mixture products_from_input_reactants(span<const cea_reactant_input> reactants,
+                                                     span<const cea_string> omit = {},
+                                                     bool ions = false)
+        {
+            cea_mixture ptr = nullptr;
+            const cea_int nr = detail::as_int(reactants.size());
+            const cea_int no = detail::as_int(omit.size());
+            detail::check(ions ? cea_mixture_create_products_from_input_reactants_w_ions(&ptr, nr, reactants.data(), no, omit.data())
+                               : cea_mixture_create_products_from_input_reactants(&ptr, nr, reactants.data(), no, omit.data()));
+            return mixture(ptr);
+        }
+
+        cea_mixture get() const noexcept { return h_.get(); }
+        std::size_t num_species() const noexcept { return names_.size(); }
+        const species_names &names() const noexcept { return names_; }
+
+        // Database IDs of the species, -1 for custom reactants
+        void species_ids(span<cea_int> ids) const
+        {
+            detail::check_size(ids.size() == num_species());
+            detail::check(cea_mixture_get_species_ids(get(), detail::as_int(ids.size()), ids.data()));
+        }
+
+        // Unit conversion; in and out have num_species entries
+        void moles_to_weights(span<const double> moles, span<double> weights) const
+        {
+            convert(cea_mixture_moles_to_weights, moles, weights);
+        }
+        void weights_to_moles(span<const double> weights, span<double> moles) const
+        {
+            convert(cea_mixture_weights_to_moles, weights, moles);
+        }
+        void per_mole_to_per_weight(span<const double> per_mole, span<double> per_weight) const
+        {
+            convert(cea_mixture_per_mole_to_per_weight, per_mole, per_weight);
+        }
+        void per_weight_to_per_mole(span<const double> per_weight, span<double> per_mole) const
+        {
+            convert(cea_mixture_per_weight_to_per_mole, per_weight, per_mole);
+        }
+
+        // Fuel/oxidant conversion
+        double chem_eq_ratio_to_of_ratio(span<const double> oxidant, span<const double> fuel, double ratio) const
+        {
+            double of = 0.0;
+            check_pair(oxidant, fuel);
+            detail::check(cea_mixture_chem_eq_ratio_to_of_ratio(get(), detail::as_int(fuel.size()),
+                                                                oxidant.data(), fuel.data(), ratio, &of));
+            return of;
+        }
+        double weight_eq_ratio_to_of_ratio(span<const double> oxidant, span<const double> fuel, double ratio) const
+        {
+            double of = 0.0;
+            check_pair(oxidant, fuel);
+            detail::check(cea_mixture_weight_eq_ratio_to_of_ratio(get(), detail::as_int(fuel.size()),
+                                                                  oxidant.data(), fuel.data(), ratio, &of));
+            return of;
+        }
+        void of_ratio_to_weights(span<const double> oxidant, span<const double> fuel, double of_ratio,
+                                 span<double> weights) const
+        {
+            check_pair(oxidant, fuel);
+            detail::check_size(weights.size() == fuel.size());
+            detail::check(cea_mixture_of_ratio_to_weights(get(), detail::as_int(fuel.size()),
+                                                          oxidant.data(), fuel.data(), of_ratio, weights.data()));
+        }
+
+        // Property of the mixture at a fixed composition
+        double calc_property(cea_property_type type, span<const double> weights, double temperature) const
+        {
+            double value = 0.0;
+            detail::check(cea_mixture_calc_property(get(), type, detail::as_int(weights.size()),
+                                                    weights.data(), temperature, &value));
+            return value;
+        }
+        double calc_property(cea_property_type type, span<const double> weights, double temperature,
+                             double pressure) const
+        {
+            double value = 0.0;
+            detail::check(cea_mixture_calc_property_tp(get(), type, detail::as_int(weights.size()),
+                                                       weights.data(), temperature, pressure, &value));
+            return value;
+        }
+
+    private:
+        using handle_type = detail::handle<cea_mixture, cea_mixture_destroy>;
+        using convert_fn = cea_err (*)(const cea_mixture, const cea_int, const cea_real[], cea_real[]);
+
+        explicit mixture(cea_mixture ptr) { reset(ptr); }
+
+        void reset(cea_mixture ptr)
+        {
+            h_ = handle_type(ptr);
+            names_ = species_names(ptr);
+        }
+
+        void convert(convert_fn fn, span<const double> in, span<double> out) const
+        {
+            detail::check_size(in.size() == num_species() && out.size() == num_species());
+            detail::check(fn(get(), detail::as_int(in.size()), in.data(), out.data()));
+        }
+
+        void check_pair(span<const double> oxidant, span<const double> fuel) const
+        {
+            detail::check_size(oxidant.size() == num_species() && fuel.size() == num_species());
+        }
+
+        handle_type h_;
+        species_names names_;
+    };
+
+    //------------------------------------------------------------------
+    // Equilibrium
+    //------------------------------------------------------------------
+
+    class eq_solution;
+    class eq_partials;
+
+    class eq_solver
+    {
+    public:
+        explicit eq_solver(const mixture &products)
+        {
+            cea_eqsolver ptr = nullptr;
+            detail::check(cea_eqsolver_create(&ptr, products.get()));
+            reset(ptr);
+        }
+        eq_solver(const mixture &products, const mixture &reactants)
+        {
+            cea_eqsolver ptr = nullptr;
+            detail::check(cea_eqsolver_create_with_reactants(&ptr, products.get(), reactants.get()));
+            reset(ptr);
+        }
+        eq_solver(const mixture &products, const cea_solver_opts &opts)
+        {
+            cea_eqsolver ptr = nullptr;
+            detail::check(cea_eqsolver_create_with_options(&ptr, products.get(), opts));
+            reset(ptr);
+        }
+
+        // Independent copy for use on another thread
+        eq_solver clone() const
+        {
+            cea_eqsolver ptr = nullptr;
+            detail::check(cea_eqsolver_clone(&ptr, get()));
+            return eq_solver(ptr, sizes_);
+        }
+
+        void write_profile(const char *filename, cea_profile_format format = CEA_PROFILE_TOTALS) const
+        {
+            detail::check(cea_eqsolver_write_profile(get(), format, filename));
+        }
+
+        cea_eqsolver get() const noexcept { return h_.get(); }
+        int num_reactants() const noexcept { return sizes_.num_reactants; }
+        int num_products() const noexcept { return sizes_.num_products; }
+        int num_gas() const noexcept { return sizes_.num_gas; }
+        int num_condensed() const noexcept { return sizes_.num_condensed; }
+        int num_elements() const noexcept { return sizes_.num_elements; }
+        int max_equations() const noexcept { return sizes_.max_equations; }
+
+        // Returns false if the solve did not converge; other failures throw
+        inline bool solve(eq_solution &soln, cea_equilibrium_type type, double state1, double state2,
+                          span<const double> amounts) const;
+        inline bool solve(eq_solution &soln, eq_partials &partials, cea_equilibrium_type type,
+                          double state1, double state2, span<const double> amounts) const;
+
+        // Solves npts points with cea_eqsolver_solve_batch, using soln as working storage.
+        // state1/state2 hold npts values or a single value used for every point; amounts holds npts
+        // rows of num_reactants weights, or a single row. props[k] at point i is written to
+        // out[i*props.size() + k]. Optional outputs: converged (npts flags) and species
+        // (npts rows of num_products fractions). Returns the number of points that did not converge.
+        inline std::size_t solve_batch(eq_solution &soln, eq_partials &partials, cea_equilibrium_type type,
+                                       span<const double> state1, span<const double> state2,
+                                       span<const double> amounts, span<const cea_property_type> props,
+                                       span<double> out, span<bool> converged = {},
+                                       span<double> species = {}, bool mass_fractions = false) const;
+
+    private:
+        using handle_type = detail::handle<cea_eqsolver, cea_eqsolver_destroy>;
+
+        eq_solver(cea_eqsolver ptr, const detail::solver_sizes &sizes) : h_(ptr), sizes_(sizes) {}
+
+        void reset(cea_eqsolver ptr)
+        {
+            h_ = handle_type(ptr);
+            sizes_ = detail::solver_sizes::read<cea_eqsolver>(ptr, cea_eqsolver_get_size);
+        }
+
+        handle_type h_;
+        detail::solver_sizes sizes_;
+    };
+
+    class eq_partials
+    {
+    public:
+        explicit eq_partials(const eq_solver &solver)
+        {
+            cea_eqpartials ptr = nullptr;
+            detail::check(cea_eqpartials_create(&ptr, solver.get()));
+            h_ = handle_type(ptr);
+        }
+
+        cea_eqpartials get() const noexcept { return h_.get(); }
+
+    private:
+        using handle_type = detail::handle<cea_eqpartials, cea_eqpartials_destroy>;
+        handle_type h_;
+    };
+
+    class eq_solution
+    {
+    public:
+        explicit eq_solution(const eq_solver &solver)
+            : np_(static_cast<std::size_t>(solver.num_products())), work_(np_)
+        {
+            cea_eqsolution ptr = nullptr;
+            detail::check(cea_eqsolution_create(&ptr, solver.get()));
+            h_ = handle_type(ptr);
+        }
+
+        cea_eqsolution get() const noexcept { return h_.get(); }
+        std::size_t num_products() const noexcept { return np_; }
+
+        double property(cea_property_type type) const
+        {
+            double value = 0.0;
+            detail::check(cea_eqsolution_get_property(get(), type, &value));
+            return value;
+        }
+
+        // values[i] receives types[i]
+        void properties(span<const cea_property_type> types, span<double> values) const
+        {
+            detail::check_size(values.size() >= types.size());
+            detail::check(cea_eqsolution_get_properties(get(), detail::as_int(types.size()),
+                                                        types.data(), values.data()));
+        }
+
+        bool converged() const
+        {
+            int conv = 0;
+            detail::check(cea_eqsolution_get_converged(get(), &conv));
+            return conv != 0;
+        }
+
+        double moles() const
+        {
+            double n = 0.0;
+            detail::check(cea_eqsolution_get_moles(get(), &n));
+            return n;
+        }
+
+        // Views over storage owned by this solution; valid until the next call to one of these
+        span<const double> mole_fractions() { return fill(&eq_solution::amounts, false); }
+        span<const double> mass_fractions() { return fill(&eq_solution::amounts, true); }
+        span<const double> nj() { return fill(&eq_solution::weights, false); }
+        span<const double> ln_nj() { return fill(&eq_solution::weights, true); }
+
+        // Caller-buffer forms; out has num_products entries
+        void amounts(span<double> out, bool mass) const
+        {
+            detail::check_size(out.size() >= np_);
+            detail::check(cea_eqsolution_get_species_amounts(get(), detail::as_int(np_), out.data(), mass));
+        }
+        void weights(span<double> out, bool log) const
+        {
+            detail::check_size(out.size() >= np_);
+            detail::check(cea_eqsolution_get_weights(get(), detail::as_int(np_), out.data(), log));
+        }
+
+    private:
+        using handle_type = detail::handle<cea_eqsolution, cea_eqsolution_destroy>;
+
+        span<const double> fill(void (eq_solution::*getter)(span<double>, bool) const, bool flag)
+        {
+            (this->*getter)(span<double>(work_), flag);
+            return span<const double>(work_);
+        }
+
+        handle_type h_;
+        std::size_t np_;
+        std::vector<double> work_;
+    };
+
+    inline bool eq_solver::solve(eq_solution &soln, cea_equilibrium_type type, double state1, double state2,
+                                 span<const double> amounts) const
+    {
+        detail::check_size(amounts.size() == static_cast<std::size_t>(num_reactants()));
+        return detail::check_solve(cea_eqsolver_solve(get(), type, state1, state2, amounts.data(), soln.get()));
+    }
+
+    inline bool eq_solver::solve(eq_solution &soln, eq_partials &partials, cea_equilibrium_type type,
+                                 double state1, double state2, span<const double> amounts) const
+    {
+        detail::check_size(amounts.size() == static_cast<std::size_t>(num_reactants()));
+        return detail::check_solve(cea_eqsolver_solve_with_partials(get(), type, state1, state2, amounts.data(),
+                                                                    soln.get(), partials.get()));
+    }
+
+    inline std::size_t eq_solver::solve_batch(eq_solution &soln, eq_partials &partials, cea_equilibrium_type type,
+                                              span<const double> state1, span<const double> state2,
+                                              span<const double> amounts, span<const cea_property_type> props,
+                                              span<double> out, span<bool> converged,
+                                              span<double> species, bool mass_fractions) const
+    {
+        const std::size_t nr = static_cast<std::size_t>(num_reactants());
+        const std::size_t np = static_cast<std::size_t>(num_products());
+        const std::size_t nprops = props.size();
+
+        detail::check_size(nr > 0 && amounts.size() % nr == 0 && !amounts.empty());
+        std::size_t npts = amounts.size() / nr;
+        if (state1.size() > npts) npts = state1.size();
+        if (state2.size() > npts) npts = state2.size();
+
+        detail::check_size(state1.size() == npts || state1.size() == 1);
+        detail::check_size(state2.size() == npts || state2.size() == 1);
+        detail::check_size(amounts.size() == nr || amounts.size() == npts * nr);
+        detail::check_size(out.size() >= npts * nprops);
+        detail::check_size(converged.empty() || converged.size() >= npts);
+        detail::check_size(species.empty() || species.size() >= npts * np);
+
+        cea_int num_failed = 0;
+        detail::check_solve(cea_eqsolver_solve_batch(
+            get(), type, detail::as_int(npts), detail::as_int(state1.size()), state1.data(),
+            detail::as_int(state2.size()), state2.data(), detail::as_int(amounts.size() / nr), amounts.data(),
+            soln.get(), partials.get(), detail::as_int(nprops), props.data(), out.data(),
+            converged.empty() ? nullptr : converged.data(), species.empty() ? nullptr : species.data(),
+            mass_fractions, &num_failed));
+        return static_cast<std::size_t>(num_failed);
+    }
+
+    //------------------------------------------------------------------
+    // ISAT cache
+    //------------------------------------------------------------------
+
+    struct isat_stats
+    {
+        int num_queries;
+        int num_hits;
+        int num_misses;
+        int num_grows;
+        int num_adds;
+        int num_evictions;
+    };
+
+    // Caches solutions of a single solver; values <= 0 select the defaults
+    class isat_table
+    {
+    public:
+        explicit isat_table(int max_records = 0, double tolerance = 0.0, double max_radius = 0.0)
+        {
+            cea_isat_table ptr = nullptr;
+            detail::check(cea_isat_create(&ptr, max_records, tolerance, max_radius));
+            h_ = handle_type(ptr);
+        }
+
+        cea_isat_table get() const noexcept { return h_.get(); }
+
+        void clear() { detail::check(cea_isat_clear(get())); }
+
+        // Same contract as eq_solver::solve, answered from the table when possible
+        bool solve(const eq_solver &solver, eq_solution &soln, cea_equilibrium_type type, double state1,
+                   double state2, span<const double> amounts)
+        {
+            detail::check_size(amounts.size() == static_cast<std::size_t>(solver.num_reactants()));
+            return detail::check_solve(cea_isat_solve(get(), solver.get(), type, state1, state2, amounts.data(),
+                                                      soln.get()));
+        }
+
+        int num_records() const
+        {
+            cea_int n = 0;
+            detail::check(cea_isat_get_num_records(get(), &n));
+            return n;
+        }
+
+        isat_stats stats() const
+        {
+            isat_stats s{};
+            detail::check(cea_isat_get_stats(get(), &s.num_queries, &s.num_hits, &s.num_misses,
+                                             &s.num_grows, &s.num_adds, &s.num_evictions));
+            return s;
+        }
+
+    private:
+        using handle_type = detail::handle<cea_isat_table, cea_isat_destroy>;
+        handle_type h_;
+    };
+
+    //------------------------------------------------------------------
+    // Rocket
+    //------------------------------------------------------------------
+
+    class rocket_solution;
+
+    class rocket_solver
+    {
+    public:
+        explicit rocket_solver(const mixture &products)
+        {
+            cea_rocket_solver ptr = nullptr;
+            detail::check(cea_rocket_solver_create(&ptr, products.get()));
+            reset(ptr);
+        }
+        rocket_solver(const mixture &products, const mixture &reactants)
+        {
+            cea_rocket_solver ptr = nullptr;
+            detail::check(cea_rocket_solver_create_with_reactants(&ptr, products.get(), reactants.get()));
+            reset(ptr);
+        }
+        rocket_solver(const mixture &products, const cea_solver_opts &opts)
+        {
+            cea_rocket_solver ptr = nullptr;
+            detail::check(cea_rocket_solver_create_with_options(&ptr, products.get(), opts));
+            reset(ptr);
+        }
+
+        rocket_solver clone() const
+        {
+            cea_rocket_solver ptr = nullptr;
+            detail::check(cea_rocket_solver_clone(&ptr, get()));
+            return rocket_solver(ptr, sizes_);
+        }
+
+        void write_profile(const char *filename, cea_profile_format format = CEA_PROFILE_TOTALS) const
+        {
+            detail::check(cea_rocket_solver_write_profile(get(), format, filename));
+        }
+
+        cea_rocket_solver get() const noexcept { return h_.get(); }
+        int num_reactants() const noexcept { return sizes_.num_reactants; }
+        int num_products() const noexcept { return sizes_.num_products; }
+
+        // Infinite-area combustor. hc_or_tc is the chamber enthalpy (use_hc) or temperature.
+        inline bool solve_iac(rocket_solution &soln, span<const double> weights, double pc,
+                              span<const double> pi_p, span<const double> subar, span<const double> supar,
+                              int n_frz, double hc_or_tc, bool use_hc,
+                              double tc_est = 0.0, bool use_tc_est = false) const;
+
+        // Finite-area combustor; mdot_or_acat is the mass flux (use_mdot) or contraction ratio.
+        inline bool solve_fac(rocket_solution &soln, span<const double> weights, double pc,
+                              span<const double> pi_p, span<const double> subar, span<const double> supar,
+                              int n_frz, double hc_or_tc, bool use_hc, double mdot_or_acat, bool use_mdot,
+                              double tc_est = 0.0, bool use_tc_est = false) const;
+
+    private:
+        using handle_type = detail::handle<cea_rocket_solver, cea_rocket_solver_destroy>;
+
+        rocket_solver(cea_rocket_solver ptr, const detail::solver_sizes &sizes) : h_(ptr), sizes_(sizes) {}
+
+        void reset(cea_rocket_solver ptr)
+        {
+            h_ = handle_type(ptr);
+            sizes_ = detail::solver_sizes::read<cea_rocket_solver>(ptr, cea_rocket_solver_get_size);
+        }
+
+        handle_type h_;
+        detail::solver_sizes sizes_;
+    };
+
+    class rocket_solution
+    {
+    public:
+        explicit rocket_solution(const rocket_solver &solver)
+            : np_(static_cast<std::size_t>(solver.num_products()))
+        {
+            cea_rocket_solution ptr = nullptr;
+            detail::check(cea_rocket_solution_create(&ptr, solver.get()));
+            h_ = handle_type(ptr);
+        }
+
+        cea_rocket_solution get() const noexcept { return h_.get(); }
+        std::size_t num_products() const noexcept { return np_; }
+
+        std::size_t num_pts() const
+        {
+            cea_int n = 0;
+            detail::check(cea_rocket_solution_get_size(get(), &n));
+            return static_cast<std::size_t>(n);
+        }
+
+        bool converged() const
+        {
+            int conv = 0;
+            detail::check(cea_rocket_solution_get_converged(get(), &conv));
+            return conv != 0;
+        }
+
+        // One value per station
+        void property(cea_rocket_property_type type, span<double> out) const
+        {
+            detail::check(cea_rocket_solution_get_property(get(), type, detail::as_int(out.size()), out.data()));
+        }
+        span<const double> property(cea_rocket_property_type type)
+        {
+            span<double> out = work(num_pts());
+            property(type, out);
+            return out;
+        }
+
+        // values[i*len + j] receives types[i] at station j, with len = values.size() / types.size()
+        void properties(span<const cea_rocket_property_type> types, span<double> values) const
+        {
+            detail::check_size(!types.empty() && values.size() % types.size() == 0);
+            detail::check(cea_rocket_solution_get_properties(get(), detail::as_int(types.size()), types.data(),
+                                                             detail::as_int(values.size() / types.size()),
+                                                             values.data()));
+        }
+
+        // Species fractions at a station, numbered from 1 as in the C API; num_products entries
+        void amounts(std::size_t station, span<double> out, bool mass) const
+        {
+            detail::check_size(out.size() >= np_);
+            detail::check(cea_rocket_solution_get_species_amounts(get(), detail::as_int(np_),
+                                                                  detail::as_int(station), out.data(), mass));
+        }
+        span<const double> mole_fractions(std::size_t station) { return station_amounts(station, false); }
+        span<const double> mass_fractions(std::size_t station) { return station_amounts(station, true); }
+
+        // out[j*num_products + k] receives species k at station j
+        void all_amounts(span<double> out, bool mass) const
+        {
+            detail::check_size(np_ > 0 && out.size() % np_ == 0);
+            detail::check(cea_rocket_solution_get_all_species_amounts(get(), detail::as_int(np_),
+                                                                      detail::as_int(out.size() / np_),
+                                                                      out.data(), mass));
+        }
+
+    private:
+        using handle_type = detail::handle<cea_rocket_solution, cea_rocket_solution_destroy>;
+
+        // Grows only, so repeated queries reuse the same storage
+        span<double> work(std::size_t n)
+        {
+            if (work_.size() < n) work_.resize(n);
+            return span<double>(work_.data(), n);
+        }
+
+        span<const double> station_amounts(std::size_t station, bool mass)
+        {
+            span<double> out = work(np_);
+            amounts(station, out, mass);
+            return out;
+        }
+
+        handle_type h_;
+        std::size_t np_;
+        std::vector<double> work_;
+    };
+
+    inline bool rocket_solver::solve_iac(rocket_solution &soln, span<const double> weights, double pc,
+                                         span<const double> pi_p, span<const double> subar,
+                                         span<const double> supar, int n_frz, double hc_or_tc, bool use_hc,
+                                         double tc_est, bool use_tc_est) const
+    {
+        detail::check_size(weights.size() == static_cast<std::size_t>(num_reactants()));
+        return detail::check_solve(cea_rocket_solver_solve_iac(
+            get(), soln.get(), weights.data(), pc, pi_p.data(), detail::as_int(pi_p.size()), subar.data(),
+            detail::as_int(subar.size()), supar.data(), detail::as_int(supar.size()), n_frz, hc_or_tc, use_hc,
+            tc_est, use_tc_est));
+    }
+
+    inline bool rocket_solver::solve_fac(rocket_solution &soln, span<const double> weights, double pc,
+                                         span<const double> pi_p, span<const double> subar,
+                                         span<const double> supar, int n_frz, double hc_or_tc, bool use_hc,
+                                         double mdot_or_acat, bool use_mdot, double tc_est, bool use_tc_est) const
+    {
+        detail::check_size(weights.size() == static_cast<std::size_t>(num_reactants()));
+        return detail::check_solve(cea_rocket_solver_solve_fac(
+            get(), soln.get(), weights.data(), pc, pi_p.data(), detail::as_int(pi_p.size()), subar.data(),
+            detail::as_int(subar.size()), supar.data(), detail::as_int(supar.size()), n_frz, hc_or_tc, use_hc,
+            mdot_or_acat, use_mdot, tc_est, use_tc_est));
+    }
+
+    //------------------------------------------------------------------
+    // Shock
+    //------------------------------------------------------------------
+
+    class shock_solution;
+
+    class shock_solver
+    {
+    public:
+        explicit shock_solver(const mixture &products)
+        {
+            cea_shock_solver ptr = nullptr;
+            detail::check(cea_shock_solver_create(&ptr, products.get()));
+            reset(ptr);
+        }
+        shock_solver(const mixture &products, const mixture &reactants)
+        {
+            cea_shock_solver ptr = nullptr;
+            detail::check(cea_shock_solver_create_with_reactants(&ptr, products.get(), reactants.get()));
+            reset(ptr);
+        }
+        shock_solver(const mixture &products, const cea_solver_opts &opts)
+        {
+            cea_shock_solver ptr = nullptr;
+            detail::check(cea_shock_solver_create_with_options(&ptr, products.get(), opts));
+            reset(ptr);
+        }
+
+        shock_solver clone() const
+        {
+            cea_shock_solver ptr = nullptr;
+            detail::check(cea_shock_solver_clone(&ptr, get()));
+            return shock_solver(ptr, sizes_);
+        }
+
+        void write_profile(const char *filename, cea_profile_format format = CEA_PROFILE_TOTALS) const
+        {
+            detail::check(cea_shock_solver_write_profile(get(), format, filename));
+        }
+
+        cea_shock_solver get() const noexcept { return h_.get(); }
+        int num_reactants() const noexcept { return sizes_.num_reactants; }
+        int num_products() const noexcept { return sizes_.num_products; }
+
+        // mach1_or_u1 is the incident Mach number (use_mach) or velocity
+        inline bool solve(shock_solution &soln, span<const double> weights, double T0, double p0,
+                          double mach1_or_u1, bool use_mach, bool refl = false, bool incd_froz = false,
+                          bool refl_froz = false) const;
+
+    private:
+        using handle_type = detail::handle<cea_shock_solver, cea_shock_solver_destroy>;
+
+        shock_solver(cea_shock_solver ptr, const detail::solver_sizes &sizes) : h_(ptr), sizes_(sizes) {}
+
+        void reset(cea_shock_solver ptr)
+        {
+            h_ = handle_type(ptr);
+            sizes_ = detail::solver_sizes::read<cea_shock_solver>(ptr, cea_shock_solver_get_size);
+        }
+
+        handle_type h_;
+        detail::solver_sizes sizes_;
+    };
+
+    class shock_solution
+    {
+    public:
+        // num_pts is 2 for an incident shock, 3 with the reflected shock
+        shock_solution(const shock_solver &solver, int num_pts)
+            : np_(static_cast<std::size_t>(solver.num_products())), num_pts_(static_cast<std::size_t>(num_pts)),
+              work_(np_ > num_pts_ ? np_ : num_pts_)
+        {
+            cea_shock_solution ptr = nullptr;
+            detail::check(cea_shock_solution_create(&ptr, num_pts));
+            h_ = handle_type(ptr);
+        }
+
+        cea_shock_solution get() const noexcept { return h_.get(); }
+        std::size_t num_products() const noexcept { return np_; }
+        std::size_t num_pts() const noexcept { return num_pts_; }
+
+        bool converged() const
+        {
+            int conv = 0;
+            detail::check(cea_shock_solution_get_converged(get(), &conv));
+            return conv != 0;
+        }
+
+        double scalar_property(cea_shock_property_type type) const
+        {
+            double value = 0.0;
+            detail::check(cea_shock_solution_get_scalar_property(get(), type, &value));
+            return value;
+        }
+
+        void property(cea_shock_property_type type, span<double> out) const
+        {
+            detail::check(cea_shock_solution_get_property(get(), type, detail::as_int(out.size()), out.data()));
+        }
+        span<const double> property(cea_shock_property_type type)
+        {
+            span<double> out(work_.data(), num_pts_);
+            property(type, out);
+            return out;
+        }
+
+        // values[i*len + j] receives types[i] at point j, with len = values.size() / types.size()
+        void properties(span<const cea_shock_property_type> types, span<double> values) const
+        {
+            detail::check_size(!types.empty() && values.size() % types.size() == 0);
+            detail::check(cea_shock_solution_get_properties(get(), detail::as_int(types.size()), types.data(),
+                                                            detail::as_int(values.size() / types.size()),
+                                                            values.data()));
+        }
+
+        // Species fractions at a point, numbered from 1 as in the C API; num_products entries
+        void amounts(std::size_t point, span<double> out, bool mass) const
+        {
+            detail::check_size(out.size() >= np_);
+            detail::check(cea_shock_solution_get_species_amounts(get(), detail::as_int(np_),
+                                                                 detail::as_int(point), out.data(), mass));
+        }
+        span<const double> mole_fractions(std::size_t point) { return point_amounts(point, false); }
+        span<const double> mass_fractions(std::size_t point) { return point_amounts(point, true); }
+
+    private:
+        using handle_type = detail::handle<cea_shock_solution, cea_shock_solution_destroy>;
+
+        span<const double> point_amounts(std::size_t point, bool mass)
+        {
+            span<double> out(work_.data(), np_);
+            amounts(point, out, mass);
+            return out;
+        }
+
+        handle_type h_;
+        std::size_t np_;
+        std::size_t num_pts_;
+        std::vector<double> work_;
+    };
+
+    inline bool shock_solver::solve(shock_solution &soln, span<const double> weights, double T0, double p0,
+                                    double mach1_or_u1, bool use_mach, bool refl, bool incd_froz,
+                                    bool refl_froz) const
+    {
+        detail::check_size(weights.size() == static_cast<std::size_t>(num_reactants()));
+        return detail::check_solve(cea_shock_solver_solve(get(), soln.get(), weights.data(), T0, p0, mach1_or_u1,
+                                                          use_mach, refl, incd_froz, refl_froz));
+    }
+
+    //------------------------------------------------------------------
+    // Detonation
+    //------------------------------------------------------------------
+
+    class detonation_solution;
+
+    class detonation_solver
+    {
+    public:
+        explicit detonation_solver(const mixture &products)
+        {
+            cea_detonation_solver ptr = nullptr;
+            detail::check(cea_detonation_solver_create(&ptr, products.get()));
+            reset(ptr);
+        }
+        detonation_solver(const mixture &products, const mixture &reactants)
+        {
+            cea_detonation_solver ptr = nullptr;
+            detail::check(cea_detonation_solver_create_with_reactants(&ptr, products.get(), reactants.get()));
+            reset(ptr);
+        }
+        detonation_solver(const mixture &products, const cea_solver_opts &opts)
+        {
+            cea_detonation_solver ptr = nullptr;
+            detail::check(cea_detonation_solver_create_with_options(&ptr, products.get(), opts));
+            reset(ptr);
+        }
+
+        detonation_solver clone() const
+        {
+            cea_detonation_solver ptr = nullptr;
+            detail::check(cea_detonation_solver_clone(&ptr, get()));
+            return detonation_solver(ptr, sizes_);
+        }
+
+        void write_profile(const char *filename, cea_profile_format format = CEA_PROFILE_TOTALS) const
+        {
+            detail::check(cea_detonation_solver_write_profile(get(), format, filename));
+        }
+
+        cea_detonation_solver get() const noexcept { return h_.get(); }
+        int num_reactants() const noexcept { return sizes_.num_reactants; }
+        int num_products() const noexcept { return sizes_.num_products; }
+
+        inline bool solve(detonation_solution &soln, span<const double> weights, double T1, double p1,
+                          bool frozen = false) const;
+
+    private:
+        using handle_type = detail::handle<cea_detonation_solver, cea_detonation_solver_destroy>;
+
+        detonation_solver(cea_detonation_solver ptr, const detail::solver_sizes &sizes) : h_(ptr), sizes_(sizes) {}
+
+        void reset(cea_detonation_solver ptr)
+        {
+            h_ = handle_type(ptr);
+            sizes_ = detail::solver_sizes::read<cea_detonation_solver>(ptr, cea_detonation_solver_get_size);
+        }
+
+        handle_type h_;
+        detail::solver_sizes sizes_;
+    };
+
+    class detonation_solution
+    {
+    public:
+        explicit detonation_solution(const detonation_solver &solver)
+            : np_(static_cast<std::size_t>(solver.num_products())), work_(np_)
+        {
+            cea_detonation_solution ptr = nullptr;
+            detail::check(cea_detonation_solution_create(&ptr));
+            h_ = handle_type(ptr);
+        }
+
+        cea_detonation_solution get() const noexcept { return h_.get(); }
+        std::size_t num_products() const noexcept { return np_; }
+
+        bool converged() const
+        {
+            int conv = 0;
+            detail::check(cea_detonation_solution_get_converged(get(), &conv));
+            return conv != 0;
+        }
+
+        double property(cea_detonation_property_type type) const
+        {
+            double value = 0.0;
+            detail::check(cea_detonation_solution_get_property(get(), type, 1, &value));
+            return value;
+        }
+
+        void properties(span<const cea_detonation_property_type> types, span<double> values) const
+        {
+            detail::check_size(values.size() >= types.size());
+            detail::check(cea_detonation_solution_get_properties(get(), detail::as_int(types.size()),
+                                                                 types.data(), values.data()));
+        }
+
+        void amounts(span<double> out, bool mass) const
+        {
+            detail::check_size(out.size() >= np_);
+            detail::check(cea_detonation_solution_get_species_amounts(get(), detail::as_int(np_), out.data(), mass));
+        }
+        span<const double> mole_fractions() { return fill(false); }
+        span<const double> mass_fractions() { return fill(true); }
+
+    private:
+        using handle_type = detail::handle<cea_detonation_solution, cea_detonation_solution_destroy>;
+
+        span<const double> fill(bool mass)
+        {
+            amounts(span<double>(work_), mass);
+            return span<const double>(work_);
+        }
+
+        handle_type h_;
+        std::size_t np_;
+        std::vector<double> work_;
+    };
+
+    inline bool detonation_solver::solve(detonation_solution &soln, span<const double> weights, double T1,
+                                         double p1, bool frozen) const
+    {
+        detail::check_size(weights.size() == static_cast<std::size_t>(num_reactants()));
+        return detail::check_solve(cea_detonation_solver_solve(get(), soln.get(), weights.data(), T1, p1, frozen));
+    }
+
+
+    //------------------------------------------------------------------
+    // Monte Carlo uncertainty
+    //------------------------------------------------------------------
+
+    struct mc_stats
+    {
+        double mean;
+        double variance;
+        double min_value;
+        double max_value;
+    };
+
+    // Streaming statistics of sampled solves; results depend only on seed and num_threads
+    class mc_driver
+    {
+    public:
+        explicit mc_driver(int num_samples, cea_mc_sampling sampling = CEA_MC_LHS, int seed = 1,
+                           int num_threads = 1)
+        {
+            cea_mc_driver ptr = nullptr;
+            detail::check(cea_mc_create(&ptr, num_samples, sampling, seed, num_threads));
+            h_ = handle_type(ptr);
+        }
+
+        cea_mc_driver get() const noexcept { return h_.get(); }
+
+        void set_quantiles(span<const double> probabilities)
+        {
+            detail::check(cea_mc_set_quantiles(get(), detail::as_int(probabilities.size()), probabilities.data()));
+            num_quantiles_ = probabilities.size();
+        }
+
+        // reactant is zero-based and ignored for state inputs
+        void add_input(cea_mc_input input, cea_mc_distribution distribution, double width, int reactant = -1)
+        {
+            detail::check(cea_mc_add_input(get(), input, distribution, width, reactant));
+        }
+
+        // Returns false if any sample failed to converge; statistics cover the converged ones
+        bool run_eq(const eq_solver &solver, cea_equilibrium_type type, double state1, double state2,
+                    span<const double> weights, span<const double> reactant_temps = {})
+        {
+            detail::check_size(weights.size() == static_cast<std::size_t>(solver.num_reactants()));
+            detail::check_size(reactant_temps.empty() || reactant_temps.size() == weights.size());
+            return detail::check_solve(cea_mc_run_eq(get(), solver.get(), type, state1, state2, weights.data(),
+                                                     reactant_temps.empty() ? nullptr : reactant_temps.data()));
+        }
+
+        // Infinite-area combustor; hc is used when use_hc, otherwise reactant_temps
+        bool run_rocket(const rocket_solver &solver, span<const double> weights, double pc,
+                        span<const double> pi_p, span<const double> subar, span<const double> supar,
+                        double hc, bool use_hc, span<const double> reactant_temps = {})
+        {
+            detail::check_size(weights.size() == static_cast<std::size_t>(solver.num_reactants()));
+            detail::check_size(reactant_temps.empty() || reactant_temps.size() == weights.size());
+            return detail::check_solve(cea_mc_run_rocket(
+                get(), solver.get(), weights.data(), pc, pi_p.data(), detail::as_int(pi_p.size()), subar.data(),
+                detail::as_int(subar.size()), supar.data(), detail::as_int(supar.size()), hc, use_hc,
+                reactant_temps.empty() ? nullptr : reactant_temps.data()));
+        }
+
+        int num_outputs() const
+        {
+            cea_int n = 0;
+            detail::check(cea_mc_get_num_outputs(get(), &n));
+            return n;
+        }
+
+        int num_converged() const
+        {
+            cea_int n = 0;
+            detail::check(cea_mc_get_num_converged(get(), &n));
+            return n;
+        }
+
+        std::string output_name(int i) const
+        {
+            char buf[64];
+            detail::check(cea_mc_get_output_name_buf(get(), i, buf, detail::as_int(sizeof(buf))));
+            return std::string(buf);
+        }
+
+        mc_stats stats(int i) const
+        {
+            mc_stats s{};
+            detail::check(cea_mc_get_stats(get(), i, &s.mean, &s.variance, &s.min_value, &s.max_value));
+            return s;
+        }
+
+        std::vector<double> quantiles(int i) const
+        {
+            std::vector<double> q(num_quantiles_);
+            detail::check(cea_mc_get_quantiles(get(), i, detail::as_int(q.size()), q.data()));
+            return q;
+        }
+
+    private:
+        using handle_type = detail::handle<cea_mc_driver, cea_mc_destroy>;
+        handle_type h_;
+        std::size_t num_quantiles_ = 3;
+    };
+
+
+    //------------------------------------------------------------------
+    // Mixture ratio optimization
+    //------------------------------------------------------------------
+
+    struct of_result
+    {
+        double of_ratio;
+        double value;
+        int num_solves;
+        bool constrained;
+    };
+
+    // Finds the o/f ratio that maximizes Isp, Ivac, or c* at the last station
+    class of_optimizer
+    {
+    public:
+        // tolerance <= 0 and max_solves <= 0 select the defaults
+        explicit of_optimizer(cea_of_objective objective = CEA_OF_ISP, double tolerance = 0.0, int max_solves = 0)
+        {
+            cea_of_optimizer ptr = nullptr;
+            detail::check(cea_of_optimizer_create(&ptr, objective, tolerance, max_solves));
+            h_ = handle_type(ptr);
+        }
+
+        cea_of_optimizer get() const noexcept { return h_.get(); }
+
+        // station is zero-based; 0 is the chamber
+        void add_constraint(int station, double T_max)
+        {
+            detail::check(cea_of_optimizer_add_constraint(get(), station, T_max));
+        }
+
+        // Infinite-area combustor; hc is used when use_hc, otherwise reactant_temps.
+        // soln receives the solution at the optimum. Returns false if no feasible optimum was found.
+        bool run_iac(const rocket_solver &solver, rocket_solution &soln, span<const double> oxidant_weights,
+                     span<const double> fuel_weights, double of_min, double of_max, double pc,
+                     span<const double> pi_p, span<const double> subar, span<const double> supar, int n_frz,
+                     double hc, bool use_hc, span<const double> reactant_temps = {})
+        {
+            detail::check_size(oxidant_weights.size() == static_cast<std::size_t>(solver.num_reactants()));
+            detail::check_size(fuel_weights.size() == oxidant_weights.size());
+            detail::check_size(reactant_temps.empty() || reactant_temps.size() == oxidant_weights.size());
+            return detail::check_solve(cea_of_optimizer_run_iac(
+                get(), solver.get(), soln.get(), oxidant_weights.data(), fuel_weights.data(), of_min, of_max, pc,
+                pi_p.data(), detail::as_int(pi_p.size()), subar.data(), detail::as_int(subar.size()),
+                supar.data(), detail::as_int(supar.size()), n_frz, hc, use_hc,
+                reactant_temps.empty() ? nullptr : reactant_temps.data()));
+        }
+
+        of_result result() const
+        {
+            of_result r{};
+            cea_int n = 0;
+            detail::check(cea_of_optimizer_get_result(get(), &r.of_ratio, &r.value, &n, &r.constrained));
+            r.num_solves = n;
+            return r;
+        }
+
+    private:
+        using handle_type = detail::handle<cea_of_optimizer, cea_of_optimizer_destroy>;
+        handle_type h_;
+    };
+
+
+    //------------------------------------------------------------------
+    // Input decks
+    //------------------------------------------------------------------
+
+    // Problems parsed from a legacy input deck in one pass. Problems and reactants are
+    // indexed from 0 and schedules keep the deck's units. Malformed input aborts, as in the CLI.
+    class input_deck
+    {
+    public:
+        explicit input_deck(const char *filename)
+        {
+            cea_input_deck ptr = nullptr;
+            detail::check(cea_input_deck_create(&ptr, filename));
+            h_ = handle_type(ptr);
+        }
+
+        static input_deck from_text(std::string_view text)
+        {
+            cea_input_deck ptr = nullptr;
+            detail::check(cea_input_deck_create_from_text(&ptr, text.data(), detail::as_int(text.size())));
+            return input_deck(ptr);
+        }
+
+        cea_input_deck get() const noexcept { return h_.get(); }
+
+        int num_problems() const
+        {
+            cea_int n = 0;
+            detail::check(cea_input_deck_get_num_problems(get(), &n));
+            return n;
+        }
+
+        std::string problem_name(int i) const
+        {
+            return read_string([&](char *buf, cea_int len) {
+                return cea_input_deck_get_problem_name_buf(get(), i, buf, len);
+            });
+        }
+        std::string problem_type(int i) const
+        {
+            return read_string([&](char *buf, cea_int len) {
+                return cea_input_deck_get_problem_type_buf(get(), i, buf, len);
+            });
+        }
+
+        // Empty when the problem does not assign the schedule
+        std::vector<double> schedule(int i, cea_input_schedule which) const
+        {
+            cea_int n = 0;
+            detail::check(cea_input_deck_get_schedule_size(get(), i, which, &n));
+            std::vector<double> values(static_cast<std::size_t>(n));
+            detail::check(cea_input_deck_get_schedule(get(), i, which, n, values.data()));
+            return values;
+        }
+        std::string schedule_name(int i, cea_input_schedule which) const
+        {
+            return read_string([&](char *buf, cea_int len) {
+                return cea_input_deck_get_schedule_name_buf(get(), i, which, buf, len);
+            });
+        }
+        std::string schedule_units(int i, cea_input_schedule which) const
+        {
+            return read_string([&](char *buf, cea_int len) {
+                return cea_input_deck_get_schedule_units_buf(get(), i, which, buf, len);
+            });
+        }
+
+        int num_reactants(int i) const
+        {
+            cea_int n = 0;
+            detail::check(cea_input_deck_get_num_reactants(get(), i, &n));
+            return n;
+        }
+        std::string reactant_name(int i, int j) const
+        {
+            return read_string([&](char *buf, cea_int len) {
+                return cea_input_deck_get_reactant_name_buf(get(), i, j, buf, len);
+            });
+        }
+        std::string reactant_type(int i, int j) const
+        {
+            return read_string([&](char *buf, cea_int len) {
+                return cea_input_deck_get_reactant_type_buf(get(), i, j, buf, len);
+            });
+        }
+        std::vector<double> reactant_schedule(int i, int j, cea_input_reactant_schedule which) const
+        {
+            cea_int n = 0;
+            detail::check(cea_input_deck_get_reactant_schedule_size(get(), i, j, which, &n));
+            std::vector<double> values(static_cast<std::size_t>(n));
+            detail::check(cea_input_deck_get_reactant_schedule(get(), i, j, which, n, values.data()));
+            return values;
+        }
+        std::string reactant_schedule_name(int i, int j, cea_input_reactant_schedule which) const
+        {
+            return read_string([&](char *buf, cea_int len) {
+                return cea_input_deck_get_reactant_schedule_name_buf(get(), i, j, which, buf, len);
+            });
+        }
+        std::string reactant_schedule_units(int i, int j, cea_input_reactant_schedule which) const
+        {
+            return read_string([&](char *buf, cea_int len) {
+                return cea_input_deck_get_reactant_schedule_units_buf(get(), i, j, which, buf, len);
+            });
+        }
+
+        std::vector<std::string> species(int i, cea_input_species_list which) const
+        {
+            cea_int n = 0;
+            detail::check(cea_input_deck_get_num_species(get(), i, which, &n));
+            std::vector<std::string> names;
+            names.reserve(static_cast<std::size_t>(n));
+            for (cea_int k = 0; k < n; ++k)
+            {
+                names.push_back(read_string([&](char *buf, cea_int len) {
+                    return cea_input_deck_get_species_name_buf(get(), i, which, k, buf, len);
+                }));
+            }
+            return names;
+        }
+
+    private:
+        using handle_type = detail::handle<cea_input_deck, cea_input_deck_destroy>;
+
+        explicit input_deck(cea_input_deck ptr) noexcept : h_(ptr) {}
+
+        // Grows the buffer until the C call stops reporting truncation
+        template <typename F>
+        static std::string read_string(F &&get_buf)
+        {
+            std::vector<char> buf(64);
+            cea_err ierr;
+            while ((ierr = get_buf(buf.data(), detail::as_int(buf.size()))) == CEA_INVALID_SIZE)
+                buf.resize(2 * buf.size());
+            detail::check(ierr);
+            return std::string(buf.data());
+        }
+
+        handle_type h_;
+    };
+
+}
@@ -0,0 +1,147 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "cea.hpp"
+
+constexpr double ATM = 1.01325;
+
+int main()
+{
+
+    //------------------------------------------------------------------
+    // TP Problem Specification
+    //------------------------------------------------------------------
+
+    // Reactants
+    const cea_string reactants[]   = { "H2", "Air" };
+    const cea_real fuel_moles[]    = {  1.0,   0.0 };
+    const cea_real oxidant_moles[] = {  0.0,   1.0 };
+
+    // Products
+    const cea_string products[] = {
+        "Ar",    "C",    "CO",   "CO2",  "H",
+        "H2",    "H2O",  "HNO",  "HO2",  "HNO2",
+        "HNO3",  "N",    "NH",   "NO",   "N2",
+        "N2O3",  "O",    "O2",   "OH",   "O3"
+    };
+
+    // Mixture States
+    const cea_real pressures[] = { 1.00*ATM, 0.10*ATM, 0.01*ATM };
+    const cea_real temperatures[] = { 3000.0, 2000.0 };
+    const cea_real chem_eq_ratios[] = { 1.0, 1.5 };
+
+
+    //------------------------------------------------------------------
+    // CEA Setup
+    //------------------------------------------------------------------
+
+    cea::set_log_level(CEA_LOG_WARNING);
+    cea::init();
+
+    // Mixtures
+    cea::mixture reac(reactants);
+    cea::mixture prod(products);
+
+    // EqSolver, EqSolution, EqPartials
+    cea_solver_opts opts = cea::solver_options();
+    opts.reactants = reac.get();
+    cea::eq_solver solver(prod, opts);
+    cea::eq_solution soln(solver);
+    cea::eq_partials partials(solver);
+
+    //------------------------------------------------------------------
+    // Unit Conversions
+    //------------------------------------------------------------------
+
+    cea_real fuel_weights[2], oxidant_weights[2];
+    reac.moles_to_weights(fuel_moles, fuel_weights);
+    reac.moles_to_weights(oxidant_moles, oxidant_weights);
+
+    //------------------------------------------------------------------
+    // Equilibrium Solve
+    //------------------------------------------------------------------
+
+    std::printf(
+        "%10s  %10s  %10s  %10s  %12s  %12s  %12s  %12s\n",
+        "T (K)", "P (Pa)", "Chem Equiv", "O/F Ratio",
+        "H2 (wtfrac)", "Air (wtfrac)", "H (cal/g)", "Cp (cal/g-K)"
+    );
+
+    const cea_property_type props[] = { CEA_ENTHALPY, CEA_EQUILIBRIUM_CP };
+    double values[2];
+
+    for (double ratio : chem_eq_ratios) {
+
+        const double of_ratio = reac.chem_eq_ratio_to_of_ratio(oxidant_weights, fuel_weights, ratio);
+        cea_real weights[2];
+        reac.of_ratio_to_weights(oxidant_weights, fuel_weights, of_ratio, weights);
+
+        for (double p : pressures) {
+        for (double t : temperatures) {
+
+            solver.solve(soln, partials, CEA_TP, t, p, weights);
+            soln.properties(props, values);
+
+            std::printf(
+                "%10.2f  %10.2f  %10.2f  %10.6f  %12.5e  %12.5e  %12.5e  %12.5e\n",
+                t, p, ratio, of_ratio,
+                weights[0], weights[1], values[0]/4.184, values[1]/4.184
+            );
+
+        }}
+    }
+
+    //------------------------------------------------------------------
+    // Batch Solve
+    //------------------------------------------------------------------
+
+    // Same sweep through one call on a cloned solver; the results must match the scalar solves
+    const double of_ratio = reac.chem_eq_ratio_to_of_ratio(oxidant_weights, fuel_weights, chem_eq_ratios[0]);
+    cea_real weights[2];
+    reac.of_ratio_to_weights(oxidant_weights, fuel_weights, of_ratio, weights);
+
+    const double batch_t[] = { 3000.0, 2000.0, 3000.0, 2000.0 };
+    const double batch_p[] = { pressures[0], pressures[0], pressures[1], pressures[1] };
+    double batch_out[4*2];
+    bool batch_conv[4];
+    std::vector<double> batch_x(4*soln.num_products());
+
+    cea::eq_solver batch_solver = solver.clone();
+    cea::eq_solution batch_soln(batch_solver);
+    cea::eq_partials batch_partials(batch_solver);
+    const std::size_t num_failed = batch_solver.solve_batch(
+        batch_soln, batch_partials, CEA_TP, batch_t, batch_p, weights, props, batch_out, batch_conv, batch_x);
+
+    auto close = [](double a, double b) { return std::fabs(a - b) <= 1.0e-6*std::fabs(b); };
+    int status = num_failed == 0 ? 0 : 1;
+    for (std::size_t i = 0; i < 4; ++i) {
+        solver.solve(soln, partials, CEA_TP, batch_t[i], batch_p[i], weights);
+        soln.properties(props, values);
+        if (!batch_conv[i] || !close(batch_out[2*i], values[0]) || !close(batch_out[2*i+1], values[1])) status = 1;
+    }
+
+    // Species names are cached on the mixture; fractions are views into the solution
+    cea::span<const double> x = soln.mole_fractions();
+    const int ih2o = prod.names().find("H2O");
+    if (ih2o < 0 || !close(batch_x[3*soln.num_products() + ih2o], x[ih2o])) status = 1;
+    std::printf("\n%s mole fraction at %.0f K, %.4f bar: %12.5e\n",
+                prod.names()[ih2o].data(), batch_t[3], batch_p[3], x[ih2o]);
+
+    //------------------------------------------------------------------
+    // Species IDs
+    //------------------------------------------------------------------
+
+    // Resolve the product names once, then build the same mixture from IDs
+    cea_int product_ids[sizeof(products)/sizeof(products[0])];
+    cea::species_ids(products, product_ids);
+    cea::mixture prod_by_id = cea::mixture::from_ids(product_ids);
+    cea_int ids_back[sizeof(products)/sizeof(products[0])];
+    prod_by_id.species_ids(ids_back);
+    for (std::size_t i = 0; i < prod.num_species(); ++i) {
+        if (prod_by_id.names()[i] != prod.names()[i] || ids_back[i] != product_ids[i]) status = 1;
+    }
+
+    return status;
+
+}
@@ -114,7 +114,8 @@ def eq_solve(cea_equilibrium_type eq_type,
         else:
             raise TypeError("Reactant temperature not defined")
 
-    # Initialize the solver (following main.f90 pattern)
+    # Initialize the solver (following main.f90 pattern); each call owns its solver, so
+    # concurrent calls from separate threads solve in parallel with the GIL released
     if trace is not None:
         if transport:
             solver = EqSolver(products_mix, reactants_mix, trace, ions=ions, transport=True, insert=insert)
@@ -2,6 +2,8 @@
 from libc.stdlib cimport malloc, free
 from libc.stddef cimport size_t
 from cpython.bytes cimport PyBytes_AsString
+from cpython.pythread cimport (PyThread_type_lock, PyThread_allocate_lock, PyThread_free_lock,
+                               PyThread_acquire_lock, PyThread_release_lock, WAIT_LOCK)
 import cython
 import ctypes
 import array
@@ -47,6 +49,32 @@ cdef inline str cea_convert_chars_to_str(const char* s):
         return str(s)
 
 
+cdef class _SolverLock:
+    """
+    Mutex serializing solves on one solver handle while the GIL is released.
+
+    A solver handle carries working state that is updated during each solve, so concurrent
+    calls on the same solver (or with the same solution) are run one at a time. Distinct
+    solvers never contend for a lock.
+    """
+    cdef PyThread_type_lock ptr
+
+    def __cinit__(self):
+        self.ptr = PyThread_allocate_lock()
+        if self.ptr == NULL:
+            raise MemoryError("Failed to allocate solver lock")
+
+    def __dealloc__(self):
+        if self.ptr != NULL:
+            PyThread_free_lock(self.ptr)
+
+    cdef inline void acquire(self) noexcept nogil:
+        PyThread_acquire_lock(self.ptr, WAIT_LOCK)
+
+    cdef inline void release(self) noexcept nogil:
+        PyThread_release_lock(self.ptr)
+
+
 def _err_name(cea_err ierr):
     if ierr == SUCCESS:
         return "CEA_SUCCESS"
@@ -72,6 +100,10 @@ def _check_ierr(cea_err ierr, str context, bint allow_not_converged=True):
     if ierr != SUCCESS:
         raise RuntimeError(f"{context} failed with {_err_name(ierr)}")
 
+def _property_array(props):
+    # Property enums as a contiguous C int array, as expected by the bulk getters
+    return np.ascontiguousarray(props, dtype=np.intc).reshape(-1)
+
 # Alias the error types
 SUCCESS                  = CEA_SUCCESS
 INVALID_FILENAME         = CEA_INVALID_FILENAME
@@ -88,6 +120,31 @@ LOG_NONE     = CEA_LOG_NONE
 
 _py_log_level = LOG_WARNING
 
+# Alias the profile export formats
+PROFILE_TOTALS       = CEA_PROFILE_TOTALS
+PROFILE_COLLAPSED    = CEA_PROFILE_COLLAPSED
+PROFILE_CHROME_TRACE = CEA_PROFILE_CHROME_TRACE
+
+# Alias the EqDerivatives output flags; combine with |
+DERIV_OUT_T      = CEA_DERIV_OUT_T
+DERIV_OUT_N      = CEA_DERIV_OUT_N
+DERIV_OUT_NJ     = CEA_DERIV_OUT_NJ
+DERIV_OUT_H      = CEA_DERIV_OUT_H
+DERIV_OUT_U      = CEA_DERIV_OUT_U
+DERIV_OUT_G      = CEA_DERIV_OUT_G
+DERIV_OUT_S      = CEA_DERIV_OUT_S
+DERIV_WRT_STATE1 = CEA_DERIV_WRT_STATE1
+DERIV_WRT_STATE2 = CEA_DERIV_WRT_STATE2
+DERIV_WRT_W0     = CEA_DERIV_WRT_W0
+DERIV_OUT_ALL    = CEA_DERIV_OUT_ALL
+
+# Alias the solver output flags; combine with |
+OUTPUT_PROPERTIES  = CEA_OUTPUT_PROPERTIES
+OUTPUT_PARTIALS    = CEA_OUTPUT_PARTIALS
+OUTPUT_TRANSPORT   = CEA_OUTPUT_TRANSPORT
+OUTPUT_PERFORMANCE = CEA_OUTPUT_PERFORMANCE
+OUTPUT_ALL         = CEA_OUTPUT_ALL
+
 # Alias the equilibrium problem types
 TP = CEA_TP
 HP = CEA_HP
@@ -292,6 +349,71 @@ def set_log_level(level):
     _py_log_level = int(level)
     return
 
+def start_log_capture(max_records=CEA_LOG_CAPTURE_MAX_RECORDS):
+    """
+    Keep log messages in memory instead of printing them.
+
+    Each thread keeps its own ring of the latest ``max_records`` messages that pass the log level.
+    Starting the capture discards any records already held. Do not start or stop the capture while
+    other threads are solving.
+
+    Parameters
+    ----------
+    max_records : int, optional
+        Records kept per thread, between 1 and CEA_LOG_CAPTURE_MAX_RECORDS (64)
+    """
+    if max_records < 1 or max_records > CEA_LOG_CAPTURE_MAX_RECORDS:
+        raise ValueError(f"max_records must be between 1 and {CEA_LOG_CAPTURE_MAX_RECORDS}")
+    _check_ierr(cea_log_capture_start(max_records), "cea_log_capture_start")
+
+def stop_log_capture():
+    """
+    Stop capturing log messages; records already captured stay readable.
+    """
+    _check_ierr(cea_log_capture_stop(), "cea_log_capture_stop")
+
+def get_log_records(clear=False):
+    """
+    Get the log messages captured on the calling thread.
+
+    Parameters
+    ----------
+    clear : bool, optional
+        Clear the calling thread's records after reading them
+
+    Returns
+    -------
+    list of (int, str)
+        (log level, message) pairs, oldest first
+    """
+    cdef cea_int count, i
+    cdef cea_log_level level
+    cdef char buf[CEA_LOG_CAPTURE_RECORD_LEN]
+    _check_ierr(cea_log_capture_get_count(&count), "cea_log_capture_get_count")
+    records = []
+    for i in range(count):
+        _check_ierr(cea_log_capture_get_record_buf(i, &level, buf, CEA_LOG_CAPTURE_RECORD_LEN),
+                    "cea_log_capture_get_record_buf")
+        records.append((int(level), buf.decode("utf-8", "replace")))
+    if clear:
+        _check_ierr(cea_log_capture_clear(), "cea_log_capture_clear")
+    return records
+
+def set_profiling(enabled):
+    """
+    Record the wall-clock time of solver phases.
+
+    Solvers created while profiling is on keep their own profile, which
+    ``write_profile`` exports. Solvers created before the switch are not affected.
+
+    Parameters
+    ----------
+    enabled : bool
+        Whether solvers created from now on are profiled
+    """
+    cdef bint on = enabled
+    _check_ierr(cea_set_profiling(on), "cea_set_profiling")
+
 def _maybe_print_init_path(label, path):
     if _py_log_level == LOG_NONE:
         return
@@ -702,6 +824,9 @@ cdef class Mixture:
                     cea_reactants[i].has_temperature = 0
                     cea_reactants[i].temperature = 0.0
                     cea_reactants[i].temperature_units = NULL
+                    cea_reactants[i].has_id = 0
+                    cea_reactants[i].id = -1
+                    cea_reactants[i].element_ids = NULL
 
                     if isinstance(entry, Reactant):
                         reactant = <Reactant>entry
@@ -1168,10 +1293,17 @@ cdef class EqSolver:
             Enable smooth logistic truncation instead of hard cutoff for trace species
         truncation_width : float, default -1.0
             Gate width in log-space for smooth truncation; values <= 0 use the solver default (0.25)
+        outputs : int, default OUTPUT_ALL
+            OUTPUT_PROPERTIES, OUTPUT_PARTIALS and OUTPUT_TRANSPORT flags, or'ed together,
+            naming the outputs computed in internal iterations; the others are computed once before solve returns
     """
     cdef cea_eqsolver ptr
     cdef Mixture products
     cdef object _keepalive_insert
+    cdef _SolverLock _lock
+
+    def __cinit__(self, *args, **kwargs):
+        self._lock = _SolverLock()
 
     def __init__(self, Mixture products, **kwargs):
 
@@ -1181,6 +1313,7 @@ cdef class EqSolver:
         cdef double trace_val = kwargs.get('trace', -1.0)
         cdef bint smooth_truncation = kwargs.get('smooth_truncation', False)
         cdef double truncation_width_val = kwargs.get('truncation_width', -1.0)
+        cdef int outputs = kwargs.get('outputs', OUTPUT_ALL)
         cdef cea_string* cea_insert = NULL
         insert = kwargs.get('insert', [])
         cdef list _insert_keepalive = []
@@ -1213,6 +1346,7 @@ cdef class EqSolver:
         opts.insert = cea_insert
         opts.smooth_truncation = smooth_truncation
         opts.truncation_width = truncation_width_val
+        opts.outputs = outputs
 
         if "reactants" in kwargs:
             reactants = kwargs["reactants"]
@@ -1234,6 +1368,54 @@ cdef class EqSolver:
             cea_eqsolver_destroy(&self.ptr)
         return
 
+    def clone(self):
+        """
+        Create a copy of this solver that can be used independently.
+
+        The copy has the same species, options, and transport data, but
+        skips the database lookups done by the constructor. Use it to give
+        each thread its own solver. The product mixture and transport data
+        are read-only and shared by reference; the copy gets its own
+        working state, so solves on one never affect the other. Either
+        solver may be deleted first.
+
+        Returns
+        -------
+        EqSolver
+            New solver object
+        """
+        cdef EqSolver other = EqSolver.__new__(EqSolver)
+        cdef cea_err ierr
+        other.products = self.products
+        with nogil:
+            self._lock.acquire()
+        # The GIL, held here and in __dealloc__, serializes the shared data's reference count
+        ierr = cea_eqsolver_clone(&other.ptr, self.ptr)
+        self._lock.release()
+        _check_ierr(ierr, "EqSolver.clone")
+        return other
+
+    def write_profile(self, filename, format=PROFILE_TOTALS):
+        """
+        Write the phase timings recorded by this solver.
+
+        Parameters
+        ----------
+        filename : str or os.PathLike
+            Output file path
+        format : int (enum), optional
+            PROFILE_TOTALS (table of calls and times), PROFILE_COLLAPSED (flame graph
+            stacks), or PROFILE_CHROME_TRACE (JSON for chrome://tracing or Perfetto)
+        """
+        cdef _CString cfilename = _CString(os.fspath(filename), "filename")
+        cdef cea_profile_format fmt = format
+        cdef cea_err ierr
+        with nogil:
+            self._lock.acquire()
+            ierr = cea_eqsolver_write_profile(self.ptr, fmt, cfilename.ptr)
+            self._lock.release()
+        _check_ierr(ierr, "EqSolver.write_profile")
+
     property num_reactants:
         """
         Number of reactant species.
@@ -1350,7 +1532,11 @@ cdef class EqSolver:
             ierr = cea_eqpartials_create(&partials, self.ptr)
             _check_ierr(ierr, "EqSolver.solve: create partials")
             try:
-                ierr = cea_eqsolver_solve_with_partials(self.ptr, eq_type, <cea_real>state1, <cea_real>state2, amts, soln.ptr, partials)
+                with nogil:
+                    self._lock.acquire()
+                    ierr = cea_eqsolver_solve_with_partials(self.ptr, eq_type, <cea_real>state1, <cea_real>state2, amts,
+                                                            soln.ptr, partials)
+                    self._lock.release()
                 soln.last_error = <int>ierr
                 _check_ierr(ierr, "EqSolver.solve")
             finally:
@@ -1361,6 +1547,152 @@ cdef class EqSolver:
 
         return
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def solve_batch(self, EqSolution soln, cea_equilibrium_type eq_type, state1, state2, amounts,
+                    props=(TEMPERATURE,), out=None, species=None, converged=None, bint mass_fraction=False):
+        """
+        Solve a sequence of equilibrium problems in a single call.
+        NOTE: only mass fractions are accepted; other values must be converted to mass fractions first.
+
+        The points are solved by ``cea_eqsolver_solve_batch``, which iterates several constant-pressure
+        problems together and solves the others in order; ``soln`` is the working storage. Inputs and
+        outputs are passed as contiguous arrays, and the GIL is released for the whole sweep.
+
+        Parameters
+        ----------
+        soln : EqSolution
+            Working solution object; holds the last point finished on return
+        eq_type : int
+            Equilibrium type constant (TP, HP, SP, TV, UV, SV)
+        state1 : float or array_like, shape (npts,)
+            First thermodynamic state variable at each point; a scalar is used for every point
+        state2 : float or array_like, shape (npts,)
+            Second thermodynamic state variable at each point; a scalar is used for every point
+        amounts : array_like, shape (num_reactants,) or (npts, num_reactants)
+            Reactant mass fractions; a 1D array is used for every point
+        props : sequence of int, default (TEMPERATURE,)
+            Property type constants to extract at each point
+        out : np.ndarray, shape (npts, len(props)), optional
+            float64 array to fill with property values; allocated if not given
+        species : np.ndarray, shape (npts, num_products), optional
+            float64 array to fill with product species fractions
+        converged : np.ndarray, shape (npts,), optional
+            bool array to fill with the convergence flag of each point
+        mass_fraction : bool, default False
+            Whether ``species`` is filled with mass fractions (True) or mole fractions (False)
+
+        Returns
+        -------
+        np.ndarray
+            Property values, shape (npts, len(props))
+
+        Raises
+        ------
+        ValueError
+            If the input or output shapes are inconsistent
+        """
+        cdef cea_err ierr = CEA_SUCCESS
+        cdef cea_eqpartials partials
+        cdef Py_ssize_t npts
+        cdef Py_ssize_t nprops
+        cdef Py_ssize_t nr = self.num_reactants
+        cdef Py_ssize_t nprod = self.num_products
+        cdef cea_int num_failed = 0
+        cdef bint want_species = species is not None
+        cdef bint want_converged = converged is not None
+        cdef const double[::1] s1
+        cdef const double[::1] s2
+        cdef const double[:, ::1] amts
+        cdef const int[::1] ptype
+        cdef double[:, ::1] out_v
+        cdef double[:, ::1] species_v
+        cdef np.uint8_t[::1] conv_v
+        cdef cea_real *species_ptr = NULL
+        cdef cea_bool_array *conv_ptr = NULL
+
+        s1_arr = np.ascontiguousarray(state1, dtype=np.float64)
+        s2_arr = np.ascontiguousarray(state2, dtype=np.float64)
+        if s1_arr.ndim > 1 or s2_arr.ndim > 1:
+            raise ValueError("EqSolver.solve_batch: state1 and state2 must be scalars or 1D arrays")
+        s1_arr = s1_arr.reshape(-1)
+        s2_arr = s2_arr.reshape(-1)
+        amts_arr = np.ascontiguousarray(amounts, dtype=np.float64)
+        if amts_arr.ndim == 1:
+            amts_arr = amts_arr.reshape(1, -1)
+        elif amts_arr.ndim != 2:
+            raise ValueError("EqSolver.solve_batch: amounts must be a 1D or 2D array")
+        if amts_arr.shape[1] != nr:
+            raise ValueError("EqSolver.solve_batch: amounts must have num_reactants columns")
+
+        # Single values are passed once and broadcast by the solver
+        npts = max(s1_arr.size, s2_arr.size, amts_arr.shape[0])
+        if s1_arr.size not in (1, npts) or s2_arr.size not in (1, npts):
+            raise ValueError("EqSolver.solve_batch: state1 and state2 must have one value per point")
+        if amts_arr.shape[0] not in (1, npts):
+            raise ValueError("EqSolver.solve_batch: amounts must have one row per point")
+        s1 = s1_arr
+        s2 = s2_arr
+        amts = amts_arr
+
+        ptype_arr = _property_array(props)
+        nprops = ptype_arr.shape[0]
+        ptype = ptype_arr if nprops > 0 else np.zeros(1, dtype=np.intc)
+        if out is None:
+            out = np.empty((npts, nprops), dtype=np.float64)
+        if out.shape != (npts, nprops):
+            raise ValueError("EqSolver.solve_batch: out must have shape (npts, len(props))")
+        if want_species and species.shape != (npts, nprod):
+            raise ValueError("EqSolver.solve_batch: species must have shape (npts, num_products)")
+        if want_converged:
+            if converged.dtype != np.bool_ or converged.shape != (npts,):
+                raise ValueError("EqSolver.solve_batch: converged must be a bool array of shape (npts,)")
+
+        if npts == 0:
+            return out
+
+        # Contiguous scratch outputs, copied into the caller's (possibly strided) arrays afterwards
+        out_buf = np.empty((npts, max(nprops, 1)), dtype=np.float64)
+        out_v = out_buf
+        if want_species:
+            species_buf = np.empty((npts, nprod), dtype=np.float64)
+            species_v = species_buf
+            species_ptr = &species_v[0, 0]
+        if want_converged:
+            conv_buf = np.empty(npts, dtype=np.uint8)
+            conv_v = conv_buf
+            conv_ptr = <cea_bool_array *>&conv_v[0]
+
+        ierr = cea_eqpartials_create(&partials, self.ptr)
+        _check_ierr(ierr, "EqSolver.solve_batch: create partials")
+        try:
+            with nogil:
+                self._lock.acquire()
+                ierr = cea_eqsolver_solve_batch(self.ptr, eq_type, <cea_int>npts, <cea_int>s1.shape[0], &s1[0],
+                                                <cea_int>s2.shape[0], &s2[0], <cea_int>amts.shape[0], &amts[0, 0],
+                                                soln.ptr, partials, <cea_int>nprops, <cea_property_type *>&ptype[0],
+                                                &out_v[0, 0], conv_ptr, species_ptr, mass_fraction, &num_failed)
+                self._lock.release()
+        finally:
+            cea_eqpartials_destroy(&partials)
+
+        if ierr != CEA_SUCCESS and ierr != CEA_NOT_CONVERGED:
+            soln.last_error = <int>ierr
+            _check_ierr(ierr, "EqSolver.solve_batch")
+        out[...] = out_buf[:, :nprops]
+        if want_species:
+            species[...] = species_buf
+        if want_converged:
+            converged[...] = conv_buf.view(np.bool_)
+        if num_failed > 0:
+            soln.last_error = <int>CEA_NOT_CONVERGED
+            warnings.warn(f"EqSolver.solve_batch: {num_failed} of {npts} points: {_err_name(CEA_NOT_CONVERGED)}",
+                          RuntimeWarning)
+        else:
+            soln.last_error = <int>SUCCESS
+
+        return out
+
 cdef class EqSolution:
     """
     Solution object containing equilibrium calculation results.
@@ -1788,6 +2120,32 @@ cdef class EqSolution:
 
         return value
 
+    def get_properties(self, props):
+        """
+        Values of several properties in one call.
+
+        Parameters
+        ----------
+        props : sequence of int
+            Property type constants (e.g., TEMPERATURE, ENTHALPY)
+
+        Returns
+        -------
+        np.ndarray
+            Property values, in the order of ``props``
+        """
+        cdef cea_err ierr
+        cdef np.ndarray[int, ndim=1, mode="c"] types = _property_array(props)
+        cdef np.ndarray[np.float64_t, ndim=1, mode="c"] values = np.empty(types.shape[0], dtype=np.float64)
+
+        ierr = cea_eqsolution_get_properties(self.ptr, <cea_int>types.shape[0], <cea_property_type *>types.data,
+                                             <cea_real *>values.data)
+        if ierr != SUCCESS:
+            self.last_error = <int>ierr
+        _check_ierr(ierr, "EqSolution.get_properties")
+
+        return values
+
     def _get_weights(self, bint log=False):
         cdef cea_err ierr
         cdef int nspecies
@@ -1855,15 +2213,22 @@ cdef class EqDerivatives:
         Equilibrium solver instance used to produce the solution
     solution : EqSolution
         Equilibrium solution instance
+    outputs : int, optional
+        Derivatives to compute, as DERIV_OUT_* flags or'ed with DERIV_WRT_* flags,
+        e.g. ``DERIV_OUT_T | DERIV_WRT_W0``. Other derivatives raise on access.
+        By default every derivative is computed.
     """
     cdef cea_eqderivatives ptr
     cdef EqSolver solver
     cdef EqSolution solution
     cdef public int last_error
 
-    def __cinit__(self, EqSolver solver, EqSolution solution):
+    def __cinit__(self, EqSolver solver, EqSolution solution, outputs=None):
         cdef cea_err ierr
-        ierr = cea_eqderivatives_create(&self.ptr, solver.ptr, solution.ptr)
+        if outputs is None:
+            ierr = cea_eqderivatives_create(&self.ptr, solver.ptr, solution.ptr)
+        else:
+            ierr = cea_eqderivatives_create_with_outputs(&self.ptr, solver.ptr, solution.ptr, outputs)
         _check_ierr(ierr, "EqDerivatives.__cinit__")
         self.solver = solver
         self.solution = solution
@@ -1886,7 +2251,11 @@ cdef class EqDerivatives:
             If True, evaluate and log derivative closure defect
         """
         cdef cea_err ierr
-        ierr = cea_eqderivatives_compute_derivatives(self.ptr, self.solver.ptr, self.solution.ptr, check_closure_defect)
+        with nogil:
+            self.solver._lock.acquire()
+            ierr = cea_eqderivatives_compute_derivatives(self.ptr, self.solver.ptr, self.solution.ptr,
+                                                         check_closure_defect)
+            self.solver._lock.release()
         if ierr != SUCCESS:
             self.last_error = <int>ierr
         _check_ierr(ierr, "EqDerivatives.compute_derivatives")
@@ -1906,7 +2275,10 @@ cdef class EqDerivatives:
             If True, use central differences; if False, use forward differences
         """
         cdef cea_err ierr
-        ierr = cea_eqderivatives_compute_fd(self.ptr, self.solver.ptr, self.solution.ptr, h, verbose, central)
+        with nogil:
+            self.solver._lock.acquire()
+            ierr = cea_eqderivatives_compute_fd(self.ptr, self.solver.ptr, self.solution.ptr, h, verbose, central)
+            self.solver._lock.release()
         if ierr != SUCCESS:
             self.last_error = <int>ierr
         _check_ierr(ierr, "EqDerivatives.compute_fd")
@@ -2150,10 +2522,17 @@ cdef class RocketSolver:
             Enable smooth logistic truncation instead of hard cutoff for trace species
         truncation_width : float, default -1.0
             Gate width in log-space for smooth truncation; values <= 0 use the solver default (0.25)
+        outputs : int, default OUTPUT_ALL
+            OUTPUT_PROPERTIES, OUTPUT_PARTIALS, OUTPUT_TRANSPORT and OUTPUT_PERFORMANCE flags, or'ed together,
+            naming the outputs computed in internal iterations; the others are computed once before solve returns
     """
     cdef cea_rocket_solver ptr
     cdef Mixture products
     cdef object _keepalive_insert
+    cdef _SolverLock _lock
+
+    def __cinit__(self, *args, **kwargs):
+        self._lock = _SolverLock()
 
     def __init__(self, Mixture products, **kwargs):
 
@@ -2163,6 +2542,7 @@ cdef class RocketSolver:
         cdef double trace_val = kwargs.get('trace', -1.0)
         cdef bint smooth_truncation = kwargs.get('smooth_truncation', False)
         cdef double truncation_width_val = kwargs.get('truncation_width', -1.0)
+        cdef int outputs = kwargs.get('outputs', OUTPUT_ALL)
         cdef cea_string* cea_insert = NULL
         insert = kwargs.get('insert', [])
         cdef list _insert_keepalive = []
@@ -2195,6 +2575,7 @@ cdef class RocketSolver:
         opts.insert = cea_insert
         opts.smooth_truncation = smooth_truncation
         opts.truncation_width = truncation_width_val
+        opts.outputs = outputs
 
         if "reactants" in kwargs:
             reactants = kwargs["reactants"]
@@ -2216,6 +2597,54 @@ cdef class RocketSolver:
             cea_rocket_solver_destroy(&self.ptr)
         return
 
+    def clone(self):
+        """
+        Create a copy of this solver that can be used independently.
+
+        The copy has the same species, options, and transport data, but
+        skips the database lookups done by the constructor. Use it to give
+        each thread its own solver. The product mixture and transport data
+        are read-only and shared by reference; the copy gets its own
+        working state, so solves on one never affect the other. Either
+        solver may be deleted first.
+
+        Returns
+        -------
+        RocketSolver
+            New solver object
+        """
+        cdef RocketSolver other = RocketSolver.__new__(RocketSolver)
+        cdef cea_err ierr
+        other.products = self.products
+        with nogil:
+            self._lock.acquire()
+        # The GIL, held here and in __dealloc__, serializes the shared data's reference count
+        ierr = cea_rocket_solver_clone(&other.ptr, self.ptr)
+        self._lock.release()
+        _check_ierr(ierr, "RocketSolver.clone")
+        return other
+
+    def write_profile(self, filename, format=PROFILE_TOTALS):
+        """
+        Write the phase timings recorded by this solver.
+
+        Parameters
+        ----------
+        filename : str or os.PathLike
+            Output file path
+        format : int (enum), optional
+            PROFILE_TOTALS (table of calls and times), PROFILE_COLLAPSED (flame graph
+            stacks), or PROFILE_CHROME_TRACE (JSON for chrome://tracing or Perfetto)
+        """
+        cdef _CString cfilename = _CString(os.fspath(filename), "filename")
+        cdef cea_profile_format fmt = format
+        cdef cea_err ierr
+        with nogil:
+            self._lock.acquire()
+            ierr = cea_rocket_solver_write_profile(self.ptr, fmt, cfilename.ptr)
+            self._lock.release()
+        _check_ierr(ierr, "RocketSolver.write_profile")
+
     property num_reactants:
         """
         Number of reactant species.
@@ -2441,12 +2870,16 @@ cdef class RocketSolver:
                 use_mdot = False
                 mdot_or_acat = <cea_real>ac_at
 
+        cdef bint use_iac = iac
         try:
             # Call the solver
-            if iac:
-                ierr = cea_rocket_solver_solve_iac(self.ptr, soln.ptr, wts, <cea_real>pc, pi_p_c, npi_p, subar_c, nsubar, supar_c, nsupar, n_frz_c, hc_or_tc, use_hc, tc_est_c, use_tc_est)
-            else:
-                ierr = cea_rocket_solver_solve_fac(self.ptr, soln.ptr, wts, <cea_real>pc, pi_p_c, npi_p, subar_c, nsubar, supar_c, nsupar, n_frz_c, hc_or_tc, use_hc, mdot_or_acat, use_mdot, tc_est_c, use_tc_est)
+            with nogil:
+                self._lock.acquire()
+                if use_iac:
+                    ierr = cea_rocket_solver_solve_iac(self.ptr, soln.ptr, wts, <cea_real>pc, pi_p_c, npi_p, subar_c, nsubar, supar_c, nsupar, n_frz_c, hc_or_tc, use_hc, tc_est_c, use_tc_est)
+                else:
+                    ierr = cea_rocket_solver_solve_fac(self.ptr, soln.ptr, wts, <cea_real>pc, pi_p_c, npi_p, subar_c, nsubar, supar_c, nsupar, n_frz_c, hc_or_tc, use_hc, mdot_or_acat, use_mdot, tc_est_c, use_tc_est)
+                self._lock.release()
             soln.last_error = <int>ierr
             _check_ierr(ierr, "RocketSolver.solve")
         finally:
@@ -2982,6 +3415,33 @@ cdef class RocketSolution:
 
         return prop_val
 
+    def get_properties(self, props):
+        """
+        Values of several properties at every station in one call.
+
+        Parameters
+        ----------
+        props : sequence of int
+            Property type constants
+
+        Returns
+        -------
+        np.ndarray
+            Property values, shape (len(props), num_pts)
+        """
+        cdef cea_err ierr
+        cdef int num_pts = self._get_size()
+        cdef np.ndarray[int, ndim=1, mode="c"] types = _property_array(props)
+        cdef np.ndarray[np.float64_t, ndim=2, mode="c"] values = np.empty((types.shape[0], num_pts), dtype=np.float64)
+
+        ierr = cea_rocket_solution_get_properties(self.ptr, <cea_int>types.shape[0], <cea_rocket_property_type *>types.data,
+                                                  num_pts, <cea_real *>values.data)
+        if ierr != SUCCESS:
+            self.last_error = <int>ierr
+        _check_ierr(ierr, "RocketSolution.get_properties")
+
+        return values
+
     def _get_weights(self, bint log=False):
         cdef cea_err ierr
         cdef int num_pts = self._get_size()
@@ -3021,22 +3481,13 @@ cdef class RocketSolution:
         cdef cea_err ierr
         cdef int num_pts = self._get_size()
         cdef int nspecies = self.solver.num_products
+        cdef np.ndarray[np.float64_t, ndim=2, mode="c"] amounts = np.zeros((num_pts, nspecies), dtype=np.double)
 
-        cdef cea_real *cea_amounts = <cea_real *>malloc(nspecies * sizeof(cea_real))
-        if cea_amounts == NULL:
-            raise MemoryError("Failed to allocate species amounts buffer")
-
-        try:
-            amounts = np.zeros((num_pts, nspecies), dtype=np.double)
-            for i in range(1,num_pts+1):
-                ierr = cea_rocket_solution_get_species_amounts(self.ptr, nspecies, <cea_int>i, cea_amounts, mass_fraction)
-                for j in range(nspecies):
-                    amounts[i-1, j] = cea_amounts[j]
-            if ierr != SUCCESS:
-                self.last_error = <int>ierr
-            _check_ierr(ierr, "RocketSolution._get_species_amounts")
-        finally:
-            free(cea_amounts)
+        ierr = cea_rocket_solution_get_all_species_amounts(self.ptr, nspecies, num_pts, <cea_real *>amounts.data,
+                                                           mass_fraction)
+        if ierr != SUCCESS:
+            self.last_error = <int>ierr
+        _check_ierr(ierr, "RocketSolution._get_species_amounts")
 
         return amounts
 
@@ -3085,6 +3536,10 @@ cdef class ShockSolver:
     cdef cea_shock_solver ptr
     cdef Mixture products
     cdef object _keepalive_insert
+    cdef _SolverLock _lock
+
+    def __cinit__(self, *args, **kwargs):
+        self._lock = _SolverLock()
 
     def __init__(self, Mixture products, **kwargs):
 
@@ -3147,6 +3602,54 @@ cdef class ShockSolver:
             cea_shock_solver_destroy(&self.ptr)
         return
 
+    def clone(self):
+        """
+        Create a copy of this solver that can be used independently.
+
+        The copy has the same species, options, and transport data, but
+        skips the database lookups done by the constructor. Use it to give
+        each thread its own solver. The product mixture and transport data
+        are read-only and shared by reference; the copy gets its own
+        working state, so solves on one never affect the other. Either
+        solver may be deleted first.
+
+        Returns
+        -------
+        ShockSolver
+            New solver object
+        """
+        cdef ShockSolver other = ShockSolver.__new__(ShockSolver)
+        cdef cea_err ierr
+        other.products = self.products
+        with nogil:
+            self._lock.acquire()
+        # The GIL, held here and in __dealloc__, serializes the shared data's reference count
+        ierr = cea_shock_solver_clone(&other.ptr, self.ptr)
+        self._lock.release()
+        _check_ierr(ierr, "ShockSolver.clone")
+        return other
+
+    def write_profile(self, filename, format=PROFILE_TOTALS):
+        """
+        Write the phase timings recorded by this solver.
+
+        Parameters
+        ----------
+        filename : str or os.PathLike
+            Output file path
+        format : int (enum), optional
+            PROFILE_TOTALS (table of calls and times), PROFILE_COLLAPSED (flame graph
+            stacks), or PROFILE_CHROME_TRACE (JSON for chrome://tracing or Perfetto)
+        """
+        cdef _CString cfilename = _CString(os.fspath(filename), "filename")
+        cdef cea_profile_format fmt = format
+        cdef cea_err ierr
+        with nogil:
+            self._lock.acquire()
+            ierr = cea_shock_solver_write_profile(self.ptr, fmt, cfilename.ptr)
+            self._lock.release()
+        _check_ierr(ierr, "ShockSolver.write_profile")
+
     property num_reactants:
         """
         Number of reactant species.
@@ -3275,8 +3778,11 @@ cdef class ShockSolver:
             u1_or_mach1 = <cea_real>Mach1
 
         try:
-            ierr = cea_shock_solver_solve(self.ptr, soln.ptr, wts, <cea_real>T0, <cea_real>p0, u1_or_mach1, use_mach,
-                                          reflected, incident_frozen, reflected_frozen)
+            with nogil:
+                self._lock.acquire()
+                ierr = cea_shock_solver_solve(self.ptr, soln.ptr, wts, <cea_real>T0, <cea_real>p0, u1_or_mach1, use_mach,
+                                              reflected, incident_frozen, reflected_frozen)
+                self._lock.release()
             soln.last_error = <int>ierr
             _check_ierr(ierr, "ShockSolver.solve")
         finally:
@@ -3858,6 +4364,33 @@ cdef class ShockSolution:
 
         return prop_val
 
+    def get_properties(self, props):
+        """
+        Values of several properties at every point in one call.
+
+        Parameters
+        ----------
+        props : sequence of int
+            Property type constants
+
+        Returns
+        -------
+        np.ndarray
+            Property values, shape (len(props), num_pts)
+        """
+        cdef cea_err ierr
+        cdef int num_pts = self.num_pts
+        cdef np.ndarray[int, ndim=1, mode="c"] types = _property_array(props)
+        cdef np.ndarray[np.float64_t, ndim=2, mode="c"] values = np.empty((types.shape[0], num_pts), dtype=np.float64)
+
+        ierr = cea_shock_solution_get_properties(self.ptr, <cea_int>types.shape[0], <cea_shock_property_type *>types.data,
+                                                  num_pts, <cea_real *>values.data)
+        if ierr != SUCCESS:
+            self.last_error = <int>ierr
+        _check_ierr(ierr, "ShockSolution.get_properties")
+
+        return values
+
     def _get_scalar_property(self, cea_shock_property_type prop_type):
         cdef cea_err ierr
         cdef cea_real value
@@ -3907,22 +4440,13 @@ cdef class ShockSolution:
 
         cdef cea_err ierr
         cdef int nspecies = self.solver.num_products
+        cdef np.ndarray[np.float64_t, ndim=2, mode="c"] amounts = np.zeros((self.num_pts, nspecies), dtype=np.double)
 
-        cdef cea_real *cea_amounts = <cea_real *>malloc(nspecies * sizeof(cea_real))
-        if cea_amounts == NULL:
-            raise MemoryError("Failed to allocate species amounts buffer")
-
-        try:
-            amounts = np.zeros((self.num_pts, nspecies), dtype=np.double)
-            for i in range(1,self.num_pts+1):
-                ierr = cea_shock_solution_get_species_amounts(self.ptr, nspecies, <cea_int>i, cea_amounts, mass_fraction)
-                for j in range(nspecies):
-                    amounts[i-1, j] = cea_amounts[j]
-            if ierr != SUCCESS:
-                self.last_error = <int>ierr
-            _check_ierr(ierr, "ShockSolution._get_species_amounts")
-        finally:
-            free(cea_amounts)
+        ierr = cea_shock_solution_get_all_species_amounts(self.ptr, nspecies, self.num_pts, <cea_real *>amounts.data,
+                                                          mass_fraction)
+        if ierr != SUCCESS:
+            self.last_error = <int>ierr
+        _check_ierr(ierr, "ShockSolution._get_species_amounts")
 
         return amounts
 
@@ -3957,6 +4481,10 @@ cdef class DetonationSolver:
     cdef cea_detonation_solver ptr
     cdef Mixture products
     cdef object _keepalive_insert
+    cdef _SolverLock _lock
+
+    def __cinit__(self, *args, **kwargs):
+        self._lock = _SolverLock()
 
     def __init__(self, Mixture products, **kwargs):
 
@@ -4019,6 +4547,54 @@ cdef class DetonationSolver:
             cea_detonation_solver_destroy(&self.ptr)
         return
 
+    def clone(self):
+        """
+        Create a copy of this solver that can be used independently.
+
+        The copy has the same species, options, and transport data, but
+        skips the database lookups done by the constructor. Use it to give
+        each thread its own solver. The product mixture and transport data
+        are read-only and shared by reference; the copy gets its own
+        working state, so solves on one never affect the other. Either
+        solver may be deleted first.
+
+        Returns
+        -------
+        DetonationSolver
+            New solver object
+        """
+        cdef DetonationSolver other = DetonationSolver.__new__(DetonationSolver)
+        cdef cea_err ierr
+        other.products = self.products
+        with nogil:
+            self._lock.acquire()
+        # The GIL, held here and in __dealloc__, serializes the shared data's reference count
+        ierr = cea_detonation_solver_clone(&other.ptr, self.ptr)
+        self._lock.release()
+        _check_ierr(ierr, "DetonationSolver.clone")
+        return other
+
+    def write_profile(self, filename, format=PROFILE_TOTALS):
+        """
+        Write the phase timings recorded by this solver.
+
+        Parameters
+        ----------
+        filename : str or os.PathLike
+            Output file path
+        format : int (enum), optional
+            PROFILE_TOTALS (table of calls and times), PROFILE_COLLAPSED (flame graph
+            stacks), or PROFILE_CHROME_TRACE (JSON for chrome://tracing or Perfetto)
+        """
+        cdef _CString cfilename = _CString(os.fspath(filename), "filename")
+        cdef cea_profile_format fmt = format
+        cdef cea_err ierr
+        with nogil:
+            self._lock.acquire()
+            ierr = cea_detonation_solver_write_profile(self.ptr, fmt, cfilename.ptr)
+            self._lock.release()
+        _check_ierr(ierr, "DetonationSolver.write_profile")
+
     property num_reactants:
         """
         Number of reactant species.
@@ -4118,7 +4694,10 @@ cdef class DetonationSolver:
             wts[i] = weights[i]
 
         try:
-            ierr = cea_detonation_solver_solve(self.ptr, soln.ptr, wts, <cea_real>T1, <cea_real>p1, frozen)
+            with nogil:
+                self._lock.acquire()
+                ierr = cea_detonation_solver_solve(self.ptr, soln.ptr, wts, <cea_real>T1, <cea_real>p1, frozen)
+                self._lock.release()
             soln.last_error = <int>ierr
             _check_ierr(ierr, "DetonationSolver.solve")
         finally:
@@ -4638,6 +5217,32 @@ cdef class DetonationSolution:
 
         return value
 
+    def get_properties(self, props):
+        """
+        Values of several properties in one call.
+
+        Parameters
+        ----------
+        props : sequence of int
+            Property type constants
+
+        Returns
+        -------
+        np.ndarray
+            Property values, in the order of ``props``
+        """
+        cdef cea_err ierr
+        cdef np.ndarray[int, ndim=1, mode="c"] types = _property_array(props)
+        cdef np.ndarray[np.float64_t, ndim=1, mode="c"] values = np.empty(types.shape[0], dtype=np.float64)
+
+        ierr = cea_detonation_solution_get_properties(self.ptr, <cea_int>types.shape[0],
+                                                      <cea_detonation_property_type *>types.data, <cea_real *>values.data)
+        if ierr != SUCCESS:
+            self.last_error = <int>ierr
+        _check_ierr(ierr, "DetonationSolution.get_properties")
+
+        return values
+
     def _get_weights(self, bint log=False):
         cdef cea_err ierr
         cdef int nspecies
@@ -4694,6 +5299,177 @@ cdef class DetonationSolution:
 
         return amounts
 
+# -----------
+# Input decks
+# -----------
+
+# Names of the prob dataset schedules, keyed the same way in the problem dicts
+_INPUT_SCHEDULES = (
+    ("of", CEA_INPUT_OF), ("t", CEA_INPUT_T), ("h", CEA_INPUT_H), ("u", CEA_INPUT_U),
+    ("s", CEA_INPUT_S), ("p", CEA_INPUT_P), ("v", CEA_INPUT_V), ("u1", CEA_INPUT_U1),
+    ("mach1", CEA_INPUT_MACH1), ("pcp", CEA_INPUT_PCP), ("subar", CEA_INPUT_SUBAR),
+    ("supar", CEA_INPUT_SUPAR),
+)
+_INPUT_REACTANT_SCHEDULES = (
+    ("amount", CEA_INPUT_REACTANT_AMOUNT), ("temperature", CEA_INPUT_REACTANT_TEMPERATURE),
+    ("enthalpy", CEA_INPUT_REACTANT_ENTHALPY), ("density", CEA_INPUT_REACTANT_DENSITY),
+)
+_INPUT_SPECIES_LISTS = (("only", CEA_INPUT_ONLY), ("omit", CEA_INPUT_OMIT), ("insert", CEA_INPUT_INSERT))
+
+cdef enum:
+    _INPUT_BUF_LEN = 512
+
+cdef object _input_schedule(cea_input_deck deck, cea_int i, cea_input_schedule which):
+    cdef cea_int n
+    cdef char name[_INPUT_BUF_LEN]
+    cdef char units[_INPUT_BUF_LEN]
+    cdef np.ndarray[np.double_t, ndim=1] values
+    _check_ierr(cea_input_deck_get_schedule_size(deck, i, which, &n), "cea_input_deck_get_schedule_size")
+    if n == 0:
+        return None
+    values = np.empty(n, dtype=np.double)
+    _check_ierr(cea_input_deck_get_schedule(deck, i, which, n, <cea_real*>values.data),
+                "cea_input_deck_get_schedule")
+    _check_ierr(cea_input_deck_get_schedule_name_buf(deck, i, which, name, _INPUT_BUF_LEN),
+                "cea_input_deck_get_schedule_name_buf")
+    _check_ierr(cea_input_deck_get_schedule_units_buf(deck, i, which, units, _INPUT_BUF_LEN),
+                "cea_input_deck_get_schedule_units_buf")
+    return {"name": name.decode("utf-8"), "units": units.decode("utf-8"), "values": values}
+
+cdef object _input_reactant_schedule(cea_input_deck deck, cea_int i, cea_int j,
+                                     cea_input_reactant_schedule which):
+    cdef cea_int n
+    cdef char name[_INPUT_BUF_LEN]
+    cdef char units[_INPUT_BUF_LEN]
+    cdef np.ndarray[np.double_t, ndim=1] values
+    _check_ierr(cea_input_deck_get_reactant_schedule_size(deck, i, j, which, &n),
+                "cea_input_deck_get_reactant_schedule_size")
+    if n == 0:
+        return None
+    values = np.empty(n, dtype=np.double)
+    _check_ierr(cea_input_deck_get_reactant_schedule(deck, i, j, which, n, <cea_real*>values.data),
+                "cea_input_deck_get_reactant_schedule")
+    _check_ierr(cea_input_deck_get_reactant_schedule_name_buf(deck, i, j, which, name, _INPUT_BUF_LEN),
+                "cea_input_deck_get_reactant_schedule_name_buf")
+    _check_ierr(cea_input_deck_get_reactant_schedule_units_buf(deck, i, j, which, units, _INPUT_BUF_LEN),
+                "cea_input_deck_get_reactant_schedule_units_buf")
+    return {"name": name.decode("utf-8"), "units": units.decode("utf-8"), "values": values}
+
+cdef list _input_deck_problems(cea_input_deck deck):
+    cdef cea_int num_problems, num_reactants, num_species, i, j, k
+    cdef char buf[_INPUT_BUF_LEN]
+    _check_ierr(cea_input_deck_get_num_problems(deck, &num_problems), "cea_input_deck_get_num_problems")
+    problems = []
+    for i in range(num_problems):
+        problem = {}
+        _check_ierr(cea_input_deck_get_problem_name_buf(deck, i, buf, _INPUT_BUF_LEN),
+                    "cea_input_deck_get_problem_name_buf")
+        problem["name"] = buf.decode("utf-8")
+        _check_ierr(cea_input_deck_get_problem_type_buf(deck, i, buf, _INPUT_BUF_LEN),
+                    "cea_input_deck_get_problem_type_buf")
+        problem["type"] = buf.decode("utf-8")
+
+        schedules = {}
+        for key, which in _INPUT_SCHEDULES:
+            sched = _input_schedule(deck, i, which)
+            if sched is not None:
+                schedules[key] = sched
+        problem["schedules"] = schedules
+
+        reactants = []
+        _check_ierr(cea_input_deck_get_num_reactants(deck, i, &num_reactants), "cea_input_deck_get_num_reactants")
+        for j in range(num_reactants):
+            reactant = {}
+            _check_ierr(cea_input_deck_get_reactant_type_buf(deck, i, j, buf, _INPUT_BUF_LEN),
+                        "cea_input_deck_get_reactant_type_buf")
+            reactant["type"] = buf.decode("utf-8")
+            _check_ierr(cea_input_deck_get_reactant_name_buf(deck, i, j, buf, _INPUT_BUF_LEN),
+                        "cea_input_deck_get_reactant_name_buf")
+            reactant["name"] = buf.decode("utf-8")
+            for key, which in _INPUT_REACTANT_SCHEDULES:
+                sched = _input_reactant_schedule(deck, i, j, which)
+                if sched is not None:
+                    reactant[key] = sched
+            reactants.append(reactant)
+        problem["reactants"] = reactants
+
+        for key, which in _INPUT_SPECIES_LISTS:
+            _check_ierr(cea_input_deck_get_num_species(deck, i, which, &num_species), "cea_input_deck_get_num_species")
+            names = []
+            for k in range(num_species):
+                _check_ierr(cea_input_deck_get_species_name_buf(deck, i, which, k, buf, _INPUT_BUF_LEN),
+                            "cea_input_deck_get_species_name_buf")
+                names.append(buf.decode("utf-8"))
+            problem[key] = names
+
+        problems.append(problem)
+    return problems
+
+def read_input(filename):
+    """
+    Parse every problem of a legacy CEA input file (.inp).
+
+    The file is read into one buffer and parsed in a single pass, without the
+    line-by-line I/O of the command line program. Malformed input aborts the
+    process with the same message as the command line program.
+
+    Parameters
+    ----------
+    filename : str or os.PathLike
+        Path to the input deck
+
+    Returns
+    -------
+    list of dict
+        One dict per problem with ``name``, ``type``, ``schedules``, ``reactants``,
+        ``only``, ``omit`` and ``insert``. ``schedules`` maps ``of``, ``t``, ``h``, ``u``,
+        ``s``, ``p``, ``v``, ``u1``, ``mach1``, ``pcp``, ``subar`` and ``supar`` to
+        ``{"name", "units", "values"}`` for the schedules the problem assigns; values keep
+        the deck's units. Each reactant dict has ``type`` (fu, ox or na), ``name`` and the
+        ``amount``, ``temperature``, ``enthalpy`` and ``density`` schedules it assigns.
+    """
+    cdef cea_input_deck deck = NULL
+    cdef _CString cfilename = _CString(os.fspath(filename), "read_input filename")
+    cdef cea_err ierr = cea_input_deck_create(&deck, cfilename.ptr)
+    if ierr == CEA_INVALID_FILENAME:
+        raise FileNotFoundError(f"Could not read input file: {os.fspath(filename)}")
+    _check_ierr(ierr, "cea_input_deck_create")
+    try:
+        return _input_deck_problems(deck)
+    finally:
+        cea_input_deck_destroy(&deck)
+
+def parse_input(text):
+    """
+    Parse every problem of a legacy CEA input deck held in memory.
+
+    Same as :func:`read_input` for the deck contents.
+
+    Parameters
+    ----------
+    text : str or bytes
+        Contents of the input deck
+
+    Returns
+    -------
+    list of dict
+        See :func:`read_input`
+    """
+    cdef cea_input_deck deck = NULL
+    cdef bytes data
+    if isinstance(text, str):
+        data = (<str>text).encode("utf-8")
+    elif isinstance(text, bytes):
+        data = <bytes>text
+    else:
+        raise TypeError(f"parse_input text must be str or bytes, not {type(text).__name__}")
+    _check_ierr(cea_input_deck_create_from_text(&deck, data, len(data)), "cea_input_deck_create_from_text")
+    try:
+        return _input_deck_problems(deck)
+    finally:
+        cea_input_deck_destroy(&deck)
+
+
 # ----------------
 # Matlab interface
 # ----------------
@@ -4,7 +4,7 @@ from libc.string cimport const_char
 # Import the python version information
 from cpython.version cimport PY_MAJOR_VERSION
 
-cdef extern from "cea.h":
+cdef extern from "cea.h" nogil:
     ctypedef enum cea_err:
         CEA_SUCCESS
         CEA_INVALID_FILENAME
@@ -14,6 +14,11 @@ cdef extern from "cea.h":
         CEA_INVALID_SIZE
         CEA_NOT_CONVERGED
 
+    ctypedef enum cea_profile_format:
+        CEA_PROFILE_TOTALS
+        CEA_PROFILE_COLLAPSED
+        CEA_PROFILE_CHROME_TRACE
+
     ctypedef enum cea_log_level:
         CEA_LOG_CRITICAL
         CEA_LOG_ERROR
@@ -61,6 +66,26 @@ cdef extern from "cea.h":
     ctypedef enum cea_eqderiv_matrix:
         CEA_DERIV_DNJ_DW0
 
+    ctypedef enum cea_eqderiv_output:
+        CEA_DERIV_OUT_T
+        CEA_DERIV_OUT_N
+        CEA_DERIV_OUT_NJ
+        CEA_DERIV_OUT_H
+        CEA_DERIV_OUT_U
+        CEA_DERIV_OUT_G
+        CEA_DERIV_OUT_S
+        CEA_DERIV_WRT_STATE1
+        CEA_DERIV_WRT_STATE2
+        CEA_DERIV_WRT_W0
+        CEA_DERIV_OUT_ALL
+
+    ctypedef enum cea_solver_output:
+        CEA_OUTPUT_PROPERTIES
+        CEA_OUTPUT_PARTIALS
+        CEA_OUTPUT_TRANSPORT
+        CEA_OUTPUT_PERFORMANCE
+        CEA_OUTPUT_ALL
+
     ctypedef enum cea_equilibrium_size:
         CEA_NUM_REACTANTS
         CEA_NUM_PRODUCTS
@@ -189,12 +214,38 @@ cdef extern from "cea.h":
         CEA_DETONATION_FROZEN_PRANDTL
         CEA_DETONATION_EQUILIBRIUM_PRANDTL
 
+    ctypedef enum cea_input_schedule:
+        CEA_INPUT_OF
+        CEA_INPUT_T
+        CEA_INPUT_H
+        CEA_INPUT_U
+        CEA_INPUT_S
+        CEA_INPUT_P
+        CEA_INPUT_V
+        CEA_INPUT_U1
+        CEA_INPUT_MACH1
+        CEA_INPUT_PCP
+        CEA_INPUT_SUBAR
+        CEA_INPUT_SUPAR
+
+    ctypedef enum cea_input_reactant_schedule:
+        CEA_INPUT_REACTANT_AMOUNT
+        CEA_INPUT_REACTANT_TEMPERATURE
+        CEA_INPUT_REACTANT_ENTHALPY
+        CEA_INPUT_REACTANT_DENSITY
+
+    ctypedef enum cea_input_species_list:
+        CEA_INPUT_ONLY
+        CEA_INPUT_OMIT
+        CEA_INPUT_INSERT
+
     # Typdefs
     ctypedef int cea_int
     ctypedef double cea_real
     ctypedef const char* cea_string
     ctypedef double* cea_array
     ctypedef unsigned char cea_bool
+    ctypedef unsigned char cea_bool_array "bool"
 
     ctypedef struct cea_mixture_t
     ctypedef cea_mixture_t* cea_mixture
@@ -229,6 +280,9 @@ cdef extern from "cea.h":
     ctypedef struct cea_detonation_solution_t
     ctypedef cea_detonation_solution_t* cea_detonation_solution
 
+    ctypedef struct cea_input_deck_t
+    ctypedef cea_input_deck_t* cea_input_deck
+
     ctypedef struct cea_reactant_input:
         cea_string name
         cea_int num_elements
@@ -242,6 +296,9 @@ cdef extern from "cea.h":
         cea_bool has_temperature
         cea_real temperature
         cea_string temperature_units
+        cea_bool has_id
+        cea_int id
+        const cea_int* element_ids
 
     ctypedef struct cea_solver_opts:
         cea_real trace
@@ -252,6 +309,8 @@ cdef extern from "cea.h":
         const cea_string* insert
         cea_bool smooth_truncation
         cea_real truncation_width
+        const cea_int* insert_ids
+        cea_int outputs
 
     cpdef cea_err cea_solver_opts_init(cea_solver_opts *opts)
     cpdef cea_err cea_species_name_len(cea_int *name_len)
@@ -262,12 +321,33 @@ cdef extern from "cea.h":
     cpdef cea_err cea_version_patch(cea_int *patch)
     cpdef cea_err cea_set_log_level(const cea_log_level level)
 
+    # Log capture
+    enum: CEA_LOG_CAPTURE_MAX_RECORDS
+    enum: CEA_LOG_CAPTURE_RECORD_LEN
+    cpdef cea_err cea_log_capture_start(const cea_int max_records)
+    cpdef cea_err cea_log_capture_stop()
+    cpdef cea_err cea_log_capture_get_count(cea_int *count)
+    cpdef cea_err cea_log_capture_get_dropped(cea_int *dropped)
+    cpdef cea_err cea_log_capture_get_record_buf(const cea_int i, cea_log_level *level, char *message, const cea_int buf_len)
+    cpdef cea_err cea_log_capture_clear()
+
+    # Profiling
+    cea_err cea_set_profiling(const cea_bool enabled)
+
     # Initialization
     cpdef cea_err cea_init()
     cpdef cea_err cea_init_thermo(const cea_string thermofile)
     cpdef cea_err cea_init_trans(const cea_string transfile)
     cpdef cea_err cea_is_initialized(cea_int *initialized)
 
+    # Species and element IDs
+    cpdef cea_err cea_num_species_ids(cea_int *num_ids)
+    cpdef cea_err cea_num_element_ids(cea_int *num_ids)
+    cpdef cea_err cea_species_ids(const cea_int n, const cea_string names[], cea_int ids[])
+    cpdef cea_err cea_element_ids(const cea_int n, const cea_string names[], cea_int ids[])
+    cpdef cea_err cea_species_id_name_buf(const cea_int id, char *name, const cea_int buf_len)
+    cpdef cea_err cea_element_id_name_buf(const cea_int id, char *name, const cea_int buf_len)
+
     # Mixture
     cpdef cea_err cea_mixture_create(cea_mixture *mix, const cea_int nspecies, const cea_string species[])
     cpdef cea_err cea_mixture_create_w_ions(cea_mixture *mix, const cea_int nspecies, const cea_string species[])
@@ -285,8 +365,18 @@ cdef extern from "cea.h":
     cpdef cea_err cea_mixture_create_products_from_input_reactants_w_ions(cea_mixture *mix, const cea_int nreactants,
                                                                           const cea_reactant_input reactants[],
                                                                           const cea_int nomit, const cea_string omit[])
+    cpdef cea_err cea_mixture_create_by_ids(cea_mixture *mix, const cea_int nspecies, const cea_int species_ids[])
+    cpdef cea_err cea_mixture_create_by_ids_w_ions(cea_mixture *mix, const cea_int nspecies, const cea_int species_ids[])
+    cpdef cea_err cea_mixture_create_from_reactant_ids(cea_mixture *mix, const cea_int nreac, const cea_int reactant_ids[],
+                                                       const cea_int nomit, const cea_int omit_ids[])
+    cpdef cea_err cea_mixture_create_from_reactant_ids_w_ions(cea_mixture *mix, const cea_int nreac,
+                                                              const cea_int reactant_ids[],
+                                                              const cea_int nomit, const cea_int omit_ids[])
     cpdef cea_err cea_mixture_destroy(cea_mixture *mix)
     cpdef cea_err cea_mixture_get_num_species(const cea_mixture mix, cea_int *num_species)
+    cpdef cea_err cea_mixture_get_num_elements(const cea_mixture mix, cea_int *num_elements)
+    cpdef cea_err cea_mixture_get_species_ids(const cea_mixture mix, const cea_int nspecies, cea_int ids[])
+    cpdef cea_err cea_mixture_get_element_ids(const cea_mixture mix, const cea_int nelements, cea_int ids[])
     cpdef cea_err cea_mixture_get_species_name(const cea_mixture *mix, const cea_int i_species, cea_string *species)
     cpdef cea_err cea_mixture_get_species_names(const cea_mixture *mix, const cea_int nspecies, cea_string *species[])
     cpdef cea_err cea_mixture_get_species_name_buf(const cea_mixture *mix, const cea_int i_species, char *species,
@@ -323,11 +413,18 @@ cdef extern from "cea.h":
                                                      const cea_mixture reactants)
     cpdef cea_err cea_eqsolver_create_with_options(cea_eqsolver *solver, const cea_mixture products,
                                                    const cea_solver_opts opts)
+    cpdef cea_err cea_eqsolver_clone(cea_eqsolver *clone, const cea_eqsolver solver)
+    cpdef cea_err cea_eqsolver_write_profile(const cea_eqsolver solver, const cea_profile_format format, const cea_string filename)
     cpdef cea_err cea_eqsolver_destroy(cea_eqsolver *solver)
     cpdef cea_err cea_eqsolver_solve(const cea_eqsolver solver, const cea_equilibrium_type eq_type,
         const cea_real state1, const cea_real state2, const cea_array amounts, cea_eqsolution soln)
     cpdef cea_err cea_eqsolver_solve_with_partials(const cea_eqsolver solver, const cea_equilibrium_type eq_type,
         const cea_real state1, const cea_real state2, const cea_array amounts, cea_eqsolution soln, cea_eqpartials partials)
+    cpdef cea_err cea_eqsolver_solve_batch(const cea_eqsolver solver, const cea_equilibrium_type eq_type,
+        const cea_int npts, const cea_int num_state1, const cea_real state1[], const cea_int num_state2,
+        const cea_real state2[], const cea_int num_amounts, const cea_real amounts[], cea_eqsolution soln,
+        cea_eqpartials partials, const cea_int nprops, const cea_property_type prop_types[], cea_real prop_values[],
+        cea_bool_array converged[], cea_real species[], const cea_bool mass_fractions, cea_int *num_failed)
     cpdef cea_err cea_eqsolver_get_size(const cea_eqsolver solver, const cea_equilibrium_size eq_variable,
         cea_int *value)
 
@@ -336,6 +433,8 @@ cdef extern from "cea.h":
     cpdef cea_err cea_eqsolution_destroy(cea_eqsolution *solution)
     cpdef cea_err cea_eqsolution_get_property(const cea_eqsolution solution, const cea_property_type type,
                                               cea_real *value)
+    cpdef cea_err cea_eqsolution_get_properties(const cea_eqsolution solution, const cea_int nprops,
+                                                const cea_property_type types[], cea_real values[])
     cpdef cea_err cea_eqsolution_get_weights(const cea_eqsolution solution, const cea_int np,
                                              cea_real weights[], const cea_bool log)
     cpdef cea_err cea_eqsolution_set_T(const cea_eqsolution solution, const cea_real T)
@@ -353,6 +452,8 @@ cdef extern from "cea.h":
     # Equilibrium Derivatives
     cpdef cea_err cea_eqderivatives_create(cea_eqderivatives *derivs, const cea_eqsolver solver,
                                            const cea_eqsolution soln)
+    cpdef cea_err cea_eqderivatives_create_with_outputs(cea_eqderivatives *derivs, const cea_eqsolver solver,
+                                                        const cea_eqsolution soln, const cea_int outputs)
     cpdef cea_err cea_eqderivatives_destroy(cea_eqderivatives *derivs)
     cpdef cea_err cea_eqderivatives_compute_derivatives(const cea_eqderivatives derivs, const cea_eqsolver solver,
                                                         const cea_eqsolution soln, const cea_bool check_closure_defect)
@@ -375,6 +476,8 @@ cdef extern from "cea.h":
                                                           const cea_mixture reactants)
     cpdef cea_err cea_rocket_solver_create_with_options(cea_rocket_solver *solver, const cea_mixture products,
                                                         const cea_solver_opts opts)
+    cpdef cea_err cea_rocket_solver_clone(cea_rocket_solver *clone, const cea_rocket_solver solver)
+    cpdef cea_err cea_rocket_solver_write_profile(const cea_rocket_solver solver, const cea_profile_format format, const cea_string filename)
     cpdef cea_err cea_rocket_solver_destroy(cea_rocket_solver *solver)
     # pi_p is optional when n_pi_p == 0.
     cpdef cea_err cea_rocket_solver_solve_iac(const cea_rocket_solver solver, cea_rocket_solution soln,
@@ -401,11 +504,17 @@ cdef extern from "cea.h":
     cpdef cea_err cea_rocket_solution_get_property(const cea_rocket_solution solution,
                                                    const cea_rocket_property_type type, const cea_int len,
                                                    cea_real value[])
+    cpdef cea_err cea_rocket_solution_get_properties(const cea_rocket_solution solution, const cea_int nprops,
+                                                     const cea_rocket_property_type types[], const cea_int len,
+                                                     cea_real values[])
     cpdef cea_err cea_rocket_solution_get_weights(const cea_rocket_solution solution, const cea_int np,
                                                   const cea_int station, cea_real weights[], const cea_bool log)
     cpdef cea_err cea_rocket_solution_get_species_amounts(const cea_rocket_solution solution, const cea_int np,
                                                           const cea_int station, cea_real amounts[],
                                                           const cea_bool mass)
+    cpdef cea_err cea_rocket_solution_get_all_species_amounts(const cea_rocket_solution solution, const cea_int np,
+                                                              const cea_int len, cea_real amounts[],
+                                                              const cea_bool mass)
     cpdef cea_err cea_rocket_solution_get_moles(const cea_rocket_solution solution, cea_real *value)
     cpdef cea_err cea_rocket_solution_get_converged(const cea_rocket_solution solution, bint *converged)
     # cpdef cea_err cea_rocket_solution_get_eq_solutions(const cea_rocket_solution solution, cea_int npts,
@@ -419,6 +528,8 @@ cdef extern from "cea.h":
                                                          const cea_mixture reactants)
     cpdef cea_err cea_shock_solver_create_with_options(cea_shock_solver *solver, const cea_mixture products,
                                                        const cea_solver_opts options)
+    cpdef cea_err cea_shock_solver_clone(cea_shock_solver *clone, const cea_shock_solver solver)
+    cpdef cea_err cea_shock_solver_write_profile(const cea_shock_solver solver, const cea_profile_format format, const cea_string filename)
     cpdef cea_err cea_shock_solver_destroy(cea_shock_solver *solver)
     cpdef cea_err cea_shock_solver_get_size(const cea_shock_solver solver, const cea_equilibrium_size eq_variable,
                                             cea_int *value)
@@ -435,11 +546,17 @@ cdef extern from "cea.h":
     cpdef cea_err cea_shock_solution_get_property(const cea_shock_solution solution,
                                                   const cea_shock_property_type type, const cea_int len,
                                                   cea_real value[])
+    cpdef cea_err cea_shock_solution_get_properties(const cea_shock_solution solution, const cea_int nprops,
+                                                    const cea_shock_property_type types[], const cea_int len,
+                                                    cea_real values[])
     cpdef cea_err cea_shock_solution_get_weights(const cea_shock_solution solution, const cea_int np,
                                                  const cea_int station, cea_real weights[], const cea_bool log)
     cpdef cea_err cea_shock_solution_get_species_amounts(const cea_shock_solution solution, const cea_int np,
                                                          const cea_int station, cea_real amounts[],
                                                          const cea_bool mass)
+    cpdef cea_err cea_shock_solution_get_all_species_amounts(const cea_shock_solution solution, const cea_int np,
+                                                             const cea_int len, cea_real amounts[],
+                                                             const cea_bool mass)
     cpdef cea_err cea_shock_solution_get_moles(const cea_shock_solution solution, cea_real *value)
     cpdef cea_err cea_shock_solution_get_converged(const cea_shock_solution solution, bint *converged)
 
@@ -449,6 +566,8 @@ cdef extern from "cea.h":
                                                               const cea_mixture reactants)
     cpdef cea_err cea_detonation_solver_create_with_options(cea_detonation_solver *solver, const cea_mixture products,
                                                             const cea_solver_opts options)
+    cpdef cea_err cea_detonation_solver_clone(cea_detonation_solver *clone, const cea_detonation_solver solver)
+    cpdef cea_err cea_detonation_solver_write_profile(const cea_detonation_solver solver, const cea_profile_format format, const cea_string filename)
     cpdef cea_err cea_detonation_solver_destroy(cea_detonation_solver *solver)
     cpdef cea_err cea_detonation_solver_get_size(const cea_detonation_solver solver, const cea_equilibrium_size eq_variable,
                                                  cea_int *value)
@@ -468,3 +587,54 @@ cdef extern from "cea.h":
     cpdef cea_err cea_detonation_solution_get_property(const cea_detonation_solution solution,
                                                        const cea_detonation_property_type type, const cea_int len,
                                                        cea_real *value)
+    cpdef cea_err cea_detonation_solution_get_properties(const cea_detonation_solution solution,
+                                                         const cea_int nprops,
+                                                         const cea_detonation_property_type types[],
+                                                         cea_real values[])
+
+    # Input Deck
+    cpdef cea_err cea_input_deck_create(cea_input_deck *deck, const cea_string filename)
+    cpdef cea_err cea_input_deck_create_from_text(cea_input_deck *deck, const char *text, const cea_int len)
+    cpdef cea_err cea_input_deck_destroy(cea_input_deck *deck)
+    cpdef cea_err cea_input_deck_get_num_problems(const cea_input_deck deck, cea_int *num_problems)
+    cpdef cea_err cea_input_deck_get_problem_name_buf(const cea_input_deck deck, const cea_int problem, char *name,
+                                                      const cea_int buf_len)
+    cpdef cea_err cea_input_deck_get_problem_type_buf(const cea_input_deck deck, const cea_int problem, char *type,
+                                                      const cea_int buf_len)
+    cpdef cea_err cea_input_deck_get_schedule_size(const cea_input_deck deck, const cea_int problem,
+                                                   const cea_input_schedule which, cea_int *num_values)
+    cpdef cea_err cea_input_deck_get_schedule(const cea_input_deck deck, const cea_int problem,
+                                              const cea_input_schedule which, const cea_int len, cea_real values[])
+    cpdef cea_err cea_input_deck_get_schedule_name_buf(const cea_input_deck deck, const cea_int problem,
+                                                       const cea_input_schedule which, char *name,
+                                                       const cea_int buf_len)
+    cpdef cea_err cea_input_deck_get_schedule_units_buf(const cea_input_deck deck, const cea_int problem,
+                                                        const cea_input_schedule which, char *units,
+                                                        const cea_int buf_len)
+    cpdef cea_err cea_input_deck_get_num_reactants(const cea_input_deck deck, const cea_int problem,
+                                                   cea_int *num_reactants)
+    cpdef cea_err cea_input_deck_get_reactant_name_buf(const cea_input_deck deck, const cea_int problem,
+                                                       const cea_int reactant, char *name, const cea_int buf_len)
+    cpdef cea_err cea_input_deck_get_reactant_type_buf(const cea_input_deck deck, const cea_int problem,
+                                                       const cea_int reactant, char *type, const cea_int buf_len)
+    cpdef cea_err cea_input_deck_get_reactant_schedule_size(const cea_input_deck deck, const cea_int problem,
+                                                            const cea_int reactant,
+                                                            const cea_input_reactant_schedule which,
+                                                            cea_int *num_values)
+    cpdef cea_err cea_input_deck_get_reactant_schedule(const cea_input_deck deck, const cea_int problem,
+                                                       const cea_int reactant,
+                                                       const cea_input_reactant_schedule which, const cea_int len,
+                                                       cea_real values[])
+    cpdef cea_err cea_input_deck_get_reactant_schedule_name_buf(const cea_input_deck deck, const cea_int problem,
+                                                                const cea_int reactant,
+                                                                const cea_input_reactant_schedule which,
+                                                                char *name, const cea_int buf_len)
+    cpdef cea_err cea_input_deck_get_reactant_schedule_units_buf(const cea_input_deck deck, const cea_int problem,
+                                                                 const cea_int reactant,
+                                                                 const cea_input_reactant_schedule which,
+                                                                 char *units, const cea_int buf_len)
+    cpdef cea_err cea_input_deck_get_num_species(const cea_input_deck deck, const cea_int problem,
+                                                 const cea_input_species_list which, cea_int *num_species)
+    cpdef cea_err cea_input_deck_get_species_name_buf(const cea_input_deck deck, const cea_int problem,
+                                                      const cea_input_species_list which, const cea_int i_species,
+                                                      char *name, const cea_int buf_len)
@@ -0,0 +1,65 @@
+import numpy as np
+import pytest
+
+import cea
+
+
+def _h2o2_solver(**kwargs):
+    reac = cea.Mixture(["H2", "O2"])
+    prod = cea.Mixture(["H", "H2", "H2O", "O", "O2", "OH"])
+    weights = reac.of_ratio_to_weights(np.array((0.0, 1.0)), np.array((1.0, 0.0)), 6.0)
+    return cea.EqSolver(prod, reactants=reac, **kwargs), weights
+
+
+def test_eq_solve_batch_matches_scalar_solve():
+    solver, weights = _h2o2_solver()
+    temps = np.linspace(1500.0, 3500.0, 9)
+    pressures = np.array([1.0, 10.0, 100.0])[np.arange(temps.size) % 3]
+    props = (cea.TEMPERATURE, cea.DENSITY, cea.ENTHALPY, cea.GAMMA_S)
+
+    soln = cea.EqSolution(solver)
+    species = np.empty((temps.size, solver.num_products))
+    converged = np.zeros(temps.size, dtype=bool)
+    out = solver.solve_batch(soln, cea.TP, temps, pressures, weights, props=props,
+                             species=species, converged=converged)
+    assert out.shape == (temps.size, len(props))
+    assert converged.all()
+    assert soln.last_error == cea.SUCCESS
+
+    for i, (t, p) in enumerate(zip(temps, pressures)):
+        ref = cea.EqSolution(solver)
+        solver.solve(ref, cea.TP, t, p, weights)
+        assert out[i, 0] == pytest.approx(ref.T, rel=1.0e-8)
+        assert out[i, 1] == pytest.approx(ref.density, rel=1.0e-6)
+        assert out[i, 2] == pytest.approx(ref.enthalpy, rel=1.0e-6, abs=1.0e-6)
+        assert out[i, 3] == pytest.approx(ref.gamma_s, rel=1.0e-6)
+        ref_x = np.array(list(ref.mole_fractions.values()))
+        assert np.allclose(species[i], ref_x, rtol=1.0e-6, atol=1.0e-12)
+
+
+def test_eq_solve_batch_fills_preallocated_output():
+    solver, weights = _h2o2_solver()
+    soln = cea.EqSolution(solver)
+
+    # Per-point weights, a scalar pressure, and a strided output view
+    amounts = np.tile(weights, (4, 1))
+    buf = np.zeros((4, 4))
+    view = buf[:, ::2]
+    result = solver.solve_batch(soln, cea.TP, [2000.0, 2500.0, 3000.0, 3500.0], 10.0, amounts,
+                                props=(cea.TEMPERATURE, cea.PRESSURE), out=view)
+    assert result is view
+    assert np.allclose(buf[:, 0], [2000.0, 2500.0, 3000.0, 3500.0])
+    assert np.allclose(buf[:, 2], 10.0)
+    assert np.all(buf[:, 1::2] == 0.0)
+
+
+def test_eq_solve_batch_rejects_bad_shapes():
+    solver, weights = _h2o2_solver()
+    soln = cea.EqSolution(solver)
+
+    with pytest.raises(ValueError):
+        solver.solve_batch(soln, cea.TP, [2000.0, 3000.0], 1.0, np.tile(weights, (3, 1)))
+    with pytest.raises(ValueError):
+        solver.solve_batch(soln, cea.TP, [2000.0, 3000.0], 1.0, weights, out=np.empty((3, 1)))
+    with pytest.raises(ValueError):
+        solver.solve_batch(soln, cea.TP, 2000.0, 1.0, weights[:1])
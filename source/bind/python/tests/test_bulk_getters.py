@@ -0,0 +1,101 @@
+import numpy as np
+import pytest
+
+import cea
+
+
+def _h2o2():
+    reac = cea.Mixture(["H2", "O2"])
+    prod = cea.Mixture(["H2", "O2"], products_from_reactants=True)
+    weights = reac.moles_to_weights(np.array([2.0, 1.0]))
+    return reac, prod, weights
+
+
+def test_eqsolution_get_properties():
+    reac, prod, weights = _h2o2()
+    solver = cea.EqSolver(prod, reactants=reac)
+    soln = cea.EqSolution(solver)
+    solver.solve(soln, cea.TP, 3000.0, 10.0, weights)
+
+    vals = soln.get_properties([cea.TEMPERATURE, cea.PRESSURE, cea.ENTHALPY, cea.GAMMA_S])
+    assert vals == pytest.approx([soln.T, soln.P, soln.enthalpy, soln.gamma_s])
+    assert soln.get_properties([]).shape == (0,)
+
+    with pytest.raises(RuntimeError):
+        soln.get_properties([cea.TEMPERATURE, 999])
+
+
+def test_rocket_solution_get_properties_and_species():
+    reac, prod, weights = _h2o2()
+    solver = cea.RocketSolver(prod, reactants=reac)
+    soln = cea.RocketSolution(solver)
+    solver.solve(soln, weights, pc=10.0, pi_p=[2.0, 10.0], tc=3000.0)
+
+    vals = soln.get_properties([cea.ROCKET_TEMPERATURE, cea.MACH])
+    assert vals.shape == (2, soln.num_pts)
+    assert np.allclose(vals[0], soln.T)
+    assert np.allclose(vals[1], soln.Mach)
+
+    x = soln.mole_fractions
+    for i, name in enumerate(prod.species_names):
+        assert x[name].shape == (soln.num_pts,)
+    total = np.sum([x[name] for name in prod.species_names], axis=0)
+    assert np.allclose(total, 1.0)
+
+
+def test_shock_and_detonation_get_properties():
+    reac, prod, weights = _h2o2()
+
+    shock = cea.ShockSolver(prod, reactants=reac)
+    ssoln = cea.ShockSolution(shock, reflected=True)
+    shock.solve(ssoln, weights, 300.0, 0.1, u1=2000.0, reflected=True)
+    vals = ssoln.get_properties([cea.SHOCK_TEMPERATURE, cea.SHOCK_PRESSURE])
+    assert vals.shape == (2, len(ssoln.T))
+    assert np.allclose(vals[0], ssoln.T)
+    assert np.allclose(vals[1], ssoln.P)
+
+    deton = cea.DetonationSolver(prod, reactants=reac)
+    dsoln = cea.DetonationSolution(deton)
+    deton.solve(dsoln, weights, T1=298.15, p1=1.0)
+    vals = dsoln.get_properties([cea.DETONATION_TEMPERATURE, cea.DETONATION_VELOCITY])
+    assert vals == pytest.approx([dsoln.T, dsoln.velocity])
+
+
+def test_deferred_outputs_match_eager():
+    reac, prod, weights = _h2o2()
+    props = [cea.TEMPERATURE, cea.ENTHALPY, cea.GAMMA_S, cea.VISCOSITY, cea.FROZEN_CONDUCTIVITY]
+
+    values = []
+    for outputs in (cea.OUTPUT_ALL, 0):
+        solver = cea.EqSolver(prod, reactants=reac, transport=True, outputs=outputs)
+        soln = cea.EqSolution(solver)
+        solver.solve(soln, cea.TP, 3000.0, 10.0, weights)
+        values.append(soln.get_properties(props))
+    assert values[1] == pytest.approx(values[0], rel=1e-12)
+
+    values = []
+    for outputs in (cea.OUTPUT_ALL, cea.OUTPUT_PROPERTIES):
+        solver = cea.RocketSolver(prod, reactants=reac, transport=True, outputs=outputs)
+        soln = cea.RocketSolution(solver)
+        solver.solve(soln, weights, pc=10.0, pi_p=[2.0, 10.0], tc=3000.0)
+        values.append(np.concatenate([soln.Isp, soln.viscosity]))
+    assert values[1] == pytest.approx(values[0], rel=1e-10)
+
+
+def test_solution_outputs_outlive_solver():
+    reac, prod, weights = _h2o2()
+    props = [cea.ENTHALPY, cea.GAMMA_S, cea.VISCOSITY]
+
+    eager = cea.EqSolver(prod, reactants=reac, transport=True)
+    soln = cea.EqSolution(eager)
+    eager.solve(soln, cea.TP, 3000.0, 10.0, weights)
+    expected = soln.get_properties(props)
+
+    # Outputs left out of the mask are finished when solve returns, so later solves
+    # with the same solver and its release do not touch the solution
+    solver = cea.EqSolver(prod, reactants=reac, transport=True, outputs=0)
+    soln = cea.EqSolution(solver)
+    solver.solve(soln, cea.TP, 3000.0, 10.0, weights)
+    solver.solve(cea.EqSolution(solver), cea.TP, 1500.0, 1.0, weights)
+    del solver
+    assert soln.get_properties(props) == pytest.approx(expected, rel=1e-12)
@@ -0,0 +1,76 @@
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+import pytest
+
+import cea
+
+
+def _h2o2():
+    reac = cea.Mixture(["H2", "O2"])
+    prod = cea.Mixture(["H", "H2", "H2O", "O", "O2", "OH"])
+    weights = reac.of_ratio_to_weights(np.array((0.0, 1.0)), np.array((1.0, 0.0)), 6.0)
+    return reac, prod, weights
+
+
+def test_eqsolver_clone_matches_original():
+    reac, prod, weights = _h2o2()
+    solver = cea.EqSolver(prod, reactants=reac, trace=1.0e-10)
+    clone = solver.clone()
+    assert clone is not solver
+    assert clone.num_products == solver.num_products
+    assert clone.num_reactants == solver.num_reactants
+
+    a = cea.EqSolution(solver)
+    b = cea.EqSolution(clone)
+    solver.solve(a, cea.HP, 0.0, 10.0, weights)
+    clone.solve(b, cea.HP, 0.0, 10.0, weights)
+    assert b.T == a.T
+    assert b.n == a.n
+
+    # The clone outlives the original
+    del solver, a
+    clone.solve(b, cea.TP, 3000.0, 10.0, weights)
+    assert b.converged
+
+
+def test_eqsolver_clones_in_threads():
+    reac, prod, weights = _h2o2()
+    solver = cea.EqSolver(prod, reactants=reac)
+    chunks = np.array_split(np.linspace(1500.0, 3500.0, 64), 4)
+
+    def work(chunk):
+        clone = solver.clone()
+        return clone.solve_batch(cea.EqSolution(clone), cea.TP, chunk, 10.0, weights)[:, 0]
+
+    with ThreadPoolExecutor(max_workers=4) as pool:
+        out = np.concatenate(list(pool.map(work, chunks)))
+    assert out == pytest.approx(np.concatenate(chunks))
+
+
+def test_rocket_shock_detonation_clone():
+    reac, prod, weights = _h2o2()
+
+    rocket = cea.RocketSolver(prod, reactants=reac)
+    rclone = rocket.clone()
+    a, b = cea.RocketSolution(rocket), cea.RocketSolution(rclone)
+    rocket.solve(a, weights, pc=10.0, pi_p=[10.0], tc=3000.0)
+    rclone.solve(b, weights, pc=10.0, pi_p=[10.0], tc=3000.0)
+    assert np.array_equal(a.T, b.T)
+    del rocket, a
+    rclone.solve(b, weights, pc=20.0, pi_p=[10.0], tc=3000.0)
+    assert b.converged
+
+    shock = cea.ShockSolver(prod, reactants=reac)
+    sclone = shock.clone()
+    a, b = cea.ShockSolution(shock), cea.ShockSolution(sclone)
+    shock.solve(a, weights, 300.0, 0.1, u1=2000.0)
+    sclone.solve(b, weights, 300.0, 0.1, u1=2000.0)
+    assert np.array_equal(a.T, b.T)
+
+    deton = cea.DetonationSolver(prod, reactants=reac)
+    dclone = deton.clone()
+    a, b = cea.DetonationSolution(deton), cea.DetonationSolution(dclone)
+    deton.solve(a, weights, T1=298.15, p1=1.0)
+    dclone.solve(b, weights, T1=298.15, p1=1.0)
+    assert a.velocity == b.velocity
@@ -0,0 +1,24 @@
+import numpy as np
+import pytest
+
+import cea
+
+
+def test_selected_derivatives_match_full():
+    reac = cea.Mixture(["H2", "O2"])
+    prod = cea.Mixture(["H", "H2", "H2O", "O", "O2", "OH"])
+    weights = reac.of_ratio_to_weights(np.array((0.0, 1.0)), np.array((1.0, 0.0)), 6.0)
+    solver = cea.EqSolver(prod, reactants=reac)
+    soln = cea.EqSolution(solver)
+    solver.solve(soln, cea.HP, 0.0, 10.0, weights)
+
+    full = cea.EqDerivatives(solver, soln)
+    full.compute_derivatives()
+    sel = cea.EqDerivatives(solver, soln, outputs=cea.DERIV_OUT_T | cea.DERIV_OUT_H | cea.DERIV_WRT_W0)
+    sel.compute_derivatives()
+
+    assert np.array_equal(sel.dT_dw0, full.dT_dw0)
+    assert np.array_equal(sel.dH_dw0, full.dH_dw0)
+    for name in ("dT_dstate1", "dnj_dw0", "dS_dw0"):
+        with pytest.raises(RuntimeError):
+            getattr(sel, name)
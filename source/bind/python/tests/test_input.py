@@ -0,0 +1,55 @@
+import numpy as np
+import pytest
+
+import cea
+
+DECK = """\
+# two problems
+prob case=first tp p,bar=1,10
+  ! comment inside a dataset
+  t,k=3000 2500
+reac name=H2 moles=2 name=O2 moles=1
+outp massf
+end
+
+prob case=second hp o/f=6 p,atm=1
+reac fuel=H2 wt%=100 t,k=298.15
+     oxid=O2 wt%=100 t,k=90
+only H2 O2 H2O OH
+end
+"""
+
+
+def test_parse_input():
+    problems = cea.parse_input(DECK)
+    assert [p["name"] for p in problems] == ["first", "second"]
+    assert [p["type"] for p in problems] == ["tp", "hp"]
+
+    first = problems[0]
+    assert first["schedules"]["p"]["units"] == "bar"
+    assert np.array_equal(first["schedules"]["t"]["values"], [3000.0, 2500.0])
+    assert "of" not in first["schedules"]
+    assert [r["name"] for r in first["reactants"]] == ["H2", "O2"]
+    assert first["reactants"][0]["amount"]["name"] == "mole_frac"
+    assert first["only"] == []
+
+    second = problems[1]
+    assert second["schedules"]["of"]["name"] == "o/f"
+    assert [r["type"] for r in second["reactants"]] == ["fu", "ox"]
+    assert second["reactants"][1]["temperature"]["values"][0] == pytest.approx(90.0)
+    assert second["only"] == ["H2", "O2", "H2O", "OH"]
+
+    assert cea.parse_input(b"# empty deck\n") == []
+
+
+def test_read_input_long_schedule(tmp_path):
+    temps = 500.0 + 10.0 * np.arange(400)
+    path = tmp_path / "long.inp"
+    path.write_text("prob tp p=1 t=" + ",".join(f"{t:g}" for t in temps)
+                    + "\r\nreac name=H2 moles=1\r\nend\r\n")
+    problems = cea.read_input(path)
+    assert len(problems) == 1
+    assert np.array_equal(problems[0]["schedules"]["t"]["values"], temps)
+
+    with pytest.raises(FileNotFoundError):
+        cea.read_input(tmp_path / "missing.inp")
@@ -0,0 +1,67 @@
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+import pytest
+
+import cea
+
+
+def _h2o2():
+    reac = cea.Mixture(["H2", "O2"])
+    prod = cea.Mixture(["H", "H2", "H2O", "O", "O2", "OH"])
+    weights = reac.of_ratio_to_weights(np.array((0.0, 1.0)), np.array((1.0, 0.0)), 6.0)
+    return cea.EqSolver(prod, reactants=reac), weights
+
+
+@pytest.fixture
+def capture():
+    cea.start_log_capture(8)
+    try:
+        yield
+    finally:
+        cea.stop_log_capture()
+        cea.set_log_level(cea.LOG_WARNING)
+
+
+def test_log_capture_keeps_latest_records(capture, capfd):
+    solver, weights = _h2o2()
+    soln = cea.EqSolution(solver)
+    cea.set_log_level(cea.LOG_DEBUG)
+    for t in (2000.0, 2500.0, 3000.0, 3500.0, 4000.0):
+        solver.solve(soln, cea.TP, t, 10.0, weights)
+    cea.set_log_level(cea.LOG_WARNING)
+
+    records = cea.get_log_records(clear=True)
+    assert len(records) == 8
+    assert all(level >= cea.LOG_DEBUG for level, _ in records)
+    assert any(msg == "Starting Eq. Solve." for _, msg in records)
+    assert "Starting Eq. Solve." not in capfd.readouterr().out
+    assert cea.get_log_records() == []
+
+
+def test_log_level_none_captures_nothing(capture):
+    solver, weights = _h2o2()
+    cea.set_log_level(cea.LOG_NONE)
+    solver.solve(cea.EqSolution(solver), cea.TP, 3000.0, 10.0, weights)
+    assert cea.get_log_records() == []
+
+
+def test_log_capture_is_per_thread(capture):
+    cea.set_log_level(cea.LOG_DEBUG)
+
+    def work(n):
+        solver, weights = _h2o2()
+        soln = cea.EqSolution(solver)
+        for _ in range(n):
+            solver.solve(soln, cea.TP, 3000.0, 10.0, weights)
+        return [msg for _, msg in cea.get_log_records(clear=True)].count("Starting Eq. Solve.")
+
+    with ThreadPoolExecutor(max_workers=2) as pool:
+        counts = list(pool.map(work, (1, 2)))
+    assert counts == [1, 2]
+    assert cea.get_log_records() == []
+
+
+def test_log_capture_rejects_bad_size():
+    with pytest.raises(ValueError):
+        cea.start_log_capture(0)
@@ -0,0 +1,37 @@
+import json
+
+import numpy as np
+
+import cea
+
+
+def test_solver_profile_exports(tmp_path):
+    reac = cea.Mixture(["H2", "O2"])
+    prod = cea.Mixture(["H2", "O2"], products_from_reactants=True)
+    weights = reac.moles_to_weights(np.array([2.0, 1.0]))
+
+    unprofiled = cea.RocketSolver(prod, reactants=reac)
+    cea.set_profiling(True)
+    try:
+        solver = cea.RocketSolver(prod, reactants=reac)
+    finally:
+        cea.set_profiling(False)
+    for s in (solver, unprofiled):
+        s.solve(cea.RocketSolution(s), weights, pc=10.0, pi_p=[2.0, 10.0], tc=3000.0)
+
+    solver.write_profile(tmp_path / "totals.txt")
+    totals = (tmp_path / "totals.txt").read_text()
+    for phase in ("rocket", "equilibrium", "thermo", "assemble_matrix", "gauss"):
+        assert phase in totals
+
+    solver.write_profile(tmp_path / "stacks.txt", cea.PROFILE_COLLAPSED)
+    paths = [line.rsplit(" ", 1)[0] for line in (tmp_path / "stacks.txt").read_text().splitlines()]
+    assert "rocket;equilibrium;gauss" in paths
+
+    solver.write_profile(tmp_path / "trace.json", cea.PROFILE_CHROME_TRACE)
+    events = json.loads((tmp_path / "trace.json").read_text())["traceEvents"]
+    assert {e["name"] for e in events} >= {"rocket", "equilibrium", "gauss"}
+    assert all(e["ph"] == "X" and e["dur"] >= 0.0 for e in events)
+
+    unprofiled.write_profile(tmp_path / "empty.json", cea.PROFILE_CHROME_TRACE)
+    assert json.loads((tmp_path / "empty.json").read_text())["traceEvents"] == []
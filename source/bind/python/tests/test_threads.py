@@ -0,0 +1,68 @@
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+import pytest
+
+import cea
+
+
+def _h2o2():
+    reac = cea.Mixture(["H2", "O2"])
+    prod = cea.Mixture(["H", "H2", "H2O", "O", "O2", "OH"])
+    weights = reac.of_ratio_to_weights(np.array((0.0, 1.0)), np.array((1.0, 0.0)), 6.0)
+    return reac, prod, weights
+
+
+def _sweep(solver, weights, temps):
+    soln = cea.EqSolution(solver)
+    values = []
+    for t in temps:
+        solver.solve(soln, cea.TP, t, 10.0, weights)
+        values.append((soln.T, soln.n, soln.enthalpy))
+    return np.array(values)
+
+
+def test_threads_one_solver_per_thread():
+    reac, prod, weights = _h2o2()
+    chunks = np.array_split(np.linspace(1500.0, 3500.0, 64), 4)
+
+    serial = [_sweep(cea.EqSolver(prod, reactants=reac), weights, c) for c in chunks]
+
+    def work(chunk):
+        return _sweep(cea.EqSolver(prod, reactants=reac), weights, chunk)
+
+    with ThreadPoolExecutor(max_workers=4) as pool:
+        threaded = list(pool.map(work, chunks))
+
+    for a, b in zip(serial, threaded):
+        assert np.array_equal(a, b)
+
+
+def test_threads_shared_solver_is_serialized():
+    reac, prod, weights = _h2o2()
+    solver = cea.EqSolver(prod, reactants=reac)
+    temps = np.linspace(1500.0, 3500.0, 16)
+    expected = _sweep(cea.EqSolver(prod, reactants=reac), weights, temps)
+
+    # Each thread has its own solution; the solver lock keeps the solves from overlapping
+    with ThreadPoolExecutor(max_workers=4) as pool:
+        results = list(pool.map(lambda _: _sweep(solver, weights, temps), range(4)))
+
+    for r in results:
+        assert np.allclose(r, expected, rtol=1.0e-8)
+
+
+def test_threads_batch_solve():
+    reac, prod, weights = _h2o2()
+    temps = np.linspace(1500.0, 3500.0, 200)
+    chunks = np.array_split(temps, 4)
+
+    def work(chunk):
+        solver = cea.EqSolver(prod, reactants=reac)
+        return solver.solve_batch(cea.EqSolution(solver), cea.TP, chunk, 10.0, weights,
+                                  props=(cea.TEMPERATURE, cea.ENTHALPY))
+
+    with ThreadPoolExecutor(max_workers=4) as pool:
+        out = np.vstack(list(pool.map(work, chunks)))
+
+    assert out[:, 0] == pytest.approx(temps)
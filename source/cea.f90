@@ -9,9 +9,13 @@ module cea
                          version_patch
     use cea_thermo, only: ThermoDB, read_thermo
     use cea_transport, only: TransportDB, read_transport
-    use cea_mixture, only: Mixture
+    use cea_mixture, only: Mixture, ProductCache
     use cea_equilibrium, only: EqSolver, EqSolution, EqPartials
+    use cea_batch, only: EqBatchSolver
+    use cea_isat, only: IsatTable
+    use cea_uncertainty, only: McDriver
     use cea_rocket, only: RocketSolver, RocketSolution
+    use cea_optimize, only: OfOptimizer
     use cea_shock, only: ShockSolver, ShockSolution
     use cea_detonation, only: DetonSolver, DetonSolution
     implicit none
@@ -0,0 +1,555 @@
+module cea_columns
+    !! Columnar, machine-readable output
+    !!
+    !! A ColumnTable holds typed columns (float64, int32, fixed-width bytes)
+    !! of equal length. A ColumnWriter streams completed tables either into an
+    !! uncompressed NumPy .npz archive, one structured array per table, or as
+    !! CSV files (one per table). Tables are written as soon as they are
+    !! complete, so archives can be built while streaming through an input deck.
+    !!
+    !! Reading the archive from Python:
+    !!     data = numpy.load('example.npz')
+    !!     data['p1']['T']
+
+    use cea_param, only: dp
+    use iso_fortran_env, only: int8, int32, int64
+    use fb_utils
+    implicit none
+
+    integer, parameter :: column_real = 1
+    integer, parameter :: column_int  = 2
+    integer, parameter :: column_str  = 3
+
+    type :: Column
+        !! Single typed column
+
+        character(:), allocatable :: name
+            !! Column (field) name
+        integer :: kind = 0
+            !! One of column_real, column_int, column_str
+        integer :: width = 0
+            !! Bytes per value
+        real(dp), allocatable :: r(:)
+            !! Values of a float64 column
+        integer, allocatable :: i(:)
+            !! Values of an int32 column
+        character(:), allocatable :: s(:)
+            !! Values of a fixed-width string column
+    end type
+
+    type :: ColumnTable
+        !! Table of equal-length typed columns
+
+        integer :: num_rows = 0
+            !! Number of rows in every column
+        integer :: num_columns = 0
+            !! Number of columns in use
+        type(Column), allocatable :: columns(:)
+            !! Column storage (grown on demand)
+
+    contains
+
+        procedure :: add_real => ColumnTable_add_real
+        procedure :: add_int => ColumnTable_add_int
+        procedure :: add_str => ColumnTable_add_str
+        procedure :: find => ColumnTable_find
+
+    end type
+    interface ColumnTable
+        module procedure :: ColumnTable_init
+    end interface
+
+    type :: EncodedTable
+        !! A table as written by a ColumnWriter: .npy or CSV bytes
+
+        character(:), allocatable :: name
+            !! Table name
+        character(:), allocatable :: bytes
+            !! Encoded contents
+    end type
+
+    type :: ColumnWriter
+        !! Streams ColumnTables to an .npz archive or CSV files
+
+        character(:), allocatable :: format
+            !! Output format: 'npz' or 'csv'
+        character(:), allocatable :: stem
+            !! Output file stem
+        integer :: unit = 0
+            !! Stream unit of the .npz archive
+        logical :: is_open = .false.
+            !! True while the .npz archive is open for writing
+        integer :: num_entries = 0
+            !! Number of archive entries written
+        character(64), allocatable :: entry_names(:)
+            !! Archive entry names
+        integer(int64), allocatable :: entry_offsets(:)
+            !! Byte offset of each local file header
+        integer(int64), allocatable :: entry_sizes(:)
+            !! Size of each stored entry
+        integer(int64), allocatable :: entry_crcs(:)
+            !! CRC-32 of each stored entry
+        logical :: recording = .false.
+            !! Keep a copy of each table written, for replay with write_encoded
+        integer :: num_recorded = 0
+            !! Number of tables recorded
+        type(EncodedTable), allocatable :: recorded(:)
+            !! Tables written while recording
+
+    contains
+
+        procedure :: write_table => ColumnWriter_write_table
+        procedure :: write_encoded => ColumnWriter_write_encoded
+        procedure :: close => ColumnWriter_close
+
+    end type
+    interface ColumnWriter
+        module procedure :: ColumnWriter_init
+    end interface
+
+    ! Zip format limits (no zip64 support)
+    integer, parameter :: max_zip_entries = 65535
+    integer(int64), parameter :: max_zip_offset = 4294967295_int64
+
+contains
+
+    !-----------------------------------------------------------------------
+    ! ColumnTable
+    !-----------------------------------------------------------------------
+    function ColumnTable_init(num_rows) result(self)
+        integer, intent(in) :: num_rows
+        type(ColumnTable) :: self
+
+        self%num_rows = num_rows
+        allocate(self%columns(16))
+
+    end function
+
+    subroutine ColumnTable_new_column(self, name, kind, width, idx)
+        ! Append an empty column, growing storage as needed
+
+        class(ColumnTable), intent(inout) :: self
+        character(*), intent(in) :: name
+        integer, intent(in) :: kind
+        integer, intent(in) :: width
+        integer, intent(out) :: idx
+
+        type(Column), allocatable :: tmp(:)
+
+        call assert(self%find(name) == 0, 'ColumnTable: duplicate column name '//name)
+
+        if (.not. allocated(self%columns)) allocate(self%columns(16))
+        if (self%num_columns == size(self%columns)) then
+            allocate(tmp(2*size(self%columns)))
+            tmp(:self%num_columns) = self%columns(:self%num_columns)
+            call move_alloc(tmp, self%columns)
+        end if
+
+        self%num_columns = self%num_columns + 1
+        idx = self%num_columns
+        self%columns(idx)%name = name
+        self%columns(idx)%kind = kind
+        self%columns(idx)%width = width
+
+    end subroutine
+
+    subroutine ColumnTable_add_real(self, name, idx)
+        class(ColumnTable), intent(inout) :: self
+        character(*), intent(in) :: name
+        integer, intent(out), optional :: idx
+        integer :: c
+        call ColumnTable_new_column(self, name, column_real, 8, c)
+        allocate(self%columns(c)%r(self%num_rows), source=0.0d0)
+        if (present(idx)) idx = c
+    end subroutine
+
+    subroutine ColumnTable_add_int(self, name, idx)
+        class(ColumnTable), intent(inout) :: self
+        character(*), intent(in) :: name
+        integer, intent(out), optional :: idx
+        integer :: c
+        call ColumnTable_new_column(self, name, column_int, 4, c)
+        allocate(self%columns(c)%i(self%num_rows), source=0)
+        if (present(idx)) idx = c
+    end subroutine
+
+    subroutine ColumnTable_add_str(self, name, width, idx)
+        class(ColumnTable), intent(inout) :: self
+        character(*), intent(in) :: name
+        integer, intent(in) :: width
+        integer, intent(out), optional :: idx
+        integer :: c
+        call ColumnTable_new_column(self, name, column_str, width, c)
+        allocate(character(width) :: self%columns(c)%s(self%num_rows))
+        self%columns(c)%s = ''
+        if (present(idx)) idx = c
+    end subroutine
+
+    function ColumnTable_find(self, name) result(idx)
+        ! Index of the named column, or 0 if not present
+        class(ColumnTable), intent(in) :: self
+        character(*), intent(in) :: name
+        integer :: idx
+        integer :: c
+        idx = 0
+        do c = 1, self%num_columns
+            if (self%columns(c)%name == name) then
+                idx = c
+                return
+            end if
+        end do
+    end function
+
+    !-----------------------------------------------------------------------
+    ! ColumnWriter
+    !-----------------------------------------------------------------------
+    function ColumnWriter_init(stem, format) result(self)
+        character(*), intent(in) :: stem
+        character(*), intent(in) :: format
+        type(ColumnWriter) :: self
+
+        self%stem = stem
+        self%format = format
+
+        select case(format)
+            case('npz')
+                open(newunit=self%unit, file=stem//'.npz', access='stream', form='unformatted', &
+                     status='replace', action='write')
+                self%is_open = .true.
+                allocate(self%entry_names(64), self%entry_offsets(64), self%entry_sizes(64), self%entry_crcs(64))
+            case('csv')
+                continue
+            case default
+                call abort('ColumnWriter: unsupported output format '//format)
+        end select
+
+    end function
+
+    subroutine ColumnWriter_write_table(self, name, table)
+        ! Write a complete table under the given name
+
+        class(ColumnWriter), intent(inout) :: self
+        character(*), intent(in) :: name
+        type(ColumnTable), intent(in) :: table
+
+        type(EncodedTable), allocatable :: tmp(:)
+        character(:), allocatable :: bytes
+
+        select case(self%format)
+            case('npz')
+                bytes = npy_bytes(table)
+                call ColumnWriter_write_npz_entry(self, name//'.npy', bytes)
+            case('csv')
+                call write_csv(self%stem//'_'//name//'.csv', table)
+                if (self%recording) bytes = read_bytes(self%stem//'_'//name//'.csv')
+        end select
+
+        if (self%recording) then
+            if (.not. allocated(self%recorded)) allocate(self%recorded(4))
+            if (self%num_recorded == size(self%recorded)) then
+                allocate(tmp(2*self%num_recorded))
+                tmp(:self%num_recorded) = self%recorded
+                call move_alloc(tmp, self%recorded)
+            end if
+            self%num_recorded = self%num_recorded + 1
+            self%recorded(self%num_recorded) = EncodedTable(name, bytes)
+        end if
+
+    end subroutine
+
+    subroutine ColumnWriter_write_encoded(self, name, bytes)
+        ! Write a table previously encoded by write_table (see recording)
+
+        class(ColumnWriter), intent(inout) :: self
+        character(*), intent(in) :: name
+        character(*), intent(in) :: bytes
+
+        integer :: fout
+
+        select case(self%format)
+            case('npz')
+                call ColumnWriter_write_npz_entry(self, name//'.npy', bytes)
+            case('csv')
+                open(newunit=fout, file=self%stem//'_'//name//'.csv', access='stream', form='unformatted', &
+                     status='replace', action='write')
+                write(fout) bytes
+                close(fout)
+        end select
+
+    end subroutine
+
+    subroutine ColumnWriter_close(self)
+        ! Finalize the archive by writing the zip central directory
+
+        class(ColumnWriter), intent(inout) :: self
+
+        integer :: k
+        integer(int64) :: cd_start, cd_end, pos
+        character(:), allocatable :: fname
+
+        if (.not. self%is_open) return
+
+        inquire(unit=self%unit, pos=pos)
+        cd_start = pos - 1
+        do k = 1, self%num_entries
+            fname = trim(self%entry_names(k))
+            write(self%unit) le(int(z'02014b50', int64), 4), &  ! Central directory file header
+                             le(20_int64, 2), le(20_int64, 2), &  ! Version made by / needed
+                             le(0_int64, 2), le(0_int64, 2), &    ! Flags, method (stored)
+                             le(0_int64, 2), le(33_int64, 2), &   ! Time, date (1980-01-01)
+                             le(self%entry_crcs(k), 4), &
+                             le(self%entry_sizes(k), 4), le(self%entry_sizes(k), 4), &
+                             le(int(len(fname), int64), 2), &
+                             le(0_int64, 2), le(0_int64, 2), &    ! Extra, comment length
+                             le(0_int64, 2), le(0_int64, 2), &    ! Disk, internal attributes
+                             le(0_int64, 4), &                    ! External attributes
+                             le(self%entry_offsets(k), 4), fname
+        end do
+        inquire(unit=self%unit, pos=pos)
+        cd_end = pos - 1
+
+        write(self%unit) le(int(z'06054b50', int64), 4), &     ! End of central directory
+                         le(0_int64, 2), le(0_int64, 2), &
+                         le(int(self%num_entries, int64), 2), le(int(self%num_entries, int64), 2), &
+                         le(cd_end - cd_start, 4), le(cd_start, 4), &
+                         le(0_int64, 2)
+
+        close(self%unit)
+        self%is_open = .false.
+
+    end subroutine
+
+    subroutine ColumnWriter_write_npz_entry(self, fname, bytes)
+        ! Append a stored (uncompressed) zip entry
+
+        class(ColumnWriter), intent(inout) :: self
+        character(*), intent(in) :: fname
+        character(*), intent(in) :: bytes
+
+        integer :: n
+        integer(int64) :: pos, crc, nbytes
+        character(64), allocatable :: names(:)
+        integer(int64), allocatable :: tmp(:)
+
+        call assert(len(fname) <= len(self%entry_names), 'ColumnWriter: entry name too long: '//fname)
+        call assert(self%num_entries < max_zip_entries, 'ColumnWriter: too many tables for a single .npz archive')
+
+        inquire(unit=self%unit, pos=pos)
+        nbytes = len(bytes, kind=int64)
+        call assert(pos - 1 + nbytes <= max_zip_offset, 'ColumnWriter: .npz archive exceeds 4 GiB')
+
+        crc = crc32(bytes)
+        write(self%unit) le(int(z'04034b50', int64), 4), &      ! Local file header
+                         le(20_int64, 2), le(0_int64, 2), le(0_int64, 2), &
+                         le(0_int64, 2), le(33_int64, 2), &
+                         le(crc, 4), le(nbytes, 4), le(nbytes, 4), &
+                         le(int(len(fname), int64), 2), le(0_int64, 2), fname, bytes
+
+        if (self%num_entries == size(self%entry_names)) then
+            n = 2*self%num_entries
+            allocate(names(n)); names(:self%num_entries) = self%entry_names
+            call move_alloc(names, self%entry_names)
+            allocate(tmp(n)); tmp(:self%num_entries) = self%entry_offsets
+            call move_alloc(tmp, self%entry_offsets)
+            allocate(tmp(n)); tmp(:self%num_entries) = self%entry_sizes
+            call move_alloc(tmp, self%entry_sizes)
+            allocate(tmp(n)); tmp(:self%num_entries) = self%entry_crcs
+            call move_alloc(tmp, self%entry_crcs)
+        end if
+
+        self%num_entries = self%num_entries + 1
+        self%entry_names(self%num_entries) = fname
+        self%entry_offsets(self%num_entries) = pos - 1
+        self%entry_sizes(self%num_entries) = nbytes
+        self%entry_crcs(self%num_entries) = crc
+
+    end subroutine
+
+    !-----------------------------------------------------------------------
+    ! Encoders
+    !-----------------------------------------------------------------------
+    function npy_bytes(table) result(bytes)
+        ! Encode a table as a version 1.0 .npy structured array (row-major records)
+
+        type(ColumnTable), intent(in) :: table
+        character(:), allocatable :: bytes
+
+        integer :: c, row, itemsize, pos, header_len
+        character(3) :: endian
+        character(:), allocatable :: descr, header, data
+
+        if (little_endian()) then
+            endian = '<'
+        else
+            endian = '>'
+        end if
+
+        itemsize = 0
+        descr = '['
+        do c = 1, table%num_columns
+            associate(col => table%columns(c))
+                descr = descr//"('"//escape_quotes(col%name)//"', "
+                select case(col%kind)
+                    case(column_real); descr = descr//"'"//trim(endian)//"f8'), "
+                    case(column_int);  descr = descr//"'"//trim(endian)//"i4'), "
+                    case(column_str);  descr = descr//"'|S"//to_str(col%width)//"'), "
+                end select
+                itemsize = itemsize + col%width
+            end associate
+        end do
+        descr = descr//']'
+
+        header = "{'descr': "//descr//", 'fortran_order': False, 'shape': ("//to_str(table%num_rows)//",), }"
+        ! Pad so that magic (6) + version (2) + length (2) + header is a multiple of 64
+        header_len = len(header) + 1
+        header_len = header_len + modulo(-(10 + header_len), 64)
+        header = header//repeat(' ', header_len - len(header) - 1)//achar(10)
+
+        allocate(character(itemsize*table%num_rows) :: data)
+        pos = 0
+        do row = 1, table%num_rows
+            do c = 1, table%num_columns
+                associate(col => table%columns(c))
+                    select case(col%kind)
+                        case(column_real)
+                            data(pos+1:pos+8) = transfer(col%r(row), repeat(' ', 8))
+                        case(column_int)
+                            data(pos+1:pos+4) = transfer(int(col%i(row), int32), repeat(' ', 4))
+                        case(column_str)
+                            data(pos+1:pos+col%width) = col%s(row)
+                    end select
+                    pos = pos + col%width
+                end associate
+            end do
+        end do
+
+        bytes = le(int(z'93', int64), 1)//'NUMPY'//le(1_int64, 1)//le(0_int64, 1)//le(int(header_len, int64), 2)//header//data
+
+    end function
+
+    subroutine write_csv(filename, table)
+        ! Write a table as CSV with a header row; reals use round-trip precision
+
+        character(*), intent(in) :: filename
+        type(ColumnTable), intent(in) :: table
+
+        integer :: fout, c, row
+        character(32) :: buf
+
+        open(newunit=fout, file=filename, status='replace', action='write', form='formatted')
+
+        do c = 1, table%num_columns
+            if (c > 1) write(fout, '(a)', advance='no') ','
+            write(fout, '(a)', advance='no') csv_field(table%columns(c)%name)
+        end do
+        write(fout, '(a)') ''
+
+        do row = 1, table%num_rows
+            do c = 1, table%num_columns
+                if (c > 1) write(fout, '(a)', advance='no') ','
+                associate(col => table%columns(c))
+                    select case(col%kind)
+                        case(column_real)
+                            write(buf, '(es24.16e3)') col%r(row)
+                            write(fout, '(a)', advance='no') trim(adjustl(buf))
+                        case(column_int)
+                            write(fout, '(i0)', advance='no') col%i(row)
+                        case(column_str)
+                            write(fout, '(a)', advance='no') csv_field(trim(col%s(row)))
+                    end select
+                end associate
+            end do
+            write(fout, '(a)') ''
+        end do
+
+        close(fout)
+
+    end subroutine
+
+    function read_bytes(filename) result(bytes)
+        ! Contents of a file as one string
+        character(*), intent(in) :: filename
+        character(:), allocatable :: bytes
+        integer :: fin, nbytes
+        open(newunit=fin, file=filename, access='stream', form='unformatted', status='old', action='read')
+        inquire(unit=fin, size=nbytes)
+        allocate(character(nbytes) :: bytes)
+        if (nbytes > 0) read(fin) bytes
+        close(fin)
+    end function
+
+    function csv_field(text) result(out)
+        ! Quote a CSV field if it contains a delimiter or quote (RFC 4180)
+        character(*), intent(in) :: text
+        character(:), allocatable :: out
+        integer :: k
+        if (scan(text, ',"') == 0) then
+            out = text
+            return
+        end if
+        out = '"'
+        do k = 1, len(text)
+            if (text(k:k) == '"') out = out//'"'
+            out = out//text(k:k)
+        end do
+        out = out//'"'
+    end function
+
+    function le(value, nbytes) result(bytes)
+        ! Little-endian encoding of the low nbytes of value
+        integer(int64), intent(in) :: value
+        integer, intent(in) :: nbytes
+        character(nbytes) :: bytes
+        integer :: k
+        do k = 1, nbytes
+            bytes(k:k) = achar(int(ibits(value, 8*(k-1), 8)))
+        end do
+    end function
+
+    function crc32(bytes) result(crc)
+        ! CRC-32 (IEEE 802.3) as used by the zip format
+
+        character(*), intent(in) :: bytes
+        integer(int64) :: crc
+
+        integer(int64), parameter :: mask = int(z'FFFFFFFF', int64)
+        integer(int64), parameter :: poly = int(z'EDB88320', int64)
+        integer(int64) :: table(0:255), c
+        integer :: k, b
+
+        do k = 0, 255
+            c = int(k, int64)
+            do b = 1, 8
+                if (iand(c, 1_int64) /= 0) then
+                    c = ieor(poly, shiftr(c, 1))
+                else
+                    c = shiftr(c, 1)
+                end if
+            end do
+            table(k) = c
+        end do
+
+        crc = mask
+        do k = 1, len(bytes)
+            crc = ieor(table(iand(ieor(crc, int(iachar(bytes(k:k)), int64)), 255_int64)), shiftr(crc, 8))
+        end do
+        crc = ieor(crc, mask)
+
+    end function
+
+    function escape_quotes(name) result(out)
+        character(*), intent(in) :: name
+        character(:), allocatable :: out
+        integer :: k
+        out = ''
+        do k = 1, len(name)
+            if (name(k:k) == "'" .or. name(k:k) == '\') out = out//'\'
+            out = out//name(k:k)
+        end do
+    end function
+
+    logical function little_endian()
+        little_endian = (transfer(1_int32, 0_int8) == 1_int8)
+    end function
+
+end module
@@ -4,7 +4,8 @@ module cea_detonation
     use cea_param, only: dp, empty_dp, R=>gas_constant
     use cea_mixture, only: Mixture, MixtureThermo
     use cea_transport, only: TransportDB
-    use cea_equilibrium, only: EqSolution, EqSolver, EqPartials
+    use cea_equilibrium, only: EqSolution, EqSolver, EqPartials, EqResult
+    use fb_timing, only: profile_enter, profile_leave
     use fb_utils
     implicit none
 
@@ -73,6 +74,53 @@ module cea_detonation
         module procedure :: DetonSolution_init
     end interface
 
+    type :: DetonResult
+        !! Compact record of the reported detonation outputs
+        !!
+        !! Keeps an EqResult in place of the EqSolution and EqPartials
+        !! workspaces, so a sweep can store one record per point.
+
+        type(EqResult) :: eq_result
+            !! Equilibrium outputs of the burned gas
+
+        ! States (unburned gas)
+        real(dp) :: P1 = 0.0d0
+        real(dp) :: T1 = 0.0d0
+        real(dp) :: H1 = 0.0d0
+        real(dp) :: M1 = 0.0d0
+        real(dp) :: gamma1 = 0.0d0
+        real(dp) :: v_sonic1 = 0.0d0
+
+        ! Detonation parameters
+        real(dp) :: pressure = 0.0d0
+            !! Pressure [bar]
+        real(dp) :: sonic_velocity = 0.0d0
+            !! Speed of sound [m/s]
+        real(dp) :: velocity = 0.0d0
+            !! Detonation velocity [m/s]
+        real(dp) :: mach = 0.0d0
+            !! Detonation Mach number
+        real(dp) :: gamma = 0.0d0
+            !! Ratio of specific heats
+        real(dp) :: enthalpy = 0.0d0
+            !! Enthalpy of the detonation
+        real(dp) :: P_P1 = 0.0d0
+            !! P/P1
+        real(dp) :: T_T1 = 0.0d0
+            !! T/T1
+        real(dp) :: M_M1 = 0.0d0
+            !! M/M1
+        real(dp) :: rho_rho1 = 0.0d0
+            !! rho/rho1
+
+        logical :: converged = .false.
+            !! Convergence flag
+
+    end type
+    interface DetonResult
+        module procedure :: DetonResult_init
+    end interface
+
 contains
 
     !-----------------------------------------------------------------------
@@ -269,7 +317,7 @@ contains
         ! Solve the detonation problem
 
         ! Arguments
-        class(DetonSolver), intent(in) :: self
+        class(DetonSolver) :: self
         real(dp), intent(in) :: reactant_weights(:)
         real(dp), intent(in) :: t1                     ! Initial reactant temperature [K]
         real(dp), intent(in) :: p1                     ! Initial reactant pressure [bar]
@@ -297,12 +345,14 @@ contains
         end if
 
         ! Call the solver
+        call profile_enter(self%eq_solver%profile, 'detonation')
         if (frozen_) then
             call log_info('DetonSolver: frozen composition not supported yet')
             ! call self%solve_frozen(soln, reactant_weights, t1, p1)
         else
             call self%solve_eq(soln, reactant_weights, t1, p1)
         end if
+        call profile_leave(self%eq_solver%profile)
 
     end function
 
@@ -313,4 +363,33 @@ contains
         type(DetonSolution) :: self
     end function
 
+    !-----------------------------------------------------------------------
+    ! DetonResult
+    !-----------------------------------------------------------------------
+    function DetonResult_init(soln) result(self)
+        ! Copy the reported outputs of a solved detonation problem
+        type(DetonResult) :: self
+        type(DetonSolution), intent(in) :: soln
+
+        self%eq_result = EqResult(soln%eq_soln, soln%eq_partials)
+        self%P1 = soln%P1
+        self%T1 = soln%T1
+        self%H1 = soln%H1
+        self%M1 = soln%M1
+        self%gamma1 = soln%gamma1
+        self%v_sonic1 = soln%v_sonic1
+        self%pressure = soln%pressure
+        self%sonic_velocity = soln%sonic_velocity
+        self%velocity = soln%velocity
+        self%mach = soln%mach
+        self%gamma = soln%gamma
+        self%enthalpy = soln%enthalpy
+        self%P_P1 = soln%P_P1
+        self%T_T1 = soln%T_T1
+        self%M_M1 = soln%M_M1
+        self%rho_rho1 = soln%rho_rho1
+        self%converged = soln%converged
+
+    end function
+
 end module
@@ -7,14 +7,56 @@ module cea_equilibrium
                          Avgdr=>avogadro, &
                          Boltz=>boltzmann, &
                          pi
-    use cea_mixture, only: Mixture, MixtureThermo
+    use cea_mixture, only: Mixture, MixtureThermo, check_array_len
+    use cea_kernels, only: gauss_fixed, element_sums
     use cea_transport, only: TransportDB, get_mixture_transport
     use fb_findloc, only: findloc
+    use fb_timing, only: profiler, profile_enter, profile_leave, profiling_enabled
     use fb_utils
     implicit none
 
+    ! EqSolver output selection: solve computes the selected outputs right away and leaves
+    ! the others pending until compute_outputs asks for them. The species amounts,
+    ! temperature, pressure and molecular weights are always computed.
+    integer, parameter :: output_properties = 1
+        !! Mixture properties: volume, density, h, u, s, g, cp, cv and gamma_s
+    integer, parameter :: output_partials = 2
+        !! Equilibrium partial derivatives that transport solvers compute without being asked
+    integer, parameter :: output_transport = 4
+        !! Transport properties (solvers with a transport database only)
+    integer, parameter :: output_performance = 8
+        !! Rocket performance parameters: Isp, vacuum Isp, c* and CF
+    integer, parameter :: output_all = 15
+
+    type :: EqSolverData
+        !! Read-only product data of an EqSolver, shared by reference with its clones
+
+        integer :: refs = 1
+            !! Number of solvers holding a reference
+        type(Mixture) :: products
+            !! Product thermodynamic database
+        type(TransportDB) :: transport_db
+            !! Transport properties database
+        real(dp), allocatable :: T_low_c(:)
+            !! Lowest curve-fit temperature of each condensed species [K]
+        real(dp), allocatable :: T_high_c(:)
+            !! Highest curve-fit temperature of each condensed species [K]
+        integer, allocatable :: phase_start(:)
+            !! Offset of each condensed species' entries in phase_list (nc+1)
+        integer, allocatable :: phase_list(:)
+            !! All phases of each condensed species, sorted by melting temperature
+
+    end type
+
     type :: EqSolver
         !! Equilibrium Solver Type
+        !!
+        !! The product mixture, transport database and condensed phase tables live in a
+        !! reference-counted EqSolverData that copies of the solver share; everything else
+        !! is the solver's own working state. EqSolver() returns a solver holding one
+        !! reference. Assignment copies the working state and shares the data without
+        !! taking a reference, so a copy must not outlive the solver it was made from
+        !! unless it calls retain. Call release when the solver is no longer needed.
 
         ! Sizing variables
         integer :: num_reactants = 0
@@ -33,14 +75,20 @@ module cea_equilibrium
         ! Thermodynamic database
         type(Mixture) :: reactants
             !! Reactant thermodynamic database
-        type(Mixture) :: products
-            !! Product thermodynamic database
+        type(Mixture), pointer :: products => null()
+            !! Product thermodynamic database (shared)
         type(MixtureThermo) :: thermo
             !! Product heat capacity, enthalpy, entropy
 
+        ! Element order
+        integer, allocatable :: element_order(:)
+            !! Product element of each element equation; permuted by the component reduction
+        real(dp), allocatable :: stoich_matrix(:, :)
+            !! Product stoichiometric matrix with its columns in element_order
+
         ! Transport database
-        type(TransportDB) :: transport_db
-            !! Transport properties database
+        type(TransportDB), pointer :: transport_db => null()
+            !! Transport properties database (shared)
 
         ! Options
         logical :: ions = .false.
@@ -51,8 +99,24 @@ module cea_equilibrium
             !! Number of temporarily reduced element equations in singular recovery
         logical :: transport = .false.
             !! Flag if transport properties should be computed
+        integer :: outputs = output_all
+            !! Outputs computed during solve (output_* flags); the others are left pending
         character(snl), allocatable :: insert(:)
 
+        ! Condensed phase data (fixed at init, shared)
+        real(dp), pointer :: T_low_c(:) => null()
+            !! Lowest curve-fit temperature of each condensed species [K]
+        real(dp), pointer :: T_high_c(:) => null()
+            !! Highest curve-fit temperature of each condensed species [K]
+        integer, pointer :: phase_start(:) => null()
+            !! Offset of each condensed species' entries in phase_list (nc+1)
+        integer, pointer :: phase_list(:) => null()
+            !! All phases of each condensed species, sorted by melting temperature
+
+        ! Shared data
+        type(EqSolverData), pointer :: data => null()
+            !! Owner of the shared components above
+
         ! Solver parameters
         ! TODO: Give these better names
         real(dp) :: size  = 18.420681d0
@@ -80,9 +144,16 @@ module cea_equilibrium
         real(dp) :: T_max = 6600.0d0
             !! Maximum mixture temperature (K)
 
+        ! Profiling
+        type(profiler), allocatable :: profile
+            !! Wall-clock time per solver phase; allocated only when profiling is on
+
     contains
 
+        procedure :: retain => EqSolver_retain
+        procedure :: release => EqSolver_release
         procedure :: num_active_elements => EqSolver_num_active_elements
+        procedure :: elements_from_species => EqSolver_elements_from_species
         procedure :: compute_damped_update_factor => EqSolver_compute_damped_update_factor
         procedure :: get_solution_vars => EqSolver_get_solution_vars
         procedure :: update_solution => EqSolver_update_solution
@@ -93,6 +164,8 @@ module cea_equilibrium
         procedure :: update_transport_basis => EqSolver_update_transport_basis
         procedure :: assemble_matrix => EqSolver_assemble_matrix
         procedure :: post_process => EqSolver_post_process
+        procedure :: finish_outputs => EqSolver_finish_outputs
+        procedure :: compute_outputs => EqSolver_compute_outputs
         procedure :: solve => EqSolver_solve
 
     end type
@@ -277,6 +350,18 @@ module cea_equilibrium
         real(dp) :: Pr_eq = 0.0d0
             !! Prandtl number, equilibrium (unitless)
 
+        ! Deferred outputs
+        integer :: pending = 0
+            !! Outputs the solver's mask left uncomputed (output_* flags)
+        logical :: caller_partials = .false.
+            !! Partials were computed for the caller; their cp_eq is kept even if zero
+        logical :: active_ions = .true.
+            !! Ion solving was active when the outputs were finished
+        integer :: num_reduced = 0
+            !! Element swaps of the solve's component reduction, replayed by compute_outputs
+        integer, allocatable :: reduced_from(:), reduced_to(:)
+            !! Element indices swapped by the component reduction, in order
+
         ! Note:
         !   The augmented iteration matrix is an n-by-n+1 matrix that appends
         !   the function residual vector as an extra column after the Jacobian.
@@ -306,6 +391,7 @@ module cea_equilibrium
         procedure :: calc_pressure => EqSolution_calc_pressure
         procedure :: calc_volume => EqSolution_calc_volume
         procedure :: calc_entropy_sum => EqSolution_calc_entropy_sum
+        procedure :: release_workspace => EqSolution_release_workspace
     end type
     interface EqSolution
         module procedure :: EqSolution_init
@@ -317,33 +403,115 @@ module cea_equilibrium
             !! Partial derivative of 𝛑 wrt ln(T) (const P)
         real(dp), allocatable :: dnc_dlnT(:)
             !! Partial derivative of nc wrt ln(T) (const P)
-        real(dp)              :: dn_dlnT
+        real(dp)              :: dn_dlnT = 0.0d0
             !! Partial derivative of n wrt ln(T) (const P)
-        real(dp)              :: dlnV_dlnT
+        real(dp)              :: dlnV_dlnT = 0.0d0
             !! Partial derivative of ln(V) wrt ln(T) (const P)
 
         real(dp), allocatable :: dpi_dlnP(:)
             !! Partial derivative of 𝛑 wrt ln(P) (const T)
         real(dp), allocatable :: dnc_dlnP(:)
             !! Partial derivative of nc wrt ln(P) (const T)
-        real(dp)              :: dn_dlnP
+        real(dp)              :: dn_dlnP = 0.0d0
             !! Partial derivative of n wrt ln(P) (const T)
-        real(dp)              :: dlnV_dlnP
+        real(dp)              :: dlnV_dlnP = 0.0d0
             !! Partial derivative of ln(V) wrt ln(P) (const T)
 
-        real(dp)              :: cp_eq
+        real(dp)              :: cp_eq = 0.0d0
             !! Equilibrium heat capacity [J/kg-K] (Eq. 2.59)
-        real(dp)              :: gamma_s
+        real(dp)              :: gamma_s = 0.0d0
             !! Isentropic exponent (Eq. 2.71/2.73)
     contains
         procedure :: assemble_partials_matrix_const_p => EqPartials_assemble_partials_matrix_const_p
         procedure :: assemble_partials_matrix_const_t => EqPartials_assemble_partials_matrix_const_t
         procedure :: compute_partials => EqPartials_compute_partials
+        procedure :: release_workspace => EqPartials_release_workspace
     end type
     interface EqPartials
         module procedure :: EqPartials_init
     end interface
 
+    type :: EqResult
+        !! Compact record of the reported equilibrium outputs
+        !!
+        !! Holds only the mixture properties and species amounts of a solved
+        !! state, so sweeps can keep one record per point while the EqSolution
+        !! and EqPartials workspaces are reused between solves.
+        logical :: converged = .false.
+            !! Flag if the solution has converged
+        real(dp) :: T = 0.0d0
+            !! Mixture temperature (K)
+        real(dp) :: n = 0.0d0
+            !! Total moles of mixture
+        real(dp) :: pressure = 0.0d0
+            !! Mixture pressure (bar)
+        real(dp) :: volume = 0.0d0
+            !! Mixture specific volume (m^3/kg)
+        real(dp) :: density = 0.0d0
+            !! Mixture density (kg/m^3)
+        real(dp) :: M = 0.0d0
+            !! Molecular weight, (1/n)
+        real(dp) :: MW = 0.0d0
+            !! Molecular weight
+        real(dp) :: enthalpy = 0.0d0
+            !! Mixture enthalpy (kJ/kg)
+        real(dp) :: energy = 0.0d0
+            !! Mixture internal energy (kJ/kg)
+        real(dp) :: gibbs_energy = 0.0d0
+            !! Mixture Gibb's energy (kJ/kg)
+        real(dp) :: entropy = 0.0d0
+            !! Mixture entropy (kJ/kg-K)
+        real(dp) :: cp_fr = 0.0d0
+            !! Heat capacity at constant pressure, frozen (kJ/kg-K)
+        real(dp) :: cp_eq = 0.0d0
+            !! Heat capacity at constant pressure, equilibrium (kJ/kg-K)
+        real(dp) :: cv_fr = 0.0d0
+            !! Heat capacity at constant volume, frozen (kJ/kg-K)
+        real(dp) :: cv_eq = 0.0d0
+            !! Heat capacity at constant volume, equilibrium (kJ/kg-K)
+        real(dp) :: gamma_s = 0.0d0
+            !! Isentropic exponent
+        real(dp) :: dlnV_dlnT = 0.0d0
+            !! Partial derivative of ln(V) wrt ln(T) (const P)
+        real(dp) :: dlnV_dlnP = 0.0d0
+            !! Partial derivative of ln(V) wrt ln(P) (const T)
+        real(dp) :: viscosity = 0.0d0
+            !! Viscosity (millipose)
+        real(dp) :: conductivity_fr = 0.0d0
+            !! Thermal conductivity, frozen (mW/cm-K)
+        real(dp) :: conductivity_eq = 0.0d0
+            !! Thermal conductivity, equilibrium (mW/cm-K)
+        real(dp) :: Pr_fr = 0.0d0
+            !! Prandtl number, frozen (unitless)
+        real(dp) :: Pr_eq = 0.0d0
+            !! Prandtl number, equilibrium (unitless)
+        real(dp), allocatable :: mole_fractions(:)
+            !! Mole fractions of products
+        real(dp), allocatable :: mass_fractions(:)
+            !! Mass fractions of products
+    end type
+    interface EqResult
+        module procedure :: EqResult_init
+    end interface
+
+    ! EqDerivatives output selection: add (or ior) one or more quantities and one or
+    ! more inputs. A mask with no quantity (or no input) flag selects all of them.
+    integer, parameter :: deriv_T = 1
+    integer, parameter :: deriv_n = 2
+    integer, parameter :: deriv_nj = 4
+    integer, parameter :: deriv_H = 8
+    integer, parameter :: deriv_U = 16
+    integer, parameter :: deriv_G = 32
+    integer, parameter :: deriv_S = 64
+    integer, parameter :: deriv_Cp_fr = 128
+    integer, parameter :: deriv_quantities = 255
+    integer, parameter :: deriv_wrt_state1 = 256
+    integer, parameter :: deriv_wrt_state2 = 512
+    integer, parameter :: deriv_wrt_b0 = 1024
+    integer, parameter :: deriv_wrt_w0 = 2048
+    integer, parameter :: deriv_inputs = 3840
+    integer, parameter :: deriv_all = 4095
+
         type :: EqDerivatives
         !! Equilibrium Total Derivatives Type
         !!
@@ -357,6 +525,8 @@ module cea_equilibrium
             !! Number of equations in the matrix system = number of equations in the active set
         integer :: n = 0
             !! Number of variables in the solution vector = number of elements + 2
+        integer :: outputs = deriv_all
+            !! Selected outputs (deriv_* flags); only these, and what they depend on, are computed
 
         !! Solver workspace
         real(dp), allocatable :: R(:)
@@ -368,7 +538,8 @@ module cea_equilibrium
         real(dp), allocatable :: dudx(:, :)
             !! Total derivatives of the solution variables wrt inputs (m x n)
         real(dp), allocatable :: delta_check(:, :)
-            !! Delta = J*dudx + Rx = 0, used to check the correctness of the computed derivatives (m x n)
+            !! Delta = J*dudx + Rx = 0, used to check the correctness of the computed derivatives (m x n);
+            !! allocated by check_closure_defect
 
         !! Final unpacked derivatives
         real(dp) :: dT_dstate1
@@ -392,6 +563,13 @@ module cea_equilibrium
         real(dp), allocatable :: dnj_dw0(:,:)
             !! Total derivative of species concentrations wrt input weights
 
+        real(dp), allocatable :: dT_db0(:)
+            !! Total derivative of T wrt element amounts b0
+        real(dp), allocatable :: dn_db0(:)
+            !! Total derivative of n wrt element amounts b0
+        real(dp), allocatable :: dnj_db0(:,:)
+            !! Total derivative of species concentrations wrt element amounts b0
+
         real(dp) :: dH_dstate1
             !! Total derivative of enthalpy wrt state1 (T0/H0/S0/U0)
         real(dp) :: dH_dstate2
@@ -427,7 +605,7 @@ module cea_equilibrium
         real(dp), allocatable :: dCp_fr_dw0(:)
             !! Total derivative of frozen heat capacity wrt input weights
 
-        !! Finite-difference derivatives (for verification)
+        !! Finite-difference derivatives (for verification); allocated by compute_fd
         real(dp) :: dT_dstate1_fd
         real(dp) :: dT_dstate2_fd
         real(dp), allocatable :: dT_dw0_fd(:)
@@ -462,6 +640,8 @@ module cea_equilibrium
 
     contains
 
+        procedure :: select => EqDerivatives_select
+        procedure :: is_selected => EqDerivatives_is_selected
         procedure :: assemble_jacobian => EqDerivatives_assemble_jacobian
         procedure :: assemble_Rx => EqDerivatives_assemble_Rx
         procedure :: compute_residual => EqDerivatives_compute_residual
@@ -475,6 +655,10 @@ module cea_equilibrium
         module procedure :: EqDerivatives_init
     end interface
 
+    interface alloc_deriv
+        module procedure :: alloc_deriv_1d, alloc_deriv_2d
+    end interface
+
 contains
 
     pure subroutine sigmoid_stable(x, g, log_g)
@@ -585,9 +769,13 @@ contains
         real(dp), intent(in), optional :: truncation_width
         integer :: i
         integer :: ngc_equiv
+        type(EqSolverData), pointer :: data
 
-        ! Initialize reactant data
-        self%products = products
+        ! Initialize the shared product data and the reactant data
+        allocate(data)
+        data%products = products
+        self%data => data
+        self%products => data%products
         if (present(reactants)) then
             self%reactants = reactants
             if (reactants%num_species > products%num_species) then
@@ -607,6 +795,8 @@ contains
         self%num_condensed = self%products%num_condensed
         self%num_elements  = self%products%num_elements
         self%max_equations = self%num_elements + self%num_condensed + 2
+        self%element_order = [(i, i = 1, self%num_elements)]
+        self%stoich_matrix = self%products%stoich_matrix
 
         ! Optional argument handling
         if (present(trace)) self%trace = trace
@@ -641,7 +831,11 @@ contains
         self%max_converged = 3*self%products%num_elements
 
         ! Initialize transport database
-        if (self%transport) self%transport_db = get_mixture_transport(all_transport, products, ions=self%ions)
+        if (self%transport) data%transport_db = get_mixture_transport(all_transport, products, ions=self%ions)
+        self%transport_db => data%transport_db
+
+        ! Tabulate condensed temperature ranges and phase lists
+        call EqSolver_init_condensed_phases(self)
 
         ! Store the insert species
         if (present(insert)) then
@@ -653,8 +847,67 @@ contains
             self%insert = insert
         end if
 
+        if (profiling_enabled()) allocate(self%profile)
+
     end function
 
+    subroutine EqSolver_init_condensed_phases(self)
+        ! Fill the condensed phase tables used by check_condensed_phases and test_condensed
+        type(EqSolver), intent(inout) :: self
+
+        ! Locals
+        integer :: i, ng, nc
+        integer, allocatable :: idx(:)  ! Phases of one condensed species
+        type(EqSolverData), pointer :: data
+
+        ng = self%num_gas
+        nc = self%num_condensed
+        data => self%data
+
+        allocate(data%T_low_c(nc), data%T_high_c(nc), data%phase_start(nc+1), data%phase_list(0))
+        data%phase_start(1) = 1
+        do i = 1, nc
+            data%T_low_c(i)  = minval(self%products%species(ng+i)%T_fit(:, 1))
+            data%T_high_c(i) = maxval(self%products%species(ng+i)%T_fit(:, 2))
+            idx = get_species_other_phases(self%products%species_names(ng+i), self%products)
+            data%phase_list = [data%phase_list, idx]
+            data%phase_start(i+1) = data%phase_start(i) + size(idx)
+        end do
+        self%T_low_c => data%T_low_c
+        self%T_high_c => data%T_high_c
+        self%phase_start => data%phase_start
+        self%phase_list => data%phase_list
+
+    end subroutine
+
+    subroutine EqSolver_retain(self)
+        ! Take a reference to the shared product data, e.g. for a copy made by assignment
+        ! that may outlive the solver it was copied from
+        class(EqSolver), intent(inout) :: self
+
+        if (.not. associated(self%data)) return
+        !$omp atomic update
+        self%data%refs = self%data%refs + 1
+    end subroutine
+
+    subroutine EqSolver_release(self)
+        ! Drop this solver's reference to the shared product data, freeing it with the last one.
+        ! The solver cannot be used again until it is reinitialized.
+        class(EqSolver), intent(inout) :: self
+
+        ! Locals
+        integer :: refs
+
+        if (.not. associated(self%data)) return
+        !$omp atomic capture
+        self%data%refs = self%data%refs - 1
+        refs = self%data%refs
+        !$omp end atomic
+        if (refs == 0) deallocate(self%data)
+        nullify(self%data, self%products, self%transport_db)
+        nullify(self%T_low_c, self%T_high_c, self%phase_start, self%phase_list)
+    end subroutine
+
     function EqSolver_num_active_elements(self) result(ne)
         class(EqSolver), intent(in) :: self
         integer :: ne
@@ -664,28 +917,42 @@ contains
         ne = max(0, ne)
     end function
 
+    function EqSolver_elements_from_species(self, n_species) result(n_elements)
+        ! Compute element concentrations from species concentrations, in element_order
+        class(EqSolver), intent(in) :: self
+        real(dp), intent(in) :: n_species(:)
+        real(dp) :: n_elements(self%num_elements)
+        integer :: e
+        call check_array_len(size(n_species), self%num_products, 'EqSolver_elements_from_species n_species')
+        do e = 1, self%num_elements
+            n_elements(e) = dot_product(self%stoich_matrix(:, e), n_species)
+        end do
+    end function
+
     subroutine EqSolver_swap_elements(self, soln, i, j)
         ! Swap two element equations/columns in the solver state.
+        ! The shared product mixture keeps its order; only element_order and the solver's
+        ! own stoichiometric matrix are permuted.
         class(EqSolver), intent(inout), target :: self
         type(EqSolution), intent(inout), target :: soln
         integer, intent(in) :: i
         integer, intent(in) :: j
         real(dp) :: tmp_col(self%num_products)
         real(dp) :: tmp
-        character(enl) :: tmp_name
+        integer :: tmp_idx
 
         if (i == j) return
         if (i < 1 .or. i > self%num_elements .or. j < 1 .or. j > self%num_elements) then
             call abort('EqSolver_swap_elements: index out of bounds.')
         end if
 
-        tmp_col = self%products%stoich_matrix(:, i)
-        self%products%stoich_matrix(:, i) = self%products%stoich_matrix(:, j)
-        self%products%stoich_matrix(:, j) = tmp_col
+        tmp_col = self%stoich_matrix(:, i)
+        self%stoich_matrix(:, i) = self%stoich_matrix(:, j)
+        self%stoich_matrix(:, j) = tmp_col
 
-        tmp_name = self%products%element_names(i)
-        self%products%element_names(i) = self%products%element_names(j)
-        self%products%element_names(j) = tmp_name
+        tmp_idx = self%element_order(i)
+        self%element_order(i) = self%element_order(j)
+        self%element_order(j) = tmp_idx
 
         tmp = soln%constraints%b0(i)
         soln%constraints%b0(i) = soln%constraints%b0(j)
@@ -831,8 +1098,8 @@ contains
         const_t = cons%is_constant_temperature()
 
         ! Associate subarray pointers
-        A_g => self%products%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
-        A   => self%products%stoich_matrix(:,:)
+        A_g => self%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
+        A   => self%stoich_matrix(:,:)
         h_g => soln%thermo%enthalpy(:ng)
         s_g => soln%thermo%entropy(:ng)
 
@@ -913,7 +1180,7 @@ contains
         ! Update the variables in the solution database using the solution vector X
 
         ! Arguments
-        class(EqSolver), intent(in), target :: self
+        class(EqSolver), target :: self
         type(EqSolution), intent(inout), target :: soln
 
         ! Locals
@@ -969,7 +1236,7 @@ contains
         T = soln%T
 
         ! Associate subarray pointers
-        A_g => self%products%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
+        A_g => self%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
         nj_g => soln%nj(:ng)
         nj_c => soln%nj(ng+1:)
         h_g => soln%thermo%enthalpy(:ng)
@@ -1007,7 +1274,9 @@ contains
         end if
 
         ! Update thermodynamic properties
-        call self%products%calc_thermo(soln%thermo, soln%T, condensed=.true.)
+        call profile_enter(self%profile, 'thermo')
+        call self%products%update_thermo(soln%thermo, soln%T, condensed=.true.)
+        call profile_leave(self%profile)
 
     end subroutine
 
@@ -1080,7 +1349,7 @@ contains
         dln_T = soln%dln_T
 
         ! Associate subarray pointers
-        A_g => self%products%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
+        A_g => self%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
         nj_g => soln%nj(:ng)
         h_g => soln%thermo%enthalpy(:ng)
         s_g => soln%thermo%entropy(:ng)
@@ -1090,7 +1359,7 @@ contains
         P = soln%calc_pressure()
 
         ! Evalutate constraint residuals
-        b_delta = b0 - self%products%elements_from_species(nj)
+        b_delta = b0 - self%elements_from_species(nj)
         if (const_s) then
             do i = 1, ng
                 ion_species = self%ions .and. self%active_ions .and. ne_full > 0 .and. A_g(i, ne_full) /= 0.0d0
@@ -1271,7 +1540,18 @@ contains
         integer  :: ne                          ! Number of elements
         integer  :: ne_full                     ! Total number of elements (including electron)
         integer  :: num_eqn                     ! Active number of equations
-        real(dp) :: tmp(self%num_gas)           ! Common sub-expression storage
+        integer  :: m                           ! Number of gas species with a nonzero Newton weight
+        integer  :: act(self%num_gas)           ! Indices of those species
+        real(dp) :: tmp(self%num_gas)           ! Common sub-expression storage (first m entries)
+        real(dp) :: w(self%num_gas)             ! nj_linear of the active gas species
+        real(dp) :: mu_a(self%num_gas)          ! mu_g of the active gas species
+        real(dp) :: h_a(self%num_gas)           ! h_g of the active gas species
+        real(dp) :: u_a(self%num_gas)           ! u_g of the active gas species
+        real(dp) :: A_a(self%num_gas, self%num_elements)  ! A_g rows of the active gas species
+        real(dp) :: Gee(self%num_elements, self%num_elements)  ! Pi-Pi block of the element rows
+        real(dp) :: t_sum(self%num_elements)    ! Element-row sums: delta ln(n) column,
+        real(dp) :: t_e(self%num_elements)      ! ... delta ln(T) column,
+        real(dp) :: t_mu(self%num_elements)     ! ... and right hand side
         real(dp) :: mu_g(self%num_gas)          ! Gas phase chemical potentials [unitless]
         real(dp) :: b_delta(self%num_elements)  ! Residual for element contraints
         real(dp) :: n_delta                     ! Residual for total moles / pressure constraint
@@ -1320,8 +1600,8 @@ contains
 
         ! Associate subarray pointers
         G   => soln%G(:num_eqn, :num_eqn+1)
-        A_g => self%products%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
-        A_c => self%products%stoich_matrix(ng+1:,:)
+        A_g => self%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
+        A_c => self%stoich_matrix(ng+1:,:)
         n = soln%n
         ln_n = log(n)
         nj  => soln%nj
@@ -1351,8 +1631,24 @@ contains
         nj_eval = nj
         nj_eval(:ng) = nj_eff_g
 
+        ! Gather the gas species with a nonzero Newton weight. Species below the
+        ! hard truncation threshold add exact zeros to every gas sum below, so
+        ! leaving them out does not change the matrix. The set is rebuilt every
+        ! iteration, so species that cross the threshold re-enter immediately.
+        m = 0
+        do i = 1, ng
+            if (nj_linear(i) == 0.0d0) cycle
+            m = m+1
+            act(m) = i
+        end do
+        w(:m) = nj_linear(act(:m))
+        mu_a(:m) = mu_g(act(:m))
+        h_a(:m) = h_g(act(:m))
+        u_a(:m) = u_g(act(:m))
+        A_a(:m, :ne) = A_g(act(:m), :ne)
+
         ! Evalutate constraint residuals
-        b_delta = cons%b0 - self%products%elements_from_species(nj_eval)
+        b_delta = cons%b0 - self%elements_from_species(nj_eval)
         n_delta = n - sum(nj_eff_g)
         if (const_s) then
             hsu_delta = (cons%state1 - soln%calc_entropy_sum(self))
@@ -1370,15 +1666,22 @@ contains
         !-------------------------------------------------------
         ! Equation (2.24/2.45): Element constraints
         !-------------------------------------------------------
+        ! Sums of w*A_a(:,i) against A_a, 1, h_a or u_a, and mu_a, in one
+        ! pass over the species when ne has a fixed-size kernel
+        if (const_p) then
+            call element_sums(ne, m, w, A_a, h_a, mu_a, Gee, t_sum, t_e, t_mu)
+        else
+            call element_sums(ne, m, w, A_a, u_a, mu_a, Gee, t_sum, t_e, t_mu)
+        end if
+
         do i = 1,ne
-            tmp = nj_linear*A_g(:,i)
             r = r+1
             c = 0
 
             ! Pi derivatives
             do j = 1,ne
                 c = c+1
-                G(r,c) = dot_product(tmp, A_g(:,j))
+                G(r,c) = Gee(i,j)
             end do
 
             ! Condensed derivatives
@@ -1389,22 +1692,18 @@ contains
             ! Symmetric with (2.26) pi derivative
             if (const_p) then
                 c = c+1
-                G(r,c) = sum(tmp)
+                G(r,c) = t_sum(i)
                 G(c,r) = G(r,c)
             end if
 
             ! Delta ln(T) derivative
             if (.not. const_t) then
                 c = c+1
-                if (const_p) then
-                    G(r,c) = dot_product(tmp, h_g)
-                else
-                    G(r,c) = dot_product(tmp, u_g)
-                end if
+                G(r,c) = t_e(i)
             end if
 
             ! Right hand side
-            G(r,c+1) = b_delta(i) + dot_product(tmp, mu_g)
+            G(r,c+1) = b_delta(i) + t_mu(i)
 
         end do
 
@@ -1467,11 +1766,11 @@ contains
             ! Delta ln(T) derviative
             if (.not. const_t) then
                 c = c+1
-                G(r,c) = dot_product(nj_linear, h_g)
+                G(r,c) = dot_product(w(:m), h_a(:m))
             end if
 
             ! Right-hand-side
-            G(r,c+1) = n_delta + dot_product(nj_linear, mu_g)
+            G(r,c+1) = n_delta + dot_product(w(:m), mu_a(:m))
 
         end if
 
@@ -1484,22 +1783,22 @@ contains
 
             ! Select entropy/enthalpy constraint
             if (const_s) then
-                tmp = nj_linear*(h_g-mu_g)
+                tmp(:m) = w(:m)*(h_a(:m)-mu_a(:m))
                 h_or_s_or_u => soln%thermo%entropy(ng+1:)
             else if (const_h) then
-                tmp = nj_linear*h_g
+                tmp(:m) = w(:m)*h_a(:m)
                 h_or_s_or_u => soln%thermo%enthalpy(ng+1:)
             else if (const_u) then
-                tmp = nj_linear*u_g
+                tmp(:m) = w(:m)*u_a(:m)
                 h_or_s_or_u => soln%thermo%energy(ng+1:)
             end if
 
             ! Pi derivatives
             do j = 1,ne
                 c = c+1
-                G(r,c) = dot_product(tmp, A_g(:,j))
+                G(r,c) = dot_product(tmp(:m), A_a(:m,j))
                 if (.not. const_p .and. const_s) then
-                    G(r,c) = G(r,c) - dot_product(nj_linear, A_g(:, j))
+                    G(r,c) = G(r,c) - dot_product(w(:m), A_a(:m, j))
                 end if
             end do
 
@@ -1513,27 +1812,27 @@ contains
             ! Delta ln(n) derivative
             if (const_p) then
                 c = c+1
-                G(r,c) = sum(tmp)
+                G(r,c) = sum(tmp(:m))
             end if
 
             ! Delta ln(T) derivative
             c = c+1
             if (const_p) then
-                G(r,c) = dot_product(nj_eval, cp) + dot_product(tmp, h_g)
+                G(r,c) = dot_product(nj_eval, cp) + dot_product(tmp(:m), h_a(:m))
             else
-                G(r,c) = dot_product(nj_eval, cv) + dot_product(tmp, u_g)
+                G(r,c) = dot_product(nj_eval, cv) + dot_product(tmp(:m), u_a(:m))
                 if (const_s) then
-                    G(r,c) = G(r,c) - dot_product(nj_linear, u_g)
+                    G(r,c) = G(r,c) - dot_product(w(:m), u_a(:m))
                 end if
             end if
 
             ! Right-hand-side
-            G(r,c+1) = hsu_delta + dot_product(tmp, mu_g)
+            G(r,c+1) = hsu_delta + dot_product(tmp(:m), mu_a(:m))
             if (const_s) then
                 if (const_p) then
                     G(r,c+1) = G(r,c+1) + n_delta
                 else
-                    G(r,c+1) = G(r,c+1) - dot_product(nj_linear, mu_g)
+                    G(r,c+1) = G(r,c+1) - dot_product(w(:m), mu_a(:m))
                 end if
             end if
 
@@ -1554,12 +1853,11 @@ contains
         integer :: ng                              ! Number of gas species
         integer :: nc                              ! Number of condensed species
         integer :: na                              ! Number of active condensed species
-        integer :: i, j, idx_c                     ! Index
+        integer :: i, j, k, idx_c                  ! Index
         integer, allocatable :: active_idx(:)      ! Active condensed indices in legacy order
         real(dp) :: T_low_i, T_high_i              ! Low and high temperature limits for a species [K]
         real(dp) :: T_low_j, T_high_j              ! Low and high temperature limits for a species [K]
         real(dp) :: max_T_j                        ! Max melting temperature of the candidate phase [K]
-        integer, allocatable :: idx_other_phase(:) ! Indices of other phases of the same species
         real(dp), parameter :: dT_phase = 50.0d0   ! Temperature gap (above/below transition) to force phase change [K]
         real(dp), parameter :: dT_limit = 1.2d0    ! Factor of safety on high temperature range for a species to exist [unitless]
         real(dp), parameter :: T_tol = 1.d-3       ! Tolerance for temperature range comparison [K]
@@ -1585,23 +1883,21 @@ contains
 
             if (i == soln%j_sol .or. i == soln%j_liq) cycle
 
-            T_low_i  = minval(self%products%species(ng+i)%T_fit(:, 1))
-            T_high_i = maxval(self%products%species(ng+i)%T_fit(:, 2))
-
-            ! Get the indices of the other phases of the same species
-            idx_other_phase = get_species_other_phases(self%products%species_names(ng+i), &
-                                                       self%products)
+            T_low_i  = self%T_low_c(i)
+            T_high_i = self%T_high_c(i)
 
             ! Reset
             max_T_j = 0.0d0
 
-            do j = 1, size(idx_other_phase)
+            ! Loop over the phases of the same species
+            do k = self%phase_start(i), self%phase_start(i+1)-1
+                j = self%phase_list(k)
 
-                d_phase = self%products%species(ng+i)%i_phase - self%products%species(ng+idx_other_phase(j))%i_phase
+                d_phase = self%products%species(ng+i)%i_phase - self%products%species(ng+j)%i_phase
 
                 ! Get the temperature range of the cantidate phase
-                T_low_j  = minval(self%products%species(ng+idx_other_phase(j))%T_fit(:, 1))
-                T_high_j = maxval(self%products%species(ng+idx_other_phase(j))%T_fit(:, 2))
+                T_low_j  = self%T_low_c(j)
+                T_high_j = self%T_high_c(j)
 
                 if (T_high_j > max_T_j) max_T_j = T_high_j
 
@@ -1612,10 +1908,12 @@ contains
                         ! Check if the cantidate phase differs by more than 1
                         if (abs(d_phase) > 1) then
                             ! Switch phase
-                            call log_info("Phase change: replace "//trim(self%products%species_names(ng+i))//&
-                                          " with "//self%products%species_names(ng+idx_other_phase(j)))
-                            call soln%replace_active_condensed(i, idx_other_phase(j))
-                            soln%nj(ng+idx_other_phase(j)) = soln%nj(ng+i)
+                            if (log_enabled(log_levels%info)) then
+                                call log_info("Phase change: replace "//trim(self%products%species_names(ng+i))//&
+                                              " with "//self%products%species_names(ng+j))
+                            end if
+                            call soln%replace_active_condensed(i, j)
+                            soln%nj(ng+j) = soln%nj(ng+i)
                             soln%nj(ng+i) = 0.0d0
                             soln%converged = .false.
                             soln%j_switch = i
@@ -1627,21 +1925,23 @@ contains
                         end if
 
                         ! If the cantidate species is the one we just removed, keep both phases
-                        if (idx_other_phase(j) == soln%j_switch) then
-                            call log_debug("Cantidate phase ("//trim(self%products%species_names(ng+idx_other_phase(j)))//&
-                                           ") is the one that was removed last ("&
-                                           //trim(self%products%species_names(ng+i))//"). Keep both.")
+                        if (j == soln%j_switch) then
+                            if (log_enabled(log_levels%debug)) then
+                                call log_debug("Cantidate phase ("//trim(self%products%species_names(ng+j))//&
+                                               ") is the one that was removed last ("&
+                                               //trim(self%products%species_names(ng+i))//"). Keep both.")
+                            end if
                             soln%T = min(T_high_i, T_high_j)  ! Set T as the melting temperature
                             if (T_high_i > T_high_j) then
-                                soln%j_sol = idx_other_phase(j)
+                                soln%j_sol = j
                                 soln%j_liq = i
                             else
                                 soln%j_sol = i
-                                soln%j_liq = idx_other_phase(j)
+                                soln%j_liq = j
                             end if
-                            call soln%activate_condensed_front(idx_other_phase(j))
-                            soln%nj(ng+idx_other_phase(j)) = 0.5d0*soln%nj(ng+i)
-                            soln%nj(ng+i)                  = 0.5d0*soln%nj(ng+i)
+                            call soln%activate_condensed_front(j)
+                            soln%nj(ng+j) = 0.5d0*soln%nj(ng+i)
+                            soln%nj(ng+i) = 0.5d0*soln%nj(ng+i)
                             soln%converged = .false.
                             iter = -1
                             made_change = .true.
@@ -1651,10 +1951,12 @@ contains
                         ! The solution temperature is outside the allowable range for the existing phase
                         if (soln%T < (T_low_i-dT_phase) .or. soln%T > (T_high_i+dT_phase)) then
                             ! Switch phase
-                            call log_info("Phase change: replace "//trim(self%products%species_names(ng+i))//&
-                                          " with "//self%products%species_names(ng+idx_other_phase(j)))
-                            call soln%replace_active_condensed(i, idx_other_phase(j))
-                            soln%nj(ng+idx_other_phase(j)) = soln%nj(ng+i)
+                            if (log_enabled(log_levels%info)) then
+                                call log_info("Phase change: replace "//trim(self%products%species_names(ng+i))//&
+                                              " with "//self%products%species_names(ng+j))
+                            end if
+                            call soln%replace_active_condensed(i, j)
+                            soln%nj(ng+j) = soln%nj(ng+i)
                             soln%nj(ng+i) = 0.0d0
                             soln%converged = .false.
                             soln%j_switch = i
@@ -1666,18 +1968,18 @@ contains
                         end if
 
                         ! else
-                        call log_debug("Adding "//self%products%species_names(ng+idx_other_phase(j)))
+                        if (log_enabled(log_levels%debug)) call log_debug("Adding "//self%products%species_names(ng+j))
                         soln%T = min(T_high_i, T_high_j)  ! Set T as the melting temperature
                         if (T_high_i > T_high_j) then
-                            soln%j_sol = idx_other_phase(j)
+                            soln%j_sol = j
                             soln%j_liq = i
                         else
                             soln%j_sol = i
-                            soln%j_liq = idx_other_phase(j)
+                            soln%j_liq = j
                         end if
-                        call soln%activate_condensed_front(idx_other_phase(j))
-                        soln%nj(ng+idx_other_phase(j)) = 0.5d0*soln%nj(ng+i)
-                        soln%nj(ng+i)                  = 0.5d0*soln%nj(ng+i)
+                        call soln%activate_condensed_front(j)
+                        soln%nj(ng+j) = 0.5d0*soln%nj(ng+i)
+                        soln%nj(ng+i) = 0.5d0*soln%nj(ng+i)
                         soln%converged = .false.
                         iter = -1
                         made_change = .true.
@@ -1691,7 +1993,7 @@ contains
 
             if (soln%T > 1.2d0*max_T_j) then
                 ! Remove condensed species
-                call log_info("Removing condensed species: "//self%products%species_names(ng+i))
+                if (log_enabled(log_levels%info)) call log_info("Removing condensed species: "//self%products%species_names(ng+i))
                 call soln%deactivate_condensed(i)
                 soln%nj(ng+i) = 0.0d0
                 soln%converged = .false.
@@ -1750,7 +2052,7 @@ contains
         ! Associate subarray pointers
         nj_c => soln%nj(ng+1:)
         cp_c => soln%thermo%cp(ng+1:)
-        A_c => self%products%stoich_matrix(ng+1:,:)
+        A_c => self%stoich_matrix(ng+1:,:)
         h_c => soln%thermo%enthalpy(ng+1:)
         s_c => soln%thermo%entropy(ng+1:)
         pi => soln%pi_prev
@@ -1785,7 +2087,7 @@ contains
                 soln%nj(ng+cond_idx) = 0.0d0
                 soln%converged = .false.
                 iter = -1
-                call log_info("Removing "//self%products%species_names(ng+cond_idx))
+                if (log_enabled(log_levels%info)) call log_info("Removing "//self%products%species_names(ng+cond_idx))
                 return
             end if
 
@@ -1804,9 +2106,8 @@ contains
             if (soln%is_active(i)) cycle
 
             ! Check if this species can be present at the current temperature
-            if (soln%T >= minval(self%products%species(ng+i)%T_fit(:, 1)) .or. &
-                T_min == minval(self%products%species(ng+i)%T_fit(:, 1))) then
-                if (soln%T <= maxval(self%products%species(ng+i)%T_fit(:, 2))) then
+            if (soln%T >= self%T_low_c(i) .or. T_min == self%T_low_c(i)) then
+                if (soln%T <= self%T_high_c(i)) then
 
                     temp = 0.0d0
                     if (ne > 0) temp = dot_product(A_c(i,:ne), pi(:ne))
@@ -1834,7 +2135,7 @@ contains
             soln%converged = .false.
             iter = -1
             soln%last_cond_idx = cond_idx
-            call log_info("Adding "//self%products%species_names(ng+cond_idx))
+            if (log_enabled(log_levels%info)) call log_info("Adding "//self%products%species_names(ng+cond_idx))
             return
         else
             call abort('EqSolver_test_condensed: Re-insertion of '// &
@@ -1881,8 +2182,8 @@ contains
         ne = self%num_active_elements()
         na = count(soln%is_active)
         active_idx = soln%active_condensed_indices()
-        A => self%products%stoich_matrix(ng+1:,:)
-        A_all => self%products%stoich_matrix(:,:)
+        A => self%stoich_matrix(ng+1:,:)
+        A_all => self%stoich_matrix(:,:)
 
         self%xsize = 80.0d0
         self%tsize = 80.0d0
@@ -1912,8 +2213,10 @@ contains
             end do
             ! Remove condensed species contributing to singular matrix
             if (idx > 0) then
-                call log_info("Removing condensed species "//self%products%species_names(ng+idx)// &
-                              " to correct singular matrix")
+                if (log_enabled(log_levels%info)) then
+                    call log_info("Removing condensed species "//self%products%species_names(ng+idx)// &
+                                  " to correct singular matrix")
+                end if
                 call soln%deactivate_condensed(idx)
                 soln%nj(ng+idx) = 0.0d0
                 soln%converged = .false.
@@ -1939,8 +2242,10 @@ contains
             end do
 
             if (idx > 0) then
-                call log_info("Removing condensed species "//self%products%species_names(ng+idx)// &
-                              " to correct element-row singularity")
+                if (log_enabled(log_levels%info)) then
+                    call log_info("Removing condensed species "//self%products%species_names(ng+idx)// &
+                                  " to correct element-row singularity")
+                end if
                 call soln%deactivate_condensed(idx)
                 soln%nj(ng+idx) = 0.0d0
                 soln%converged = .false.
@@ -1972,7 +2277,7 @@ contains
         ! ionized species from the active iterate and disable ion solving.
         if (.not. made_change .and. ierr >= 1 .and. ierr <= ne .and. &
             self%ions .and. self%active_ions .and. self%num_elements > 0) then
-            if (trim(self%products%element_names(self%num_elements)) == 'E' .and. ierr == ne) then
+            if (trim(self%products%element_names(self%element_order(self%num_elements))) == 'E' .and. ierr == ne) then
                 do i = 1, ng
                     if (A_all(i, self%num_elements) /= 0.0d0) then
                         soln%nj(i) = 0.0d0
@@ -1993,8 +2298,10 @@ contains
         ! Legacy component-reduction fallback for persistent element-row singularities.
         if (.not. made_change .and. ierr >= 1 .and. ierr <= ne .and. iter < 1 .and. &
             ne > 1 .and. .not. (self%ions .and. self%active_ions)) then
-            call log_info("Reducing active element equations after singular restart on "// &
-                          trim(self%products%element_names(ierr)))
+            if (log_enabled(log_levels%info)) then
+                call log_info("Reducing active element equations after singular restart on "// &
+                              trim(self%products%element_names(self%element_order(ierr))))
+            end if
             if (ierr /= ne) call EqSolver_swap_elements(self, soln, ierr, ne)
             self%reduced_elements = self%reduced_elements + 1
             soln%pi(ne) = 0.0d0
@@ -2049,7 +2356,7 @@ contains
             return
         end if
 
-        A => self%products%stoich_matrix
+        A => self%stoich_matrix
         nn = ne
         if (self%ions .and. self%active_ions) nn = max(1, ne-1)
 
@@ -2185,11 +2492,12 @@ contains
 
     end subroutine
 
-    subroutine EqSolver_post_process(self, soln, computed_partials)
+    subroutine EqSolver_post_process(self, soln, computed_partials, properties)
         ! Arguments
         class(EqSolver), intent(in), target :: self
         type(EqSolution), intent(inout), target :: soln
         logical, intent(in), optional :: computed_partials
+        logical, intent(in), optional :: properties  ! Compute the mixture properties (default true)
 
         ! Locals
         integer :: i
@@ -2203,8 +2511,23 @@ contains
         soln%mass_fractions = soln%nj * self%products%species%molecular_weight / &
             sum(soln%nj * self%products%species%molecular_weight)
 
-        ! Add mixture properties
         soln%pressure = soln%calc_pressure()
+
+        ! Calculate molecular weights
+        soln%M = 1.0d0/soln%n
+        soln%MW = 1.0d0
+        do i = 1, self%num_condensed
+            if (soln%is_active(i)) then
+                soln%MW = soln%MW - soln%mole_fractions(self%num_gas+i)
+            end if
+        end do
+        soln%MW = soln%M*soln%MW
+
+        if (present(properties)) then
+            if (.not. properties) return
+        end if
+
+        ! Add mixture properties
         soln%volume   = soln%calc_volume()
         soln%density  = 1.0d0/soln%volume
 
@@ -2218,16 +2541,6 @@ contains
             soln%cp_eq = dot_product(soln%thermo%cp, soln%nj) * R / 1.d3
         end if
 
-        ! Calculate molecular weights
-        soln%M = 1.0d0/soln%n
-        soln%MW = 1.0d0
-        do i = 1, self%num_condensed
-            if (soln%is_active(i)) then
-                soln%MW = soln%MW - soln%mole_fractions(self%num_gas+i)
-            end if
-        end do
-        soln%MW = soln%M*soln%MW
-
         ! Calculate Cv
         soln%cv_fr = soln%cp_fr - soln%n*R/1.d3
 
@@ -2236,6 +2549,117 @@ contains
 
     end subroutine
 
+    subroutine EqSolver_finish_outputs(self, soln, partials, num_reduced, reduced_from, reduced_to)
+        ! Compute the outputs of a converged solution that the output mask selects, and
+        ! mark the others pending. Partials passed by the caller are always computed.
+        ! The solution keeps the ion and element-reduction state for compute_outputs,
+        ! since later solves change the solver's own.
+
+        ! Arguments
+        class(EqSolver), target :: self
+        type(EqSolution), intent(inout), target :: soln
+        type(EqPartials), intent(out), optional :: partials
+        integer, intent(in), optional :: num_reduced      ! Element swaps of the component reduction
+        integer, intent(in), optional :: reduced_from(:)
+        integer, intent(in), optional :: reduced_to(:)
+
+        ! Locals
+        type(EqPartials) :: partials_
+
+        soln%pending = 0
+        soln%caller_partials = present(partials)
+        soln%active_ions = self%active_ions
+        soln%num_reduced = 0
+        if (present(num_reduced)) then
+            soln%num_reduced = num_reduced
+            soln%reduced_from(:num_reduced) = reduced_from(:num_reduced)
+            soln%reduced_to(:num_reduced) = reduced_to(:num_reduced)
+        end if
+
+        ! Compute the partial derivatives; transport solvers compute them unasked
+        if (present(partials)) then
+            call profile_enter(self%profile, 'partials')
+            partials = EqPartials(self%num_elements, count(soln%is_active))
+            call partials%compute_partials(self, soln)
+            call profile_leave(self%profile)
+        else if (self%transport .and. iand(self%outputs, output_partials) /= 0) then
+            call profile_enter(self%profile, 'partials')
+            partials_ = EqPartials(self%num_elements, count(soln%is_active))
+            call partials_%compute_partials(self, soln)
+            call profile_leave(self%profile)
+        else if (self%transport) then
+            soln%pending = ior(soln%pending, output_partials)
+        end if
+
+        ! Compute transport properties
+        if (self%transport .and. iand(self%outputs, output_transport) /= 0) then
+            call profile_enter(self%profile, 'transport')
+            call self%update_transport_basis(soln)
+            call compute_transport_properties(self, soln)
+            call profile_leave(self%profile)
+        else if (self%transport) then
+            soln%pending = ior(soln%pending, output_transport)
+        end if
+
+        ! Compute post-processing solution values
+        call profile_enter(self%profile, 'post_process')
+        call self%post_process(soln, present(partials), iand(self%outputs, output_properties) /= 0)
+        if (iand(self%outputs, output_properties) == 0) soln%pending = ior(soln%pending, output_properties)
+        call profile_leave(self%profile)
+
+    end subroutine
+
+    subroutine EqSolver_compute_outputs(self, soln, outputs)
+        ! Compute pending outputs of a solution from this solver; outputs already
+        ! computed are left alone, so getters may call this before every read.
+
+        ! Arguments
+        class(EqSolver), target :: self
+        type(EqSolution), intent(inout), target :: soln
+        integer, intent(in), optional :: outputs  ! output_* flags; default output_all
+
+        ! Locals
+        type(EqPartials) :: partials
+        integer :: i, todo, was_pending
+        real(dp) :: cp_fr
+        logical :: active_ions
+
+        todo = output_all
+        if (present(outputs)) todo = outputs
+        todo = iand(todo, soln%pending)
+        if (todo == 0) return
+        was_pending = soln%pending
+        soln%pending = iand(soln%pending, not(todo))
+
+        ! Replay the ion and element-reduction state the solve finished with
+        active_ions = self%active_ions
+        self%active_ions = soln%active_ions
+        do i = 1, soln%num_reduced
+            call EqSolver_swap_elements(self, soln, soln%reduced_from(i), soln%reduced_to(i))
+        end do
+        self%reduced_elements = soln%num_reduced
+
+        if (iand(todo, output_partials) /= 0) then
+            ! Transport replaces the frozen heat capacity; keep its value if it came first
+            cp_fr = soln%cp_fr
+            partials = EqPartials(self%num_elements, count(soln%is_active))
+            call partials%compute_partials(self, soln)
+            if (iand(was_pending, output_transport) == 0) soln%cp_fr = cp_fr
+        end if
+
+        if (iand(todo, output_transport) /= 0) then
+            call self%update_transport_basis(soln)
+            call compute_transport_properties(self, soln)
+        end if
+
+        ! The mixture properties depend on the heat capacities set above
+        if (iand(todo, output_properties) /= 0) call self%post_process(soln, soln%caller_partials)
+
+        call EqSolver_restore_reduced_elements(self, soln, soln%num_reduced, soln%reduced_from, soln%reduced_to)
+        self%active_ions = active_ions
+
+    end subroutine
+
     subroutine EqSolution_reset_iteration_state(soln)
         ! Reset transient Newton-update state before each solve call.
         ! This allows EqSolution instances to be safely reused across solves.
@@ -2301,6 +2725,24 @@ contains
         real(dp), intent(in) :: reactant_weights(:)
         type(EqPartials), intent(out), optional :: partials
 
+        call profile_enter(self%profile, 'equilibrium')
+        call EqSolver_solve_point(self, soln, type, state1, state2, reactant_weights, partials)
+        call profile_leave(self%profile)
+
+    end subroutine
+
+    subroutine EqSolver_solve_point(self, soln, type, state1, state2, reactant_weights, partials)
+        ! Newton iteration for one equilibrium state; called by EqSolver_solve
+
+        ! Arguments
+        class(EqSolver), target :: self
+        type(EqSolution), intent(inout), target :: soln
+        character(2), intent(in) :: type
+        real(dp), intent(in) :: state1
+        real(dp), intent(in) :: state2
+        real(dp), intent(in) :: reactant_weights(:)
+        type(EqPartials), intent(out), optional :: partials
+
         ! Locals
         integer :: i, iter, ierr, num_eqn, times_singular
         integer :: cond_idx
@@ -2311,10 +2753,10 @@ contains
         integer :: phase_iter, phase_pass
         real(dp) :: gas_moles, xi, xln
         real(dp), pointer :: G(:, :)
-        type(EqPartials) :: partials_
         logical :: made_change, max_iter_fallback_used, was_converged
 
         call log_debug("Starting Eq. Solve.")
+        soln%pending = 0
 
         ! If the prior solve did not converge, restore the last stable iterate
         ! seed before applying new constraints for this solve call.
@@ -2353,16 +2795,20 @@ contains
         reduced_to = 0
 
         ! Pre-check active condensed phases before the first Newton matrix build.
+        call profile_enter(self%profile, 'condensed')
         phase_iter = 0
         do phase_pass = 1, self%num_condensed + 1
             call self%check_condensed_phases(soln, phase_iter, made_change)
             if (.not. made_change) exit
         end do
+        call profile_leave(self%profile)
 
         ! Initial call of the thermodynamic properties.
         ! Compute condensed thermo too so the first Newton build does not use
         ! stale condensed values when active condensed species are present.
-        call self%products%calc_thermo(soln%thermo, soln%T, condensed=.true.)
+        call profile_enter(self%profile, 'thermo')
+        call self%products%update_thermo(soln%thermo, soln%T, condensed=.true.)
+        call profile_leave(self%profile)
 
         ierr = 0
         iter = 0
@@ -2373,13 +2819,17 @@ contains
             iter = iter + 1
 
             ! Assemble the matrix
+            call profile_enter(self%profile, 'assemble_matrix')
             call self%assemble_matrix(soln)
+            call profile_leave(self%profile)
 
             ! Get the size of the matrix that we need
             num_eqn = soln%num_equations(self)
             G => soln%G(:num_eqn, :num_eqn+1)
 
+            call profile_enter(self%profile, 'gauss')
             call gauss(G, ierr)
+            call profile_leave(self%profile)
 
             if (ierr == 0) then
                 call self%update_solution(soln)
@@ -2391,7 +2841,9 @@ contains
                 if (.not. soln%converged) cycle
 
             else
-                call log_warning('Singular update matrix encountered at iteration '//to_str(iter))
+                if (log_enabled(log_levels%warning)) then
+                    call log_warning('Singular update matrix encountered at iteration '//to_str(iter))
+                end if
 
                 times_singular = times_singular + 1
                 if (times_singular > 8) then
@@ -2426,7 +2878,9 @@ contains
             end if
 
             ! Initial convergence; check on adding or removing condensed species
+            call profile_enter(self%profile, 'condensed')
             call self%test_condensed(soln, iter, singular_index)
+            call profile_leave(self%profile)
 
             if (soln%converged .or. (iter == self%max_iterations)) then
 
@@ -2469,38 +2923,23 @@ contains
                             soln%converged = .false.
                             soln%times_converged = 0
                             iter = -1
-                            call self%products%calc_thermo(soln%thermo, soln%T, condensed=.false.)
+                            call profile_enter(self%profile, 'thermo')
+                            call self%products%update_thermo(soln%thermo, soln%T, condensed=.false.)
+                            call profile_leave(self%profile)
                             cycle
                         end if
                     end if
 
+                    call profile_enter(self%profile, 'post_process')
                     call self%post_process(soln, .false.)
+                    call profile_leave(self%profile)
                     call EqSolver_restore_reduced_elements(self, soln, num_reduced, reduced_from, reduced_to)
                     call log_warning('EqSolver_solve: Maximum iterations reached without convergence')
                     return
                 end if
 
-                ! Compute the partial derivatives
-                if (present(partials) .or. self%transport) then
-
-                    if (present(partials)) then
-                        partials = EqPartials(self%num_elements, count(soln%is_active))
-                        call partials%compute_partials(self, soln)
-                    else  ! Transport; partials are required
-                        partials_ = EqPartials(self%num_elements, count(soln%is_active))
-                        call partials_%compute_partials(self, soln)
-                    end if
-
-                end if
-
-                ! Compute transport properties
-                if (self%transport) then
-                    call self%update_transport_basis(soln)
-                    call compute_transport_properties(self, soln)
-                end if
-
-                ! Compute post-processing solution values
-                call self%post_process(soln, present(partials))
+                ! Compute the partials, transport and post-processing values the mask selects
+                call self%finish_outputs(soln, partials, num_reduced, reduced_from, reduced_to)
 
                 ! Check for temperature outside of bounds
                 if (soln%T > self%T_max .or. soln%T < self%T_min) then
@@ -2524,51 +2963,69 @@ contains
     !-----------------------------------------------------------------------
     ! EqDerivatives
     !-----------------------------------------------------------------------
-    function EqDerivatives_init(solver, solution) result(self)
+    function EqDerivatives_init(solver, solution, outputs) result(self)
 
         ! Arguments
         type(EqSolver), intent(in) :: solver
         type(EqSolution), intent(in) :: solution
+        integer, intent(in), optional :: outputs  ! deriv_* flags; default deriv_all
         type(EqDerivatives) :: self
 
         ! Locals
-        integer :: m, n, nr, ns
+        integer :: m, n, nr, ns, ne
 
         m = solution%num_equations(solver)
         n = solver%num_elements + 2
         nr = solver%num_reactants
+        ne = solver%num_elements
         ns = solver%num_gas + count(solution%is_active)  ! Number of species (gas + active condensed)
         self%m = m
         self%n = n
+        if (present(outputs)) call self%select(outputs)
 
         allocate(self%R(m), source=empty_dp)
         allocate(self%J(m, m), source=empty_dp)
         allocate(self%Rx(m, n), source=empty_dp)
         allocate(self%dudx(m, n), source=empty_dp)
 
-        allocate(self%delta_check(m, n), source=empty_dp)
-
-        allocate(self%dT_dw0(nr), source=empty_dp)
-        allocate(self%dn_dw0(nr), source=empty_dp)
-        allocate(self%dnj_dstate1(ns), source=empty_dp)
-        allocate(self%dnj_dstate2(ns), source=empty_dp)
-        allocate(self%dnj_dw0(ns, nr), source=empty_dp)
-        allocate(self%dH_dw0(nr), source=empty_dp)
-        allocate(self%dU_dw0(nr), source=empty_dp)
-        allocate(self%dG_dw0(nr), source=empty_dp)
-        allocate(self%dS_dw0(nr), source=empty_dp)
-        allocate(self%dCp_fr_dw0(nr), source=empty_dp)
-
-        allocate(self%dT_dw0_fd(nr), source=empty_dp)
-        allocate(self%dn_dw0_fd(nr), source=empty_dp)
-        allocate(self%dnj_dstate1_fd(ns), source=empty_dp)
-        allocate(self%dnj_dstate2_fd(ns), source=empty_dp)
-        allocate(self%dnj_dw0_fd(ns, nr), source=empty_dp)
-        allocate(self%dH_dw0_fd(nr), source=empty_dp)
-        allocate(self%dU_dw0_fd(nr), source=empty_dp)
-        allocate(self%dG_dw0_fd(nr), source=empty_dp)
-        allocate(self%dS_dw0_fd(nr), source=empty_dp)
-        allocate(self%dCp_fr_dw0_fd(nr), source=empty_dp)
+        ! Output arrays; the rest are allocated on first use
+        if (self%is_selected(ior(deriv_T, deriv_wrt_w0))) allocate(self%dT_dw0(nr), source=empty_dp)
+        if (self%is_selected(ior(deriv_n, deriv_wrt_w0))) allocate(self%dn_dw0(nr), source=empty_dp)
+        if (self%is_selected(ior(deriv_nj, deriv_wrt_state1))) allocate(self%dnj_dstate1(ns), source=empty_dp)
+        if (self%is_selected(ior(deriv_nj, deriv_wrt_state2))) allocate(self%dnj_dstate2(ns), source=empty_dp)
+        if (self%is_selected(ior(deriv_nj, deriv_wrt_w0))) allocate(self%dnj_dw0(ns, nr), source=empty_dp)
+        if (self%is_selected(ior(deriv_T, deriv_wrt_b0))) allocate(self%dT_db0(ne), source=empty_dp)
+        if (self%is_selected(ior(deriv_n, deriv_wrt_b0))) allocate(self%dn_db0(ne), source=empty_dp)
+        if (self%is_selected(ior(deriv_nj, deriv_wrt_b0))) allocate(self%dnj_db0(ns, ne), source=empty_dp)
+        if (self%is_selected(ior(deriv_H, deriv_wrt_w0))) allocate(self%dH_dw0(nr), source=empty_dp)
+        if (self%is_selected(ior(deriv_U, deriv_wrt_w0))) allocate(self%dU_dw0(nr), source=empty_dp)
+        if (self%is_selected(ior(deriv_G, deriv_wrt_w0))) allocate(self%dG_dw0(nr), source=empty_dp)
+        if (self%is_selected(ior(deriv_S, deriv_wrt_w0))) allocate(self%dS_dw0(nr), source=empty_dp)
+        if (self%is_selected(ior(deriv_Cp_fr, deriv_wrt_w0))) allocate(self%dCp_fr_dw0(nr), source=empty_dp)
+
+    end function
+
+    subroutine EqDerivatives_select(self, outputs)
+        ! Select the derivatives computed by compute_derivatives/unpack_values
+
+        ! Arguments
+        class(EqDerivatives), intent(inout) :: self
+        integer, intent(in) :: outputs  ! deriv_* flags
+
+        self%outputs = iand(outputs, deriv_all)
+        if (iand(self%outputs, deriv_quantities) == 0) self%outputs = ior(self%outputs, deriv_quantities)
+        if (iand(self%outputs, deriv_inputs) == 0) self%outputs = ior(self%outputs, deriv_inputs)
+
+    end subroutine
+
+    logical function EqDerivatives_is_selected(self, flags) result(selected)
+        ! True if every quantity and input in flags is selected
+
+        ! Arguments
+        class(EqDerivatives), intent(in) :: self
+        integer, intent(in) :: flags  ! deriv_* flags
+
+        selected = iand(self%outputs, flags) == flags
 
     end function
 
@@ -2632,8 +3089,8 @@ contains
         const_u = cons%is_constant_energy()
 
         ! Associate subarray pointers
-        A_g => solver%products%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
-        A_c => solver%products%stoich_matrix(ng+1:,:)
+        A_g => solver%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
+        A_c => solver%stoich_matrix(ng+1:,:)
         n = solution%n
         nj  => solution%nj
         nj_g => solution%nj(:ng)
@@ -2830,7 +3287,7 @@ contains
         const_u = cons%is_constant_energy()
 
         ! Associate subarray pointers
-        A_c => solver%products%stoich_matrix(ng+1:, :)
+        A_c => solver%stoich_matrix(ng+1:, :)
         nj => solution%nj
         nj_g => solution%nj(:ng)
         h_c => solution%thermo%enthalpy(ng+1:)
@@ -2838,7 +3295,7 @@ contains
         pi => solution%pi
 
         ! Evaluate constraint residuals
-        b_delta = cons%b0 - solver%products%elements_from_species(nj)
+        b_delta = cons%b0 - solver%elements_from_species(nj)
         n_delta = solution%n - sum(nj_g)
         if (const_s) then
             hsu_delta = cons%state1 - solution%calc_entropy_sum(solver)
@@ -2893,7 +3350,10 @@ contains
         lverbose = .false.
         if (present(verbose)) lverbose = verbose
 
+        call alloc_deriv(self%delta_check, self%m, self%n)
+        self%delta_check = 0.0d0
         do i = 1, self%n
+            if (.not. deriv_column_selected(self%outputs, i)) cycle
             self%delta_check(:, i) = matmul(self%J, self%dudx(:, i)) + self%Rx(:, i)
             if (lverbose) then
                 write(*,*) "max|delta| row=", maxloc(abs(self%delta_check(:, i))), " val=", maxval(abs(self%delta_check(:, i)))
@@ -2983,6 +3443,8 @@ contains
         real(dp) :: fac
         logical :: ion_species
         logical :: const_p, const_t, const_s, const_h, const_u  ! Flags enabling/disabling matrix equations
+        logical :: wrt_b, wrt_w                 ! Derivatives wrt b0/w0 selected
+        logical :: need_nj, need_H, need_S, need_Cp  ! Quantities needed by the selected outputs
         type(EqConstraints), pointer :: cons    ! Abbreviation for soln%constraints
 
         ! Define shorthand
@@ -2999,9 +3461,18 @@ contains
         const_h = cons%is_constant_enthalpy()
         const_u = cons%is_constant_energy()
 
+        ! Work out what the selected outputs need; state1/state2 terms are cheap and always computed
+        wrt_w = iand(self%outputs, deriv_wrt_w0) /= 0
+        wrt_b = wrt_w .or. iand(self%outputs, deriv_wrt_b0) /= 0
+        need_H = iand(self%outputs, ior(deriv_H, ior(deriv_U, deriv_G))) /= 0
+        need_S = iand(self%outputs, ior(deriv_S, deriv_G)) /= 0
+        need_Cp = iand(self%outputs, deriv_Cp_fr) /= 0
+        need_nj = need_H .or. need_S .or. need_Cp .or. iand(self%outputs, deriv_nj) /= 0 &
+            .or. (.not. const_p .and. iand(self%outputs, deriv_n) /= 0)
+
         ! Associate subarray pointers
-        A_g => solver%products%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
-        A_c => solver%products%stoich_matrix(ng+1:,:)
+        A_g => solver%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
+        A_c => solver%stoich_matrix(ng+1:,:)
         n = solution%n
         nj  => solution%nj
         nj_g => solution%nj(:ng)
@@ -3019,16 +3490,24 @@ contains
         T = solution%T
 
         ! Compute intermediate derivatives
-        do i = 1, ng
-            dh_g_dT(i) = solver%products%species(i)%calc_denthalpy_dT(T)/T - h_g(i)/T
-            ds_g_dT(i) = solver%products%species(i)%calc_dentropy_dT(T)
-            dcp_g_dT(i) = solver%products%species(i)%calc_dcp_dT(T)
-        end do
-        do i = 1, nc
-            dh_c_dT(i) = solver%products%species(ng+i)%calc_denthalpy_dT(T)/T - h_c(i)/T
-            ds_c_dT(i) = solver%products%species(ng+i)%calc_dentropy_dT(T)
-            dcp_c_dT(i) = solver%products%species(ng+i)%calc_dcp_dT(T)
-        end do
+        if (need_nj) then
+            do i = 1, ng
+                dh_g_dT(i) = solver%products%species(i)%calc_denthalpy_dT(T)/T - h_g(i)/T
+                ds_g_dT(i) = solver%products%species(i)%calc_dentropy_dT(T)
+            end do
+            do i = 1, nc
+                dh_c_dT(i) = solver%products%species(ng+i)%calc_denthalpy_dT(T)/T - h_c(i)/T
+                ds_c_dT(i) = solver%products%species(ng+i)%calc_dentropy_dT(T)
+            end do
+        end if
+        if (need_Cp) then
+            do i = 1, ng
+                dcp_g_dT(i) = solver%products%species(i)%calc_dcp_dT(T)
+            end do
+            do i = 1, nc
+                dcp_c_dT(i) = solver%products%species(ng+i)%calc_dcp_dT(T)
+            end do
+        end if
 
         ! Set indices for ln(T) and ln(n) derivatives in du/dx
         if (const_t) then
@@ -3048,13 +3527,15 @@ contains
         end if
 
         ! Pre-compute db0/dw0 as a common term
-        w_sum = sum(solution%w0)
-        inv_w_sum = 1.0d0 / w_sum
-        do j = 1, nr
-            db0_dw0(:, j) = solver%reactants%stoich_matrix(j, :) / &
-                solver%reactants%species(j)%molecular_weight
-            db0_dw0(:, j) = (db0_dw0(:, j) - cons%b0) * inv_w_sum
-        end do
+        if (wrt_w) then
+            w_sum = sum(solution%w0)
+            inv_w_sum = 1.0d0 / w_sum
+            do j = 1, nr
+                db0_dw0(:, j) = solver%reactants%stoich_matrix(j, :) / &
+                    solver%reactants%species(j)%molecular_weight
+                db0_dw0(:, j) = (db0_dw0(:, j) - cons%b0) * inv_w_sum
+            end do
+        end if
 
         fac = R / 1.d3
         ln_n = log(n)
@@ -3062,22 +3543,25 @@ contains
         ln_threshold = ln_n - solver%tsize
 
         allocate(ln_nj_eff(ng), nj_g_eff(ng), dnj_dln_nj(ng), dln_nj_eff_dln_nj(ng), dln_nj_amount_dln_nj(ng))
-        do i = 1, ng
-            call compute_nj_effective(ln_nj(i), ln_threshold, solver%smooth_truncation, solver%truncation_width, &
-                                      nj_eff=nj_g_eff(i), ln_nj_eff=ln_nj_eff(i), dln_nj_eff_dln_nj=dln_nj_eff_dln_nj(i))
-            ion_species = solver%ions .and. solver%active_ions .and. ne > 0 .and. A_g(i, ne) /= 0.0d0
-            ln_threshold_nj = gas_amount_ln_threshold(ln_n, solver%tsize, solver%esize, ion_species)
-            call compute_nj_effective(ln_nj(i), ln_threshold_nj, solver%smooth_truncation, solver%truncation_width, &
-                                      nj_eff=nj_g_eff(i), dln_nj_eff_dln_nj=dln_nj_amount_dln_nj(i))
-            if (solver%smooth_truncation) then
-                dnj_dln_nj(i) = exp(ln_nj(i)) * dln_nj_amount_dln_nj(i)
-            else
-                dnj_dln_nj(i) = nj_g_eff(i)
-            end if
-        end do
+        if (need_nj) then
+            do i = 1, ng
+                call compute_nj_effective(ln_nj(i), ln_threshold, solver%smooth_truncation, solver%truncation_width, &
+                                          nj_eff=nj_g_eff(i), ln_nj_eff=ln_nj_eff(i), &
+                                          dln_nj_eff_dln_nj=dln_nj_eff_dln_nj(i))
+                ion_species = solver%ions .and. solver%active_ions .and. ne > 0 .and. A_g(i, ne) /= 0.0d0
+                ln_threshold_nj = gas_amount_ln_threshold(ln_n, solver%tsize, solver%esize, ion_species)
+                call compute_nj_effective(ln_nj(i), ln_threshold_nj, solver%smooth_truncation, solver%truncation_width, &
+                                          nj_eff=nj_g_eff(i), dln_nj_eff_dln_nj=dln_nj_amount_dln_nj(i))
+                if (solver%smooth_truncation) then
+                    dnj_dln_nj(i) = exp(ln_nj(i)) * dln_nj_amount_dln_nj(i)
+                else
+                    dnj_dln_nj(i) = nj_g_eff(i)
+                end if
+            end do
 
-        ! Compute gas phase chemical potentials
-        mu_g = h_g - s_g + ln_nj_eff + log(P/n)
+            ! Compute gas phase chemical potentials
+            mu_g = h_g - s_g + ln_nj_eff + log(P/n)
+        end if
 
         if (na > 0) then
             allocate(active_cond_idx(na))
@@ -3110,10 +3594,13 @@ contains
         end if
 
         ! dT/dw0:
-        if (const_t) then
-            self%dT_dw0 = 0.0d0
-        else
-            self%dT_dw0 = T*matmul(self%dudx(lnT_idx, 3:ne+2), db0_dw0)
+        if (wrt_w) then
+            call alloc_deriv(self%dT_dw0, nr)
+            if (const_t) then
+                self%dT_dw0 = 0.0d0
+            else
+                self%dT_dw0 = T*matmul(self%dudx(lnT_idx, 3:ne+2), db0_dw0)
+            end if
         end if
 
         ! ---------------------------------------------------------
@@ -3135,10 +3622,13 @@ contains
         end if
 
         ! dn/dw0:
-        if (const_p) then
-            self%dn_dw0 = n*matmul(self%dudx(lnn_idx, 3:ne+2), db0_dw0)  ! dn/dw0 = n*d(ln(n))/dw0
-        else
-            self%dn_dw0 = 0.0d0
+        if (wrt_w) then
+            call alloc_deriv(self%dn_dw0, nr)
+            if (const_p) then
+                self%dn_dw0 = n*matmul(self%dudx(lnn_idx, 3:ne+2), db0_dw0)  ! dn/dw0 = n*d(ln(n))/dw0
+            else
+                self%dn_dw0 = 0.0d0
+            end if
         end if
 
         ! ---------------------------------------------------------
@@ -3147,12 +3637,6 @@ contains
 
         allocate(dT_db0(ne), dn_db0(ne))
         allocate(dlogP_over_n_db0(ne), dlogP_over_n_dw0(nr))
-        allocate(dln_nj_dstate1(ng), dln_nj_dstate2(ng))
-        allocate(dln_nj_eff_dstate1(ng), dln_nj_eff_dstate2(ng))
-        allocate(dln_nj_db0(ng, ne), dln_nj_dw0(ng, nr))
-        allocate(dln_nj_eff_dw0(ng, nr))
-        allocate(dnj_db0(ng+na, ne))
-        allocate(dS_sum_dw0(nr))
 
         if (const_t) then
             dT_db0 = 0.0d0
@@ -3170,289 +3654,315 @@ contains
             dlogP_over_n_state1 = -self%dn_dstate1 / n
             dlogP_over_n_state2 = 1.0d0/P - self%dn_dstate2 / n
             dlogP_over_n_db0 = -dn_db0 / n
-            dlogP_over_n_dw0 = -self%dn_dw0 / n
+            if (wrt_w) dlogP_over_n_dw0 = -self%dn_dw0 / n
         else
             dlogP_over_n_state1 = self%dT_dstate1 / T
             dlogP_over_n_state2 = self%dT_dstate2 / T - 1.0d0/cons%state2
             dlogP_over_n_db0 = dT_db0 / T
-            dlogP_over_n_dw0 = self%dT_dw0 / T
+            if (wrt_w) dlogP_over_n_dw0 = self%dT_dw0 / T
         end if
 
-        dln_nj_dstate1 = 0.0d0
-        dln_nj_dstate2 = 0.0d0
-        dln_nj_eff_dstate1 = 0.0d0
-        dln_nj_eff_dstate2 = 0.0d0
-        dln_nj_db0 = 0.0d0
-        dln_nj_eff_dw0 = 0.0d0
-        dnj_db0 = 0.0d0
-        self%dnj_dstate1 = 0.0d0
-        self%dnj_dstate2 = 0.0d0
-
-        ! ln(nj) = dot(A_g, pi) - h_g + s_g - log(P/n) [+ A_g(i, ne)*pi_e if ions]
-        ! pi_e is treated as constant in the total derivatives.
-        do i = 1, ng
-            temp_dT = ds_g_dT(i) - dh_g_dT(i)
+        if (need_nj) then
+
+            allocate(dln_nj_dstate1(ng), dln_nj_dstate2(ng))
+            allocate(dln_nj_eff_dstate1(ng), dln_nj_eff_dstate2(ng))
+            allocate(dln_nj_db0(ng, ne), dln_nj_dw0(ng, nr))
+            allocate(dln_nj_eff_dw0(ng, nr))
+            allocate(dnj_db0(ng+na, ne))
+            allocate(dS_sum_dw0(nr))
+            call alloc_deriv(self%dnj_dstate1, ng+na)
+            call alloc_deriv(self%dnj_dstate2, ng+na)
+
+            dln_nj_dstate1 = 0.0d0
+            dln_nj_dstate2 = 0.0d0
+            dln_nj_eff_dstate1 = 0.0d0
+            dln_nj_eff_dstate2 = 0.0d0
+            dln_nj_db0 = 0.0d0
+            dln_nj_eff_dw0 = 0.0d0
+            dnj_db0 = 0.0d0
+            self%dnj_dstate1 = 0.0d0
+            self%dnj_dstate2 = 0.0d0
+
+            ! ln(nj) = dot(A_g, pi) - h_g + s_g - log(P/n) [+ A_g(i, ne)*pi_e if ions]
+            ! pi_e is treated as constant in the total derivatives.
+            do i = 1, ng
+                temp_dT = ds_g_dT(i) - dh_g_dT(i)
 
-            dln_nj_dstate1(i) = dot_product(A_g(i, :), self%dudx(1:ne, 2)) &
-                + temp_dT*self%dT_dstate1 - dlogP_over_n_state1
-            dln_nj_dstate2(i) = dot_product(A_g(i, :), self%dudx(1:ne, 1)) &
-                + temp_dT*self%dT_dstate2 - dlogP_over_n_state2
+                dln_nj_dstate1(i) = dot_product(A_g(i, :), self%dudx(1:ne, 2)) &
+                    + temp_dT*self%dT_dstate1 - dlogP_over_n_state1
+                dln_nj_dstate2(i) = dot_product(A_g(i, :), self%dudx(1:ne, 1)) &
+                    + temp_dT*self%dT_dstate2 - dlogP_over_n_state2
 
-            do j = 1, ne
-                dln_nj_db0(i, j) = dot_product(A_g(i, :), self%dudx(1:ne, j+2)) &
-                    + temp_dT*dT_db0(j) - dlogP_over_n_db0(j)
+                if (wrt_b) then
+                    do j = 1, ne
+                        dln_nj_db0(i, j) = dot_product(A_g(i, :), self%dudx(1:ne, j+2)) &
+                            + temp_dT*dT_db0(j) - dlogP_over_n_db0(j)
+                    end do
+                end if
             end do
-        end do
 
-        dln_nj_dw0 = matmul(dln_nj_db0, db0_dw0)
-        do i = 1, ng
-            dln_nj_eff_dstate1(i) = dln_nj_eff_dln_nj(i) * dln_nj_dstate1(i)
-            dln_nj_eff_dstate2(i) = dln_nj_eff_dln_nj(i) * dln_nj_dstate2(i)
-            dln_nj_eff_dw0(i, :) = dln_nj_eff_dln_nj(i) * dln_nj_dw0(i, :)
-        end do
+            if (wrt_w .and. need_S) dln_nj_dw0 = matmul(dln_nj_db0, db0_dw0)
+            do i = 1, ng
+                dln_nj_eff_dstate1(i) = dln_nj_eff_dln_nj(i) * dln_nj_dstate1(i)
+                dln_nj_eff_dstate2(i) = dln_nj_eff_dln_nj(i) * dln_nj_dstate2(i)
+                if (wrt_w .and. need_S) dln_nj_eff_dw0(i, :) = dln_nj_eff_dln_nj(i) * dln_nj_dw0(i, :)
+            end do
 
-        do i = 1, ng
-            ion_species = solver%ions .and. solver%active_ions .and. ne > 0 .and. A_g(i, ne) /= 0.0d0
-            if (ion_species) then
-                species_size = solver%esize
-            else
-                species_size = solver%tsize
-            end if
-            threshold_value = ln_nj(i) - ln_n + species_size
-            threshold_margin = 0.05d0*species_size
-            if (solver%smooth_truncation) then
-                self%dnj_dstate1(i) = dnj_dln_nj(i)*dln_nj_dstate1(i)
-                self%dnj_dstate2(i) = dnj_dln_nj(i)*dln_nj_dstate2(i)
-                dnj_db0(i, :) = dnj_dln_nj(i)*dln_nj_db0(i, :)
-            else if (threshold_value > 0.0d0) then
-                self%dnj_dstate1(i) = nj_g_eff(i)*dln_nj_dstate1(i)
-                self%dnj_dstate2(i) = nj_g_eff(i)*dln_nj_dstate2(i)
-                dnj_db0(i, :) = nj_g_eff(i)*dln_nj_db0(i, :)
-            else
-                if (threshold_value >= -threshold_margin) then
-                    call log_warning("EqDerivatives_unpack_values: "// &
-                        trim(solver%products%species_names(i))// &
-                        " not in the active-set so derivatives are 0, but they are close to the threshold")
+            do i = 1, ng
+                ion_species = solver%ions .and. solver%active_ions .and. ne > 0 .and. A_g(i, ne) /= 0.0d0
+                if (ion_species) then
+                    species_size = solver%esize
+                else
+                    species_size = solver%tsize
+                end if
+                threshold_value = ln_nj(i) - ln_n + species_size
+                threshold_margin = 0.05d0*species_size
+                if (solver%smooth_truncation) then
+                    self%dnj_dstate1(i) = dnj_dln_nj(i)*dln_nj_dstate1(i)
+                    self%dnj_dstate2(i) = dnj_dln_nj(i)*dln_nj_dstate2(i)
+                    dnj_db0(i, :) = dnj_dln_nj(i)*dln_nj_db0(i, :)
+                else if (threshold_value > 0.0d0) then
+                    self%dnj_dstate1(i) = nj_g_eff(i)*dln_nj_dstate1(i)
+                    self%dnj_dstate2(i) = nj_g_eff(i)*dln_nj_dstate2(i)
+                    dnj_db0(i, :) = nj_g_eff(i)*dln_nj_db0(i, :)
+                else
+                    if (threshold_value >= -threshold_margin) then
+                        if (log_enabled(log_levels%warning)) then
+                            call log_warning("EqDerivatives_unpack_values: "// &
+                                trim(solver%products%species_names(i))// &
+                                " not in the active-set so derivatives are 0, but they are close to the threshold")
+                        end if
+                    end if
                 end if
+            end do
+
+            do idx_c = 1, na
+                i = active_cond_idx(idx_c)
+                self%dnj_dstate1(ng+idx_c) = self%dudx(ne+idx_c, 2)
+                self%dnj_dstate2(ng+idx_c) = self%dudx(ne+idx_c, 1)
+                dnj_db0(ng+idx_c, :) = self%dudx(ne+idx_c, 3:ne+2)
+            end do
+
+            if (wrt_w) then
+                call alloc_deriv(self%dnj_dw0, ng+na, nr)
+                self%dnj_dw0 = matmul(dnj_db0, db0_dw0)
             end if
-        end do
 
-        do idx_c = 1, na
-            i = active_cond_idx(idx_c)
-            self%dnj_dstate1(ng+idx_c) = self%dudx(ne+idx_c, 2)
-            self%dnj_dstate2(ng+idx_c) = self%dudx(ne+idx_c, 1)
-            dnj_db0(ng+idx_c, :) = self%dudx(ne+idx_c, 3:ne+2)
-        end do
+            ! For volume-constrained problems, n is the sum of gas species.
+            if (.not. const_p) then
+                self%dn_dstate1 = sum(self%dnj_dstate1(:ng))
+                self%dn_dstate2 = sum(self%dnj_dstate2(:ng))
+                if (wrt_w) then
+                    do j = 1, nr
+                        self%dn_dw0(j) = sum(self%dnj_dw0(:ng, j))
+                    end do
+                end if
+                do j = 1, ne
+                    dn_db0(j) = sum(dnj_db0(:ng, j))
+                end do
+            end if
 
-        self%dnj_dw0 = matmul(dnj_db0, db0_dw0)
+        end if
 
-        ! For volume-constrained problems, n is the sum of gas species.
-        if (.not. const_p) then
-            self%dn_dstate1 = sum(self%dnj_dstate1(:ng))
-            self%dn_dstate2 = sum(self%dnj_dstate2(:ng))
-            do j = 1, nr
-                self%dn_dw0(j) = sum(self%dnj_dw0(:ng, j))
-            end do
+        ! Keep the element-amount sensitivities for callers that linearize about this solution
+        if (wrt_b) then
+            call alloc_deriv(self%dT_db0, ne)
+            call alloc_deriv(self%dn_db0, ne)
+            self%dT_db0 = dT_db0
+            self%dn_db0 = dn_db0
+            if (need_nj) then
+                call alloc_deriv(self%dnj_db0, ng+na, ne)
+                self%dnj_db0 = dnj_db0
+            end if
         end if
 
         ! ---------------------------------------------------------
         ! dH/dx
         ! ---------------------------------------------------------
 
-        sum_h = dot_product(nj, solution%thermo%enthalpy)
-        sum_dh_dT = dot_product(nj_g_eff, dh_g_dT)
-        if (nc > 0) sum_dh_dT = sum_dh_dT + dot_product(nj_c, dh_c_dT)
+        if (need_H) then
 
-        do i = 1, ng
-            s_g_minus(i) = s_g(i) - ln_nj_eff(i) - log_p_over_n
-        end do
-
-        entropy_sum = dot_product(nj_g_eff, s_g_minus)
-        if (nc > 0) entropy_sum = entropy_sum + dot_product(nj_c, s_c)
-        entropy_dim = fac*entropy_sum
+            sum_h = dot_product(nj, solution%thermo%enthalpy)
+            sum_dh_dT = dot_product(nj_g_eff, dh_g_dT)
+            if (nc > 0) sum_dh_dT = sum_dh_dT + dot_product(nj_c, dh_c_dT)
 
-        ! dH/dstate1:
-        if (const_h) then
-            self%dH_dstate1 = fac
-        else
-            sum_h_dnj = dot_product(h_g, self%dnj_dstate1(:ng))
-            do idx_c = 1, na
-                i = active_cond_idx(idx_c)
-                sum_h_dnj = sum_h_dnj + h_c(i)*self%dnj_dstate1(ng+idx_c)
-            end do
-            self%dH_dstate1 = fac*(T*sum_h_dnj + (sum_h + T*sum_dh_dT)*self%dT_dstate1)
-        end if
-
-        ! dH/dstate2:
-        if (const_h) then
-            self%dH_dstate2 = 0.0d0
-        else
-            sum_h_dnj = dot_product(h_g, self%dnj_dstate2(:ng))
-            do idx_c = 1, na
-                i = active_cond_idx(idx_c)
-                sum_h_dnj = sum_h_dnj + h_c(i)*self%dnj_dstate2(ng+idx_c)
-            end do
-            self%dH_dstate2 = fac*(T*sum_h_dnj + (sum_h + T*sum_dh_dT)*self%dT_dstate2)
-        end if
+            ! dH/dstate1:
+            if (const_h) then
+                self%dH_dstate1 = fac
+            else
+                sum_h_dnj = dot_product(h_g, self%dnj_dstate1(:ng))
+                do idx_c = 1, na
+                    i = active_cond_idx(idx_c)
+                    sum_h_dnj = sum_h_dnj + h_c(i)*self%dnj_dstate1(ng+idx_c)
+                end do
+                self%dH_dstate1 = fac*(T*sum_h_dnj + (sum_h + T*sum_dh_dT)*self%dT_dstate1)
+            end if
 
-        ! dH/dw0:
-        if (const_h) then
-            self%dH_dw0 = 0.0d0
-        else
-            do j = 1, nr
-                sum_h_dnj = dot_product(h_g, self%dnj_dw0(:ng, j))
+            ! dH/dstate2:
+            if (const_h) then
+                self%dH_dstate2 = 0.0d0
+            else
+                sum_h_dnj = dot_product(h_g, self%dnj_dstate2(:ng))
                 do idx_c = 1, na
                     i = active_cond_idx(idx_c)
-                    sum_h_dnj = sum_h_dnj + h_c(i)*self%dnj_dw0(ng+idx_c, j)
+                    sum_h_dnj = sum_h_dnj + h_c(i)*self%dnj_dstate2(ng+idx_c)
                 end do
-                self%dH_dw0(j) = fac*(T*sum_h_dnj + (sum_h + T*sum_dh_dT)*self%dT_dw0(j))
-            end do
+                self%dH_dstate2 = fac*(T*sum_h_dnj + (sum_h + T*sum_dh_dT)*self%dT_dstate2)
+            end if
+
+            ! dH/dw0:
+            if (wrt_w) then
+                call alloc_deriv(self%dH_dw0, nr)
+                if (const_h) then
+                    self%dH_dw0 = 0.0d0
+                else
+                    do j = 1, nr
+                        sum_h_dnj = dot_product(h_g, self%dnj_dw0(:ng, j))
+                        do idx_c = 1, na
+                            i = active_cond_idx(idx_c)
+                            sum_h_dnj = sum_h_dnj + h_c(i)*self%dnj_dw0(ng+idx_c, j)
+                        end do
+                        self%dH_dw0(j) = fac*(T*sum_h_dnj + (sum_h + T*sum_dh_dT)*self%dT_dw0(j))
+                    end do
+                end if
+            end if
+
         end if
 
         ! ---------------------------------------------------------
         ! dU/dx
         ! ---------------------------------------------------------
 
-        ! dU/dstate1:
-        self%dU_dstate1 = self%dH_dstate1 - fac*(n*self%dT_dstate1 + T*self%dn_dstate1)
+        if (iand(self%outputs, deriv_U) /= 0) then
 
-        ! dU/dstate2:
-        self%dU_dstate2 = self%dH_dstate2 - fac*(n*self%dT_dstate2 + T*self%dn_dstate2)
+            ! dU/dstate1:
+            self%dU_dstate1 = self%dH_dstate1 - fac*(n*self%dT_dstate1 + T*self%dn_dstate1)
 
-        ! dU/dw0:
-        do j = 1, nr
-            self%dU_dw0(j) = self%dH_dw0(j) - fac*(n*self%dT_dw0(j) + T*self%dn_dw0(j))
-        end do
+            ! dU/dstate2:
+            self%dU_dstate2 = self%dH_dstate2 - fac*(n*self%dT_dstate2 + T*self%dn_dstate2)
+
+            ! dU/dw0:
+            if (wrt_w) then
+                call alloc_deriv(self%dU_dw0, nr)
+                do j = 1, nr
+                    self%dU_dw0(j) = self%dH_dw0(j) - fac*(n*self%dT_dw0(j) + T*self%dn_dw0(j))
+                end do
+            end if
+
+        end if
 
         ! ---------------------------------------------------------
         ! dS/dx
         ! ---------------------------------------------------------
 
-        ! dS/dstate1:
-        if (const_s) then
-            ! state1 is entropy/R; convert to dimensional entropy derivative
-            self%dS_dstate1 = fac
-        else
-            dS_sum_state1 = 0.0d0
-            do i = 1, ng
-                dS_sum_state1 = dS_sum_state1 + self%dnj_dstate1(i)*s_g_minus(i)
-                dS_sum_state1 = dS_sum_state1 + nj_g_eff(i)* &
-                    (ds_g_dT(i)*self%dT_dstate1 - dln_nj_eff_dstate1(i))
-            end do
-            ! Add the log(P/n) derivative terms once (not once per species)
-            dS_sum_state1 = dS_sum_state1 - n*dlogP_over_n_state1
-            do idx_c = 1, na
-                i = active_cond_idx(idx_c)
-                dS_sum_state1 = dS_sum_state1 + self%dnj_dstate1(ng+idx_c)*s_c(i)
-                dS_sum_state1 = dS_sum_state1 + nj_c(i)*ds_c_dT(i)*self%dT_dstate1
-            end do
-            self%dS_dstate1 = fac*dS_sum_state1
-        end if
+        if (need_S) then
 
-        ! dS/dstate2:
-        if (const_s) then
-            self%dS_dstate2 = 0.0d0
-        else
-            dS_sum_state2 = 0.0d0
             do i = 1, ng
-                dS_sum_state2 = dS_sum_state2 + self%dnj_dstate2(i)*s_g_minus(i)
-                dS_sum_state2 = dS_sum_state2 + nj_g_eff(i)* &
-                    (ds_g_dT(i)*self%dT_dstate2 - dln_nj_eff_dstate2(i))
-            end do
-            ! Add the log(P/n) derivative terms once (not once per species)
-            dS_sum_state2 = dS_sum_state2 - n*dlogP_over_n_state2
-            do idx_c = 1, na
-                i = active_cond_idx(idx_c)
-                dS_sum_state2 = dS_sum_state2 + self%dnj_dstate2(ng+idx_c)*s_c(i)
-                dS_sum_state2 = dS_sum_state2 + nj_c(i)*ds_c_dT(i)*self%dT_dstate2
+                s_g_minus(i) = s_g(i) - ln_nj_eff(i) - log_p_over_n
             end do
-            self%dS_dstate2 = fac*dS_sum_state2
-        end if
 
-        ! dS/dw0:
-        if (const_s) then
-            self%dS_dw0 = 0.0d0
-        else
-            do j = 1, nr
-                dS_sum_dw0(j) = 0.0d0
+            entropy_sum = dot_product(nj_g_eff, s_g_minus)
+            if (nc > 0) entropy_sum = entropy_sum + dot_product(nj_c, s_c)
+            entropy_dim = fac*entropy_sum
+
+            ! dS/dstate1:
+            if (const_s) then
+                ! state1 is entropy/R; convert to dimensional entropy derivative
+                self%dS_dstate1 = fac
+            else
+                dS_sum_state1 = 0.0d0
                 do i = 1, ng
-                    dS_sum_dw0(j) = dS_sum_dw0(j) + self%dnj_dw0(i, j)*s_g_minus(i)
-                    dS_sum_dw0(j) = dS_sum_dw0(j) + nj_g_eff(i)* &
-                        (ds_g_dT(i)*self%dT_dw0(j) - dln_nj_eff_dw0(i, j))
+                    dS_sum_state1 = dS_sum_state1 + self%dnj_dstate1(i)*s_g_minus(i)
+                    dS_sum_state1 = dS_sum_state1 + nj_g_eff(i)* &
+                        (ds_g_dT(i)*self%dT_dstate1 - dln_nj_eff_dstate1(i))
                 end do
                 ! Add the log(P/n) derivative terms once (not once per species)
-                dS_sum_dw0(j) = dS_sum_dw0(j) - n*dlogP_over_n_dw0(j)
+                dS_sum_state1 = dS_sum_state1 - n*dlogP_over_n_state1
                 do idx_c = 1, na
                     i = active_cond_idx(idx_c)
-                    dS_sum_dw0(j) = dS_sum_dw0(j) + self%dnj_dw0(ng+idx_c, j)*s_c(i)
-                    dS_sum_dw0(j) = dS_sum_dw0(j) + nj_c(i)*ds_c_dT(i)*self%dT_dw0(j)
+                    dS_sum_state1 = dS_sum_state1 + self%dnj_dstate1(ng+idx_c)*s_c(i)
+                    dS_sum_state1 = dS_sum_state1 + nj_c(i)*ds_c_dT(i)*self%dT_dstate1
                 end do
-                self%dS_dw0(j) = fac*dS_sum_dw0(j)
-            end do
+                self%dS_dstate1 = fac*dS_sum_state1
+            end if
+
+            ! dS/dstate2:
+            if (const_s) then
+                self%dS_dstate2 = 0.0d0
+            else
+                dS_sum_state2 = 0.0d0
+                do i = 1, ng
+                    dS_sum_state2 = dS_sum_state2 + self%dnj_dstate2(i)*s_g_minus(i)
+                    dS_sum_state2 = dS_sum_state2 + nj_g_eff(i)* &
+                        (ds_g_dT(i)*self%dT_dstate2 - dln_nj_eff_dstate2(i))
+                end do
+                ! Add the log(P/n) derivative terms once (not once per species)
+                dS_sum_state2 = dS_sum_state2 - n*dlogP_over_n_state2
+                do idx_c = 1, na
+                    i = active_cond_idx(idx_c)
+                    dS_sum_state2 = dS_sum_state2 + self%dnj_dstate2(ng+idx_c)*s_c(i)
+                    dS_sum_state2 = dS_sum_state2 + nj_c(i)*ds_c_dT(i)*self%dT_dstate2
+                end do
+                self%dS_dstate2 = fac*dS_sum_state2
+            end if
+
+            ! dS/dw0:
+            if (wrt_w) then
+                call alloc_deriv(self%dS_dw0, nr)
+                if (const_s) then
+                    self%dS_dw0 = 0.0d0
+                else
+                    do j = 1, nr
+                        dS_sum_dw0(j) = 0.0d0
+                        do i = 1, ng
+                            dS_sum_dw0(j) = dS_sum_dw0(j) + self%dnj_dw0(i, j)*s_g_minus(i)
+                            dS_sum_dw0(j) = dS_sum_dw0(j) + nj_g_eff(i)* &
+                                (ds_g_dT(i)*self%dT_dw0(j) - dln_nj_eff_dw0(i, j))
+                        end do
+                        ! Add the log(P/n) derivative terms once (not once per species)
+                        dS_sum_dw0(j) = dS_sum_dw0(j) - n*dlogP_over_n_dw0(j)
+                        do idx_c = 1, na
+                            i = active_cond_idx(idx_c)
+                            dS_sum_dw0(j) = dS_sum_dw0(j) + self%dnj_dw0(ng+idx_c, j)*s_c(i)
+                            dS_sum_dw0(j) = dS_sum_dw0(j) + nj_c(i)*ds_c_dT(i)*self%dT_dw0(j)
+                        end do
+                        self%dS_dw0(j) = fac*dS_sum_dw0(j)
+                    end do
+                end if
+            end if
+
         end if
 
         ! ---------------------------------------------------------
         ! dG/dx
         ! ---------------------------------------------------------
 
-        ! dG/dstate1:
-        self%dG_dstate1 = self%dH_dstate1 - entropy_dim*self%dT_dstate1 - T*self%dS_dstate1
+        if (iand(self%outputs, deriv_G) /= 0) then
 
-        ! dG/dstate2:
-        self%dG_dstate2 = self%dH_dstate2 - entropy_dim*self%dT_dstate2 - T*self%dS_dstate2
+            ! dG/dstate1:
+            self%dG_dstate1 = self%dH_dstate1 - entropy_dim*self%dT_dstate1 - T*self%dS_dstate1
 
-        ! dG/dw0:
-        do j = 1, nr
-            self%dG_dw0(j) = self%dH_dw0(j) - entropy_dim*self%dT_dw0(j) - T*self%dS_dw0(j)
-        end do
+            ! dG/dstate2:
+            self%dG_dstate2 = self%dH_dstate2 - entropy_dim*self%dT_dstate2 - T*self%dS_dstate2
+
+            ! dG/dw0:
+            if (wrt_w) then
+                call alloc_deriv(self%dG_dw0, nr)
+                do j = 1, nr
+                    self%dG_dw0(j) = self%dH_dw0(j) - entropy_dim*self%dT_dw0(j) - T*self%dS_dw0(j)
+                end do
+            end if
+
+        end if
 
         ! ---------------------------------------------------------
         ! dCp_fr/dx
         ! ---------------------------------------------------------
 
-        ! dCp_fr/dstate1:
-        ! dCp_fr/dx = sum_j(dnj/dx * Cp_j) + sum_j(nj * dCp_j/dT * dT/dx)
-        sum_cp_dnj = dot_product(cp(:ng), self%dnj_dstate1(:ng))
-        do idx_c = 1, na
-            i = active_cond_idx(idx_c)
-            sum_cp_dnj = sum_cp_dnj + cp(ng+i)*self%dnj_dstate1(ng+idx_c)
-        end do
-        ! Add temperature derivative terms: sum_j(nj * dCp_j/dT) * dT/dstate1
-        sum_dcp_dT_term = 0.0d0
-        do i = 1, ng
-            sum_dcp_dT_term = sum_dcp_dT_term + nj_g_eff(i) * dcp_g_dT(i)
-        end do
-        do idx_c = 1, na
-            i = active_cond_idx(idx_c)
-            sum_dcp_dT_term = sum_dcp_dT_term + nj_c(i) * dcp_c_dT(i)
-        end do
-        self%dCp_fr_dstate1 = fac*(sum_cp_dnj + sum_dcp_dT_term*self%dT_dstate1)
-
-        ! dCp_fr/dstate2:
-        sum_cp_dnj = dot_product(cp(:ng), self%dnj_dstate2(:ng))
-        do idx_c = 1, na
-            i = active_cond_idx(idx_c)
-            sum_cp_dnj = sum_cp_dnj + cp(ng+i)*self%dnj_dstate2(ng+idx_c)
-        end do
-        ! Add temperature derivative terms: sum_j(nj * dCp_j/dT) * dT/dstate2
-        sum_dcp_dT_term = 0.0d0
-        do i = 1, ng
-            sum_dcp_dT_term = sum_dcp_dT_term + nj_g_eff(i) * dcp_g_dT(i)
-        end do
-        do idx_c = 1, na
-            i = active_cond_idx(idx_c)
-            sum_dcp_dT_term = sum_dcp_dT_term + nj_c(i) * dcp_c_dT(i)
-        end do
-        self%dCp_fr_dstate2 = fac*(sum_cp_dnj + sum_dcp_dT_term*self%dT_dstate2)
+        if (need_Cp) then
 
-        ! dCp_fr/dw0:
-        do j = 1, nr
-            sum_cp_dnj = dot_product(cp(:ng), self%dnj_dw0(:ng, j))
-            do idx_c = 1, na
-                i = active_cond_idx(idx_c)
-                sum_cp_dnj = sum_cp_dnj + cp(ng+i)*self%dnj_dw0(ng+idx_c, j)
-            end do
-            ! Add temperature derivative terms: sum_j(nj * dCp_j/dT) * dT/dw0
+            ! dCp_fr/dx = sum_j(dnj/dx * Cp_j) + sum_j(nj * dCp_j/dT * dT/dx)
+            ! sum_j(nj * dCp_j/dT) is the same for every input
             sum_dcp_dT_term = 0.0d0
             do i = 1, ng
                 sum_dcp_dT_term = sum_dcp_dT_term + nj_g_eff(i) * dcp_g_dT(i)
@@ -3461,8 +3971,37 @@ contains
                 i = active_cond_idx(idx_c)
                 sum_dcp_dT_term = sum_dcp_dT_term + nj_c(i) * dcp_c_dT(i)
             end do
-            self%dCp_fr_dw0(j) = fac*(sum_cp_dnj + sum_dcp_dT_term*self%dT_dw0(j))
-        end do
+
+            ! dCp_fr/dstate1:
+            sum_cp_dnj = dot_product(cp(:ng), self%dnj_dstate1(:ng))
+            do idx_c = 1, na
+                i = active_cond_idx(idx_c)
+                sum_cp_dnj = sum_cp_dnj + cp(ng+i)*self%dnj_dstate1(ng+idx_c)
+            end do
+            self%dCp_fr_dstate1 = fac*(sum_cp_dnj + sum_dcp_dT_term*self%dT_dstate1)
+
+            ! dCp_fr/dstate2:
+            sum_cp_dnj = dot_product(cp(:ng), self%dnj_dstate2(:ng))
+            do idx_c = 1, na
+                i = active_cond_idx(idx_c)
+                sum_cp_dnj = sum_cp_dnj + cp(ng+i)*self%dnj_dstate2(ng+idx_c)
+            end do
+            self%dCp_fr_dstate2 = fac*(sum_cp_dnj + sum_dcp_dT_term*self%dT_dstate2)
+
+            ! dCp_fr/dw0:
+            if (wrt_w) then
+                call alloc_deriv(self%dCp_fr_dw0, nr)
+                do j = 1, nr
+                    sum_cp_dnj = dot_product(cp(:ng), self%dnj_dw0(:ng, j))
+                    do idx_c = 1, na
+                        i = active_cond_idx(idx_c)
+                        sum_cp_dnj = sum_cp_dnj + cp(ng+i)*self%dnj_dw0(ng+idx_c, j)
+                    end do
+                    self%dCp_fr_dw0(j) = fac*(sum_cp_dnj + sum_dcp_dT_term*self%dT_dw0(j))
+                end do
+            end if
+
+        end if
 
     end subroutine
 
@@ -3489,8 +4028,12 @@ contains
         call self%assemble_jacobian(solver, solution)
         call self%assemble_Rx(solver, solution)
 
-        ! Compute the derivatives: du/dx = -J^-1 * Rx
+        ! Compute the derivatives: du/dx = -J^-1 * Rx, for the selected inputs only
         do i = 1, self%n
+            if (.not. deriv_column_selected(self%outputs, i)) then
+                self%dudx(:, i) = 0.0d0
+                cycle
+            end if
             ierr = 0
             G(:, :self%m) = self%J
             G(:, self%m+1) = -self%Rx(:, i)
@@ -3554,7 +4097,8 @@ contains
         logical :: const_p, const_t
         type(EqConstraints), pointer :: cons
 
-        ! NOTE: EqDerivatives_compute_derivatives and EqDerivatives_unpack_values should be called first.
+        ! NOTE: EqDerivatives_compute_derivatives and EqDerivatives_unpack_values should be called first
+        !       for the verbose comparison, with all outputs selected.
 
         verbose_ = .true.
         if (present(verbose)) verbose_ = verbose
@@ -3587,6 +4131,23 @@ contains
             lnn_idx = 0
         end if
 
+        ! The verbose report compares against every analytic output
+        if (verbose_ .and. (self%outputs /= deriv_all .or. .not. allocated(self%dnj_dw0))) then
+            call log_warning("EqDerivatives_compute_fd: verbose comparison needs all analytic derivatives; skipping it")
+            verbose_ = .false.
+        end if
+
+        call alloc_deriv(self%dT_dw0_fd, nr)
+        call alloc_deriv(self%dn_dw0_fd, nr)
+        call alloc_deriv(self%dnj_dstate1_fd, ns)
+        call alloc_deriv(self%dnj_dstate2_fd, ns)
+        call alloc_deriv(self%dnj_dw0_fd, ns, nr)
+        call alloc_deriv(self%dH_dw0_fd, nr)
+        call alloc_deriv(self%dU_dw0_fd, nr)
+        call alloc_deriv(self%dG_dw0_fd, nr)
+        call alloc_deriv(self%dS_dw0_fd, nr)
+        call alloc_deriv(self%dCp_fr_dw0_fd, nr)
+
         allocate(base_nj(ns), pert_nj(ns))
         if (central_) allocate(pert_nj_minus(ns))
         if (na > 0) then
@@ -3629,7 +4190,7 @@ contains
             dlogP_over_n_state1_fd = 0.0d0
             dlogP_over_n_state2_fd = 0.0d0
             dlogP_over_n_dw0_fd_max = 0.0d0
-            A_g => solver%products%stoich_matrix(:ng,:)
+            A_g => solver%stoich_matrix(:ng,:)
             do i = 1, ng
                 dh_g_dT(i) = solver%products%species(i)%calc_denthalpy_dT(base_T)/base_T - &
                     solution%thermo%enthalpy(i)/base_T
@@ -4137,6 +4698,8 @@ contains
         allocate(self%is_active(solver%num_condensed), source=.false.)
         allocate(self%w0(solver%num_reactants), source=0.0d0)
         allocate(self%active_rank(solver%num_condensed), source=0)
+        allocate(self%reduced_from(solver%num_elements), source=0)
+        allocate(self%reduced_to(solver%num_elements), source=0)
         allocate(self%is_active_seed(solver%num_condensed), source=.false.)
         allocate(self%active_rank_seed(solver%num_condensed), source=0)
         allocate(self%transport_component_idx(solver%num_elements), source=0)
@@ -4173,7 +4736,7 @@ contains
                 if (j > 0) then
                     ! Only count this as an "insert" if it is condensed; no effect otherwise
                     if (solver%products%species(j)%i_phase > 0) then
-                        call log_info("Inserting "//solver%products%species_names(j))
+                        if (log_enabled(log_levels%info)) call log_info("Inserting "//solver%products%species_names(j))
                         call self%activate_condensed_front(j-solver%num_gas)
                     end if
                 end if
@@ -4443,7 +5006,7 @@ contains
 
         do i = 1, ng
             ion_species = solver%ions .and. solver%active_ions .and. ne_full > 0 .and. &
-                          solver%products%stoich_matrix(i, ne_full) /= 0.0d0
+                          solver%stoich_matrix(i, ne_full) /= 0.0d0
             ln_threshold = gas_amount_ln_threshold(ln_n, solver%tsize, solver%esize, ion_species)
             call compute_nj_effective(ln_nj(i), ln_threshold, solver%smooth_truncation, solver%truncation_width, &
                                       nj_eff=nj_eff_tmp, ln_nj_eff=ln_nj_eff(i))
@@ -4453,6 +5016,36 @@ contains
 
     end function
 
+    subroutine EqSolution_release_workspace(self)
+        ! Free the iteration workspace of a solved state, keeping the reported
+        ! properties, species amounts, and fractions. The object can no longer
+        ! be passed back to the solver afterwards, nor can its pending outputs
+        ! be computed.
+        class(EqSolution), intent(inout) :: self
+
+        if (allocated(self%ln_nj)) deallocate(self%ln_nj)
+        if (allocated(self%pi)) deallocate(self%pi)
+        if (allocated(self%pi_prev)) deallocate(self%pi_prev)
+        if (allocated(self%dln_nj)) deallocate(self%dln_nj)
+        if (allocated(self%dnj_c)) deallocate(self%dnj_c)
+        if (allocated(self%G)) deallocate(self%G)
+        if (allocated(self%constraints%b0)) deallocate(self%constraints%b0)
+        if (allocated(self%is_active)) deallocate(self%is_active)
+        if (allocated(self%active_rank)) deallocate(self%active_rank)
+        if (allocated(self%nj_seed)) deallocate(self%nj_seed)
+        if (allocated(self%ln_nj_seed)) deallocate(self%ln_nj_seed)
+        if (allocated(self%is_active_seed)) deallocate(self%is_active_seed)
+        if (allocated(self%active_rank_seed)) deallocate(self%active_rank_seed)
+        if (allocated(self%transport_component_idx)) deallocate(self%transport_component_idx)
+        if (allocated(self%transport_basis_matrix)) deallocate(self%transport_basis_matrix)
+        if (allocated(self%thermo%cp)) deallocate(self%thermo%cp)
+        if (allocated(self%thermo%cv)) deallocate(self%thermo%cv)
+        if (allocated(self%thermo%enthalpy)) deallocate(self%thermo%enthalpy)
+        if (allocated(self%thermo%entropy)) deallocate(self%thermo%entropy)
+        if (allocated(self%thermo%energy)) deallocate(self%thermo%energy)
+
+    end subroutine
+
 
     !-----------------------------------------------------------------------
     ! EqPartials Implementation
@@ -4474,6 +5067,16 @@ contains
                  self%dnc_dlnP(num_active))
     end function
 
+    subroutine EqPartials_release_workspace(self)
+        ! Free the per-species derivative arrays, keeping the scalar partials
+        class(EqPartials), intent(inout) :: self
+
+        if (allocated(self%dpi_dlnT)) deallocate(self%dpi_dlnT)
+        if (allocated(self%dnc_dlnT)) deallocate(self%dnc_dlnT)
+        if (allocated(self%dpi_dlnP)) deallocate(self%dpi_dlnP)
+        if (allocated(self%dnc_dlnP)) deallocate(self%dnc_dlnP)
+    end subroutine
+
     subroutine EqPartials_assemble_partials_matrix_const_p(self, solver, soln, J)
         ! Assemble the matrix for evaluating derivatives with respect to
         ! log(T) at constant P (RP-1311 Table 2.3)
@@ -4511,8 +5114,8 @@ contains
 
         ! Associate subarray pointers
         allocate(J(num_eqn, num_eqn+1))
-        A_g => solver%products%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
-        A_c => solver%products%stoich_matrix(ng+1:,:)
+        A_g => solver%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
+        A_c => solver%stoich_matrix(ng+1:,:)
         nj  => soln%nj
         nj_g => soln%nj(:ng)
         ln_nj => soln%ln_nj
@@ -4612,8 +5215,8 @@ contains
 
         ! Associate subarray pointers
         allocate(J(num_eqn, num_eqn+1))
-        A_g => solver%products%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
-        A_c => solver%products%stoich_matrix(ng+1:,:)
+        A_g => solver%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
+        A_c => solver%stoich_matrix(ng+1:,:)
         nj  => soln%nj
         nj_g => soln%nj(:ng)
         ln_nj => soln%ln_nj
@@ -4694,8 +5297,8 @@ contains
         nc = solver%num_condensed
         ne = solver%num_active_elements()
         na = count(soln%is_active)
-        A_g => solver%products%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
-        A_c => solver%products%stoich_matrix(ng+1:,:)
+        A_g => solver%stoich_matrix(:ng,:) ! NOTE: A is transpose of a_ij in RP-1311
+        A_c => solver%stoich_matrix(ng+1:,:)
         nj  => soln%nj
         nj_g => soln%nj(:ng)
         cp  => soln%thermo%cp
@@ -4804,9 +5407,94 @@ contains
     end subroutine
 
 
+    !-----------------------------------------------------------------------
+    ! EqResult Implementation
+    !-----------------------------------------------------------------------
+    function EqResult_init(soln, partials) result(self)
+        ! Copy the reported outputs of a solved state into a compact record.
+        ! When given, the partials supply gamma_s and the volume derivatives.
+        type(EqResult) :: self
+        type(EqSolution), intent(in) :: soln
+        type(EqPartials), intent(in), optional :: partials
+
+        self%converged = soln%converged
+        self%T = soln%T
+        self%n = soln%n
+        self%pressure = soln%pressure
+        self%volume = soln%volume
+        self%density = soln%density
+        self%M = soln%M
+        self%MW = soln%MW
+        self%enthalpy = soln%enthalpy
+        self%energy = soln%energy
+        self%gibbs_energy = soln%gibbs_energy
+        self%entropy = soln%entropy
+        self%cp_fr = soln%cp_fr
+        self%cp_eq = soln%cp_eq
+        self%cv_fr = soln%cv_fr
+        self%cv_eq = soln%cv_eq
+        self%gamma_s = soln%gamma_s
+        self%viscosity = soln%viscosity
+        self%conductivity_fr = soln%conductivity_fr
+        self%conductivity_eq = soln%conductivity_eq
+        self%Pr_fr = soln%Pr_fr
+        self%Pr_eq = soln%Pr_eq
+        if (present(partials)) then
+            self%gamma_s = partials%gamma_s
+            self%dlnV_dlnT = partials%dlnV_dlnT
+            self%dlnV_dlnP = partials%dlnV_dlnP
+        end if
+        if (allocated(soln%mole_fractions)) self%mole_fractions = soln%mole_fractions
+        if (allocated(soln%mass_fractions)) self%mass_fractions = soln%mass_fractions
+
+    end function
+
+
     !-----------------------------------------------------------------------
     ! Helper Functions
     !-----------------------------------------------------------------------
+    logical function deriv_column_selected(outputs, i) result(selected)
+        ! True if column i of EqDerivatives%dudx (x: [P0/V0, T0/H0/S0/U0, b0]) is needed for outputs
+        integer, intent(in) :: outputs
+        integer, intent(in) :: i
+
+        select case (i)
+            case (1)
+                selected = iand(outputs, deriv_wrt_state2) /= 0
+            case (2)
+                selected = iand(outputs, deriv_wrt_state1) /= 0
+            case default
+                selected = iand(outputs, ior(deriv_wrt_b0, deriv_wrt_w0)) /= 0
+        end select
+
+    end function
+
+    subroutine alloc_deriv_1d(a, n)
+        ! Allocate a derivative array to size n unless it already has that size
+        real(dp), allocatable, intent(inout) :: a(:)
+        integer, intent(in) :: n
+
+        if (allocated(a)) then
+            if (size(a) == n) return
+            deallocate(a)
+        end if
+        allocate(a(n), source=empty_dp)
+
+    end subroutine
+
+    subroutine alloc_deriv_2d(a, n1, n2)
+        ! Allocate a derivative array to shape (n1, n2) unless it already has that shape
+        real(dp), allocatable, intent(inout) :: a(:, :)
+        integer, intent(in) :: n1, n2
+
+        if (allocated(a)) then
+            if (size(a, 1) == n1 .and. size(a, 2) == n2) return
+            deallocate(a)
+        end if
+        allocate(a(n1, n2), source=empty_dp)
+
+    end subroutine
+
     subroutine gauss(G, ierr)
         ! Gaussian elimination solver
         !
@@ -4814,6 +5502,25 @@ contains
         ! partial pivoting. Input is the augmented system G = [A, b].
         ! Solution is done in-place, and on output the augmented
         ! system matrix contains the solution vector in the last column.
+        ! Small systems use the generated fixed-size kernels of cea_kernels.
+
+        ! Inputs
+        real(dp), intent(inout) :: G(:, :)
+        integer,  intent(out), optional :: ierr
+
+        ! Locals
+        integer :: ierr_
+
+        if (gauss_fixed(G, ierr_)) then
+            if (present(ierr)) ierr = ierr_
+        else
+            call gauss_general(G, ierr)
+        end if
+
+    end subroutine
+
+    subroutine gauss_general(G, ierr)
+        ! gauss for a system of any size
 
         ! Inputs
         real(dp), intent(inout) :: G(:, :)
@@ -5064,7 +5771,7 @@ contains
         nb = eq_solver%transport_db%num_binary
         ng = eq_solver%num_gas
         ne = eq_solver%num_elements
-        A => eq_solver%products%stoich_matrix
+        A => eq_solver%stoich_matrix
 
         ! Allocate
         allocate(psi(ng, ng), phi(ng, ng), eta(ng, ng), cond(ng), &
@@ -5214,8 +5921,10 @@ contains
                 selected_local_idx(j) = i
                 transport_to_local(idx(1)) = i
             else
-                call log_info('compute_transport_properties: Species '//eq_solver%products%species_names(idx_list(i))//&
-                              ' not found in transport database.')
+                if (log_enabled(log_levels%info)) then
+                    call log_info('compute_transport_properties: Species '//eq_solver%products%species_names(idx_list(i))//&
+                                  ' not found in transport database.')
+                end if
             end if
         end do
         selected_transport_pure_idx = selected_transport_pure_idx(:j)
@@ -5235,8 +5944,10 @@ contains
                     bin_idx(bin_count) = i
                 end if
             else
-                call log_info('compute_transport_properties: Binary species'//eq_solver%transport_db%binary_species(i,1)// &
-                              ' or '//eq_solver%transport_db%binary_species(i,2)//'not found in products mixture.')
+                if (log_enabled(log_levels%info)) then
+                    call log_info('compute_transport_properties: Binary species'//eq_solver%transport_db%binary_species(i,1)// &
+                                  ' or '//eq_solver%transport_db%binary_species(i,2)//'not found in products mixture.')
+                end if
             end if
 
         end do
@@ -5264,8 +5975,11 @@ contains
                     eta(local_idx2, local_idx1) = cfit_val
                 end if
             else
-                call log_info('compute_transport_properties: Binary species'//eq_solver%transport_db%binary_species(bin_idx(i),1)//&
-                ' or '//eq_solver%transport_db%binary_species(bin_idx(i),2)//'not found in transport database')
+                if (log_enabled(log_levels%info)) then
+                    call log_info('compute_transport_properties: Binary species'// &
+                                  eq_solver%transport_db%binary_species(bin_idx(i),1)//&
+                                  ' or '//eq_solver%transport_db%binary_species(bin_idx(i),2)//'not found in transport database')
+                end if
             end if
         end do
 
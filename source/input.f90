@@ -1,12 +1,11 @@
 module cea_input
     !! Module for parsing legacy input files
 
-    use cea_param, only: dp, empty_dp, stdout, &
+    use cea_param, only: dp, empty_dp, empty_int, stdout, &
                          gas_constant, &
                          sn => species_name_len, &
                          en => element_name_len
-    use fb_utils, only: abort, assert, substring, startswith, endswith, to_str
-    use fb_string_scanner
+    use fb_utils, only: abort, assert, substring, startswith, endswith, to_str, to_real, to_int
     use fb_logging
     implicit none
 
@@ -45,6 +44,8 @@ module cea_input
             !! Reference enthalpy of the reactant (optional)
         type(Schedule), allocatable :: density
             !! Density of the reactant (optional)
+        integer :: id = 0
+            !! ThermoDB species ID of the reactant, or 0 to look it up by name
 
     end type
 
@@ -144,10 +145,48 @@ module cea_input
             !! Species to insert into product mixture
     end type
 
+    type :: InputDeck
+        !! All problems parsed from one input deck
+        type(ProblemDB), allocatable :: problems(:)
+            !! Problems in deck order
+    end type
+
+    type :: InputFile
+        !! Input file read into memory once; read_next_problem parses its problems one at a time
+        character(:), allocatable :: text
+            !! Whole file, newlines included; comment lines are blanked as they are parsed
+        integer :: pos = 1
+            !! Start of the first line not yet parsed
+    end type
+
+    type :: TokenScanner
+        !! Walks the words of a dataset buffer, word by word.
+        !! Words are index ranges buffer(first:last) into the caller's buffer, so
+        !! reading a dataset copies only the values it stores.
+        integer :: pos = 1
+            !! Position of the next unread character
+        logical :: commas = .true.
+            !! Commas separate words
+        logical :: equals = .true.
+            !! '=' separates words
+    contains
+        procedure :: peek => TokenScanner_peek
+        procedure :: next => TokenScanner_next
+        procedure :: skip => TokenScanner_skip
+        procedure :: read_word => TokenScanner_read_word
+        procedure :: peek_real => TokenScanner_peek_real
+        procedure :: read_real => TokenScanner_read_real
+        procedure :: read_int => TokenScanner_read_int
+    end type
+    interface TokenScanner
+        module procedure :: TokenScanner_init
+    end interface
+
 contains
 
     function read_input(filename) result(problems)
-        ! Reads all problem specifications from the CEA input file
+        ! Reads all problem specifications from the CEA input file.
+        ! The whole file is read into a single buffer and parsed in place.
 
         ! Inputs
         character(*), intent(in) :: filename
@@ -156,134 +195,274 @@ contains
         type(ProblemDB), allocatable :: problems(:)
 
         ! Locals
-        integer, parameter :: max_problems = 100
-        integer :: fin, n, ierr
-        type(ProblemDB), allocatable :: parsed_problems(:)
-        character(512) :: line
+        character(:), allocatable :: text
+        integer :: ierr
 
         call log_info('Parsing input file: '//trim(filename))
-        open(newunit=fin, file=filename, &
-             status="old", action="read", form="formatted")
-        allocate(problems(max_problems))
+        call read_text_file(filename, text, ierr)
+        if (ierr /= 0) call abort('Could not read input file: '//trim(filename))
 
-        n = 1
-        do
-            do
-                read(fin, '(a)', iostat=ierr) line
-                if (ierr /= 0) exit
-                line = adjustl(line)
-                if (.not. is_empty(line)) then
-                    backspace(fin)
-                    exit
-                end if
-            end do
-            if (ierr /= 0) exit
+        call parse_input_buffer(text, problems)
+        call log_info('Parsed '//to_str(size(problems))//' problems from '//trim(filename))
 
-            call log_info('Parsing problem specification '//to_str(n))
-            call assert(n <= max_problems, "Maximum problem count exceeded.")
-            call read_problem(fin, problems(n), ierr)
-            if (ierr /= 0) exit
+        return
+    end function
+
+    function parse_input(text) result(problems)
+        ! Parses all problem specifications from an input deck held in memory
+
+        character(*), intent(in) :: text
+        type(ProblemDB), allocatable :: problems(:)
+
+        character(:), allocatable :: buffer
+
+        buffer = text
+        call parse_input_buffer(buffer, problems)
+
+    end function
+
+    subroutine read_text_file(filename, text, ierr)
+        ! Reads a whole file into one character buffer, newlines included
+
+        character(*), intent(in) :: filename
+        character(:), allocatable, intent(out) :: text
+        integer, intent(out) :: ierr
+
+        integer :: fin, nbytes
+
+        open(newunit=fin, file=filename, status="old", action="read", &
+             access="stream", form="unformatted", iostat=ierr)
+        if (ierr /= 0) return
+        inquire(unit=fin, size=nbytes)
+        allocate(character(max(nbytes, 0)) :: text)
+        if (nbytes > 0) read(fin, iostat=ierr) text
+        close(fin)
+
+    end subroutine
+
+    subroutine parse_input_buffer(text, problems)
+        ! Parses every problem in a complete input deck
+
+        character(*), intent(inout) :: text
+        type(ProblemDB), allocatable, intent(out) :: problems(:)
+
+        type(ProblemDB), allocatable :: parsed_problems(:)
+        type(ProblemDB) :: extra
+        integer :: pos, n
+        logical :: found
+
+        ! Every problem ends with an 'end' line, so this sizes the array exactly
+        allocate(problems(count_problems(text)))
+
+        n = 0
+        pos = 1
+        do while (n < size(problems))
+            call parse_next_problem(text, pos, problems(n+1), found)
+            if (.not. found) exit
             n = n+1
         end do
 
-        allocate(parsed_problems(n-1))
-        parsed_problems = problems(1:n-1)
-        call move_alloc(parsed_problems, problems)
-        call log_info('Parsed '//to_str(n-1)//' problems from '//trim(filename))
+        ! Anything but blank lines after the last 'end' is a problem without one
+        if (n == size(problems)) call parse_next_problem(text, pos, extra, found)
 
-        close(fin)
+        if (n < size(problems)) then
+            allocate(parsed_problems(n))
+            parsed_problems = problems(:n)
+            call move_alloc(parsed_problems, problems)
+        end if
 
-        return
-    end function
+    end subroutine
 
-    subroutine read_problem(fin, problem, ierr)
-        ! Reads a complete ProblemDB from the input stream.
-        ! Aborts program if malformed input is discovered.
-        ! Returns ierr < 0 if no further problems in the stream.
+    subroutine parse_next_problem(text, pos, problem, found)
+        ! Parses the problem whose lines start at text(pos:) and advances pos past its 'end' line.
+        ! Datasets are handed to their parsers as slices of `text`: the scanner
+        ! already treats newlines as blanks, so only comment lines inside a
+        ! dataset are overwritten (in place) instead of copying line by line.
+        ! found is false when only blank and comment lines remain.
 
-        integer, intent(in) :: fin
+        character(*), intent(inout) :: text
+        integer, intent(inout) :: pos
         type(ProblemDB), intent(out) :: problem
-        integer, intent(out) :: ierr
+        logical, intent(out) :: found
 
-        character(512) :: line
-        character(:), allocatable :: buffer, dsname
+        character(4) :: dsname
+        integer :: first, last, ds_first, ds_last
         logical :: has_data, has_prob, has_reac
 
+        found = .false.
+        ds_first = 0
+        ds_last = -1
+        dsname = ''
         has_data = .false.
         has_prob = .false.
         has_reac = .false.
-        do
+        do while (next_line(text, pos, first, last))
 
-            ! Get next good line of input
-            read(fin, '(a)', iostat=ierr) line
-            if (ierr /= 0) then
-                if (has_data) then
-                    call abort('Problem is missing end keyword.')
-                else
-                    call log_info('No problem found. Reached EOF.')
-                    return
-                end if
+            if (is_empty(text(first:last))) then
+                text(first:last) = ' '
+                cycle
             end if
-            line = adjustl(line)
-            if (is_empty(line)) cycle
-            if (startswith(line,'end')) then
+
+            if (.not. is_keyword(text(first:last))) then
+                call assert(ds_first > 0, 'Problem has non-empty line outside of dataset.')
+                ds_last = last
+                cycle
+            end if
+
+            if (dsname == 'outp' .and. text(first:min(first+3, last)) == 'outp') then
+                ! Legacy behavior allows repeated output datasets; merge them.
+                ds_last = last
+                cycle
+            end if
+
+            ! A keyword closes the open dataset
+            if (ds_first > 0) then
+                if (dsname == 'prob') has_prob = .true.
+                if (dsname == 'reac') has_reac = .true.
+                call parse_dataset(problem, dsname, text(ds_first:ds_last))
+                ds_first = 0
+                dsname = ''
+            end if
+
+            if (startswith(text(first:last), 'end')) then
                 call assert(has_prob, 'Problem is missing prob dataset.')
                 call assert(has_reac, 'Problem is missing reac dataset.')
+                found = .true.
                 return
             end if
 
-            ! Extract dataset name
-            call assert(is_keyword(line), 'Problem has non-empty line outside of dataset.')
-            dsname = line(1:4)
-            has_data = .true.
-
+            dsname = text(first:first+3)
             if (dsname == 'ther' .or. dsname == 'tran') then
-                ! These need special handling. Shouldn't read into a buffer.
                 call abort('Thermo/transport databases not yet implemented')
             end if
+            call log_debug('Parsing dataset '//dsname)
+            if (.not. has_data) call log_info('Parsing problem specification')
+            has_data = .true.
+            ds_first = first
+            ds_last = last
 
-            ! Read until next keyword, saving input
-            buffer = trim(line)
-            do
-                read(fin, '(A)', iostat=ierr) line
-                if (ierr /= 0) call abort('Problem has incomplete dataset: '//dsname)
-                line = adjustl(line)
-                if (is_empty(line)) cycle
-                if (is_keyword(line)) then
-                    if (dsname == 'outp' .and. line(1:4) == 'outp') then
-                        ! Legacy behavior allows repeated output datasets; merge them.
-                        buffer = buffer // ' ' // trim(line)
-                        cycle
-                    end if
-                    backspace(fin)
-                    exit
-                else
-                    buffer = buffer // ' ' // trim(line)
-                end if
-            end do
+        end do
 
-            ! Process buffer
-            call log_debug('Parsing dataset '//dsname)
-            select case(dsname)
-                case('prob')
-                    has_prob = .true.
-                    problem%problem = parse_prob(buffer)
-                case('reac')
-                    has_reac = .true.
-                    problem%reactants = parse_reac(buffer)
-                case('only')
-                    problem%only = parse_species(buffer)
-                case('omit')
-                    problem%omit = parse_species(buffer)
-                case('inse')
-                    problem%insert = parse_species(buffer)
-                case('outp')
-                    problem%output = parse_outp(buffer)
-                case default
-                    call abort('Encountered unrecognized dataset: '//dsname)
-            end select
+        if (has_data) then
+            if (ds_first > 0) call abort('Problem has incomplete dataset: '//dsname)
+            call abort('Problem is missing end keyword.')
+        end if
+
+    end subroutine
+
+    function count_problems(text) result(n)
+        ! Counts the 'end' lines that terminate each problem in an input deck
+
+        character(*), intent(in) :: text
+        integer :: n
+
+        integer :: pos, first, last
 
+        n = 0
+        pos = 1
+        do while (next_line(text, pos, first, last))
+            if (startswith(text(first:last), 'end')) n = n+1
+        end do
+
+    end function
+
+    function next_line(text, pos, first, last) result(found)
+        ! Locates the line of `text` that starts at `pos` and advances `pos` past it.
+        ! text(first:last) is the line without leading blanks or its line terminator.
+
+        character(*), intent(in) :: text
+        integer, intent(inout) :: pos
+        integer, intent(out) :: first, last
+        logical :: found
+
+        character(1), parameter :: lf = achar(10), cr = achar(13)
+        integer :: k
+
+        found = (pos <= len(text))
+        if (.not. found) then
+            first = pos
+            last = pos-1
+            return
+        end if
+
+        first = pos
+        k = index(text(pos:), lf)
+        if (k == 0) then
+            last = len(text)
+            pos = len(text) + 1
+        else
+            last = pos + k - 2
+            pos = pos + k
+        end if
+        if (last >= first) then
+            if (text(last:last) == cr) last = last-1
+        end if
+        do while (first <= last)
+            if (text(first:first) /= ' ') exit
+            first = first+1
         end do
+
+    end function
+
+    function open_input(filename) result(file)
+        ! Reads a CEA input file into memory for problem-by-problem parsing with read_next_problem
+
+        ! Inputs
+        character(*), intent(in) :: filename
+
+        ! Return
+        type(InputFile) :: file
+
+        ! Locals
+        integer :: ierr
+
+        call log_info('Parsing input file: '//trim(filename))
+        call read_text_file(filename, file%text, ierr)
+        if (ierr /= 0) call abort('Could not read input file: '//trim(filename))
+
+    end function
+
+    subroutine read_next_problem(file, problem, ierr)
+        ! Parses the next problem specification of an input file.
+        ! Only one parsed problem is held at a time, so a deck can be solved and
+        ! written problem by problem. Returns ierr /= 0 when the file is exhausted.
+
+        type(InputFile), intent(inout) :: file
+        type(ProblemDB), intent(out) :: problem
+        integer, intent(out) :: ierr
+
+        logical :: found
+
+        call parse_next_problem(file%text, file%pos, problem, found)
+        ierr = 0
+        if (.not. found) ierr = -1
+
+    end subroutine
+
+    subroutine parse_dataset(problem, dsname, buffer)
+        ! Parses one dataset buffer into the matching part of a ProblemDB
+
+        type(ProblemDB), intent(inout) :: problem
+        character(*), intent(in) :: dsname
+        character(*), intent(in) :: buffer
+
+        select case(dsname)
+            case('prob')
+                problem%problem = parse_prob(buffer)
+            case('reac')
+                problem%reactants = parse_reac(buffer)
+            case('only')
+                problem%only = parse_species(buffer)
+            case('omit')
+                problem%omit = parse_species(buffer)
+            case('inse')
+                problem%insert = parse_species(buffer)
+            case('outp')
+                problem%output = parse_outp(buffer)
+            case default
+                call abort('Encountered unrecognized dataset: '//dsname)
+        end select
+
     end subroutine
 
     function parse_prob(buffer) result(prob)
@@ -292,26 +471,26 @@ contains
         character(*), intent(in) :: buffer
         type(ProblemDataset) :: prob
 
-        type(string_scanner) :: scanner
+        type(TokenScanner) :: scanner
         character(15) :: token
         logical :: match
-        integer :: ierr
+        integer :: ierr, first, last
 
-        scanner = string_scanner(replace_delimiters(buffer))
-        token = scanner%read_word()  ! Skip "prob" keyword
+        scanner = TokenScanner()
+        call scanner%skip(buffer)  ! Skip "prob" keyword
         do
-            token = scanner%read_word(ierr)
-            if (ierr < 0) exit  ! Buffer exhausted
+            if (.not. scanner%next(buffer, first, last)) exit  ! Buffer exhausted
+            token = buffer(first:last)
             call log_debug('Parsing prob literal '//token)
 
             ! Four letter keywords
             match = .true.
             select case(token(:4))
                 case('ions');  prob%include_ions = .true.
-                case('tces');  prob%tc_est = scanner%read_real(ierr)!parse_schedule(scanner, token)
-                case('case');  prob%name = scanner%read_word()
-                case('mach');  prob%mach1_schedule = parse_schedule(scanner, token)
-                case('mdot');  prob%mdot = scanner%read_real(ierr)!parse_schedule(scanner, token)
+                case('tces');  prob%tc_est = scanner%read_real(buffer, ierr)
+                case('case');  prob%name = scanner%read_word(buffer)
+                case('mach');  prob%mach1_schedule = parse_schedule(scanner, buffer, buffer(first:last))
+                case('mdot');  prob%mdot = scanner%read_real(buffer, ierr)
                 case default
                     match = .false.
             end select
@@ -322,20 +501,20 @@ contains
             select case(token(:3))
                 case('det');       prob%type = 'det'
                 case('dgb','deb'); prob%debug = .true.
-                case('f/o','f/a'); prob%of_schedule = parse_schedule(scanner, token)
+                case('f/o','f/a'); prob%of_schedule = parse_schedule(scanner, buffer, buffer(first:last))
                 case('fac');       prob%rkt_finite_area = .true.
-                case('h/r');       prob%h_schedule = parse_schedule(scanner, token)
+                case('h/r');       prob%h_schedule = parse_schedule(scanner, buffer, buffer(first:last))
                 case('inc');       prob%shk_incident = .true.
-                case('nfz','nfr'); prob%rkt_nfrozen = scanner%read_int(ierr)
-                case('o/f');       prob%of_schedule = parse_schedule(scanner, token)
-                case('phi');       prob%of_schedule = parse_schedule(scanner, token)
+                case('nfz','nfr'); prob%rkt_nfrozen = scanner%read_int(buffer, ierr)
+                case('o/f');       prob%of_schedule = parse_schedule(scanner, buffer, buffer(first:last))
+                case('phi');       prob%of_schedule = parse_schedule(scanner, buffer, buffer(first:last))
                 case('ref');       prob%shk_reflected = .true.
-                case('rho');       prob%v_schedule = parse_schedule(scanner, token)
+                case('rho');       prob%v_schedule = parse_schedule(scanner, buffer, buffer(first:last))
                 case('rkt');       prob%type = 'rkt'
-                case('sub');       prob%subar_schedule = parse_schedule(scanner, token)
-                case('sup');       prob%supar_schedule = parse_schedule(scanner, token)
-                case('s/r');       prob%s_schedule = parse_schedule(scanner, token)
-                case('u/r');       prob%u_schedule = parse_schedule(scanner, token)
+                case('sub');       prob%subar_schedule = parse_schedule(scanner, buffer, buffer(first:last))
+                case('sup');       prob%supar_schedule = parse_schedule(scanner, buffer, buffer(first:last))
+                case('s/r');       prob%s_schedule = parse_schedule(scanner, buffer, buffer(first:last))
+                case('u/r');       prob%u_schedule = parse_schedule(scanner, buffer, buffer(first:last))
                 case default
                     match = .false.
             end select
@@ -344,12 +523,12 @@ contains
             ! Two letter keywords
             match = .true.
             select case(token(:2))
-                case('%f');       prob%of_schedule = parse_schedule(scanner, token)
-                case('ac');       prob%ac_at = scanner%read_real(ierr)
+                case('%f');       prob%of_schedule = parse_schedule(scanner, buffer, buffer(first:last))
+                case('ac');       prob%ac_at = scanner%read_real(buffer, ierr)
                 case('eq');       prob%equilibrium = .true.
                 case('fr','fz');  prob%frozen = .true.
                 case('hp','ph');  prob%type = 'hp'
-                case('pc','pi');  prob%pcp_schedule = parse_schedule(scanner, token)
+                case('pc','pi');  prob%pcp_schedule = parse_schedule(scanner, buffer, buffer(first:last))
                 case('ro');       prob%type = 'rkt'
                 case('sh');       prob%type = 'shk'
                 case('sp','ps');  prob%type = 'sp'
@@ -357,8 +536,8 @@ contains
                 case('tp','pt');  prob%type = 'tp'
                 case('tv','vt');  prob%type = 'tv'
                 case('uv','vu');  prob%type = 'uv'
-                case('u1');       prob%u1_schedule = parse_schedule(scanner, token)
-                case('ma');       prob%mdot = scanner%read_real(ierr)
+                case('u1');       prob%u1_schedule = parse_schedule(scanner, buffer, buffer(first:last))
+                case('ma');       prob%mdot = scanner%read_real(buffer, ierr)
                 case default
                     match = .false.
             end select
@@ -367,10 +546,10 @@ contains
             ! One-letter tokens
             match = .true.
             select case(token(:1))
-                case('t');  prob%t_schedule = parse_schedule(scanner, token)
-                case('p');  prob%p_schedule = parse_schedule(scanner, token)
-                case('v');  prob%v_schedule = parse_schedule(scanner, token)
-                case('r');  prob%of_schedule = parse_schedule(scanner, token)
+                case('t');  prob%t_schedule = parse_schedule(scanner, buffer, buffer(first:last))
+                case('p');  prob%p_schedule = parse_schedule(scanner, buffer, buffer(first:last))
+                case('v');  prob%v_schedule = parse_schedule(scanner, buffer, buffer(first:last))
+                case('r');  prob%of_schedule = parse_schedule(scanner, buffer, buffer(first:last))
                 case default
                     match = .false.
             end select
@@ -441,81 +620,72 @@ contains
         !type(ReactantDataset) :: reac
         type(ReactantInput), allocatable :: reac(:)
 
-        type(string_scanner) :: scanner
-        character(15) :: token
-        character(2) :: token2
-        character(:), allocatable :: token_lower
-        integer :: ierr, n, capacity, i, len_tok
+        type(TokenScanner) :: scanner
+        type(ReactantInput), allocatable :: grown(:)
+        character(15) :: key
+        integer :: n, i, first, last
         logical :: has_na, has_fuel_oxid, has_mole_amount, has_weight_amount
         type(Schedule) :: amount_sched
 
-        scanner = string_scanner(replace_delimiters(buffer, replace_commas=.false.))
-        token = scanner%read_word()  ! Skip 'reac' keyword
+        ! Commas separate formula values here, so they are not blanks
+        scanner = TokenScanner(commas=.false.)
+        call scanner%skip(buffer)  ! Skip 'reac' keyword
 
         n = 0
-        capacity = 32
-        allocate(reac(capacity))
+        allocate(reac(32))
         has_mole_amount = .false.
         has_weight_amount = .false.
         do
-            token = scanner%read_word(ierr)
-            if (ierr < 0) exit  ! Buffer exhausted
-            token_lower = to_lower(trim(token))
-            len_tok = len_trim(token_lower)
-            if (len_tok == 0) cycle
-            token2 = '  '
-            if (len_tok >= 2) then
-                token2 = token_lower(:2)
-            else
-                token2(1:1) = token_lower(1:1)
-            end if
+            if (.not. scanner%next(buffer, first, last)) exit  ! Buffer exhausted
+            key = lower_key(buffer(first:last))
 
             ! Start new reactant definition
-            select case(token2)
+            select case(key(:2))
                 case ('fu','ox','na')
                     n = n+1
-                    if (n > capacity) then
-                        reac = [reac, reac]
-                        capacity = size(reac)
+                    if (n > size(reac)) then
+                        allocate(grown(2*size(reac)))
+                        grown(:n-1) = reac
+                        call move_alloc(grown, reac)
                     end if
-                    reac(n)%type = token_lower(:2)
-                    reac(n)%name = scanner%read_word()
+                    reac(n)%type = key(:2)
+                    reac(n)%name = scanner%read_word(buffer)
                     call log_debug('Parsing parameters for reactant '//reac(n)%name)
                     cycle
             end select
 
             ! Parse reactant parameters
             if (n == 0) then
-                call abort('reac dataset missing reactant definition before token: '//token)
+                call abort('reac dataset missing reactant definition before token: '//buffer(first:last))
             end if
-            if (is_molecular_weight_token(token_lower)) then
-                reac(n)%molecular_weight = parse_molecular_weight(scanner, token)
+            if (is_molecular_weight_token(key)) then
+                reac(n)%molecular_weight = parse_molecular_weight(scanner, buffer, buffer(first:last))
                 cycle
             end if
-            if (is_formula_element_token(token)) then
-                reac(n)%formula = parse_formula(scanner, token)
+            if (is_formula_element_token(buffer(first:last))) then
+                reac(n)%formula = parse_formula(scanner, buffer, buffer(first:last))
                 cycle
             end if
-            select case(token_lower(1:1))
+            select case(key(1:1))
                 case ('m','w')
-                    amount_sched = parse_schedule(scanner, token_lower)
+                    amount_sched = parse_schedule(scanner, buffer, trim(key))
                     reac(n)%amount = amount_sched
                     if (amount_sched%name == 'mole_frac') has_mole_amount = .true.
                     if (amount_sched%name == 'weight_frac') has_weight_amount = .true.
-                case ('t');      reac(n)%temperature = parse_schedule(scanner, token)
-                case ('h','u');  reac(n)%enthalpy = parse_schedule(scanner, token)
+                case ('t');      reac(n)%temperature = parse_schedule(scanner, buffer, buffer(first:last))
+                case ('h','u');  reac(n)%enthalpy = parse_schedule(scanner, buffer, buffer(first:last))
                 case ('r')
-                    reac(n)%density = parse_schedule(scanner, token)
+                    reac(n)%density = parse_schedule(scanner, buffer, buffer(first:last))
                     if (len_trim(reac(n)%density%units) == 0) reac(n)%density%units = 'g/cc'
                 case ('d')
-                    if (is_density_token(token)) then
-                        reac(n)%density = parse_schedule(scanner, token)
+                    if (is_density_token(key)) then
+                        reac(n)%density = parse_schedule(scanner, buffer, buffer(first:last))
                         if (len_trim(reac(n)%density%units) == 0) reac(n)%density%units = 'g/cc'
                     else
-                        call abort('reac dataset contains unrecognized token: '//token)
+                        call abort('reac dataset contains unrecognized token: '//buffer(first:last))
                     end if
                 case default
-                    call abort('reac dataset contains unrecognized token: '//token)
+                    call abort('reac dataset contains unrecognized token: '//buffer(first:last))
             end select
 
         end do
@@ -562,70 +732,57 @@ contains
 
     end function
 
-    logical function is_density_token(token) result(tf)
-        character(*), intent(in) :: token
-        character(:), allocatable :: tok
-        integer :: l
-
-        tok = to_lower(trim(token))
-        l = len_trim(tok)
-        if (l == 0) then
-            tf = .false.
-        else
-            tf = (tok(:min(3, l)) == 'den')
-        end if
+    logical function is_density_token(key) result(tf)
+        character(*), intent(in) :: key  ! Lower case, see lower_key
+        tf = startswith(key, 'den')
     end function
 
-    logical function is_molecular_weight_token(token) result(tf)
-        character(*), intent(in) :: token
-        character(:), allocatable :: tok
-
-        tok = to_lower(trim(token))
-        tf = (tok == 'wt/mol') .or. (tok == 'wt/mole') .or. (tok == 'molwt') .or. &
-             (tok == 'mwt') .or. (tok == 'mw')
+    logical function is_molecular_weight_token(key) result(tf)
+        character(*), intent(in) :: key  ! Lower case, see lower_key
+        tf = (key == 'wt/mol') .or. (key == 'wt/mole') .or. (key == 'molwt') .or. &
+             (key == 'mwt') .or. (key == 'mw')
     end function
 
     logical function is_formula_element_token(token) result(tf)
         character(*), intent(in) :: token
-        character(:), allocatable :: tok
         integer :: l
 
-        tok = trim(token)
-        l = len_trim(tok)
+        l = len_trim(token)
         if (l < 1 .or. l > 2) then
             tf = .false.
             return
         end if
-        if (.not. (tok(1:1) >= 'A' .and. tok(1:1) <= 'Z')) then
+        if (.not. (token(1:1) >= 'A' .and. token(1:1) <= 'Z')) then
             tf = .false.
             return
         end if
         if (l == 2) then
-            tf = (tok(2:2) >= 'a' .and. tok(2:2) <= 'z')
+            tf = (token(2:2) >= 'a' .and. token(2:2) <= 'z')
         else
             tf = .true.
         end if
     end function
 
-    function parse_molecular_weight(scanner, token) result(mw)
-        type(string_scanner), intent(inout) :: scanner
+    function parse_molecular_weight(scanner, buffer, token) result(mw)
+        type(TokenScanner), intent(inout) :: scanner
+        character(*), intent(in) :: buffer
         character(*), intent(in) :: token
         real(dp) :: mw
-        character(:), allocatable :: units
-        integer :: ierr
+        character(15) :: units
+        integer :: ierr, first, last
 
-        mw = scanner%peek_real(ierr)
+        mw = scanner%peek_real(buffer, ierr)
         if (ierr == 0) then
-            mw = scanner%read_real(ierr)
+            mw = scanner%read_real(buffer, ierr)
             return
         end if
 
-        units = to_lower(scanner%read_word(ierr))
-        if (ierr /= 0) then
+        if (.not. scanner%next(buffer, first, last)) then
             call abort('reac dataset missing molecular weight value after token: '//trim(token))
         end if
+        units = lower_key(buffer(first:last))
 
-        mw = scanner%read_real(ierr)
+        mw = scanner%read_real(buffer, ierr)
         if (ierr /= 0) then
             call abort('reac dataset missing molecular weight value after units token: '//trim(units))
         end if
@@ -636,7 +793,7 @@ contains
             case ('kg/mol', 'kg/mole')
                 mw = mw*1.0d3
             case default
-                call abort('reac dataset has unrecognized molecular weight units: '//trim(units))
+                call abort('reac dataset has unrecognized molecular weight units: '//buffer(first:last))
         end select
     end function
 
@@ -646,29 +803,30 @@ contains
         character(*), intent(in) :: buffer
         character(sn), allocatable :: species(:)
 
-        type(string_scanner) :: scanner
-        character(:), allocatable :: dsname
-        integer :: ierr, n, capacity
+        type(TokenScanner) :: scanner
+        character(sn), allocatable :: grown(:)
+        integer :: n, first, last
 
-        capacity = 64
-        allocate(species(capacity))
-        scanner = string_scanner(buffer)
-        dsname = scanner%read_word()  ! Skip dataset name, e.g. omit
+        allocate(species(64))
 
-        n = 1
-        do
-            species(n) = scanner%read_word(ierr)
-            if (ierr /= 0) exit
-            n = n+1
-            if (n > capacity) then
+        ! Species names may hold commas and '=', so only white space separates them
+        scanner = TokenScanner(commas=.false., equals=.false.)
+        call scanner%skip(buffer)  ! Skip dataset name, e.g. omit
+
+        n = 0
+        do while (scanner%next(buffer, first, last))
+            if (n == size(species)) then
                 ! Double array size when we hit capacity
-                species = [species, species]
-                capacity = size(species)
+                allocate(grown(2*n))
+                grown(:n) = species
+                call move_alloc(grown, species)
             end if
+            n = n+1
+            species(n) = buffer(first:last)
         end do
 
-        call log_debug('Parsed '//to_str(n-1)//' species from '//dsname)
-        species = species(:n-1)
+        call log_debug('Parsed '//to_str(n)//' species from '//buffer(1:4))
+        species = species(:n)
 
         return
     end function
@@ -677,16 +835,16 @@ contains
         character(*), intent(in) :: buffer
         type(OutputDataset) :: output
 
-        type(string_scanner) :: scanner
+        type(TokenScanner) :: scanner
         character(15) :: token
         logical :: match
-        integer :: ierr
+        integer :: first, last
 
-        scanner = string_scanner(replace_delimiters(buffer))
-        token = scanner%read_word()  ! Skip "prob" keyword
+        scanner = TokenScanner()
+        call scanner%skip(buffer)  ! Skip "outp" keyword
         do
-            token = scanner%read_word(ierr)
-            if (ierr < 0) exit  ! Buffer exhausted
+            if (.not. scanner%next(buffer, first, last)) exit  ! Buffer exhausted
+            token = buffer(first:last)
             call log_debug('Parsing prob literal '//token)
 
             ! Five letter keywords
@@ -702,7 +860,7 @@ contains
             match = .true.
             select case(token(:4))
                 case('tran'); output%transport = .true.
-                case('trac'); output%trace = scanner%read_real()
+                case('trac'); output%trace = scanner%read_real(buffer)
                 case default
                     match = .false.
             end select
@@ -723,52 +881,59 @@ contains
 
     end function
 
-    function parse_schedule(scanner, token) result(sched)
+    function parse_schedule(scanner, buffer, token) result(sched)
         ! Parse a schedule object from a string buffer
 
-        type(string_scanner), intent(inout) :: scanner
+        type(TokenScanner), intent(inout) :: scanner
+        character(*), intent(in) :: buffer
         character(*), intent(in) :: token
         type(Schedule) :: sched
 
-        integer, parameter :: max_values = 64
-        integer :: i,ierr
+        integer, parameter :: initial_values = 64
+        real(dp), allocatable :: values(:), grown(:)
+        integer :: n, ierr, first, last
         real(dp) :: val
 
-        allocate(sched%values(max_values))
+        allocate(values(initial_values))
 
         ! Try reading first schedule value; if fails, its a unit string
-        val = scanner%peek_real(ierr)
+        val = scanner%peek_real(buffer, ierr)
         if (ierr == 0) then
             call parse_embedded(token, sched%name, sched%units)
         else
             sched%name = trim(token)
-            sched%units = scanner%read_word(ierr)
+            sched%units = scanner%read_word(buffer, ierr)
         end if
 
-        ! Read values from the schedule
-        ! Need to peek then read so we don't consume next token
-        do i = 1,max_values
-            sched%values(i) = scanner%peek_real(ierr)
-            if (ierr == 0) then
-                sched%values(i) = scanner%read_real(ierr)
-            else
-                sched%values = sched%values(:i-1)
-                exit
+        ! Read values from the schedule, doubling the array when it fills.
+        ! Peek then skip the word so we don't consume the next token.
+        n = 0
+        do while (scanner%peek(buffer, first, last))
+            val = to_real(buffer(first:last), ierr)
+            if (ierr /= 0) exit
+            call scanner%skip(buffer)
+            if (n == size(values)) then
+                allocate(grown(2*n))
+                grown(:n) = values
+                call move_alloc(grown, values)
             end if
+            n = n+1
+            values(n) = val
         end do
+        sched%values = values(:n)
 
         return
     end function
 
-    function parse_formula(scanner, token) result(f)
-        type(string_scanner), intent(inout) :: scanner
+    function parse_formula(scanner, buffer, token) result(f)
+        type(TokenScanner), intent(inout) :: scanner
+        character(*), intent(in) :: buffer
         character(*), intent(in) :: token
 
         type(Formula) :: f
         integer, parameter :: max_values = 16
-        integer :: i, n, ierr
+        integer :: i, n, ierr, first, last
         real(dp) :: val
-        character(:), allocatable :: word
 
         allocate(f%elements(max_values))
         allocate(f%coefficients(max_values))
@@ -779,22 +944,21 @@ contains
         end if
         f%elements(n) = token
         f%coefficients(n) = 1.0d0
-        val = scanner%peek_real(ierr)
-        if (ierr == 0) f%coefficients(n) = scanner%read_real(ierr)
+        val = scanner%peek_real(buffer, ierr)
+        if (ierr == 0) f%coefficients(n) = scanner%read_real(buffer, ierr)
 
         do i = 2,size(f%elements)
-            word = scanner%peek_word(ierr)
-            if (ierr /= 0) exit  ! Buffer empty
-            select case(word(1:1))
+            if (.not. scanner%peek(buffer, first, last)) exit  ! Buffer empty
+            select case(buffer(first:first))
                 case('A':'Z')
-                    word = scanner%read_word()
-                    if (len_trim(word) > en) then
-                        call abort('parse_formula: element symbol too long: '//trim(word))
+                    call scanner%skip(buffer)
+                    if (last-first+1 > en) then
+                        call abort('parse_formula: element symbol too long: '//buffer(first:last))
                     end if
-                    f%elements(i) = word
+                    f%elements(i) = buffer(first:last)
                     f%coefficients(i) = 1.0d0
-                    val = scanner%peek_real(ierr)
-                    if (ierr == 0) f%coefficients(i) = scanner%read_real(ierr)
+                    val = scanner%peek_real(buffer, ierr)
+                    if (ierr == 0) f%coefficients(i) = scanner%read_real(buffer, ierr)
                     n = i
                 case default
                     exit  ! Start of new keyword
@@ -927,16 +1091,17 @@ contains
              startswith(line,'!')
     end function
 
-    function to_lower(txt) result(out)
-        character(*), intent(in) :: txt
-        character(:), allocatable :: out
+    pure function lower_key(word) result(key)
+        ! Lower-case copy of the first 15 characters of a word, for keyword matching
+        character(*), intent(in) :: word
+        character(15) :: key
         integer :: i, code
 
-        out = txt
-        do i = 1, len(out)
-            code = iachar(out(i:i))
+        key = word
+        do i = 1, len_trim(key)
+            code = iachar(key(i:i))
             if (code >= iachar('A') .and. code <= iachar('Z')) then
-                out(i:i) = achar(code + 32)
+                key(i:i) = achar(code + 32)
             end if
         end do
     end function
@@ -959,30 +1124,137 @@ contains
         end if
     end function
 
-    function replace_delimiters(line, replace_commas) result(out)
-        character(*), intent(in)  :: line
-        character(:), allocatable :: out
-        logical, intent(in), optional :: replace_commas
-        character(1), parameter :: tab = achar(9)
-        character(1) :: c
-        integer :: i
-        logical :: commas
-
-        commas = .true.
-        if (present(replace_commas)) commas = replace_commas
-
-        out = trim(line)
-        do i = 1,len(out)
-            c = out(i:i)
-            select case(c)
-                case(',')
-                    if (commas) out(i:i) = ' '
-                case('=',tab)
-                    out(i:i) = ' '
-            end select
+    !-----------------------------------------------------------------------
+    ! TokenScanner
+    !-----------------------------------------------------------------------
+    function TokenScanner_init(commas, equals) result(self)
+        logical, intent(in), optional :: commas
+        logical, intent(in), optional :: equals
+        type(TokenScanner) :: self
+        if (present(commas)) self%commas = commas
+        if (present(equals)) self%equals = equals
+    end function
+
+    logical function TokenScanner_is_blank(self, c) result(tf)
+        class(TokenScanner), intent(in) :: self
+        character(1), intent(in) :: c
+        tf = (c <= ' ') .or. (self%commas .and. c == ',') .or. (self%equals .and. c == '=')
+    end function
+
+    function TokenScanner_peek(self, buffer, first, last) result(found)
+        ! Locate the next word, buffer(first:last), without consuming it
+        class(TokenScanner), intent(in) :: self
+        character(*), intent(in) :: buffer
+        integer, intent(out) :: first, last
+        logical :: found
+
+        first = self%pos
+        do while (first <= len(buffer))
+            if (.not. TokenScanner_is_blank(self, buffer(first:first))) exit
+            first = first+1
+        end do
+        last = first
+        do while (last < len(buffer))
+            if (TokenScanner_is_blank(self, buffer(last+1:last+1))) exit
+            last = last+1
         end do
+        found = (first <= len(buffer))
+
+    end function
+
+    function TokenScanner_next(self, buffer, first, last) result(found)
+        ! Locate the next word, buffer(first:last), and consume it
+        class(TokenScanner), intent(inout) :: self
+        character(*), intent(in) :: buffer
+        integer, intent(out) :: first, last
+        logical :: found
+
+        found = self%peek(buffer, first, last)
+        self%pos = last+1
+
+    end function
+
+    subroutine TokenScanner_skip(self, buffer)
+        ! Consume the next word, if any
+        class(TokenScanner), intent(inout) :: self
+        character(*), intent(in) :: buffer
+        integer :: first, last
+        logical :: found
+        found = self%next(buffer, first, last)
+    end subroutine
+
+    function TokenScanner_read_word(self, buffer, ierr) result(word)
+        ! Copy of the next word; aborts at the end of the buffer unless ierr is present
+        class(TokenScanner), intent(inout) :: self
+        character(*), intent(in) :: buffer
+        integer, intent(out), optional :: ierr
+        character(:), allocatable :: word
+        integer :: first, last
+
+        if (self%next(buffer, first, last)) then
+            word = buffer(first:last)
+            if (present(ierr)) ierr = 0
+        else
+            word = ''
+            if (present(ierr)) then
+                ierr = -1
+            else
+                call abort('Input dataset ended before its last value: '//buffer)
+            end if
+        end if
+
+    end function
+
+    function TokenScanner_peek_real(self, buffer, ierr) result(val)
+        ! Value of the next word, without consuming it
+        class(TokenScanner), intent(in) :: self
+        character(*), intent(in) :: buffer
+        integer, intent(out) :: ierr
+        real(dp) :: val
+        integer :: first, last
+
+        val = empty_dp
+        ierr = -1
+        if (self%peek(buffer, first, last)) val = to_real(buffer(first:last), ierr)
+
+    end function
+
+    function TokenScanner_read_real(self, buffer, ierr) result(val)
+        ! Value of the next word; aborts on a missing or bad value unless ierr is present
+        class(TokenScanner), intent(inout) :: self
+        character(*), intent(in) :: buffer
+        integer, intent(out), optional :: ierr
+        real(dp) :: val
+        integer :: first, last, ierr_
+
+        val = empty_dp
+        ierr_ = -1
+        if (self%next(buffer, first, last)) val = to_real(buffer(first:last), ierr_)
+        if (present(ierr)) then
+            ierr = ierr_
+        else if (ierr_ /= 0) then
+            call abort('Input dataset has a missing or bad value: '//buffer)
+        end if
+
+    end function
+
+    function TokenScanner_read_int(self, buffer, ierr) result(val)
+        ! Integer value of the next word; aborts on a missing or bad value unless ierr is present
+        class(TokenScanner), intent(inout) :: self
+        character(*), intent(in) :: buffer
+        integer, intent(out), optional :: ierr
+        integer :: val
+        integer :: first, last, ierr_
+
+        val = empty_int
+        ierr_ = -1
+        if (self%next(buffer, first, last)) val = to_int(buffer(first:last), ierr_)
+        if (present(ierr)) then
+            ierr = ierr_
+        else if (ierr_ /= 0) then
+            call abort('Input dataset has a missing or bad value: '//buffer)
+        end if
 
-        return
     end function
 
 end module
@@ -0,0 +1,456 @@
+module cea_isat
+    !! In-situ adaptive tabulation (ISAT) of equilibrium solutions
+    !!
+    !! Caches converged equilibrium states in front of EqSolver_solve. Each
+    !! record stores the solution phi = [T, n, nj] at a query point
+    !! x = [b0, state1, state2], the sensitivity matrix A = dphi/dx from
+    !! EqDerivatives, and an ellipsoid of accuracy (EOA) in which the linear
+    !! approximation phi0 + A*(x - x0) is trusted. Queries inside an EOA are
+    !! retrieved without a Newton solve; other queries are solved directly and
+    !! then either grow the nearest EOA or add a new record (Pope, 1997).
+
+    use cea_param, only: dp
+    use cea_equilibrium, only: EqSolver, EqSolution, EqPartials, EqDerivatives, &
+                               deriv_T, deriv_n, deriv_nj, &
+                               deriv_wrt_state1, deriv_wrt_state2, deriv_wrt_b0
+    use fb_utils
+    implicit none
+
+    type :: IsatRecord
+        !! Single tabulated equilibrium state
+
+        character(2) :: type = '  '
+            !! Problem type of the tabulated solve
+        real(dp), allocatable :: x0(:)
+            !! Query point [b0, state1, state2] (ne+2)
+        real(dp), allocatable :: x_scale(:)
+            !! Scaling applied to x before measuring distances (ne+2)
+        real(dp), allocatable :: phi0(:)
+            !! Tabulated solution [T, n, nj] (np+2)
+        real(dp), allocatable :: A(:, :)
+            !! Sensitivity matrix dphi/dx (np+2 x ne+2)
+        real(dp), allocatable :: M(:, :)
+            !! Ellipsoid of accuracy in scaled coordinates, x^T M x <= 1 (ne+2 x ne+2)
+        real(dp), allocatable :: ln_nj0(:)
+            !! Log of gas species concentrations at the tabulated point (ng)
+        real(dp), allocatable :: pi0(:)
+            !! Lagrange multipliers at the tabulated point (ne)
+        logical, allocatable :: is_active(:)
+            !! Active condensed set at the tabulated point (nc)
+        integer, allocatable :: active_rank(:)
+            !! Activation order of the condensed set at the tabulated point (nc)
+        integer :: last_used = 0
+            !! Table clock value at the last retrieve/grow (for LRU eviction)
+    end type
+
+    type :: IsatTable
+        !! ISAT cache for a single EqSolver
+        !!
+        !! A table is tied to the product/reactant mixtures of the solver it
+        !! was first used with; call clear() before reusing it with another.
+
+        ! Parameters
+        integer :: max_records = 500
+            !! Maximum number of stored records; least recently used are evicted
+        real(dp) :: tolerance = 1.0d-4
+            !! Error tolerance on the scaled solution [T/T0, n/n0, nj/n0]
+        real(dp) :: max_radius = 5.0d-2
+            !! Upper bound on the EOA radius in scaled coordinates
+
+        ! Storage
+        integer :: num_records = 0
+            !! Number of records currently stored
+        type(IsatRecord), allocatable :: records(:)
+            !! Record storage (max_records)
+        integer :: clock = 0
+            !! Monotonic counter used to timestamp record use
+
+        ! Statistics
+        integer :: num_queries = 0
+            !! Total number of queries
+        integer :: num_hits = 0
+            !! Queries retrieved from the table by linear approximation
+        integer :: num_misses = 0
+            !! Queries that required a direct solve
+        integer :: num_grows = 0
+            !! Misses that grew an existing EOA
+        integer :: num_adds = 0
+            !! Misses that added a new record
+        integer :: num_evictions = 0
+            !! Records evicted to respect max_records
+
+    contains
+
+        procedure :: solve => IsatTable_solve
+        procedure :: clear => IsatTable_clear
+        procedure :: reset_stats => IsatTable_reset_stats
+
+    end type
+    interface IsatTable
+        module procedure :: IsatTable_init
+    end interface
+
+contains
+
+    function IsatTable_init(max_records, tolerance, max_radius) result(self)
+
+        ! Arguments
+        integer, intent(in), optional :: max_records
+        real(dp), intent(in), optional :: tolerance
+        real(dp), intent(in), optional :: max_radius
+
+        ! Result
+        type(IsatTable) :: self
+
+        if (present(max_records)) self%max_records = max_records
+        if (present(tolerance)) self%tolerance = tolerance
+        if (present(max_radius)) self%max_radius = max_radius
+
+        call assert(self%max_records > 0, 'IsatTable_init: max_records must be positive')
+        call assert(self%tolerance > 0.0d0, 'IsatTable_init: tolerance must be positive')
+        call assert(self%max_radius > 0.0d0, 'IsatTable_init: max_radius must be positive')
+
+        allocate(self%records(self%max_records))
+
+    end function
+
+    subroutine IsatTable_clear(self)
+        ! Drop all records, keeping the table parameters and statistics
+        class(IsatTable), intent(inout) :: self
+
+        if (allocated(self%records)) deallocate(self%records)
+        allocate(self%records(self%max_records))
+        self%num_records = 0
+        self%clock = 0
+
+    end subroutine
+
+    subroutine IsatTable_reset_stats(self)
+        class(IsatTable), intent(inout) :: self
+
+        self%num_queries = 0
+        self%num_hits = 0
+        self%num_misses = 0
+        self%num_grows = 0
+        self%num_adds = 0
+        self%num_evictions = 0
+
+    end subroutine
+
+    subroutine IsatTable_solve(self, solver, soln, type, state1, state2, reactant_weights, partials)
+        ! Drop-in replacement for EqSolver_solve that retrieves from the table when possible
+
+        ! Arguments
+        class(IsatTable), intent(inout) :: self
+        type(EqSolver), intent(inout) :: solver
+        type(EqSolution), intent(inout) :: soln
+        character(2), intent(in) :: type
+        real(dp), intent(in) :: state1
+        real(dp), intent(in) :: state2
+        real(dp), intent(in) :: reactant_weights(:)
+        type(EqPartials), intent(out), optional :: partials
+
+        ! Locals
+        integer :: ne                          ! Number of elements
+        integer :: idx                         ! Index of the nearest record
+        real(dp) :: x(solver%num_elements+2)   ! Query point [b0, state1, state2]
+        real(dp) :: phi(solver%num_products+2) ! Exact solution [T, n, nj]
+        real(dp) :: dist                       ! Scaled EOA distance to the nearest record
+        real(dp) :: err                        ! Scaled error of the linear approximation
+
+        if (.not. allocated(self%records)) allocate(self%records(self%max_records))
+
+        ne = solver%num_elements
+        x(:ne) = solver%reactants%element_amounts_from_weights(reactant_weights)
+        x(ne+1) = state1
+        x(ne+2) = state2
+
+        self%num_queries = self%num_queries + 1
+        self%clock = self%clock + 1
+
+        call IsatTable_find(self, solver, type, x, idx, dist)
+
+        if (idx > 0 .and. dist <= 1.0d0) then
+            self%num_hits = self%num_hits + 1
+            self%records(idx)%last_used = self%clock
+            call IsatTable_retrieve(self%records(idx), solver, soln, type, state1, state2, &
+                                    reactant_weights, x, partials)
+            return
+        end if
+
+        ! Direct evaluation
+        self%num_misses = self%num_misses + 1
+        call solver%solve(soln, type, state1, state2, reactant_weights, partials)
+        if (.not. soln%converged) return
+
+        ! Derivatives are only consistent when every element row is active
+        if (solver%num_active_elements() /= ne) return
+
+        phi(1) = soln%T
+        phi(2) = soln%n
+        phi(3:) = soln%nj
+
+        if (idx > 0) then
+            if (all(self%records(idx)%is_active .eqv. soln%is_active)) then
+                err = IsatRecord_error(self%records(idx), x, phi)
+                if (err <= self%tolerance) then
+                    call IsatRecord_grow(self%records(idx), x)
+                    self%records(idx)%last_used = self%clock
+                    self%num_grows = self%num_grows + 1
+                    return
+                end if
+            end if
+        end if
+
+        call IsatTable_add(self, solver, soln, type, x, phi)
+
+    end subroutine
+
+    subroutine IsatTable_find(self, solver, type, x, idx, dist)
+        ! Locate the record whose EOA is closest to x (in EOA-scaled distance)
+
+        ! Arguments
+        class(IsatTable), intent(in) :: self
+        type(EqSolver), intent(in) :: solver
+        character(2), intent(in) :: type
+        real(dp), intent(in) :: x(:)
+        integer, intent(out) :: idx
+        real(dp), intent(out) :: dist
+
+        ! Locals
+        integer :: i
+        real(dp) :: d
+        real(dp) :: dx(size(x))
+
+        idx = 0
+        dist = huge(1.0d0)
+
+        do i = 1, self%num_records
+            associate(rec => self%records(i))
+                if (rec%type /= type) cycle
+                if (size(rec%x0) /= size(x)) cycle
+                if (size(rec%phi0) /= solver%num_products+2) cycle
+                dx = (x - rec%x0) / rec%x_scale
+                d = dot_product(dx, matmul(rec%M, dx))
+            end associate
+            if (d < dist) then
+                dist = d
+                idx = i
+            end if
+        end do
+
+    end subroutine
+
+    subroutine IsatTable_retrieve(rec, solver, soln, type, state1, state2, reactant_weights, x, partials)
+        ! Populate soln from the linear approximation stored in rec
+
+        ! Arguments
+        type(IsatRecord), intent(in) :: rec
+        type(EqSolver), intent(inout) :: solver
+        type(EqSolution), intent(inout) :: soln
+        character(2), intent(in) :: type
+        real(dp), intent(in) :: state1
+        real(dp), intent(in) :: state2
+        real(dp), intent(in) :: reactant_weights(:)
+        real(dp), intent(in) :: x(:)
+        type(EqPartials), intent(out), optional :: partials
+
+        ! Locals
+        integer :: i, ng, ne
+        real(dp) :: phi(size(rec%phi0))
+
+        ng = solver%num_gas
+        ne = solver%num_elements
+
+        phi = rec%phi0 + matmul(rec%A, x - rec%x0)
+
+        soln%w0 = reactant_weights
+        call soln%constraints%set(type, state1, state2, x(:ne))
+
+        soln%is_active = rec%is_active
+        soln%active_rank = rec%active_rank
+        soln%pi = rec%pi0
+        soln%pi_prev = rec%pi0
+
+        ! Species amounts; species driven below zero by the linearization are removed
+        soln%nj = max(phi(3:), 0.0d0)
+        do i = 1, ng
+            if (soln%nj(i) > 0.0d0) then
+                soln%ln_nj(i) = log(soln%nj(i))
+            else
+                soln%ln_nj(i) = rec%ln_nj0(i)
+            end if
+        end do
+
+        if (soln%constraints%is_constant_temperature()) then
+            soln%T = state1
+        else
+            soln%T = phi(1)
+        end if
+        if (soln%constraints%is_constant_pressure()) then
+            soln%n = phi(2)
+        else
+            soln%n = sum(soln%nj(:ng))
+        end if
+
+        call solver%products%calc_thermo(soln%thermo, soln%T, condensed=.true.)
+
+        ! Force post-processing to recompute the mixture properties
+        soln%cp_fr = 0.0d0
+        soln%cp_eq = 0.0d0
+        soln%gamma_s = 0.0d0
+
+        call solver%finish_outputs(soln, partials)
+        soln%converged = .true.
+
+    end subroutine
+
+    subroutine IsatTable_add(self, solver, soln, type, x, phi)
+        ! Tabulate a converged solution as a new record, evicting the LRU record if full
+
+        ! Arguments
+        class(IsatTable), intent(inout) :: self
+        type(EqSolver), intent(in) :: solver
+        type(EqSolution), intent(inout) :: soln
+        character(2), intent(in) :: type
+        real(dp), intent(in) :: x(:)
+        real(dp), intent(in) :: phi(:)
+
+        ! Locals
+        integer :: i, j, k, idx
+        integer :: ng, ne, nx, nphi
+        real(dp) :: phi_scale(size(phi))
+        real(dp) :: B(size(phi), size(x))       ! Scaled sensitivity matrix
+        real(dp) :: b_ref                       ! Reference element amount for scaling
+        type(EqDerivatives) :: derivs
+
+        ng = solver%num_gas
+        ne = solver%num_elements
+        nx = size(x)
+        nphi = size(phi)
+
+        ! Compute the sensitivities about the converged state
+        derivs = EqDerivatives(solver, soln, outputs=deriv_T + deriv_n + deriv_nj + &
+                               deriv_wrt_state1 + deriv_wrt_state2 + deriv_wrt_b0)
+        call derivs%compute_derivatives(solver, soln)
+        call derivs%unpack_values(solver, soln)
+
+        ! Select a slot
+        if (self%num_records < self%max_records) then
+            self%num_records = self%num_records + 1
+            idx = self%num_records
+        else
+            idx = minloc(self%records(:self%num_records)%last_used, dim=1)
+            self%num_evictions = self%num_evictions + 1
+        end if
+
+        associate(rec => self%records(idx))
+
+            rec%type = type
+            rec%last_used = self%clock
+            rec%x0 = x
+            rec%phi0 = phi
+            rec%ln_nj0 = soln%ln_nj
+            rec%pi0 = soln%pi
+            rec%is_active = soln%is_active
+            rec%active_rank = soln%active_rank
+
+            ! Per-dimension scaling of the query point
+            b_ref = max(maxval(abs(x(:ne))), tiny(1.0d0))
+            if (allocated(rec%x_scale)) deallocate(rec%x_scale)
+            allocate(rec%x_scale(nx))
+            do i = 1, ne
+                rec%x_scale(i) = max(abs(x(i)), 1.0d-6*b_ref)
+            end do
+            rec%x_scale(ne+1) = max(abs(x(ne+1)), 1.0d0)
+            rec%x_scale(ne+2) = max(abs(x(ne+2)), 1.0d-12)
+
+            ! Sensitivity matrix A = dphi/dx; active condensed rows are compressed in derivs
+            if (allocated(rec%A)) deallocate(rec%A)
+            allocate(rec%A(nphi, nx), source=0.0d0)
+            rec%A(1, :ne) = derivs%dT_db0
+            rec%A(1, ne+1) = derivs%dT_dstate1
+            rec%A(1, ne+2) = derivs%dT_dstate2
+            rec%A(2, :ne) = derivs%dn_db0
+            rec%A(2, ne+1) = derivs%dn_dstate1
+            rec%A(2, ne+2) = derivs%dn_dstate2
+            do j = 1, ng
+                rec%A(2+j, :ne) = derivs%dnj_db0(j, :)
+                rec%A(2+j, ne+1) = derivs%dnj_dstate1(j)
+                rec%A(2+j, ne+2) = derivs%dnj_dstate2(j)
+            end do
+            k = ng
+            do j = 1, solver%num_condensed
+                if (.not. soln%is_active(j)) cycle
+                k = k + 1
+                rec%A(2+ng+j, :ne) = derivs%dnj_db0(k, :)
+                rec%A(2+ng+j, ne+1) = derivs%dnj_dstate1(k)
+                rec%A(2+ng+j, ne+2) = derivs%dnj_dstate2(k)
+            end do
+
+            ! Initial EOA: region where the linear change stays within tolerance,
+            ! bounded by max_radius in every direction
+            phi_scale(1) = max(phi(1), 1.0d0)
+            phi_scale(2:) = max(phi(2), tiny(1.0d0))
+            do j = 1, nx
+                B(:, j) = rec%A(:, j) * rec%x_scale(j) / phi_scale
+            end do
+            rec%M = matmul(transpose(B), B) / self%tolerance**2
+            do j = 1, nx
+                rec%M(j, j) = rec%M(j, j) + 1.0d0/self%max_radius**2
+            end do
+
+        end associate
+
+        self%num_adds = self%num_adds + 1
+
+    end subroutine
+
+    function IsatRecord_error(rec, x, phi) result(err)
+        ! Scaled max-norm error of the linear approximation at x against the exact phi
+
+        ! Arguments
+        type(IsatRecord), intent(in) :: rec
+        real(dp), intent(in) :: x(:)
+        real(dp), intent(in) :: phi(:)
+
+        ! Result
+        real(dp) :: err
+
+        ! Locals
+        real(dp) :: phi_lin(size(phi))
+
+        phi_lin = rec%phi0 + matmul(rec%A, x - rec%x0)
+
+        err = abs(phi_lin(1) - phi(1)) / max(rec%phi0(1), 1.0d0)
+        err = max(err, maxval(abs(phi_lin(2:) - phi(2:))) / max(rec%phi0(2), tiny(1.0d0)))
+
+    end function
+
+    subroutine IsatRecord_grow(rec, x)
+        ! Grow the EOA to the minimum-volume ellipsoid containing the old EOA and x
+
+        ! Arguments
+        type(IsatRecord), intent(inout) :: rec
+        real(dp), intent(in) :: x(:)
+
+        ! Locals
+        integer :: i
+        real(dp) :: dx(size(x))
+        real(dp) :: Mdx(size(x))
+        real(dp) :: s, gamma
+
+        dx = (x - rec%x0) / rec%x_scale
+        Mdx = matmul(rec%M, dx)
+        s = dot_product(dx, Mdx)
+        if (s <= 1.0d0) return
+
+        ! Rank-one update M' = M - gamma*(M dx)(M dx)^T puts x on the boundary of the new EOA
+        gamma = (s - 1.0d0) / s**2
+        do i = 1, size(x)
+            rec%M(:, i) = rec%M(:, i) - gamma*Mdx*Mdx(i)
+        end do
+
+    end subroutine
+
+end module
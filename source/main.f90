@@ -4,41 +4,66 @@ program cea
                    R=>gas_constant
     use cea_thermo, only: ThermoDB, read_thermo
     use cea_transport, only: TransportDB, read_transport
-    use cea_input, only: ProblemDB, read_input
-    use cea_equilibrium, only: EqSolver, EqSolution, EqPartials
-    use cea_rocket, only: RocketSolver, RocketSolution
-    use cea_shock, only: ShockSolver, ShockSolution
-    use cea_detonation, only: DetonSolver, DetonSolution
+    use cea_input, only: ProblemDB, InputFile, open_input, read_next_problem, parse_input
+    use cea_equilibrium, only: EqSolver, EqSolution, EqPartials, EqResult, output_properties, output_partials, &
+                               output_transport, output_performance, output_all
+    use cea_rocket, only: RocketSolver, RocketSolution, RocketResult
+    use cea_optimize, only: OfOptimizer, of_opt_isp, of_opt_ivac, of_opt_cstar
+    use cea_shock, only: ShockSolver, ShockSolution, ShockResult
+    use cea_detonation, only: DetonSolver, DetonSolution, DetonResult
     use cea_db_compile, only: compile_thermo_database, compile_transport_database
+    use cea_columns, only: ColumnTable, ColumnWriter, EncodedTable
+    use cea_cache, only: ResultCache, file_checksum, default_cache_bytes
     use cea_mixture
     use cea_units
     use fb_logging
+    use fb_timing, only: profiler, set_profiling
     use fb_utils
+    use iso_fortran_env, only: int64, input_unit, error_unit
+    !$ use omp_lib, only: omp_get_max_threads
     implicit none
 
+    ! One problem block of --serve, handed to the task that answers it
+    type :: ServeRequest
+        character(:), allocatable :: label
+        character(:), allocatable :: text
+    end type
+
     ! Locals
     character(:), allocatable :: input_file_stem, thermo_file, trans_file
     character(:), allocatable :: compile_thermo_input, compile_trans_input
+    character(:), allocatable :: output_format
+    character(:), allocatable :: profile_file
     character(:), allocatable :: data_search_dirs(:)
+    character(:), allocatable :: cache_dir
     type(ThermoDB) :: all_thermo
     type(TransportDB) :: all_transport
-    type(ProblemDB), allocatable :: problems(:)
     type(ProblemDB) :: prob
-    type(EqSolver) :: eq_solver
-    type(EqSolution), allocatable :: eq_solutions(:,:,:)
-    type(EqPartials), allocatable :: eq_partials(:,:,:)
-    type(RocketSolver) :: rkt_solver
-    type(RocketSolution), allocatable :: rkt_solutions(:,:,:)
-    type(ShockSolver) :: shk_solver
-    type(ShockSolution), allocatable :: shk_solutions(:,:,:)
-    type(DetonSolver) :: det_solver
-    type(DetonSolution), allocatable :: det_solutions(:,:,:)
-    integer :: n
-    logical :: ok
-
-    allocate(problems(0))
-
-    call parse_arguments(input_file_stem, thermo_file, trans_file, compile_thermo_input, compile_trans_input)
+    type(OfOptimizer), allocatable :: of_optimizer
+    type(ColumnWriter) :: columns
+    type(ProductCache) :: product_cache
+    type(profiler), allocatable :: run_profile
+    type(ResultCache), allocatable :: cache
+    type(EncodedTable), allocatable :: cached(:)
+    character(16) :: cache_key
+    integer(int64) :: cache_bytes
+    type(InputFile) :: input
+    integer :: n, ierr, punit
+    integer :: iout = 1
+    integer :: num_workers
+    integer :: solve_outputs
+    logical :: ok, print_profile, serve_mode
+
+    call parse_arguments(input_file_stem, thermo_file, trans_file, compile_thermo_input, compile_trans_input, &
+                         output_format, print_profile, profile_file, of_optimizer, cache_dir, cache_bytes, &
+                         serve_mode, num_workers, solve_outputs)
+    ! In --serve, standard output carries the responses; log to standard error instead
+    if (serve_mode) call set_log_unit(error_unit)
+    if (print_profile .or. allocated(profile_file)) then
+        ! Solvers built from here on time their phases; the totals are merged into run_profile
+        call set_profiling(.true.)
+        allocate(run_profile)
+    end if
     call log_info('CEA Version: '//version_string)
 
     if (allocated(compile_thermo_input) .or. allocated(compile_trans_input)) then
@@ -53,11 +78,13 @@ program cea
         stop
     end if
 
-    call log_info('Input File:  '//input_file_stem)
+    if (.not. serve_mode) call log_info('Input File:  '//input_file_stem)
     call log_info('Thermo File: '//thermo_file)
 
-    if (.not. exists(input_file_stem//'.inp')) then
-        call abort('Could not locate input file: '//input_file_stem)
+    if (.not. serve_mode) then
+        if (.not. exists(input_file_stem//'.inp')) then
+            call abort('Could not locate input file: '//input_file_stem)
+        end if
     end if
 
     call get_data_search_dirs(data_search_dirs)
@@ -74,75 +101,555 @@ program cea
         all_transport = read_transport(trans_file)
     end if
 
-    ! Read and parse the input and data files
-    problems = read_input(input_file_stem//'.inp')
+    ! Read the data files and the input deck; problems are parsed from it one at a time
     all_thermo = read_thermo(thermo_file)
+    if (serve_mode) then
+        call serve(num_workers)
+        stop
+    end if
+    input = open_input(input_file_stem//'.inp')
 
     ! Initialize the output file
-    open(1, file=input_file_stem(1:len_trim(input_file_stem))//".out", status="replace")
+    if (output_format == 'text') then
+        open(1, file=input_file_stem(1:len_trim(input_file_stem))//".out", status="replace")
+    else
+        columns = ColumnWriter(input_file_stem, output_format)
+    end if
+
+    ! Problems found in the result cache are replayed instead of solved
+    if (allocated(cache_dir)) then
+        call log_info('Result cache: '//cache_dir)
+        cache = ResultCache(cache_dir, cache_context(), cache_bytes)
+    end if
+
+    ! Parse, solve, and write each problem in turn so parsed problems do not accumulate
+    n = 0
+    do
+        call read_next_problem(input, prob, ierr)
+        if (ierr /= 0) exit
+        n = n + 1
 
-    ! Loop over all problem in the input file
-    do n = 1, size(problems)
         write(log_buffer,'("Executing problem ",i0,": name=",a, ", type=",a)') &
-            n, problems(n)%problem%name, problems(n)%problem%type
+            n, prob%problem%name, prob%problem%type
         call log_info(trim(log_buffer))
 
-        ! Setup
-        prob = problems(n)
+        if (allocated(cache)) then
+            cache_key = cache%key(prob)
+            if (cache%load(cache_key, cached)) then
+                call log_info('Replaying cached result '//cache_key)
+                call replay_output(n, cached)
+                if (output_format == 'text') flush(1)
+                cycle
+            end if
+            call begin_capture()
+        end if
+
+        call run_problem(n, prob, iout)
+
+        if (allocated(cache)) call end_capture(n)
+
+        ! Make results available to downstream readers as soon as each problem completes
+        if (output_format == 'text') flush(1)
+
+    end do
+    call log_info('Processed '//to_str(n)//' problems from '//input_file_stem//'.inp')
+    if (allocated(cache)) then
+        call log_info('Result cache: '//to_str(cache%num_hits)//' hits, '//to_str(cache%num_misses)//' misses, '// &
+                      to_str(cache%num_evicted)//' evicted')
+        call cache%close()
+    end if
+
+    ! Close the output file
+    if (output_format == 'text') then
+        close(1)
+    else
+        call columns%close()
+    end if
+
+    ! Report where the time went
+    if (print_profile) call run_profile%write_totals(stdout)
+    if (allocated(profile_file)) then
+        open(newunit=punit, file=profile_file, status='replace')
+        if (index(profile_file, '.json', back=.true.) == len(profile_file)-4) then
+            call run_profile%write_chrome_trace(punit)
+        else
+            call run_profile%write_collapsed(punit)
+        end if
+        close(punit)
+    end if
+
+contains
+
+    subroutine run_problem(num, prob, unit)
+        ! Solve problem number num and write it to the text output unit or the column writer.
+        ! Solvers are local, so --serve workers can run problems concurrently.
+
+        integer, intent(in) :: num
+        type(ProblemDB), intent(in) :: prob
+        integer, intent(in) :: unit
+
+        type(EqSolver) :: eq_solver
+        type(EqResult), allocatable :: eq_results(:,:,:)
+        type(RocketSolver) :: rkt_solver
+        type(OfOptimizer), allocatable :: optimizer
+        type(ShockSolver) :: shk_solver
+        type(ShockResult), allocatable :: shk_solutions(:,:,:)
+        type(DetonSolver) :: det_solver
+        type(DetonResult), allocatable :: det_solutions(:,:,:)
 
         select case(prob%problem%type)
             case ("tp", "hp", "sp", "tv", "uv", "sv")
                 call log_info('Solving equilibrium problem:')
 
-                call run_thermo_problem(prob, all_thermo, eq_solver, eq_solutions, eq_partials)
-                call thermo_output(1, prob, eq_solver, eq_solutions, eq_partials)
-                deallocate(eq_solutions, eq_partials)
+                call run_thermo_problem(prob, all_thermo, eq_solver, eq_results)
+                call collect_profile(run_profile, eq_solver%profile)
+                if (allocated(run_profile)) call run_profile%enter('output')
+                if (output_format == 'text') then
+                    call thermo_output(unit, prob, eq_solver, eq_results)
+                else
+                    call thermo_columns(columns, num, prob, eq_solver, eq_results)
+                end if
+                if (allocated(run_profile)) call run_profile%leave()
+                deallocate(eq_results)
+                call eq_solver%release()
 
             case ("rkt")
                 call log_info('Solving rocket problem:')
 
-                call run_rocket_problem(prob, all_thermo, rkt_solver, rkt_solutions)
-                call rocket_output(1, prob, rkt_solver, rkt_solutions)
-                deallocate(rkt_solutions)
+                if (allocated(of_optimizer)) then
+                    ! The optimizer keeps the state of its search; work on a copy
+                    optimizer = of_optimizer
+                    call run_optimized_rocket_problem(num, prob, all_thermo, rkt_solver, optimizer, unit)
+                else
+                    call solve_and_write_rocket_problem(num, prob, all_thermo, rkt_solver, unit)
+                end if
+                call rkt_solver%eq_solver%release()
 
             case ("shk")
                 call log_info('Solving shock problem:')
 
                 call run_shock_problem(prob, all_thermo, shk_solver, shk_solutions)
-                call shock_output(1, prob, shk_solver, shk_solutions)
+                call collect_profile(run_profile, shk_solver%eq_solver%profile)
+                if (allocated(run_profile)) call run_profile%enter('output')
+                if (output_format == 'text') then
+                    call shock_output(unit, prob, shk_solver, shk_solutions)
+                else
+                    call shock_columns(columns, num, prob, shk_solver, shk_solutions)
+                end if
+                if (allocated(run_profile)) call run_profile%leave()
                 deallocate(shk_solutions)
+                call shk_solver%eq_solver%release()
 
             case ("det")
                 call log_info('Solving detonation problem:')
 
                 call run_detonation_problem(prob, all_thermo, det_solver, det_solutions)
-                call deton_output(1, prob, det_solver, det_solutions)
+                call collect_profile(run_profile, det_solver%eq_solver%profile)
+                if (allocated(run_profile)) call run_profile%enter('output')
+                if (output_format == 'text') then
+                    call deton_output(unit, prob, det_solver, det_solutions)
+                else
+                    call deton_columns(columns, num, prob, det_solver, det_solutions)
+                end if
+                if (allocated(run_profile)) call run_profile%leave()
                 deallocate(det_solutions)
+                call det_solver%eq_solver%release()
 
             case default
                 call log_error('Problem type '//prob%problem%type//' is not supported')
                 call abort
         end select
 
-    end do
+    end subroutine
 
-    ! Close the output file
-    close(1)
+    subroutine serve(num_workers)
+        ! Answer problems read from standard input until @quit or the end of input.
+        !
+        ! Input is a stream of problem blocks in .inp syntax; each block ending in an
+        ! `end` line is one request. Lines starting with @ are commands:
+        !   @id LABEL   label the next request (default: its sequence number)
+        !   @sync       reply @synced once every earlier request has been answered
+        !   @quit       answer the outstanding requests and exit
+        ! Each answer is written as one frame, in completion order:
+        !   @begin LABEL ok|error NUM_LINES
+        !   ... NUM_LINES lines of .out text ...
+        !   @end LABEL
+        ! Requests are solved as OpenMP tasks by num_workers threads. The databases and the
+        ! product list cache stay loaded between requests and are shared by the workers.
+
+        integer, intent(in) :: num_workers
+
+        type(ServeRequest), pointer :: req
+        character(:), allocatable :: text, label, line, command
+        integer :: num_requests, num_threads, ios, i
+
+        num_threads = 1
+        !$ num_threads = omp_get_max_threads()
+        if (num_workers > 0) num_threads = num_workers
+        call log_info('Serving on standard input with '//to_str(num_threads)//' workers')
+
+        num_requests = 0
+        text = ''
+        label = ''
+
+        !$omp parallel num_threads(num_threads)
+        !$omp single
+        do
+            call read_line(input_unit, line, ios)
+            if (ios /= 0) exit
+
+            if (startswith(adjustl(line), '@')) then
+                command = trim(adjustl(line))
+                i = index(command, ' ')
+                if (i == 0) i = len(command) + 1
+                select case(command(:i-1))
+                    case ('@id')
+                        label = trim(adjustl(command(i:)))
+                        i = index(label, ' ')
+                        if (i > 0) label = label(:i-1)
+                    case ('@sync')
+                        !$omp taskwait
+                        !$omp critical (serve_output)
+                        write(stdout, '(a)') '@synced'
+                        flush(stdout)
+                        !$omp end critical (serve_output)
+                    case ('@quit')
+                        exit
+                    case default
+                        !$omp critical (serve_output)
+                        write(stdout, '(a)') '@error unknown command '//command(:i-1)
+                        flush(stdout)
+                        !$omp end critical (serve_output)
+                end select
+                cycle
+            end if
 
-contains
+            text = text//line//new_line('a')
+            if (startswith(adjustl(line), 'end')) then
+                num_requests = num_requests + 1
+                if (len(label) == 0) label = to_str(num_requests)
+                allocate(req)
+                req%label = label
+                req%text = text
+                !$omp task firstprivate(req)
+                call serve_request(req%label, req%text)
+                deallocate(req)
+                !$omp end task
+                text = ''
+                label = ''
+            end if
+        end do
+        !$omp end single
+        !$omp end parallel
+
+        call log_info('Served '//to_str(num_requests)//' requests')
+
+    end subroutine
+
+    subroutine serve_request(label, text)
+        ! Solve the problems of one --serve request and write its response frame
+
+        character(*), intent(in) :: label
+        character(*), intent(in) :: text
+
+        type(ProblemDB), allocatable :: problems(:)
+        character(:), allocatable :: response, status, message
+        integer :: k, num_lines, unit
+
+        allocate(problems, source=parse_input(text))
+        status = 'ok'
+
+        ! A problem that run_problem would abort on is answered with an error frame instead
+        open(newunit=unit, status='scratch', form='formatted', action='readwrite')
+        do k = 1, size(problems)
+            message = request_error(problems(k))
+            if (len(message) > 0) then
+                status = 'error'
+                write(unit, '(a)') message
+                cycle
+            end if
+            call run_problem(k, problems(k), unit)
+        end do
+        call read_capture(unit, response, num_lines)
+        close(unit)
+
+        !$omp critical (serve_output)
+        write(stdout, '(a,1x,a,1x,a,1x,i0)') '@begin', label, status, num_lines
+        if (len(response) > 0) write(stdout, '(a)') response(:len(response)-1)
+        write(stdout, '(a,1x,a)') '@end', label
+        flush(stdout)
+        !$omp end critical (serve_output)
+
+    end subroutine
+
+    function request_error(prob) result(message)
+        ! Why run_problem cannot solve a --serve problem, or '' if it can: unknown species and
+        ! missing state schedules, which would otherwise stop the server
+
+        type(ProblemDB), intent(in) :: prob
+        character(:), allocatable :: message
+
+        integer :: k, num_u1, num_t
+
+        message = ''
+        if (.not. allocated(prob%problem%type)) then
+            message = 'Problem type not given'
+            return
+        end if
+
+        ! Species: reactants without a formula, and product lists, must be in the thermo database
+        if (.not. allocated(prob%reactants)) then
+            message = 'No reactants given'
+            return
+        end if
+        do k = 1, size(prob%reactants)
+            if (allocated(prob%reactants(k)%formula)) cycle
+            if (all_thermo%species_id(prob%reactants(k)%name) == 0) then
+                message = 'Reactant not found in the thermo database: '//prob%reactants(k)%name
+                return
+            end if
+        end do
+        if (allocated(prob%only)) then
+            do k = 1, size(prob%only)
+                if (all_thermo%species_id(trim(prob%only(k))) == 0) then
+                    message = 'Product not found in the thermo database: '//trim(prob%only(k))
+                    return
+                end if
+            end do
+        end if
+        if (allocated(prob%insert)) then
+            do k = 1, size(prob%insert)
+                if (all_thermo%species_id(trim(prob%insert(k))) == 0) then
+                    message = 'Inserted species not found in the thermo database: '//trim(prob%insert(k))
+                    return
+                end if
+            end do
+        end if
+
+        ! State schedules each problem type reads
+        associate(p => prob%problem)
+            select case(p%type)
+                case ('tp')
+                    if (.not. allocated(p%t_schedule)) message = 'tp problem requires t'
+                    if (.not. allocated(p%p_schedule)) message = 'tp problem requires p'
+                case ('hp', 'rkt')
+                    if (.not. allocated(p%p_schedule)) message = p%type//' problem requires p'
+                case ('sp')
+                    if (.not. allocated(p%s_schedule)) message = 'sp problem requires s'
+                    if (.not. allocated(p%p_schedule)) message = 'sp problem requires p'
+                case ('tv', 'uv', 'sv')
+                    if (p%type == 'tv' .and. .not. allocated(p%t_schedule)) message = 'tv problem requires t'
+                    if (p%type == 'uv' .and. .not. allocated(p%u_schedule)) message = 'uv problem requires u'
+                    if (p%type == 'sv' .and. .not. allocated(p%s_schedule)) message = 'sv problem requires s'
+                    if (.not. allocated(p%v_schedule)) then
+                        message = p%type//' problem requires rho or v'
+                    else
+                        select case(p%v_schedule%units)
+                            case('m**3/kg', 'cm**3/g', 'cc/g', 'kg/m**3', 'g/cm**3', 'g/cc')
+                                continue
+                            case default
+                                message = 'Volume units not recognized: '//p%v_schedule%units
+                        end select
+                    end if
+                case ('shk')
+                    if (.not. allocated(p%p_schedule)) message = 'shk problem requires p'
+                    if (.not. (allocated(p%u1_schedule) .or. allocated(p%mach1_schedule))) then
+                        message = 'shk problem requires u1 or mach1'
+                    else if (allocated(p%p_schedule)) then
+                        if (allocated(p%u1_schedule)) then
+                            num_u1 = size(p%u1_schedule%values)
+                        else
+                            num_u1 = size(p%mach1_schedule%values)
+                        end if
+                        num_t = 1
+                        if (allocated(p%t_schedule)) num_t = size(p%t_schedule%values)
+                        if (num_u1 < size(p%p_schedule%values) .or. num_u1 < num_t) then
+                            message = 'shk problem requires at least as many u1 or mach1 values as p and t values'
+                        end if
+                    end if
+                    if (.not. (allocated(p%t_schedule) .or. allocated(prob%reactants(1)%temperature))) then
+                        message = 'shk problem requires t or a reactant temperature'
+                    end if
+                case ('det')
+                    if (.not. allocated(p%t_schedule)) message = 'det problem requires t'
+                    if (.not. allocated(p%p_schedule)) message = 'det problem requires p'
+                case default
+                    message = 'Problem type '//p%type//' is not supported'
+            end select
+        end associate
+
+    end function
+
+    subroutine read_line(unit, line, ios)
+        ! Read one record of any length
+        integer, intent(in) :: unit
+        character(:), allocatable, intent(out) :: line
+        integer, intent(out) :: ios
+        character(256) :: chunk
+        integer :: nread
+        line = ''
+        do
+            read(unit, '(a)', advance='no', size=nread, iostat=ios) chunk
+            line = line//chunk(:nread)
+            if (ios /= 0) exit
+        end do
+        if (is_iostat_eor(ios) .or. (is_iostat_end(ios) .and. len(line) > 0)) ios = 0
+    end subroutine
+
+    subroutine read_capture(unit, text, num_lines)
+        ! Everything written to a scratch unit, one newline-terminated line per record
+        integer, intent(in) :: unit
+        character(:), allocatable, intent(out) :: text
+        integer, intent(out) :: num_lines
+        character(:), allocatable :: line
+        integer :: ios
+        rewind(unit)
+        text = ''
+        num_lines = 0
+        do
+            call read_line(unit, line, ios)
+            if (ios /= 0) exit
+            text = text//line//new_line('a')
+            num_lines = num_lines + 1
+        end do
+    end subroutine
+
+    subroutine collect_profile(total, solver_profile)
+        ! Add the phase timings of the last problem's solver to the run totals
+        type(profiler), allocatable, intent(inout) :: total
+        type(profiler), allocatable, intent(in) :: solver_profile
+        if (.not. allocated(total) .or. .not. allocated(solver_profile)) return
+        call total%merge(solver_profile)
+    end subroutine
+
+    function cache_context() result(context)
+        ! Everything besides the problem that its output depends on: the program version,
+        ! the output format, the thermo and transport databases, and the o/f optimizer
+
+        character(:), allocatable :: context
+        character(32) :: buffer
+        integer :: k
+
+        context = 'cea '//version_string//'; format '//output_format//'; thermo '//file_checksum(thermo_file)
+        if (len(trans_file) > 0) then
+            context = context//'; trans '//file_checksum(trans_file)
+        else
+            context = context//'; trans none'
+        end if
+        if (allocated(of_optimizer)) then
+            context = context//'; optimize-of '//to_str(of_optimizer%objective)
+            if (allocated(of_optimizer%constraints)) then
+                do k = 1, size(of_optimizer%constraints)
+                    write(buffer, '(es24.16e3)') of_optimizer%constraints(k)%T_max
+                    context = context//'; t-max '//to_str(of_optimizer%constraints(k)%station)//':'// &
+                              trim(adjustl(buffer))
+                end do
+            end if
+        end if
+
+    end function
+
+    subroutine begin_capture()
+        ! Record the output of the current problem for the result cache
+
+        if (output_format == 'text') then
+            open(newunit=iout, status='scratch', form='formatted', action='readwrite')
+        else
+            columns%recording = .true.
+            columns%num_recorded = 0
+        end if
+
+    end subroutine
+
+    subroutine end_capture(num)
+        ! Store the output recorded since begin_capture under cache_key. Text output
+        ! was written to a scratch unit and is copied to the .out file here.
+
+        integer, intent(in) :: num
+
+        type(EncodedTable), allocatable :: entries(:)
+        character(:), allocatable :: prefix
+        integer :: num_lines, k
+
+        if (output_format == 'text') then
+            allocate(entries(1))
+            entries(1)%name = 'out'
+            call read_capture(iout, entries(1)%bytes, num_lines)
+            close(iout)
+            iout = 1
+        else
+            ! Table names start with the problem number, which is not part of the key
+            prefix = 'p'//to_str(num)
+            allocate(entries(columns%num_recorded))
+            do k = 1, columns%num_recorded
+                entries(k)%name = columns%recorded(k)%name(len(prefix)+1:)
+                entries(k)%bytes = columns%recorded(k)%bytes
+            end do
+            columns%recording = .false.
+            columns%num_recorded = 0
+        end if
+
+        call cache%store(cache_key, entries)
+        if (output_format == 'text') call replay_output(num, entries)
+
+    end subroutine
+
+    subroutine replay_output(num, entries)
+        ! Write cached output of problem number num
+
+        integer, intent(in) :: num
+        type(EncodedTable), intent(in) :: entries(:)
+
+        integer :: k, nbytes
+
+        if (output_format == 'text') then
+            ! The captured text ends with a record terminator, which the advancing write supplies
+            nbytes = len(entries(1)%bytes)
+            if (nbytes > 0) write(1, '(a)') entries(1)%bytes(:nbytes-1)
+        else
+            do k = 1, size(entries)
+                call columns%write_encoded('p'//to_str(num)//entries(k)%name, entries(k)%bytes)
+            end do
+        end if
+
+    end subroutine
 
-    subroutine parse_arguments(input_file_stem, thermo_file, trans_file, compile_thermo_input, compile_trans_input)
+    subroutine parse_arguments(input_file_stem, thermo_file, trans_file, compile_thermo_input, compile_trans_input, &
+                               output_format, print_profile, profile_file, of_optimizer, cache_dir, cache_bytes, &
+                               serve_mode, num_workers, solve_outputs)
         character(:), allocatable, intent(out) :: input_file_stem
         character(:), allocatable, intent(out) :: thermo_file
         character(:), allocatable, intent(out) :: trans_file
         character(:), allocatable, intent(out) :: compile_thermo_input
         character(:), allocatable, intent(out) :: compile_trans_input
+        character(:), allocatable, intent(out) :: output_format
+        logical, intent(out) :: print_profile
+        character(:), allocatable, intent(out) :: profile_file
+        type(OfOptimizer), allocatable, intent(out) :: of_optimizer
+        character(:), allocatable, intent(out) :: cache_dir
+        integer(int64), intent(out) :: cache_bytes
+        logical, intent(out) :: serve_mode
+        integer, intent(out) :: num_workers
+        integer, intent(out) :: solve_outputs
         character(:), allocatable :: arg
-        integer :: n,nargs
+        real(dp) :: cache_mb
+        logical :: no_cache
+        integer :: env_len, env_status
+        real(dp), allocatable :: t_caps(:)
+        integer, allocatable :: t_cap_stations(:)
+        integer :: n,nargs,i,ios
 
         ! Defaults
         thermo_file = 'thermo.lib'
         trans_file = 'trans.lib'
+        output_format = 'text'
+        print_profile = .false.
+        no_cache = .false.
+        serve_mode = .false.
+        num_workers = 0
+        solve_outputs = output_all
+        cache_bytes = default_cache_bytes
+        allocate(t_caps(0), t_cap_stations(0))
 
         nargs = command_argument_count()
         !if (nargs == 0) then
@@ -169,6 +676,79 @@ contains
                 case ('--compile-trans')
                     call log_info('Reading transport input file for compilation')
                     compile_trans_input = pop_argument(n)
+                case ('-f','--format')
+                    output_format = pop_argument(n)
+                    select case(output_format)
+                        case ('text', 'npz', 'csv')
+                            continue
+                        case default
+                            call log_error('Unsupported output format: '//output_format)
+                            call display_help
+                            call abort
+                    end select
+                case ('--profile')
+                    print_profile = .true.
+                case ('--profile-out')
+                    profile_file = pop_argument(n)
+                case ('--optimize-of')
+                    arg = pop_argument(n)
+                    select case(arg)
+                        case ('isp')
+                            of_optimizer = OfOptimizer(of_opt_isp)
+                        case ('ivac')
+                            of_optimizer = OfOptimizer(of_opt_ivac)
+                        case ('cstar')
+                            of_optimizer = OfOptimizer(of_opt_cstar)
+                        case default
+                            call log_error('Unsupported --optimize-of objective: '//arg)
+                            call display_help
+                            call abort
+                    end select
+                case ('--t-max')
+                    ! [STATION:]KELVIN; the station defaults to 1, the chamber
+                    arg = pop_argument(n)
+                    i = index(arg, ':')
+                    t_cap_stations = [t_cap_stations, 1]
+                    t_caps = [t_caps, 0.0d0]
+                    ios = 0
+                    if (i > 0) read(arg(:i-1), *, iostat=ios) t_cap_stations(size(t_cap_stations))
+                    if (ios == 0) read(arg(i+1:), *, iostat=ios) t_caps(size(t_caps))
+                    if (ios /= 0 .or. t_caps(size(t_caps)) <= 0.0d0 .or. t_cap_stations(size(t_caps)) < 1) then
+                        call log_error('Invalid --t-max value: '//arg)
+                        call display_help
+                        call abort
+                    end if
+                case ('--serve')
+                    serve_mode = .true.
+                case ('--workers')
+                    arg = pop_argument(n)
+                    read(arg, *, iostat=ios) num_workers
+                    if (ios /= 0 .or. num_workers < 1) then
+                        call log_error('Invalid --workers value: '//arg)
+                        call display_help
+                        call abort
+                    end if
+                case ('--outputs')
+                    arg = pop_argument(n)
+                    solve_outputs = parse_outputs(arg)
+                    if (solve_outputs < 0) then
+                        call log_error('Invalid --outputs value: '//arg)
+                        call display_help
+                        call abort
+                    end if
+                case ('--cache')
+                    cache_dir = pop_argument(n)
+                case ('--no-cache')
+                    no_cache = .true.
+                case ('--cache-size')
+                    arg = pop_argument(n)
+                    read(arg, *, iostat=ios) cache_mb
+                    if (ios /= 0 .or. cache_mb <= 0.0d0) then
+                        call log_error('Invalid --cache-size value: '//arg)
+                        call display_help
+                        call abort
+                    end if
+                    cache_bytes = int(cache_mb*1024.0d0**2, int64)
                 case ('-h')
                     call display_help
                     stop
@@ -193,18 +773,52 @@ contains
             return
         end if
 
+        if (size(t_caps) > 0) then
+            if (.not. allocated(of_optimizer)) then
+                call log_error('--t-max requires --optimize-of')
+                call display_help
+                call abort
+            end if
+            do i = 1, size(t_caps)
+                call of_optimizer%add_constraint(t_caps(i), t_cap_stations(i))
+            end do
+        end if
+
+        if (serve_mode) then
+            if (allocated(input_file_stem) .or. output_format /= 'text' .or. print_profile .or. &
+                allocated(profile_file) .or. allocated(cache_dir)) then
+                call log_error('--serve takes no input_file and does not combine with -f, --profile, '// &
+                               '--profile-out, or --cache')
+                call display_help
+                call abort
+            end if
+            return
+        end if
+
         if (.not. allocated(input_file_stem)) then
             call log_error('Required argument not specified: input_file')
             call display_help
             call abort
         end if
 
+        ! The result cache is opt-in: --cache DIR, else the CEA_CACHE_DIR environment variable
+        if (no_cache) then
+            if (allocated(cache_dir)) deallocate(cache_dir)
+        else if (.not. allocated(cache_dir)) then
+            call get_environment_variable('CEA_CACHE_DIR', length=env_len, status=env_status)
+            if (env_status == 0 .and. env_len > 0) then
+                allocate(character(env_len) :: cache_dir)
+                call get_environment_variable('CEA_CACHE_DIR', value=cache_dir)
+            end if
+        end if
+
         return
     end subroutine
 
     subroutine display_help
         write(stdout,'(a)') &
             'usage: cea [options] input_file',&
+            '       cea --serve [--workers N] [options]',&
             '       cea --compile-thermo thermo.inp',&
             '       cea --compile-trans trans.inp',&
             '',&
@@ -217,11 +831,69 @@ contains
             '  -d   Activate debug logging mode',&
             '  -t   Specify name of thermodynamic database to read (def: thermo.lib)',&
             '  -r   Specify name of transport database to read (def: trans.lib)',&
+            '  -f, --format FMT  Output format: text (.out, default), npz (NumPy archive of',&
+            '                    typed columns, one table per problem), or csv (one file per problem)',&
+            '  --profile         Print wall-clock time per solver phase after the run',&
+            '  --profile-out FILE  Write the solver phase timings to FILE: a Chrome trace',&
+            '                    (chrome://tracing, Perfetto) if FILE ends in .json, else',&
+            '                    collapsed stacks for flame graph tools',&
+            '  --optimize-of OBJ  For rocket problems, find the o/f ratio that maximizes OBJ',&
+            '                    (isp, ivac, or cstar at the last station) between the smallest',&
+            '                    and largest entries of the fuel ratio schedule, at each',&
+            '                    chamber pressure, and report the solution at that o/f',&
+            '  --t-max [STATION:]K  With --optimize-of, cap the temperature [K] at a station',&
+            '                    (1 = chamber, the default); may be repeated',&
+            '  --cache DIR       Reuse the output of unchanged problems from the result cache',&
+            '                    in DIR (default: $CEA_CACHE_DIR if set, else no cache)',&
+            '  --cache-size MB   Evict least recently used cache entries beyond MB (default 256)',&
+            '  --no-cache        Solve every problem; ignore --cache and $CEA_CACHE_DIR',&
+            '  --serve           Keep the databases loaded and answer problems read from',&
+            '                    standard input on standard output (see the documentation)',&
+            '  --workers N       Number of problems --serve solves at once (OpenMP builds)',&
+            '  --outputs LIST    Outputs computed inside every equilibrium and rocket solve:',&
+            '                    all (default), none, or a comma-separated list of properties,',&
+            '                    partials, transport, and performance. The rest are computed',&
+            '                    once per reported state, so the output does not change',&
             '  --compile-thermo  Compile a thermo.inp file into thermo.lib',&
             '  --compile-trans   Compile a trans.inp file into trans.lib',&
             ''
     end subroutine
 
+    function parse_outputs(list) result(mask)
+        ! Output mask (output_* flags) of a --outputs list; -1 if a name is unknown
+        character(*), intent(in) :: list
+        integer :: mask
+        integer :: i, j
+
+        mask = 0
+        i = 1
+        do while (i <= len(list))
+            j = index(list(i:), ',')
+            if (j == 0) then
+                j = len(list) + 1
+            else
+                j = i + j - 1
+            end if
+            select case (list(i:j-1))
+                case ('all')
+                    mask = ior(mask, output_all)
+                case ('none')
+                case ('properties')
+                    mask = ior(mask, output_properties)
+                case ('partials')
+                    mask = ior(mask, output_partials)
+                case ('transport')
+                    mask = ior(mask, output_transport)
+                case ('performance')
+                    mask = ior(mask, output_performance)
+                case default
+                    mask = -1
+                    return
+            end select
+            i = j + 1
+        end do
+    end function
+
     function pop_argument(n) result(arg)
         integer, intent(inout) :: n
         character(:), allocatable :: arg
@@ -233,15 +905,146 @@ contains
         n = n+1
     end function
 
-    subroutine run_thermo_problem(prob, thermo, solver, solutions, partials)
-        ! Loop over problem state values and solve the thermodynamic equilibrium problems
+    subroutine solve_and_write_rocket_problem(num, prob, thermo, solver, unit, suffix)
+        ! Solve a rocket problem and write it to the text output or the column writer
+
+        ! Arguments
+        integer, intent(in) :: num
+        type(ProblemDB), intent(in) :: prob
+        type(ThermoDB), intent(in) :: thermo
+        type(RocketSolver), intent(inout) :: solver
+        integer, intent(in) :: unit
+        character(*), intent(in), optional :: suffix
+
+        type(RocketResult), allocatable :: rkt_solutions(:,:,:)
+
+        call run_rocket_problem(prob, thermo, solver, rkt_solutions)
+        call collect_profile(run_profile, solver%eq_solver%profile)
+        if (allocated(run_profile)) call run_profile%enter('output')
+        if (output_format == 'text') then
+            call rocket_output(unit, prob, solver, rkt_solutions)
+        else
+            call rocket_columns(columns, num, prob, solver, rkt_solutions, suffix)
+        end if
+        if (allocated(run_profile)) call run_profile%leave()
+        deallocate(rkt_solutions)
+
+    end subroutine
+
+    subroutine run_optimized_rocket_problem(num, prob, thermo, solver, optimizer, unit)
+        ! For each chamber pressure, find the optimal o/f ratio between the smallest and
+        ! largest entries of the fuel ratio schedule and solve the problem at that ratio
+
+        ! Arguments
+        integer, intent(in) :: num
+        type(ProblemDB), intent(in) :: prob
+        type(ThermoDB), intent(in) :: thermo
+        type(RocketSolver), intent(inout) :: solver
+        type(OfOptimizer), intent(inout) :: optimizer
+        integer, intent(in) :: unit
+
+        ! Locals
+        type(ProblemDB) :: sub
+        real(dp), allocatable :: fuel_weights(:), oxidant_weights(:), of_values(:)
+        real(dp), allocatable :: hc, tc, mdot, ac_at, reac_temps(:)
+        real(dp), allocatable :: subar(:), supar(:), pi_p(:)
+        integer, allocatable :: nfrz
+        integer :: i, j, num_pc
+        character(16) :: label
+
+        if (prob%reactants(1)%type == "na" .or. .not. allocated(prob%problem%of_schedule)) then
+            call log_warning('--optimize-of needs fuel and oxidant reactants and a fuel ratio schedule; '// &
+                             'solving problem '//case_name(prob)//' as written')
+            call solve_and_write_rocket_problem(num, prob, thermo, solver, unit)
+            return
+        end if
+        if (size(prob%problem%of_schedule%values) < 2) then
+            call log_warning('--optimize-of needs at least two fuel ratios to bracket the search; '// &
+                             'solving problem '//case_name(prob)//' as written')
+            call solve_and_write_rocket_problem(num, prob, thermo, solver, unit)
+            return
+        end if
+        if (.not. allocated(prob%problem%p_schedule)) call abort("Chamber pressure not supplied for rocket problem")
+
+        call init_rocket_solver(prob, thermo, solver)
+        associate(reactants => solver%eq_solver%reactants)
+            call get_fuel_oxidant_weights(prob, reactants, fuel_weights, oxidant_weights)
+            allocate(of_values(size(prob%problem%of_schedule%values)))
+            do j = 1, size(of_values)
+                of_values(j) = scheduled_of_ratio(prob, reactants, oxidant_weights, fuel_weights, j)
+            end do
+            reac_temps = get_reactant_temperatures(prob, reactants)
+        end associate
+        if (minval(of_values) >= maxval(of_values)) then
+            call abort('--optimize-of: the fuel ratio schedule of problem '//case_name(prob)//' spans no o/f range')
+        end if
+
+        ! Same rocket inputs as run_rocket_problem
+        if (allocated(prob%problem%pcp_schedule)) pi_p = prob%problem%pcp_schedule%values
+        if (allocated(prob%problem%subar_schedule)) subar = prob%problem%subar_schedule%values
+        if (allocated(prob%problem%supar_schedule)) supar = prob%problem%supar_schedule%values
+        if (allocated(prob%problem%mdot)) mdot = prob%problem%mdot
+        if (allocated(prob%problem%ac_at)) ac_at = prob%problem%ac_at
+        if (allocated(prob%problem%h_schedule)) then
+            hc = prob%problem%h_schedule%values(1)
+        else if (allocated(prob%problem%t_schedule)) then
+            tc = prob%problem%t_schedule%values(1)
+        end if
+
+        ! The objective is evaluated with frozen flow only for a frozen-only problem
+        if (prob%problem%frozen .and. .not. prob%problem%equilibrium) nfrz = prob%problem%rkt_nfrozen
+
+        select case(optimizer%objective)
+            case (of_opt_ivac)
+                label = 'Ivac, m/s'
+            case (of_opt_cstar)
+                label = 'Cstar, m/s'
+            case default
+                label = 'Isp, m/s'
+        end select
+
+        num_pc = size(prob%problem%p_schedule%values)
+        do i = 1, num_pc
+            call optimizer%run(solver, oxidant_weights, fuel_weights, minval(of_values), maxval(of_values), &
+                               get_state2(prob, i), pi_p, &
+                               fac=prob%problem%rkt_finite_area, subar=subar, supar=supar, mdot=mdot, &
+                               ac_at=ac_at, n_frz=nfrz, hc=hc, tc=tc, reactant_temps=reac_temps)
+            call collect_profile(run_profile, solver%eq_solver%profile)
+            if (.not. optimizer%converged) then
+                call log_warning('--optimize-of did not converge for problem '//case_name(prob)// &
+                                 ' at chamber pressure '//to_str(i))
+                if (optimizer%num_solves == 0 .or. optimizer%of_ratio <= 0.0d0) cycle
+            end if
+
+            ! Solve and report the problem at this pressure and the optimal o/f
+            sub = prob
+            sub%problem%p_schedule%values = [prob%problem%p_schedule%values(i)]
+            sub%problem%of_schedule%name = 'o/f'
+            sub%problem%of_schedule%values = [optimizer%of_ratio]
+            if (output_format == 'text') then
+                write(unit, '(/," OPTIMUM O/F =",F10.5,",  ",A,"=",F10.2," (",I0," SOLVES)")', advance='no') &
+                    optimizer%of_ratio, trim(label), optimizer%value, optimizer%num_solves
+                if (optimizer%constrained) write(unit, '(A)', advance='no') ', TEMPERATURE CAP ACTIVE'
+                write(unit, '(A)') ''
+            end if
+            if (num_pc > 1) then
+                call solve_and_write_rocket_problem(num, sub, thermo, solver, unit, '_pc'//to_str(i))
+            else
+                call solve_and_write_rocket_problem(num, sub, thermo, solver, unit)
+            end if
+        end do
+
+    end subroutine
+
+    subroutine run_thermo_problem(prob, thermo, solver, results)
+        ! Loop over problem state values and solve the thermodynamic equilibrium problems.
+        ! One EqSolution/EqPartials workspace is reused; each point keeps only an EqResult.
 
         ! Arguments
         type(ProblemDB), intent(in) :: prob
         type(ThermoDB), intent(in) :: thermo
         type(EqSolver), intent(out) :: solver
-        type(EqSolution), allocatable, intent(out) :: solutions(:, :, :)
-        type(EqPartials), allocatable, intent(out) :: partials(:, :, :)
+        type(EqResult), allocatable, intent(out) :: results(:, :, :)
 
         ! Locals
         type(Mixture) :: reactants, products
@@ -258,14 +1061,7 @@ contains
         allocate(weights(reactants%num_species))
 
         ! Get the products Mixture object
-        if (allocated(prob%only)) then
-            allocate(product_names(size(prob%only)))
-            product_names = prob%only
-        else if (allocated(prob%omit)) then
-            product_names = reactants%get_products(thermo, prob%omit)
-        else
-            product_names = reactants%get_products(thermo)
-        end if
+        product_names = get_product_names(prob, reactants, thermo)
         products = Mixture(thermo, product_names, ions=prob%problem%include_ions)
 
         ! Get the loop sizes
@@ -303,8 +1099,7 @@ contains
         end if
 
         ! Loop over problem state values
-        allocate(solutions(num_state1, num_state2, num_of))
-        allocate(partials(num_state1, num_state2, num_of))
+        allocate(results(num_state1, num_state2, num_of))
 
         ! Initialize the EqSolver and EqSolution objects
         if (allocated(prob%output%trace)) then
@@ -325,6 +1120,8 @@ contains
             end if
         end if
 
+        solver%outputs = solve_outputs
+
         ! Initialize the solution object
         solution = EqSolution(solver)
 
@@ -343,10 +1140,10 @@ contains
                     ! Solve the thermodynamic equilibrium problem
                     ! solution = prev_solution
                     call solver%solve(solution, prob%problem%type, state1, state2, weights, problem_partials)
+                    call solver%compute_outputs(solution)
 
                     !call output(prob, state1, state2, weights, solution)
-                    solutions(i, j, k) = solution
-                    partials(i, j, k) = problem_partials
+                    results(i, j, k) = EqResult(solution, problem_partials)
 
                 end do
             end do
@@ -360,11 +1157,11 @@ contains
         ! Arguments
         type(ProblemDB), intent(in) :: prob
         type(ThermoDB), intent(in) :: thermo
-        type(RocketSolver), intent(out) :: solver
-        type(RocketSolution), allocatable, intent(out) :: solutions(:, :, :)
+        type(RocketSolver), intent(inout) :: solver
+        type(RocketResult), allocatable, intent(out) :: solutions(:, :, :)
 
         ! Locals
-        type(Mixture) :: reactants, products
+        type(Mixture) :: reactants
         type(RocketSolution) :: solution
         real(dp), allocatable :: weights(:)
         integer :: i, j, k, num_pc, num_of
@@ -373,27 +1170,15 @@ contains
         real(dp), allocatable :: subar(:), supar(:), pi_p(:)
         logical :: fac, frz, eql, need_hc
         integer :: nfrz
-        character(snl), allocatable :: product_names(:)
 
         ! Initialize
         need_hc = .false.
 
-        ! Get the reactants Mixture object
-        reactants = Mixture(thermo, input_reactants=prob%reactants, ions=prob%problem%include_ions)
-        call apply_reactant_thermo_overrides(prob, reactants)
+        ! Initialize the RocketSolver object
+        call init_rocket_solver(prob, thermo, solver)
+        reactants = solver%eq_solver%reactants
         allocate(weights(reactants%num_species))
 
-        ! Get the products Mixture object
-        if (allocated(prob%only)) then
-            allocate(product_names(size(prob%only)))
-            product_names = prob%only
-        else if (allocated(prob%omit)) then
-            product_names = reactants%get_products(thermo, prob%omit)
-        else
-            product_names = reactants%get_products(thermo)
-        end if
-        products = Mixture(thermo, product_names, ions=prob%problem%include_ions)
-
         ! Get the loop sizes
         num_pc = 1
         if (allocated(prob%problem%p_schedule)) then
@@ -408,7 +1193,7 @@ contains
         end if
 
         ! Get the rocket variables
-        pi_p = prob%problem%pcp_schedule%values
+        if (allocated(prob%problem%pcp_schedule)) pi_p = prob%problem%pcp_schedule%values
         if (allocated(prob%problem%subar_schedule)) subar = prob%problem%subar_schedule%values
         if (allocated(prob%problem%supar_schedule)) supar = prob%problem%supar_schedule%values
         if (allocated(prob%problem%mdot)) mdot = prob%problem%mdot
@@ -439,23 +1224,6 @@ contains
             allocate(solutions(num_pc, num_of, 1))
         end if
 
-        ! Initialize the RocketSolver object
-        if (allocated(prob%output%trace)) then
-            if (prob%output%transport) then
-                solver = RocketSolver(products, reactants, prob%output%trace, ions=prob%problem%include_ions, &
-                                      all_transport=all_transport, insert=prob%insert)
-            else
-                solver = RocketSolver(products, reactants, prob%output%trace, ions=prob%problem%include_ions, insert=prob%insert)
-            end if
-        else
-            if (prob%output%transport) then
-                solver = RocketSolver(products, reactants, ions=prob%problem%include_ions, &
-                                      all_transport=all_transport, insert=prob%insert)
-            else
-                solver = RocketSolver(products, reactants, ions=prob%problem%include_ions, insert=prob%insert)
-            end if
-        end if
-
         ! Loop over the input parameters
         k = 1
         if (eql) then
@@ -473,7 +1241,8 @@ contains
                                             mdot=mdot, ac_at=ac_at, tc_est=tc_est, hc=hc, tc=tc)
 
                     ! Set the solution
-                    solutions(i, j, k) = solution
+                    call solver%compute_outputs(solution)
+                    solutions(i, j, k) = RocketResult(solution)
 
                 end do
             end do
@@ -495,7 +1264,8 @@ contains
                         mdot=mdot, ac_at=ac_at, n_frz=nfrz, tc_est=tc_est, hc=hc, tc=tc)
 
                     ! Set the solution
-                    solutions(i, j, k) = solution
+                    call solver%compute_outputs(solution)
+                    solutions(i, j, k) = RocketResult(solution)
 
                 end do
             end do
@@ -503,6 +1273,48 @@ contains
 
     end subroutine
 
+    subroutine init_rocket_solver(prob, thermo, solver)
+        ! Build the reactant and product mixtures and the RocketSolver of a rocket problem,
+        ! releasing the product data of the solver's previous problem
+
+        ! Arguments
+        type(ProblemDB), intent(in) :: prob
+        type(ThermoDB), intent(in) :: thermo
+        type(RocketSolver), intent(inout) :: solver
+
+        ! Locals
+        type(Mixture) :: reactants, products
+        character(snl), allocatable :: product_names(:)
+
+        ! Get the reactants Mixture object
+        reactants = Mixture(thermo, input_reactants=prob%reactants, ions=prob%problem%include_ions)
+        call apply_reactant_thermo_overrides(prob, reactants)
+
+        ! Get the products Mixture object
+        product_names = get_product_names(prob, reactants, thermo)
+        products = Mixture(thermo, product_names, ions=prob%problem%include_ions)
+
+        ! Initialize the RocketSolver object
+        call solver%eq_solver%release()
+        if (allocated(prob%output%trace)) then
+            if (prob%output%transport) then
+                solver = RocketSolver(products, reactants, prob%output%trace, ions=prob%problem%include_ions, &
+                                      all_transport=all_transport, insert=prob%insert)
+            else
+                solver = RocketSolver(products, reactants, prob%output%trace, ions=prob%problem%include_ions, insert=prob%insert)
+            end if
+        else
+            if (prob%output%transport) then
+                solver = RocketSolver(products, reactants, ions=prob%problem%include_ions, &
+                                      all_transport=all_transport, insert=prob%insert)
+            else
+                solver = RocketSolver(products, reactants, ions=prob%problem%include_ions, insert=prob%insert)
+            end if
+        end if
+        solver%eq_solver%outputs = solve_outputs
+
+    end subroutine
+
     subroutine run_shock_problem(prob, thermo, solver, solutions)
         ! Loop over problem state values and solve shock problems
 
@@ -510,7 +1322,7 @@ contains
         type(ProblemDB), intent(in) :: prob
         type(ThermoDB), intent(in) :: thermo
         type(ShockSolver), intent(out) :: solver
-        type(ShockSolution), allocatable, intent(out) :: solutions(:, :, :)
+        type(ShockResult), allocatable, intent(out) :: solutions(:, :, :)
 
         ! Locals
         type(Mixture) :: reactants, products
@@ -527,14 +1339,7 @@ contains
         allocate(weights(reactants%num_species))
 
         ! Get the products Mixture object
-        if (allocated(prob%only)) then
-            allocate(product_names(size(prob%only)))
-            product_names = prob%only
-        else if (allocated(prob%omit)) then
-            product_names = reactants%get_products(thermo, prob%omit)
-        else
-            product_names = reactants%get_products(thermo)
-        end if
+        product_names = get_product_names(prob, reactants, thermo)
         products = Mixture(thermo, product_names, ions=prob%problem%include_ions)
 
         ! Get the problem flags
@@ -729,7 +1534,7 @@ contains
                     solution = solver%solve(weights, T0, P0, u1=u1, reflected=reflected, &
                                             reflected_frozen=reflected_frozen, incident_frozen=incident_frozen)
                 end if
-                solutions(i, 1, k) = solution
+                solutions(i, 1, k) = ShockResult(solution)
             end do
         end do
 
@@ -742,7 +1547,7 @@ contains
         type(ProblemDB), intent(in) :: prob
         type(ThermoDB), intent(in) :: thermo
         type(DetonSolver), intent(out) :: solver
-        type(DetonSolution), allocatable, intent(out) :: solutions(:, :, :)
+        type(DetonResult), allocatable, intent(out) :: solutions(:, :, :)
 
         ! Locals
         type(Mixture) :: reactants, products
@@ -759,14 +1564,7 @@ contains
         allocate(weights(reactants%num_species))
 
         ! Get the products Mixture object
-        if (allocated(prob%only)) then
-            allocate(product_names(size(prob%only)))
-            product_names = prob%only
-        else if (allocated(prob%omit)) then
-            product_names = reactants%get_products(thermo, prob%omit)
-        else
-            product_names = reactants%get_products(thermo)
-        end if
+        product_names = get_product_names(prob, reactants, thermo)
         products = Mixture(thermo, product_names, ions=prob%problem%include_ions)
 
         ! Get the problem flags
@@ -831,7 +1629,7 @@ contains
                     solution = solver%solve(weights, T0, P0, frozen)
 
                     !call output(prob, state1, state2, weights, solution)
-                    solutions(i, j, k) = solution
+                    solutions(i, j, k) = DetonResult(solution)
 
                 end do
             end do
@@ -839,6 +1637,31 @@ contains
 
     end subroutine
 
+    function get_product_names(prob, reactants, thermo) result(product_names)
+        ! Product species of a problem: its `only` list, else the products of its reactants
+
+        type(ProblemDB), intent(in) :: prob
+        type(Mixture), intent(in) :: reactants
+        type(ThermoDB), intent(in) :: thermo
+        character(snl), allocatable :: product_names(:)
+
+        if (allocated(prob%only)) then
+            allocate(product_names(size(prob%only)))
+            product_names = prob%only
+            return
+        end if
+
+        ! The product list cache is shared by the --serve workers
+        !$omp critical (product_cache)
+        if (allocated(prob%omit)) then
+            product_names = reactants%get_products(thermo, prob%omit, cache=product_cache)
+        else
+            product_names = reactants%get_products(thermo, cache=product_cache)
+        end if
+        !$omp end critical (product_cache)
+
+    end function
+
     subroutine apply_reactant_thermo_overrides(prob, reactants)
         type(ProblemDB), intent(in) :: prob
         type(Mixture), intent(inout) :: reactants
@@ -850,10 +1673,7 @@ contains
             if (.not. allocated(prob%reactants(i)%enthalpy)) cycle
 
             h_val = convert_units_to_si(prob%reactants(i)%enthalpy%values(1), prob%reactants(i)%enthalpy%units)
-            reactants%species(i)%enthalpy_ref = h_val
-            reactants%species(i)%num_intervals = 0
-            if (allocated(reactants%species(i)%T_fit)) deallocate(reactants%species(i)%T_fit)
-            if (allocated(reactants%species(i)%fits)) deallocate(reactants%species(i)%fits)
+            call reactants%set_species_enthalpy(i, h_val)
         end do
     end subroutine
 
@@ -864,7 +1684,7 @@ contains
         integer, intent(in) :: ioout
         type(ProblemDB), intent(in) :: prob
         type(ShockSolver), intent(in) :: solver
-        type(ShockSolution), intent(in) :: solutions(:, :, :)
+        type(ShockResult), intent(in) :: solutions(:, :, :)
 
         ! Locals
         integer :: i, j, k, m, npts, idx, last_row_cols, nrows, ncols, num_trace
@@ -1034,16 +1854,16 @@ contains
                 write(ioout, '(A, 14F9.3)') "Mach1            ", (solutions(i, 1, k)%mach(1), i=1,m)
                 write(ioout, '(A, 14F9.3)') "u1, m/s          ", (solutions(i, 1, k)%u(1), i=1,m)
                 write(ioout, '(A, 14F9.3)') "P, bar           ", (solutions(i, 1, k)%pressure(1), i=1,m)
-                write(ioout, '(A, 14F9.3)') "T, K             ", (solutions(i, 1, k)%eq_soln(1)%T, i=1,m)
-                write(ioout, '(A, 14E9.3e1)') "rho1, kg/m^3     ", (solutions(i, 1, k)%eq_soln(1)%density, i=1,m)
-                write(ioout, '(A, 14F9.2)') "H, kJ/kg         ", (solutions(i, 1, k)%eq_soln(1)%enthalpy, i=1,m)
-                write(ioout, '(A, 14F9.2)') "U, kJ/kg         ", (solutions(i, 1, k)%eq_soln(1)%energy, i=1,m)
-                write(ioout, '(A, 14F9.1)') "G, kJ/kg         ", (solutions(i, 1, k)%eq_soln(1)%gibbs_energy, i=1,m)
-                write(ioout, '(A, 14F9.2)') "S, kJ/(kg-K)     ", (solutions(i, 1, k)%eq_soln(1)%entropy, i=1,m)
+                write(ioout, '(A, 14F9.3)') "T, K             ", (solutions(i, 1, k)%eq_result(1)%T, i=1,m)
+                write(ioout, '(A, 14E9.3e1)') "rho1, kg/m^3     ", (solutions(i, 1, k)%eq_result(1)%density, i=1,m)
+                write(ioout, '(A, 14F9.2)') "H, kJ/kg         ", (solutions(i, 1, k)%eq_result(1)%enthalpy, i=1,m)
+                write(ioout, '(A, 14F9.2)') "U, kJ/kg         ", (solutions(i, 1, k)%eq_result(1)%energy, i=1,m)
+                write(ioout, '(A, 14F9.1)') "G, kJ/kg         ", (solutions(i, 1, k)%eq_result(1)%gibbs_energy, i=1,m)
+                write(ioout, '(A, 14F9.2)') "S, kJ/(kg-K)     ", (solutions(i, 1, k)%eq_result(1)%entropy, i=1,m)
                 write(ioout, '(A)') ""
-                write(ioout, '(A, 14F9.3)') "M, (1/n)         ", (1.0d0/solutions(i, 1, k)%eq_soln(1)%n, i=1,m)
-                write(ioout, '(A, 14F9.3)') "Cp, kJ/(kg-K)    ", (solutions(i, 1, k)%eq_soln(1)%cp_eq, i=1,m)
-                write(ioout, '(A, 14F9.3)') "Gamma_s          ", (solutions(i, 1, k)%eq_soln(1)%gamma_s, i=1,m)
+                write(ioout, '(A, 14F9.3)') "M, (1/n)         ", (1.0d0/solutions(i, 1, k)%eq_result(1)%n, i=1,m)
+                write(ioout, '(A, 14F9.3)') "Cp, kJ/(kg-K)    ", (solutions(i, 1, k)%eq_result(1)%cp_eq, i=1,m)
+                write(ioout, '(A, 14F9.3)') "Gamma_s          ", (solutions(i, 1, k)%eq_result(1)%gamma_s, i=1,m)
                 write(ioout, '(A, 14F9.3)') "Son. Vel., m/s   ", (solutions(i, 1, k)%v_sonic(1), i=1,m)
 
                 ! -------------------------------------------------------------------
@@ -1067,20 +1887,20 @@ contains
                 write(ioout, '(A)') "SHOCKED GAS (2)--INCIDENT--"//incd_type
                 write(ioout, '(A, 14F9.3)') "u2, m/s          ", (solutions(i, 1, k)%u(2), i=1,m)
                 write(ioout, '(A, 14F9.3)') "P, bar           ", (solutions(i, 1, k)%pressure(2), i=1,m)
-                write(ioout, '(A, 14F9.3)') "T, K             ", (solutions(i, 1, k)%eq_soln(2)%T, i=1,m)
-                write(ioout, '(A, 14E9.3e1)') "rho, kg/m^3      ", (solutions(i, 1, k)%eq_soln(2)%density, i=1,m)
-                write(ioout, '(A, 14F9.2)') "H, kJ/kg         ", (solutions(i, 1, k)%eq_soln(2)%enthalpy, i=1,m)
-                write(ioout, '(A, 14F9.2)') "U, kJ/kg         ", (solutions(i, 1, k)%eq_soln(2)%energy, i=1,m)
-                write(ioout, '(A, 14F9.1)') "G, kJ/kg         ", (solutions(i, 1, k)%eq_soln(2)%gibbs_energy, i=1,m)
-                write(ioout, '(A, 14F9.2)') "S, kJ/(kg-K)     ", (solutions(i, 1, k)%eq_soln(2)%entropy, i=1,m)
+                write(ioout, '(A, 14F9.3)') "T, K             ", (solutions(i, 1, k)%eq_result(2)%T, i=1,m)
+                write(ioout, '(A, 14E9.3e1)') "rho, kg/m^3      ", (solutions(i, 1, k)%eq_result(2)%density, i=1,m)
+                write(ioout, '(A, 14F9.2)') "H, kJ/kg         ", (solutions(i, 1, k)%eq_result(2)%enthalpy, i=1,m)
+                write(ioout, '(A, 14F9.2)') "U, kJ/kg         ", (solutions(i, 1, k)%eq_result(2)%energy, i=1,m)
+                write(ioout, '(A, 14F9.1)') "G, kJ/kg         ", (solutions(i, 1, k)%eq_result(2)%gibbs_energy, i=1,m)
+                write(ioout, '(A, 14F9.2)') "S, kJ/(kg-K)     ", (solutions(i, 1, k)%eq_result(2)%entropy, i=1,m)
                 write(ioout, '(A)') ""
-                write(ioout, '(A, 14F9.3)') "M, (1/n)         ", (1.0d0/solutions(i, 1, k)%eq_soln(2)%n, i=1,m)
+                write(ioout, '(A, 14F9.3)') "M, (1/n)         ", (1.0d0/solutions(i, 1, k)%eq_result(2)%n, i=1,m)
                 if (write_incd_eql) then
-                    write(ioout, '(A, 14F9.3)') "(dln(V)/dln(P))t ", (solutions(i, 1, k)%eq_partials(2)%dlnV_dlnP, i=1,m)
-                    write(ioout, '(A, 14F9.3)') "(dln(V)/dln(T))p ", (solutions(i, 1, k)%eq_partials(2)%dlnV_dlnT, i=1,m)
+                    write(ioout, '(A, 14F9.3)') "(dln(V)/dln(P))t ", (solutions(i, 1, k)%eq_result(2)%dlnV_dlnP, i=1,m)
+                    write(ioout, '(A, 14F9.3)') "(dln(V)/dln(T))p ", (solutions(i, 1, k)%eq_result(2)%dlnV_dlnT, i=1,m)
                 end if
-                write(ioout, '(A, 14F9.3)') "Cp, kJ/(kg-K)    ", (solutions(i, 1, k)%eq_soln(2)%cp_eq, i=1,m)
-                write(ioout, '(A, 14F9.3)') "Gamma_s          ", (solutions(i, 1, k)%eq_partials(2)%gamma_s, i=1,m)
+                write(ioout, '(A, 14F9.3)') "Cp, kJ/(kg-K)    ", (solutions(i, 1, k)%eq_result(2)%cp_eq, i=1,m)
+                write(ioout, '(A, 14F9.3)') "Gamma_s          ", (solutions(i, 1, k)%eq_result(2)%gamma_s, i=1,m)
                 write(ioout, '(A, 14F9.3)') "Son. Vel., m/s   ", (solutions(i, 1, k)%v_sonic(2), i=1,m)
                 write(ioout, '(A)') ""
 
@@ -1104,12 +1924,12 @@ contains
                     do i = 1,m
                         if (is_trace(idx) .eqv. .false.) exit
                         if (prob%output%mass_fractions) then
-                            if (solutions(i, 1, k)%eq_soln(2)%mass_fractions(idx) > trace) then
+                            if (solutions(i, 1, k)%eq_result(2)%mass_fractions(idx) > trace) then
                                 is_trace(idx) = .false.
                                 exit
                             end if
                         else
-                            if (solutions(i, 1, k)%eq_soln(2)%mole_fractions(idx) > trace) then
+                            if (solutions(i, 1, k)%eq_result(2)%mole_fractions(idx) > trace) then
                                 is_trace(idx) = .false.
                                 exit
                             end if
@@ -1130,10 +1950,10 @@ contains
                         eq_fmt = get_shock_species_format(solutions, idx, 1, k, m, 2, prob%output%mass_fractions)
                         if (prob%output%mass_fractions) then
                         write(ioout, eq_fmt) trim(adjustl(solver%eq_solver%products%species_names(idx))), &
-                            (solutions(i, 1, k)%eq_soln(2)%mass_fractions(idx), i=1,m)
+                            (solutions(i, 1, k)%eq_result(2)%mass_fractions(idx), i=1,m)
                     else
                         write(ioout, eq_fmt) trim(adjustl(solver%eq_solver%products%species_names(idx))), &
-                            (solutions(i, 1, k)%eq_soln(2)%mole_fractions(idx), i=1,m)
+                            (solutions(i, 1, k)%eq_result(2)%mole_fractions(idx), i=1,m)
                         end if
                     end if
                 end do
@@ -1160,20 +1980,20 @@ contains
                 write(ioout, '(A)') "SHOCKED GAS (5)--REFLECTED--"//refl_type
                 write(ioout, '(A, 14F9.3)') "u5, m/s          ", (solutions(i, 1, k)%u(3), i=1,m)
                 write(ioout, '(A, 14F9.3)') "P, bar           ", (solutions(i, 1, k)%pressure(3), i=1,m)
-                write(ioout, '(A, 14F9.3)') "T, K             ", (solutions(i, 1, k)%eq_soln(3)%T, i=1,m)
-                write(ioout, '(A, 14E9.3e1)') "rho, kg/m^3      ", (solutions(i, 1, k)%eq_soln(3)%density, i=1,m)
-                write(ioout, '(A, 14F9.2)') "H, kJ/kg         ", (solutions(i, 1, k)%eq_soln(3)%enthalpy, i=1,m)
-                write(ioout, '(A, 14F9.2)') "U, kJ/kg         ", (solutions(i, 1, k)%eq_soln(3)%energy, i=1,m)
-                write(ioout, '(A, 14F9.1)') "G, kJ/kg         ", (solutions(i, 1, k)%eq_soln(3)%gibbs_energy, i=1,m)
-                write(ioout, '(A, 14F9.2)') "S, kJ/(kg-K)     ", (solutions(i, 1, k)%eq_soln(3)%entropy, i=1,m)
+                write(ioout, '(A, 14F9.3)') "T, K             ", (solutions(i, 1, k)%eq_result(3)%T, i=1,m)
+                write(ioout, '(A, 14E9.3e1)') "rho, kg/m^3      ", (solutions(i, 1, k)%eq_result(3)%density, i=1,m)
+                write(ioout, '(A, 14F9.2)') "H, kJ/kg         ", (solutions(i, 1, k)%eq_result(3)%enthalpy, i=1,m)
+                write(ioout, '(A, 14F9.2)') "U, kJ/kg         ", (solutions(i, 1, k)%eq_result(3)%energy, i=1,m)
+                write(ioout, '(A, 14F9.1)') "G, kJ/kg         ", (solutions(i, 1, k)%eq_result(3)%gibbs_energy, i=1,m)
+                write(ioout, '(A, 14F9.2)') "S, kJ/(kg-K)     ", (solutions(i, 1, k)%eq_result(3)%entropy, i=1,m)
                 write(ioout, '(A)') ""
-                write(ioout, '(A, 14F9.3)') "M, (1/n)         ", (1.0d0/solutions(i, 1, k)%eq_soln(3)%n, i=1,m)
+                write(ioout, '(A, 14F9.3)') "M, (1/n)         ", (1.0d0/solutions(i, 1, k)%eq_result(3)%n, i=1,m)
                 if (write_refl_eql) then
-                    write(ioout, '(A, 14F9.3)') "(dln(V)/dln(P))t ", (solutions(i, 1, k)%eq_partials(3)%dlnV_dlnP, i=1,m)
-                    write(ioout, '(A, 14F9.3)') "(dln(V)/dln(T))p ", (solutions(i, 1, k)%eq_partials(3)%dlnV_dlnT, i=1,m)
+                    write(ioout, '(A, 14F9.3)') "(dln(V)/dln(P))t ", (solutions(i, 1, k)%eq_result(3)%dlnV_dlnP, i=1,m)
+                    write(ioout, '(A, 14F9.3)') "(dln(V)/dln(T))p ", (solutions(i, 1, k)%eq_result(3)%dlnV_dlnT, i=1,m)
                 end if
-                write(ioout, '(A, 14F9.3)') "Cp, kJ/(kg-K)    ", (solutions(i, 1, k)%eq_soln(3)%cp_eq, i=1,m)
-                write(ioout, '(A, 14F9.3)') "Gamma_s          ", (solutions(i, 1, k)%eq_partials(3)%gamma_s, i=1,m)
+                write(ioout, '(A, 14F9.3)') "Cp, kJ/(kg-K)    ", (solutions(i, 1, k)%eq_result(3)%cp_eq, i=1,m)
+                write(ioout, '(A, 14F9.3)') "Gamma_s          ", (solutions(i, 1, k)%eq_result(3)%gamma_s, i=1,m)
                 write(ioout, '(A, 14F9.3)') "Son. Vel., m/s   ", (solutions(i, 1, k)%v_sonic(3), i=1,m)
                 write(ioout, '(A)') ""
 
@@ -1197,12 +2017,12 @@ contains
                     do i = 1,m
                         if (is_trace(idx) .eqv. .false.) exit
                         if (prob%output%mass_fractions) then
-                            if (solutions(i, 1, k)%eq_soln(3)%mass_fractions(idx) > trace) then
+                            if (solutions(i, 1, k)%eq_result(3)%mass_fractions(idx) > trace) then
                                 is_trace(idx) = .false.
                                 exit
                             end if
                         else
-                            if (solutions(i, 1, k)%eq_soln(3)%mole_fractions(idx) > trace) then
+                            if (solutions(i, 1, k)%eq_result(3)%mole_fractions(idx) > trace) then
                                 is_trace(idx) = .false.
                                 exit
                             end if
@@ -1223,10 +2043,10 @@ contains
                         eq_fmt = get_shock_species_format(solutions, idx, 1, k, m, 3, prob%output%mass_fractions)
                         if (prob%output%mass_fractions) then
                         write(ioout, eq_fmt) trim(adjustl(solver%eq_solver%products%species_names(idx))), &
-                            (solutions(i, 1, k)%eq_soln(3)%mass_fractions(idx), i=1,m)
+                            (solutions(i, 1, k)%eq_result(3)%mass_fractions(idx), i=1,m)
                     else
                         write(ioout, eq_fmt) trim(adjustl(solver%eq_solver%products%species_names(idx))), &
-                            (solutions(i, 1, k)%eq_soln(3)%mole_fractions(idx), i=1,m)
+                            (solutions(i, 1, k)%eq_result(3)%mole_fractions(idx), i=1,m)
                         end if
                     end if
                 end do
@@ -1260,7 +2080,7 @@ contains
         integer, intent(in) :: ioout
         type(ProblemDB), intent(in) :: prob
         type(DetonSolver), intent(in) :: solver
-        type(DetonSolution), intent(in) :: solutions(:, :, :)
+        type(DetonResult), intent(in) :: solutions(:, :, :)
 
         ! Locals
         integer :: i, j, k, m, n, idx, last_row_cols, nrows, ncols, num_trace
@@ -1316,40 +2136,40 @@ contains
 
                 ! Print the values of each variable in the required format
                 write(ioout, '(A, 14F9.4)') ' P, bar          ', ((solutions(i, j, k)%pressure,             j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.2)') ' T, K            ', ((solutions(i, j, k)%eq_soln%T,            j=1,n), i=1,m)
-                write(ioout, '(A, 14E9.3e1)') ' Density, kg/m^3   ', ((solutions(i, j, k)%eq_soln%density,  j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.3)') ' H, kJ/kg        ', ((solutions(i, j, k)%eq_soln%enthalpy,     j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.3)') ' U, kJ/kg        ', ((solutions(i, j, k)%eq_soln%energy,       j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.1)') ' G, kJ/kg        ', ((solutions(i, j, k)%eq_soln%gibbs_energy, j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.4)') ' S, kJ/kg-K      ', ((solutions(i, j, k)%eq_soln%entropy,      j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.2)') ' T, K            ', ((solutions(i, j, k)%eq_result%T,            j=1,n), i=1,m)
+                write(ioout, '(A, 14E9.3e1)') ' Density, kg/m^3   ', ((solutions(i, j, k)%eq_result%density,  j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.3)') ' H, kJ/kg        ', ((solutions(i, j, k)%eq_result%enthalpy,     j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.3)') ' U, kJ/kg        ', ((solutions(i, j, k)%eq_result%energy,       j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.1)') ' G, kJ/kg        ', ((solutions(i, j, k)%eq_result%gibbs_energy, j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.4)') ' S, kJ/kg-K      ', ((solutions(i, j, k)%eq_result%entropy,      j=1,n), i=1,m)
                 write(ioout, *) ""
-                write(ioout, '(A, 14F9.3)') ' M, (1/n)        ', ((1.0/solutions(i, j, k)%eq_soln%n,         j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.3)') ' (dln(V)/dln(P))t', ((solutions(i, j, k)%eq_partials%dlnV_dlnP, j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.3)') ' (dln(V)/dln(T))p', ((solutions(i, j, k)%eq_partials%dlnV_dlnT, j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.4)') ' Cp, kJ/kg-K     ', ((solutions(i, j, k)%eq_soln%cp_eq,         j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.4)') ' Gamma_s         ', ((solutions(i, j, k)%eq_partials%gamma_s,   j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.3)') ' M, (1/n)        ', ((1.0/solutions(i, j, k)%eq_result%n,         j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.3)') ' (dln(V)/dln(P))t', ((solutions(i, j, k)%eq_result%dlnV_dlnP, j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.3)') ' (dln(V)/dln(T))p', ((solutions(i, j, k)%eq_result%dlnV_dlnT, j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.4)') ' Cp, kJ/kg-K     ', ((solutions(i, j, k)%eq_result%cp_eq,         j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.4)') ' Gamma_s         ', ((solutions(i, j, k)%eq_result%gamma_s,   j=1,n), i=1,m)
                 write(ioout, '(A, 14F9.3)') ' Son. Vel., m/s  ', &
-                    ((sqrt(solutions(i, j, k)%eq_soln%n*R*solutions(i, j, k)%eq_partials%gamma_s*solutions(i, j, k)%eq_soln%T),&
+                    ((sqrt(solutions(i, j, k)%eq_result%n*R*solutions(i, j, k)%eq_result%gamma_s*solutions(i, j, k)%eq_result%T),&
                      j=1,n), i=1,m)
 
             else
 
                 ! Print the values of each variable in the required format
                 write(ioout, '(A, 14F9.4)') ' P, atm          ', ((solutions(i, j, k)%pressure/1.01325d0,   j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.2)') ' T, K            ', ((solutions(i, j, k)%eq_soln%T,                    j=1,n), i=1,m)
-                write(ioout, '(A, 14E9.3e1)') ' Density, g/cc   ', ((solutions(i, j, k)%eq_soln%density/1.d3,       j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.3)') ' H, cal/g        ', ((solutions(i, j, k)%eq_soln%enthalpy/4.184d0,     j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.3)') ' U, cal/g        ', ((solutions(i, j, k)%eq_soln%energy/4.184d0,       j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.1)') ' G, cal/g        ', ((solutions(i, j, k)%eq_soln%gibbs_energy/4.184d0, j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.4)') ' S, cal/g-K      ', ((solutions(i, j, k)%eq_soln%entropy/4.184d0,      j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.2)') ' T, K            ', ((solutions(i, j, k)%eq_result%T,                    j=1,n), i=1,m)
+                write(ioout, '(A, 14E9.3e1)') ' Density, g/cc   ', ((solutions(i, j, k)%eq_result%density/1.d3,       j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.3)') ' H, cal/g        ', ((solutions(i, j, k)%eq_result%enthalpy/4.184d0,     j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.3)') ' U, cal/g        ', ((solutions(i, j, k)%eq_result%energy/4.184d0,       j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.1)') ' G, cal/g        ', ((solutions(i, j, k)%eq_result%gibbs_energy/4.184d0, j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.4)') ' S, cal/g-K      ', ((solutions(i, j, k)%eq_result%entropy/4.184d0,      j=1,n), i=1,m)
                 write(ioout, *) ""
-                write(ioout, '(A, 14F9.3)') ' M, (1/n)        ', ((1.0/solutions(i, j, k)%eq_soln%n,         j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.3)') ' (dln(V)/dln(P))t', ((solutions(i, j, k)%eq_partials%dlnV_dlnP, j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.3)') ' (dln(V)/dln(T))p', ((solutions(i, j, k)%eq_partials%dlnV_dlnT, j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.4)') ' Cp, cal/g-K     ', ((solutions(i, j, k)%eq_soln%cp_eq/4.184d0, j=1,n), i=1,m)
-                write(ioout, '(A, 14F9.4)') ' Gamma_s         ', ((solutions(i, j, k)%eq_partials%gamma_s,   j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.3)') ' M, (1/n)        ', ((1.0/solutions(i, j, k)%eq_result%n,         j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.3)') ' (dln(V)/dln(P))t', ((solutions(i, j, k)%eq_result%dlnV_dlnP, j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.3)') ' (dln(V)/dln(T))p', ((solutions(i, j, k)%eq_result%dlnV_dlnT, j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.4)') ' Cp, cal/g-K     ', ((solutions(i, j, k)%eq_result%cp_eq/4.184d0, j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.4)') ' Gamma_s         ', ((solutions(i, j, k)%eq_result%gamma_s,   j=1,n), i=1,m)
                 write(ioout, '(A, 14F9.3)') ' Son. Vel., m/s  ', &
-                    ((sqrt(solutions(i, j, k)%eq_soln%n*R*solutions(i, j, k)%eq_partials%gamma_s*solutions(i, j, k)%eq_soln%T),&
+                    ((sqrt(solutions(i, j, k)%eq_result%n*R*solutions(i, j, k)%eq_result%gamma_s*solutions(i, j, k)%eq_result%T),&
                      j=1,n), i=1,m)
 
             end if
@@ -1362,33 +2182,33 @@ contains
                 write(ioout, *) ""
 
                 ! Viscosity
-                write(ioout, '(A, 14F9.4)') " Visc, Millipoise", ((solutions(i, j, k)%eq_soln%viscosity, j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.4)') " Visc, Millipoise", ((solutions(i, j, k)%eq_result%viscosity, j=1,n), i=1,m)
                 write(ioout, *) ""
 
                 ! Equilibrium properies
                 write(ioout, '(A)') " WITH EQUILIBRIUM REACTIONS"
                 if (prob%output%siunit) then
-                    write(ioout, '(A, 14F9.4)') " Cp, kJ/kg-K     ", ((solutions(i, j, k)%eq_soln%cp_eq, j=1,n), i=1,m)
-                    write(ioout, '(A, 14F9.4)') " Conductivity    ", ((solutions(i, j, k)%eq_soln%conductivity_eq, j=1,n), i=1,m)
+                    write(ioout, '(A, 14F9.4)') " Cp, kJ/kg-K     ", ((solutions(i, j, k)%eq_result%cp_eq, j=1,n), i=1,m)
+                    write(ioout, '(A, 14F9.4)') " Conductivity    ", ((solutions(i, j, k)%eq_result%conductivity_eq, j=1,n), i=1,m)
                 else
-                    write(ioout, '(A, 14F9.4)') " Cp, cal/g-K     ", ((solutions(i, j, k)%eq_soln%cp_eq/4.184d0, j=1,n), i=1,m)
+                    write(ioout, '(A, 14F9.4)') " Cp, cal/g-K     ", ((solutions(i, j, k)%eq_result%cp_eq/4.184d0, j=1,n), i=1,m)
                     write(ioout, '(A, 14F9.4)') " Conductivity    ", &
-                        ((solutions(i, j, k)%eq_soln%conductivity_eq/4.184d0, j=1,n), i=1,m)
+                        ((solutions(i, j, k)%eq_result%conductivity_eq/4.184d0, j=1,n), i=1,m)
                 end if
-                write(ioout, '(A, 14F9.4)') " Prandtl Number  ", ((solutions(i, j, k)%eq_soln%Pr_eq, j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.4)') " Prandtl Number  ", ((solutions(i, j, k)%eq_result%Pr_eq, j=1,n), i=1,m)
                 write(ioout, *) ""
 
                 ! Frozen properties
                 write(ioout, '(A)') " WITH FROZEN REACTIONS"
                 if (prob%output%siunit) then
-                    write(ioout, '(A, 14F9.4)') " Cp, kJ/kg-K     ", ((solutions(i, j, k)%eq_soln%cp_fr, j=1,n), i=1,m)
-                    write(ioout, '(A, 14F9.4)') " Conductivity    ", ((solutions(i, j, k)%eq_soln%conductivity_fr, j=1,n), i=1,m)
+                    write(ioout, '(A, 14F9.4)') " Cp, kJ/kg-K     ", ((solutions(i, j, k)%eq_result%cp_fr, j=1,n), i=1,m)
+                    write(ioout, '(A, 14F9.4)') " Conductivity    ", ((solutions(i, j, k)%eq_result%conductivity_fr, j=1,n), i=1,m)
                 else
-                    write(ioout, '(A, 14F9.4)') " Cp, cal/g-K     ", ((solutions(i, j, k)%eq_soln%cp_fr/4.184d0, j=1,n), i=1,m)
+                    write(ioout, '(A, 14F9.4)') " Cp, cal/g-K     ", ((solutions(i, j, k)%eq_result%cp_fr/4.184d0, j=1,n), i=1,m)
                     write(ioout, '(A, 14F9.4)') " Conductivity    ", &
-                        ((solutions(i, j, k)%eq_soln%conductivity_fr/4.184d0, j=1,n), i=1,m)
+                        ((solutions(i, j, k)%eq_result%conductivity_fr/4.184d0, j=1,n), i=1,m)
                 end if
-                write(ioout, '(A, 14F9.4)') " Prandtl Number  ", ((solutions(i, j, k)%eq_soln%Pr_fr, j=1,n), i=1,m)
+                write(ioout, '(A, 14F9.4)') " Prandtl Number  ", ((solutions(i, j, k)%eq_result%Pr_fr, j=1,n), i=1,m)
                 write(ioout, *) ""
 
             end if
@@ -1414,7 +2234,7 @@ contains
                 do i = 1,m
                     if (is_trace(idx) .eqv. .false.) exit
                     do j = 1,n
-                        if (solutions(i, j, k)%eq_soln%mole_fractions(idx) > trace) then
+                        if (solutions(i, j, k)%eq_result%mole_fractions(idx) > trace) then
                             is_trace(idx) = .false.
                             exit
                         end if
@@ -1435,10 +2255,10 @@ contains
                     eq_fmt = get_deton_species_format(solutions, idx, k, m, n, prob%output%mass_fractions)
                     if (prob%output%mass_fractions) then
                         write(ioout, eq_fmt) trim(adjustl(solver%eq_solver%products%species_names(idx))), &
-                            ((solutions(i, j, k)%eq_soln%mass_fractions(idx), j=1,n), i=1,m)
+                            ((solutions(i, j, k)%eq_result%mass_fractions(idx), j=1,n), i=1,m)
                     else
                         write(ioout, eq_fmt) trim(adjustl(solver%eq_solver%products%species_names(idx))), &
-                            ((solutions(i, j, k)%eq_soln%mole_fractions(idx), j=1,n), i=1,m)
+                            ((solutions(i, j, k)%eq_result%mole_fractions(idx), j=1,n), i=1,m)
                     end if
                 end if
             end do
@@ -1554,32 +2374,41 @@ contains
         real(dp) :: h0
 
         ! Locals
-        integer :: i, idx_
-        real(dp), allocatable :: reac_temps(:)
+        integer :: idx_
 
         idx_ = 1
         if (present(idx)) idx_ = idx
 
-        allocate(reac_temps(reactants%num_species))
-
         h0 = 0.0d0
         if (allocated(prob%problem%h_schedule)) then
             h0 = prob%problem%h_schedule%values(idx_)
         else  ! Compute the enthalpy from the reactants
+            h0 = reactants%calc_enthalpy(weights, get_reactant_temperatures(prob, reactants))/R
+        end if
 
-            ! Get the reactant temperatures
-            do i = 1, reactants%num_species
-                reac_temps(i) = 0.0d0
-                if (allocated(prob%reactants(i)%temperature)) then
-                    reac_temps(i) = convert_units_to_si(prob%reactants(i)%temperature%values(1), &
-                                                        prob%reactants(i)%temperature%units)
-                end if
-            end do
+    end function
 
-            ! Compute the reactant enthalpy
-            h0 = reactants%calc_enthalpy(weights, reac_temps)/R
+    function get_reactant_temperatures(prob, reactants) result(reac_temps)
+        ! Get the reactant temperatures [K]; 0 where none is given
 
-        end if
+        ! Arguments
+        type(ProblemDB), intent(in) :: prob
+        type(Mixture), intent(in) :: reactants
+
+        ! Result
+        real(dp), allocatable :: reac_temps(:)
+
+        ! Locals
+        integer :: i
+
+        allocate(reac_temps(reactants%num_species))
+        do i = 1, reactants%num_species
+            reac_temps(i) = 0.0d0
+            if (allocated(prob%reactants(i)%temperature)) then
+                reac_temps(i) = convert_units_to_si(prob%reactants(i)%temperature%values(1), &
+                                                    prob%reactants(i)%temperature%units)
+            end if
+        end do
 
     end function
 
@@ -1594,23 +2423,16 @@ contains
 
         ! Locals
         integer :: i, idx_
-        real(dp) :: of_ratio, ratio_val
+        real(dp) :: of_ratio
         real(dp), allocatable :: moles(:)
-        real(dp), allocatable :: fuel_moles(:), oxidant_moles(:)
         real(dp), allocatable :: fuel_weights(:), oxidant_weights(:)
         character(:), allocatable :: amount_basis
 
-        allocate(moles(reactants%num_species), weights(reactants%num_species), &
-                 fuel_moles(reactants%num_species), oxidant_moles(reactants%num_species), &
-                 fuel_weights(reactants%num_species), oxidant_weights(reactants%num_species))
+        allocate(moles(reactants%num_species), weights(reactants%num_species))
 
         idx_ = 1
         if (present(idx)) idx_ = idx
 
-        fuel_weights = 0.0d0
-        oxidant_weights = 0.0d0
-        fuel_moles = 0.0d0
-        oxidant_moles = 0.0d0
         weights = 0.0d0
 
         ! If fuel and oxidant are not specified separately, use the provided weights,
@@ -1657,84 +2479,124 @@ contains
         ! If fuel and oxidant are specified separately, compute fuel weights and oxidant weights
         else
 
-            if (allocated(prob%reactants(1)%amount) .eqv. .false.) then
-                call log_warning("Reactant amounts not specified; assuming 100% for each.")
-                do i = 1, size(prob%reactants)
-                    if (prob%reactants(i)%type == "fu") then
-                        fuel_weights(i) = 1.0
-                    else if (prob%reactants(i)%type == "ox") then
-                        oxidant_weights(i) = 1.0
-                    end if
-                end do
-
-            else if (prob%reactants(1)%amount%name == "weight_frac") then
-                do i = 1, size(prob%reactants)
-                    if (prob%reactants(i)%type == "fu") then
-                        fuel_weights(i) = prob%reactants(i)%amount%values(1)
-                    else if (prob%reactants(i)%type == "ox") then
-                        oxidant_weights(i) = prob%reactants(i)%amount%values(1)
-                    end if
-                end do
+            call get_fuel_oxidant_weights(prob, reactants, fuel_weights, oxidant_weights)
 
+            ! If an o/f schedule is set, get the o/f ratio and compute the weights
+            if (allocated(prob%problem%of_schedule)) then
+                of_ratio = scheduled_of_ratio(prob, reactants, oxidant_weights, fuel_weights, idx_)
+                weights = reactants%weights_from_of(oxidant_weights, fuel_weights, of_ratio)
             else
-                do i = 1, size(prob%reactants)
-                    if (prob%reactants(i)%type == "fu") then
-                        fuel_moles(i) = prob%reactants(i)%amount%values(1)
-                    else if (prob%reactants(i)%type == "ox") then
-                        oxidant_moles(i) = prob%reactants(i)%amount%values(1)
-                    end if
-                end do
-                fuel_weights = reactants%weights_from_moles(fuel_moles)
-                oxidant_weights = reactants%weights_from_moles(oxidant_moles)
 
-            end if
+                ! If no o/f schedule is set, add the oxidant and fuel weights
+                weights = fuel_weights + oxidant_weights
 
-            ! If an o/f schedule is set, get the o/f ratio and compute the weights
-            if (allocated(prob%problem%of_schedule)) then
-                ratio_val = prob%problem%of_schedule%values(idx_)
+            end if
 
-                ! Get the o/f ratio
-                select case(prob%problem%of_schedule%name)
-                    case ("f/o", "f/a")
-                        of_ratio = 1.0d0/ratio_val
+        end if
 
-                    case ("%f", "%fuel")
-                        of_ratio = (100.0d0-ratio_val)/ratio_val
+    end function
 
-                    case ("phi")
-                        of_ratio = reactants%of_from_phi(oxidant_weights, fuel_weights, ratio_val)
+    subroutine get_fuel_oxidant_weights(prob, reactants, fuel_weights, oxidant_weights)
+        ! Get the separate fuel and oxidant weights of a problem with "fu"/"ox" reactants
 
-                    case ("r")
-                        of_ratio = reactants%of_from_equivalence(oxidant_weights, fuel_weights, ratio_val)
+        ! Arguments
+        type(ProblemDB), intent(in) :: prob
+        type(Mixture), intent(in) :: reactants
+        real(dp), allocatable, intent(out) :: fuel_weights(:)
+        real(dp), allocatable, intent(out) :: oxidant_weights(:)
 
-                    case default
-                        of_ratio = ratio_val
+        ! Locals
+        integer :: i
+        real(dp), allocatable :: fuel_moles(:), oxidant_moles(:)
 
-                end select
+        allocate(fuel_moles(reactants%num_species), oxidant_moles(reactants%num_species), &
+                 fuel_weights(reactants%num_species), oxidant_weights(reactants%num_species))
 
-                ! Compute the weights from the o/f ratio
-                weights = reactants%weights_from_of(oxidant_weights, fuel_weights, of_ratio)
+        fuel_weights = 0.0d0
+        oxidant_weights = 0.0d0
+        fuel_moles = 0.0d0
+        oxidant_moles = 0.0d0
 
-            else
+        if (allocated(prob%reactants(1)%amount) .eqv. .false.) then
+            call log_warning("Reactant amounts not specified; assuming 100% for each.")
+            do i = 1, size(prob%reactants)
+                if (prob%reactants(i)%type == "fu") then
+                    fuel_weights(i) = 1.0
+                else if (prob%reactants(i)%type == "ox") then
+                    oxidant_weights(i) = 1.0
+                end if
+            end do
 
-                ! If no o/f schedule is set, add the oxidant and fuel weights
-                weights = fuel_weights + oxidant_weights
+        else if (prob%reactants(1)%amount%name == "weight_frac") then
+            do i = 1, size(prob%reactants)
+                if (prob%reactants(i)%type == "fu") then
+                    fuel_weights(i) = prob%reactants(i)%amount%values(1)
+                else if (prob%reactants(i)%type == "ox") then
+                    oxidant_weights(i) = prob%reactants(i)%amount%values(1)
+                end if
+            end do
 
-            end if
+        else
+            do i = 1, size(prob%reactants)
+                if (prob%reactants(i)%type == "fu") then
+                    fuel_moles(i) = prob%reactants(i)%amount%values(1)
+                else if (prob%reactants(i)%type == "ox") then
+                    oxidant_moles(i) = prob%reactants(i)%amount%values(1)
+                end if
+            end do
+            fuel_weights = reactants%weights_from_moles(fuel_moles)
+            oxidant_weights = reactants%weights_from_moles(oxidant_moles)
 
         end if
 
+    end subroutine
+
+    function scheduled_of_ratio(prob, reactants, oxidant_weights, fuel_weights, idx) result(of_ratio)
+        ! Convert entry idx of the fuel ratio schedule to an o/f weight ratio
+
+        ! Arguments
+        type(ProblemDB), intent(in) :: prob
+        type(Mixture), intent(in) :: reactants
+        real(dp), intent(in) :: oxidant_weights(:)
+        real(dp), intent(in) :: fuel_weights(:)
+        integer, intent(in) :: idx
+
+        ! Result
+        real(dp) :: of_ratio
+
+        ! Locals
+        real(dp) :: ratio_val
+
+        ratio_val = prob%problem%of_schedule%values(idx)
+
+        select case(prob%problem%of_schedule%name)
+            case ("f/o", "f/a")
+                of_ratio = 1.0d0/ratio_val
+
+            case ("%f", "%fuel")
+                of_ratio = (100.0d0-ratio_val)/ratio_val
+
+            case ("phi")
+                of_ratio = reactants%of_from_phi(oxidant_weights, fuel_weights, ratio_val)
+
+            case ("r")
+                of_ratio = reactants%of_from_equivalence(oxidant_weights, fuel_weights, ratio_val)
+
+            case default
+                of_ratio = ratio_val
+
+        end select
+
     end function
 
-    subroutine thermo_output(ioout, prob, solver, solutions, partials)
+    subroutine thermo_output(ioout, prob, solver, results)
         ! Write out an output file
 
         ! Arguments
         integer, intent(in) :: ioout
         type(ProblemDB), intent(in) :: prob
         type(EqSolver), intent(in) :: solver
-        type(EqSolution), intent(in) :: solutions(:, :, :)
-        type(EqPartials), intent(in) :: partials(:, :, :)
+        type(EqResult), intent(in) :: results(:, :, :)
 
         ! Locals
         integer :: i, j, k, idx, m, n, num_trace, nrows, ncols, last_row_cols
@@ -1750,8 +2612,8 @@ contains
         ! TODO: Print the problem input
 
         ! Initialization
-        m = size(solutions, 1)
-        n = size(solutions, 2)
+        m = size(results, 1)
+        n = size(results, 2)
         allocate(trace_names(solver%num_products), is_trace(solver%num_products))
 
         mass_or_mole = "MOLE"
@@ -1759,7 +2621,7 @@ contains
             mass_or_mole = "MASS"
         end if
 
-        do k = 1, size(solutions, 3)  ! Loop over o/f ratio
+        do k = 1, size(results, 3)  ! Loop over o/f ratio
 
             ! Legacy-style section headers to align major output structure with CEA2.
             select case(prob%problem%type)
@@ -1827,40 +2689,40 @@ contains
             if (prob%output%siunit) then
 
                 ! Print the values of each variable in the required format
-                write(ioout, '(A, 18F14.5)') ' P, bar          ', ((solutions(i, j, k)%pressure,     i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.2)') ' T, K            ', ((solutions(i, j, k)%T,            i=1,m), j=1,n)
-                write(ioout, '(A, 18E14.4e1)') ' Density, kg/m^3 ', ((solutions(i, j, k)%density,    i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.3)') ' H, kJ/kg        ', ((solutions(i, j, k)%enthalpy,     i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.3)') ' U, kJ/kg        ', ((solutions(i, j, k)%energy,       i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.3)') ' G, kJ/kg        ', ((solutions(i, j, k)%gibbs_energy, i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.4)') ' S, kJ/kg-K      ', ((solutions(i, j, k)%entropy,      i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.5)') ' P, bar          ', ((results(i, j, k)%pressure,     i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.2)') ' T, K            ', ((results(i, j, k)%T,            i=1,m), j=1,n)
+                write(ioout, '(A, 18E14.4e1)') ' Density, kg/m^3 ', ((results(i, j, k)%density,    i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.3)') ' H, kJ/kg        ', ((results(i, j, k)%enthalpy,     i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.3)') ' U, kJ/kg        ', ((results(i, j, k)%energy,       i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.3)') ' G, kJ/kg        ', ((results(i, j, k)%gibbs_energy, i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.4)') ' S, kJ/kg-K      ', ((results(i, j, k)%entropy,      i=1,m), j=1,n)
                 write(ioout, *) ""
-                write(ioout, '(A, 18F14.5)') ' M, (1/n)        ', ((1.0/solutions(i, j, k)%n,        i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.5)') ' (dln(V)/dln(P))t', ((partials(i, j, k)%dlnV_dlnP,     i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.5)') ' (dln(V)/dln(T))p', ((partials(i, j, k)%dlnV_dlnT,     i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.5)') ' Cp, kJ/kg-K     ', ((solutions(i, j, k)%cp_eq,        i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.5)') ' Gamma_s         ', ((partials(i, j, k)%gamma_s,       i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.5)') ' M, (1/n)        ', ((1.0/results(i, j, k)%n,        i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.5)') ' (dln(V)/dln(P))t', ((results(i, j, k)%dlnV_dlnP,     i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.5)') ' (dln(V)/dln(T))p', ((results(i, j, k)%dlnV_dlnT,     i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.5)') ' Cp, kJ/kg-K     ', ((results(i, j, k)%cp_eq,        i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.5)') ' Gamma_s         ', ((results(i, j, k)%gamma_s,       i=1,m), j=1,n)
                 write(ioout, '(A, 18F14.3)') ' Son. Vel., m/s  ', &
-                    ((sqrt(solutions(i, j, k)%n * R * partials(i, j, k)%gamma_s * solutions(i, j, k)%T), i=1,m), j=1,n)
+                    ((sqrt(results(i, j, k)%n * R * results(i, j, k)%gamma_s * results(i, j, k)%T), i=1,m), j=1,n)
 
             else
 
                 ! Print the values of each variable in the required format
-                write(ioout, '(A, 18F14.5)') ' P, atm          ', ((solutions(i, j, k)%pressure/1.01325d0,   i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.2)') ' T, K            ', ((solutions(i, j, k)%T,                    i=1,m), j=1,n)
-                write(ioout, '(A, 18E14.4e1)') ' Density, g/cc   ', ((solutions(i, j, k)%density/1.d3,       i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.3)') ' H, cal/g        ', ((solutions(i, j, k)%enthalpy/4.184d0,     i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.3)') ' U, cal/g        ', ((solutions(i, j, k)%energy/4.184d0,       i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.3)') ' G, cal/g        ', ((solutions(i, j, k)%gibbs_energy/4.184d0, i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.4)') ' S, cal/g-K      ', ((solutions(i, j, k)%entropy/4.184d0,      i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.5)') ' P, atm          ', ((results(i, j, k)%pressure/1.01325d0,   i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.2)') ' T, K            ', ((results(i, j, k)%T,                    i=1,m), j=1,n)
+                write(ioout, '(A, 18E14.4e1)') ' Density, g/cc   ', ((results(i, j, k)%density/1.d3,       i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.3)') ' H, cal/g        ', ((results(i, j, k)%enthalpy/4.184d0,     i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.3)') ' U, cal/g        ', ((results(i, j, k)%energy/4.184d0,       i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.3)') ' G, cal/g        ', ((results(i, j, k)%gibbs_energy/4.184d0, i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.4)') ' S, cal/g-K      ', ((results(i, j, k)%entropy/4.184d0,      i=1,m), j=1,n)
                 write(ioout, *) ""
-                write(ioout, '(A, 18F14.5)') ' M, (1/n)        ', ((1.0/solutions(i, j, k)%n,         i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.5)') ' (dln(V)/dln(P))t', ((partials(i, j, k)%dlnV_dlnP,      i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.5)') ' (dln(V)/dln(T))p', ((partials(i, j, k)%dlnV_dlnT,      i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.5)') ' Cp, cal/g-K     ', ((solutions(i, j, k)%cp_eq/4.184d0, i=1,m), j=1,n)
-                write(ioout, '(A, 18F14.5)') ' Gamma_s         ', ((partials(i, j, k)%gamma_s,        i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.5)') ' M, (1/n)        ', ((1.0/results(i, j, k)%n,         i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.5)') ' (dln(V)/dln(P))t', ((results(i, j, k)%dlnV_dlnP,      i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.5)') ' (dln(V)/dln(T))p', ((results(i, j, k)%dlnV_dlnT,      i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.5)') ' Cp, cal/g-K     ', ((results(i, j, k)%cp_eq/4.184d0, i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.5)') ' Gamma_s         ', ((results(i, j, k)%gamma_s,        i=1,m), j=1,n)
                 write(ioout, '(A, 18F14.3)') ' Son. Vel., m/s  ', &
-                    ((sqrt(solutions(i, j, k)%n * R * partials(i, j, k)%gamma_s * solutions(i, j, k)%T), i=1,m), j=1,n)
+                    ((sqrt(results(i, j, k)%n * R * results(i, j, k)%gamma_s * results(i, j, k)%T), i=1,m), j=1,n)
 
             end if
 
@@ -1872,31 +2734,31 @@ contains
                 write(ioout, *) ""
 
                 ! Viscosity
-                write(ioout, '(A, 18F14.4)') " Visc, Millipoise", ((solutions(i, j, k)%viscosity, i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.4)') " Visc, Millipoise", ((results(i, j, k)%viscosity, i=1,m), j=1,n)
                 write(ioout, *) ""
 
                 ! Equilibrium properies
                 write(ioout, '(A)') " WITH EQUILIBRIUM REACTIONS"
                 if (prob%output%siunit) then
-                    write(ioout, '(A, 18F14.4)') " Cp, kJ/kg-K     ", ((solutions(i, j, k)%cp_eq, i=1,m), j=1,n)
-                    write(ioout, '(A, 18F14.4)') " Conductivity    ", ((solutions(i, j, k)%conductivity_eq, i=1,m), j=1,n)
+                    write(ioout, '(A, 18F14.4)') " Cp, kJ/kg-K     ", ((results(i, j, k)%cp_eq, i=1,m), j=1,n)
+                    write(ioout, '(A, 18F14.4)') " Conductivity    ", ((results(i, j, k)%conductivity_eq, i=1,m), j=1,n)
                 else
-                    write(ioout, '(A, 18F14.4)') " Cp, cal/g-K     ", ((solutions(i, j, k)%cp_eq/4.184d0, i=1,m), j=1,n)
-                    write(ioout, '(A, 18F14.4)') " Conductivity    ", ((solutions(i, j, k)%conductivity_eq/4.184d0, i=1,m), j=1,n)
+                    write(ioout, '(A, 18F14.4)') " Cp, cal/g-K     ", ((results(i, j, k)%cp_eq/4.184d0, i=1,m), j=1,n)
+                    write(ioout, '(A, 18F14.4)') " Conductivity    ", ((results(i, j, k)%conductivity_eq/4.184d0, i=1,m), j=1,n)
                 end if
-                write(ioout, '(A, 18F14.4)') " Prandtl Number  ", ((solutions(i, j, k)%Pr_eq, i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.4)') " Prandtl Number  ", ((results(i, j, k)%Pr_eq, i=1,m), j=1,n)
                 write(ioout, *) ""
 
                 ! Frozen properties
                 write(ioout, '(A)') " WITH FROZEN REACTIONS"
                 if (prob%output%siunit) then
-                    write(ioout, '(A, 18F14.4)') " Cp, kJ/kg-K     ", ((solutions(i, j, k)%cp_fr, i=1,m), j=1,n)
-                    write(ioout, '(A, 18F14.4)') " Conductivity    ", ((solutions(i, j, k)%conductivity_fr, i=1,m), j=1,n)
+                    write(ioout, '(A, 18F14.4)') " Cp, kJ/kg-K     ", ((results(i, j, k)%cp_fr, i=1,m), j=1,n)
+                    write(ioout, '(A, 18F14.4)') " Conductivity    ", ((results(i, j, k)%conductivity_fr, i=1,m), j=1,n)
                 else
-                    write(ioout, '(A, 18F14.4)') " Cp, cal/g-K     ", ((solutions(i, j, k)%cp_fr/4.184d0, i=1,m), j=1,n)
-                    write(ioout, '(A, 18F14.4)') " Conductivity    ", ((solutions(i, j, k)%conductivity_fr/4.184d0, i=1,m), j=1,n)
+                    write(ioout, '(A, 18F14.4)') " Cp, cal/g-K     ", ((results(i, j, k)%cp_fr/4.184d0, i=1,m), j=1,n)
+                    write(ioout, '(A, 18F14.4)') " Conductivity    ", ((results(i, j, k)%conductivity_fr/4.184d0, i=1,m), j=1,n)
                 end if
-                write(ioout, '(A, 18F14.4)') " Prandtl Number  ", ((solutions(i, j, k)%Pr_fr, i=1,m), j=1,n)
+                write(ioout, '(A, 18F14.4)') " Prandtl Number  ", ((results(i, j, k)%Pr_fr, i=1,m), j=1,n)
                 write(ioout, *) ""
 
             end if
@@ -1913,7 +2775,7 @@ contains
                 do i = 1,m
                     if (is_trace(idx) .eqv. .false.) exit
                     do j = 1,n
-                        if (solutions(i, j, k)%mole_fractions(idx) > trace) then
+                        if (results(i, j, k)%mole_fractions(idx) > trace) then
                             is_trace(idx) = .false.
                             exit
                         end if
@@ -1931,13 +2793,13 @@ contains
             write(ioout, *) ""
             do idx = 1, solver%num_products
                 if (is_trace(idx) .eqv. .false.) then
-                    eq_fmt = get_eq_species_format(solutions, idx, k, m, n, prob%output%mass_fractions)
+                    eq_fmt = get_eq_species_format(results, idx, k, m, n, prob%output%mass_fractions)
                     if (prob%output%mass_fractions) then
                         write(ioout, eq_fmt) trim(adjustl(solver%products%species_names(idx))), &
-                            ((solutions(i, j, k)%mass_fractions(idx), i=1,m), j=1,n)
+                            ((results(i, j, k)%mass_fractions(idx), i=1,m), j=1,n)
                     else
                         write(ioout, eq_fmt) trim(adjustl(solver%products%species_names(idx))), &
-                            ((solutions(i, j, k)%mole_fractions(idx), i=1,m), j=1,n)
+                            ((results(i, j, k)%mole_fractions(idx), i=1,m), j=1,n)
                     end if
                 end if
             end do
@@ -1972,7 +2834,7 @@ contains
         integer, intent(in) :: ioout
         type(ProblemDB), intent(in) :: prob
         type(RocketSolver), intent(in) :: solver
-        type(RocketSolution), intent(inout) :: solutions(:, :, :)
+        type(RocketResult), intent(inout) :: solutions(:, :, :)
 
         ! Locals
         integer :: i, j, k, idx, ii, jj, m, n, num_trace, nrows, ncols, np, ne, nc
@@ -2115,11 +2977,9 @@ contains
                                 continue
                             else
                                 solutions(i,j,k)%station(idx-1) = solutions(i,j,k)%station(idx)
-                                solutions(i,j,k)%eq_soln(idx-1) = solutions(i,j,k)%eq_soln(idx)
-                                solutions(i,j,k)%eq_partials(idx-1) = solutions(i,j,k)%eq_partials(idx)
+                                solutions(i,j,k)%eq_result(idx-1) = solutions(i,j,k)%eq_result(idx)
                                 solutions(i,j,k)%pressure(idx-1) = solutions(i,j,k)%pressure(idx)
                                 solutions(i,j,k)%mach(idx-1) = solutions(i,j,k)%mach(idx)
-                                solutions(i,j,k)%gamma_s(idx-1) = solutions(i,j,k)%gamma_s(idx)
                                 solutions(i,j,k)%v_sonic(idx-1) = solutions(i,j,k)%v_sonic(idx)
                                 solutions(i,j,k)%ae_at(idx-1) = solutions(i,j,k)%ae_at(idx)
                                 solutions(i,j,k)%c_star(idx-1) = solutions(i,j,k)%c_star(idx)
@@ -2225,38 +3085,38 @@ contains
                     write(ioout, pinj_fmt) (solutions(i,j,k)%pressure(1)/solutions(i,j,k)%pressure(idx), idx=1,np)
                     if (prob%output%siunit) then
                         write(ioout, p_fmt) (solutions(i,j,k)%pressure(idx), idx=1,np)
-                        write(ioout, t_fmt) (solutions(i,j,k)%eq_soln(idx)%T, idx=1,np)
-                        write(ioout, rho_fmt) (solutions(i,j,k)%eq_soln(idx)%density, idx=1,np)
-                        write(ioout, h_fmt) (solutions(i,j,k)%eq_soln(idx)%enthalpy, idx=1,np)
-                        write(ioout, u_fmt) (solutions(i,j,k)%eq_soln(idx)%energy, idx=1,np)
-                        write(ioout, g_fmt) (solutions(i,j,k)%eq_soln(idx)%gibbs_energy, idx=1,np)
-                        write(ioout, s_fmt) (solutions(i,j,k)%eq_soln(idx)%entropy, idx=1,np)
+                        write(ioout, t_fmt) (solutions(i,j,k)%eq_result(idx)%T, idx=1,np)
+                        write(ioout, rho_fmt) (solutions(i,j,k)%eq_result(idx)%density, idx=1,np)
+                        write(ioout, h_fmt) (solutions(i,j,k)%eq_result(idx)%enthalpy, idx=1,np)
+                        write(ioout, u_fmt) (solutions(i,j,k)%eq_result(idx)%energy, idx=1,np)
+                        write(ioout, g_fmt) (solutions(i,j,k)%eq_result(idx)%gibbs_energy, idx=1,np)
+                        write(ioout, s_fmt) (solutions(i,j,k)%eq_result(idx)%entropy, idx=1,np)
                         write(ioout, *) ""
-                        write(ioout, thermo_fmt) 'M, (1/n)        ', (1.0/solutions(i, j, k)%eq_soln(idx)%n         , idx=1,np)
+                        write(ioout, thermo_fmt) 'M, (1/n)        ', (1.0/solutions(i, j, k)%eq_result(idx)%n         , idx=1,np)
                         if (frozen .eqv. .false.) then
-                            write(ioout, thermo_fmt) '(dln(V)/dln(P))t', (solutions(i, j, k)%eq_partials(idx)%dlnV_dlnP , idx=1,np)
-                            write(ioout, thermo_fmt) '(dln(V)/dln(T))p', (solutions(i, j, k)%eq_partials(idx)%dlnV_dlnT , idx=1,np)
+                            write(ioout, thermo_fmt) '(dln(V)/dln(P))t', (solutions(i, j, k)%eq_result(idx)%dlnV_dlnP , idx=1,np)
+                            write(ioout, thermo_fmt) '(dln(V)/dln(T))p', (solutions(i, j, k)%eq_result(idx)%dlnV_dlnT , idx=1,np)
                         end if
-                        write(ioout, thermo_fmt) 'Cp, kJ/(kg-K)   ', (solutions(i, j, k)%eq_soln(idx)%cp_eq         , idx=1,np)
-                        write(ioout, thermo_fmt) 'Gamma_s         ', (solutions(i, j, k)%eq_partials(idx)%gamma_s, idx=1,np)
+                        write(ioout, thermo_fmt) 'Cp, kJ/(kg-K)   ', (solutions(i, j, k)%eq_result(idx)%cp_eq         , idx=1,np)
+                        write(ioout, thermo_fmt) 'Gamma_s         ', (solutions(i, j, k)%eq_result(idx)%gamma_s, idx=1,np)
                         write(ioout, vsonic_fmt) 'Son. Vel., m/s  ', (solutions(i, j, k)%v_sonic(idx), idx=1,np)
                         write(ioout, thermo_fmt) 'Mach            ', (solutions(i, j, k)%mach(idx), idx=1,np)
                     else
                         write(ioout, p_fmt) (solutions(i,j,k)%pressure(idx)/1.01325d0, idx=1,np)
-                        write(ioout, t_fmt) (solutions(i,j,k)%eq_soln(idx)%T, idx=1,np)
-                        write(ioout, rho_fmt) (solutions(i,j,k)%eq_soln(idx)%density/1.d3, idx=1,np)
-                        write(ioout, h_fmt) (solutions(i,j,k)%eq_soln(idx)%enthalpy/4.184d0, idx=1,np)
-                        write(ioout, u_fmt) (solutions(i,j,k)%eq_soln(idx)%energy/4.184d0, idx=1,np)
-                        write(ioout, g_fmt) (solutions(i,j,k)%eq_soln(idx)%gibbs_energy/4.184d0, idx=1,np)
-                        write(ioout, s_fmt) (solutions(i,j,k)%eq_soln(idx)%entropy/4.184d0, idx=1,np)
+                        write(ioout, t_fmt) (solutions(i,j,k)%eq_result(idx)%T, idx=1,np)
+                        write(ioout, rho_fmt) (solutions(i,j,k)%eq_result(idx)%density/1.d3, idx=1,np)
+                        write(ioout, h_fmt) (solutions(i,j,k)%eq_result(idx)%enthalpy/4.184d0, idx=1,np)
+                        write(ioout, u_fmt) (solutions(i,j,k)%eq_result(idx)%energy/4.184d0, idx=1,np)
+                        write(ioout, g_fmt) (solutions(i,j,k)%eq_result(idx)%gibbs_energy/4.184d0, idx=1,np)
+                        write(ioout, s_fmt) (solutions(i,j,k)%eq_result(idx)%entropy/4.184d0, idx=1,np)
                         write(ioout, *) ""
-                        write(ioout, thermo_fmt) 'M, (1/n)        ', (1.0/solutions(i, j, k)%eq_soln(idx)%n         , idx=1,np)
+                        write(ioout, thermo_fmt) 'M, (1/n)        ', (1.0/solutions(i, j, k)%eq_result(idx)%n         , idx=1,np)
                         if (frozen .eqv. .false.) then
-                            write(ioout, thermo_fmt) '(dln(V)/dln(P))t', (solutions(i, j, k)%eq_partials(idx)%dlnV_dlnP , idx=1,np)
-                            write(ioout, thermo_fmt) '(dln(V)/dln(T))p', (solutions(i, j, k)%eq_partials(idx)%dlnV_dlnT , idx=1,np)
+                            write(ioout, thermo_fmt) '(dln(V)/dln(P))t', (solutions(i, j, k)%eq_result(idx)%dlnV_dlnP , idx=1,np)
+                            write(ioout, thermo_fmt) '(dln(V)/dln(T))p', (solutions(i, j, k)%eq_result(idx)%dlnV_dlnT , idx=1,np)
                         end if
-                        write(ioout, thermo_fmt) 'Cp, cal/(g-K)   ', (solutions(i, j, k)%eq_soln(idx)%cp_eq/4.184d0, idx=1,np)
-                        write(ioout, thermo_fmt) 'Gamma_s         ', (solutions(i, j, k)%eq_partials(idx)%gamma_s, idx=1,np)
+                        write(ioout, thermo_fmt) 'Cp, cal/(g-K)   ', (solutions(i, j, k)%eq_result(idx)%cp_eq/4.184d0, idx=1,np)
+                        write(ioout, thermo_fmt) 'Gamma_s         ', (solutions(i, j, k)%eq_result(idx)%gamma_s, idx=1,np)
                         write(ioout, vsonic_fmt) 'Son. Vel., m/s  ', (solutions(i, j, k)%v_sonic(idx), idx=1,np)
                         write(ioout, thermo_fmt) 'Mach            ', (solutions(i, j, k)%mach(idx), idx=1,np)
                     end if
@@ -2269,35 +3129,37 @@ contains
                         write(ioout, *) ""
 
                         ! Viscosity
-                        write(ioout, thermo_fmt) " Visc, Millipoise", (solutions(i, j, k)%eq_soln(idx)%viscosity, idx=1,np)
+                        write(ioout, thermo_fmt) " Visc, Millipoise", (solutions(i, j, k)%eq_result(idx)%viscosity, idx=1,np)
                         write(ioout, *) ""
 
                         ! Equilibrium properies
                         write(ioout, '(A)') " WITH EQUILIBRIUM REACTIONS"
                         if (prob%output%siunit) then
-                            write(ioout, thermo_fmt) " Cp, kJ/(kg-K)   ", (solutions(i, j, k)%eq_soln(idx)%cp_eq, idx=1,np)
+                            write(ioout, thermo_fmt) " Cp, kJ/(kg-K)   ", (solutions(i, j, k)%eq_result(idx)%cp_eq, idx=1,np)
                             write(ioout, thermo_fmt) " Conductivity    ", &
-                                (solutions(i, j, k)%eq_soln(idx)%conductivity_eq, idx=1,np)
+                                (solutions(i, j, k)%eq_result(idx)%conductivity_eq, idx=1,np)
                         else
-                            write(ioout, thermo_fmt) " Cp, cal/(g-K)   ", (solutions(i, j, k)%eq_soln(idx)%cp_eq/4.184d0, idx=1,np)
+                            write(ioout, thermo_fmt) " Cp, cal/(g-K)   ", &
+                                (solutions(i, j, k)%eq_result(idx)%cp_eq/4.184d0, idx=1,np)
                             write(ioout, thermo_fmt) " Conductivity    ", &
-                                (solutions(i, j, k)%eq_soln(idx)%conductivity_eq/4.184d0, idx=1,np)
+                                (solutions(i, j, k)%eq_result(idx)%conductivity_eq/4.184d0, idx=1,np)
                         end if
-                        write(ioout, thermo_fmt) " Prandtl Number  ", (solutions(i, j, k)%eq_soln(idx)%Pr_eq, idx=1,np)
+                        write(ioout, thermo_fmt) " Prandtl Number  ", (solutions(i, j, k)%eq_result(idx)%Pr_eq, idx=1,np)
                         write(ioout, *) ""
 
                         ! Frozen properties
                         write(ioout, '(A)') " WITH FROZEN REACTIONS"
                         if (prob%output%siunit) then
-                            write(ioout, thermo_fmt) " Cp, kJ/(kg-K)   ", (solutions(i, j, k)%eq_soln(idx)%cp_fr, idx=1,np)
+                            write(ioout, thermo_fmt) " Cp, kJ/(kg-K)   ", (solutions(i, j, k)%eq_result(idx)%cp_fr, idx=1,np)
                             write(ioout, thermo_fmt) " Conductivity    ", &
-                                (solutions(i, j, k)%eq_soln(idx)%conductivity_fr, idx=1,np)
+                                (solutions(i, j, k)%eq_result(idx)%conductivity_fr, idx=1,np)
                         else
-                            write(ioout, thermo_fmt) " Cp, cal/(g-K)   ", (solutions(i, j, k)%eq_soln(idx)%cp_fr/4.184d0, idx=1,np)
+                            write(ioout, thermo_fmt) " Cp, cal/(g-K)   ", &
+                                (solutions(i, j, k)%eq_result(idx)%cp_fr/4.184d0, idx=1,np)
                             write(ioout, thermo_fmt) " Conductivity    ", &
-                                (solutions(i, j, k)%eq_soln(idx)%conductivity_fr/4.184d0, idx=1,np)
+                                (solutions(i, j, k)%eq_result(idx)%conductivity_fr/4.184d0, idx=1,np)
                         end if
-                        write(ioout, thermo_fmt) " Prandtl Number  ", (solutions(i, j, k)%eq_soln(idx)%Pr_fr, idx=1,np)
+                        write(ioout, thermo_fmt) " Prandtl Number  ", (solutions(i, j, k)%eq_result(idx)%Pr_fr, idx=1,np)
                         write(ioout, *) ""
 
                     end if
@@ -2355,7 +3217,7 @@ contains
                         is_trace(ii) = .true.
                         if (is_trace(ii) .eqv. .false.) exit
                         do idx = 1,np
-                            if (solutions(i, j, k)%eq_soln(idx)%mole_fractions(ii) > trace) then
+                            if (solutions(i, j, k)%eq_result(idx)%mole_fractions(ii) > trace) then
                                 is_trace(ii) = .false.
                                 exit
                             end if
@@ -2382,23 +3244,23 @@ contains
                             end if
                             if (prob%output%mass_fractions) then
                                 if (frozen) then
-                                    if (solutions(i, j, k)%eq_soln(nfrz)%mass_fractions(ii) > trace) then
+                                    if (solutions(i, j, k)%eq_result(nfrz)%mass_fractions(ii) > trace) then
                                         write(ioout, spec_fmt) trim(adjustl(solver%eq_solver%products%species_names(ii))), &
-                                            solutions(i, j, k)%eq_soln(nfrz)%mass_fractions(ii)
+                                            solutions(i, j, k)%eq_result(nfrz)%mass_fractions(ii)
                                     end if
                                 else
                                     write(ioout, spec_fmt) trim(adjustl(solver%eq_solver%products%species_names(ii))), &
-                                        (solutions(i, j, k)%eq_soln(idx)%mass_fractions(ii), idx=1,np)
+                                        (solutions(i, j, k)%eq_result(idx)%mass_fractions(ii), idx=1,np)
                                 end if
                             else
                                 if (frozen) then
-                                    if (solutions(i, j, k)%eq_soln(nfrz)%mole_fractions(ii) > trace) then
+                                    if (solutions(i, j, k)%eq_result(nfrz)%mole_fractions(ii) > trace) then
                                         write(ioout, spec_fmt) trim(adjustl(solver%eq_solver%products%species_names(ii))), &
-                                             solutions(i, j, k)%eq_soln(nfrz)%mole_fractions(ii)
+                                             solutions(i, j, k)%eq_result(nfrz)%mole_fractions(ii)
                                     end if
                                 else
                                     write(ioout, spec_fmt) trim(adjustl(solver%eq_solver%products%species_names(ii))), &
-                                        (solutions(i, j, k)%eq_soln(idx)%mole_fractions(ii), idx=1,np)
+                                        (solutions(i, j, k)%eq_result(idx)%mole_fractions(ii), idx=1,np)
                                 end if
                             end if
                         end if
@@ -2450,87 +3312,87 @@ contains
                             write(ioout, p_fmt, advance="no") (solutions(i,j,k)%pressure(idx), idx=1,nc)
                             write(ioout, ffmt) (solutions(i,j,k)%pressure(idx), idx=x,y)
 
-                            write(ioout, t_fmt, advance="no") (solutions(i,j,k)%eq_soln(idx)%T, idx=1,nc)
-                            write(ioout, ffmt) (solutions(i,j,k)%eq_soln(idx)%T, idx=x,y)
+                            write(ioout, t_fmt, advance="no") (solutions(i,j,k)%eq_result(idx)%T, idx=1,nc)
+                            write(ioout, ffmt) (solutions(i,j,k)%eq_result(idx)%T, idx=x,y)
 
-                            write(ioout, rho_fmt, advance="no") (solutions(i,j,k)%eq_soln(idx)%density, idx=1,nc)
-                            write(ioout, "(6(E13.4e1))") (solutions(i,j,k)%eq_soln(idx)%density, idx=x,y)
+                            write(ioout, rho_fmt, advance="no") (solutions(i,j,k)%eq_result(idx)%density, idx=1,nc)
+                            write(ioout, "(6(E13.4e1))") (solutions(i,j,k)%eq_result(idx)%density, idx=x,y)
 
-                            write(ioout, h_fmt, advance="no") (solutions(i,j,k)%eq_soln(idx)%enthalpy, idx=1,nc)
-                            write(ioout, ffmt) (solutions(i,j,k)%eq_soln(idx)%enthalpy, idx=x,y)
+                            write(ioout, h_fmt, advance="no") (solutions(i,j,k)%eq_result(idx)%enthalpy, idx=1,nc)
+                            write(ioout, ffmt) (solutions(i,j,k)%eq_result(idx)%enthalpy, idx=x,y)
 
-                            write(ioout, u_fmt, advance="no") (solutions(i,j,k)%eq_soln(idx)%energy, idx=1,nc)
-                            write(ioout, ffmt) (solutions(i,j,k)%eq_soln(idx)%energy, idx=x,y)
+                            write(ioout, u_fmt, advance="no") (solutions(i,j,k)%eq_result(idx)%energy, idx=1,nc)
+                            write(ioout, ffmt) (solutions(i,j,k)%eq_result(idx)%energy, idx=x,y)
 
-                            write(ioout, g_fmt, advance="no") (solutions(i,j,k)%eq_soln(idx)%gibbs_energy, idx=1,nc)
-                            write(ioout, "(6(F13.2))") (solutions(i,j,k)%eq_soln(idx)%gibbs_energy, idx=x,y)
+                            write(ioout, g_fmt, advance="no") (solutions(i,j,k)%eq_result(idx)%gibbs_energy, idx=1,nc)
+                            write(ioout, "(6(F13.2))") (solutions(i,j,k)%eq_result(idx)%gibbs_energy, idx=x,y)
 
-                            write(ioout, s_fmt, advance="no") (solutions(i,j,k)%eq_soln(idx)%entropy, idx=1,nc)
-                            write(ioout, ffmt) (solutions(i,j,k)%eq_soln(idx)%entropy, idx=x,y)
+                            write(ioout, s_fmt, advance="no") (solutions(i,j,k)%eq_result(idx)%entropy, idx=1,nc)
+                            write(ioout, ffmt) (solutions(i,j,k)%eq_result(idx)%entropy, idx=x,y)
 
                             write(ioout, *) ""
                             write(ioout, thermo_fmt, advance="no") 'M, (1/n)        ', &
-                                (1.0/solutions(i, j, k)%eq_soln(idx)%n, idx=1,nc)
-                            write(ioout, ffmt) (1.0/solutions(i, j, k)%eq_soln(idx)%n, idx=x,y)
+                                (1.0/solutions(i, j, k)%eq_result(idx)%n, idx=1,nc)
+                            write(ioout, ffmt) (1.0/solutions(i, j, k)%eq_result(idx)%n, idx=x,y)
 
                             if (frozen .eqv. .false.) then
                                 write(ioout, thermo_fmt, advance="no") '(dln(V)/dln(P))t', &
-                                    (solutions(i, j, k)%eq_partials(idx)%dlnV_dlnP, idx=1,nc)
-                                write(ioout, ffmt) (solutions(i, j, k)%eq_partials(idx)%dlnV_dlnP, idx=x,y)
+                                    (solutions(i, j, k)%eq_result(idx)%dlnV_dlnP, idx=1,nc)
+                                write(ioout, ffmt) (solutions(i, j, k)%eq_result(idx)%dlnV_dlnP, idx=x,y)
 
                                 write(ioout, thermo_fmt, advance="no") '(dln(V)/dln(T))p', &
-                                    (solutions(i, j, k)%eq_partials(idx)%dlnV_dlnT, idx=1,nc)
-                                write(ioout, ffmt) (solutions(i, j, k)%eq_partials(idx)%dlnV_dlnT, idx=x,y)
+                                    (solutions(i, j, k)%eq_result(idx)%dlnV_dlnT, idx=1,nc)
+                                write(ioout, ffmt) (solutions(i, j, k)%eq_result(idx)%dlnV_dlnT, idx=x,y)
                             end if
 
                             write(ioout, thermo_fmt, advance="no") 'Cp, kJ/(kg-K)   ', &
-                                (solutions(i, j, k)%eq_soln(idx)%cp_eq, idx=1,nc)
-                            write(ioout, ffmt) (solutions(i, j, k)%eq_soln(idx)%cp_eq, idx=x,y)
+                                (solutions(i, j, k)%eq_result(idx)%cp_eq, idx=1,nc)
+                            write(ioout, ffmt) (solutions(i, j, k)%eq_result(idx)%cp_eq, idx=x,y)
                         else
                             write(ioout, p_fmt, advance="no") (solutions(i,j,k)%pressure(idx)/1.01325d0, idx=1,nc)
                             write(ioout, ffmt) (solutions(i,j,k)%pressure(idx), idx=x,y)
 
-                            write(ioout, t_fmt, advance="no") (solutions(i,j,k)%eq_soln(idx)%T, idx=1,nc)
-                            write(ioout, ffmt) (solutions(i,j,k)%eq_soln(idx)%T, idx=x,y)
+                            write(ioout, t_fmt, advance="no") (solutions(i,j,k)%eq_result(idx)%T, idx=1,nc)
+                            write(ioout, ffmt) (solutions(i,j,k)%eq_result(idx)%T, idx=x,y)
 
-                            write(ioout, rho_fmt, advance="no") (solutions(i,j,k)%eq_soln(idx)%density/1.d3, idx=1,nc)
-                            write(ioout, "(6(E13.4e1))") (solutions(i,j,k)%eq_soln(idx)%density, idx=x,y)
+                            write(ioout, rho_fmt, advance="no") (solutions(i,j,k)%eq_result(idx)%density/1.d3, idx=1,nc)
+                            write(ioout, "(6(E13.4e1))") (solutions(i,j,k)%eq_result(idx)%density, idx=x,y)
 
-                            write(ioout, h_fmt, advance="no") (solutions(i,j,k)%eq_soln(idx)%enthalpy/4.184d0, idx=1,nc)
-                            write(ioout, ffmt) (solutions(i,j,k)%eq_soln(idx)%enthalpy, idx=x,y)
+                            write(ioout, h_fmt, advance="no") (solutions(i,j,k)%eq_result(idx)%enthalpy/4.184d0, idx=1,nc)
+                            write(ioout, ffmt) (solutions(i,j,k)%eq_result(idx)%enthalpy, idx=x,y)
 
-                            write(ioout, u_fmt, advance="no") (solutions(i,j,k)%eq_soln(idx)%energy/4.184d0, idx=1,nc)
-                            write(ioout, ffmt) (solutions(i,j,k)%eq_soln(idx)%energy, idx=x,y)
+                            write(ioout, u_fmt, advance="no") (solutions(i,j,k)%eq_result(idx)%energy/4.184d0, idx=1,nc)
+                            write(ioout, ffmt) (solutions(i,j,k)%eq_result(idx)%energy, idx=x,y)
 
-                            write(ioout, g_fmt, advance="no") (solutions(i,j,k)%eq_soln(idx)%gibbs_energy/4.184d0, idx=1,nc)
-                            write(ioout, "(6(F13.2))") (solutions(i,j,k)%eq_soln(idx)%gibbs_energy, idx=x,y)
+                            write(ioout, g_fmt, advance="no") (solutions(i,j,k)%eq_result(idx)%gibbs_energy/4.184d0, idx=1,nc)
+                            write(ioout, "(6(F13.2))") (solutions(i,j,k)%eq_result(idx)%gibbs_energy, idx=x,y)
 
-                            write(ioout, s_fmt, advance="no") (solutions(i,j,k)%eq_soln(idx)%entropy/4.184d0, idx=1,nc)
-                            write(ioout, ffmt) (solutions(i,j,k)%eq_soln(idx)%entropy, idx=x,y)
+                            write(ioout, s_fmt, advance="no") (solutions(i,j,k)%eq_result(idx)%entropy/4.184d0, idx=1,nc)
+                            write(ioout, ffmt) (solutions(i,j,k)%eq_result(idx)%entropy, idx=x,y)
 
                             write(ioout, *) ""
                             write(ioout, thermo_fmt, advance="no") 'M, (1/n)        ', &
-                                (1.0/solutions(i, j, k)%eq_soln(idx)%n, idx=1,nc)
-                            write(ioout, ffmt) (1.0/solutions(i, j, k)%eq_soln(idx)%n, idx=x,y)
+                                (1.0/solutions(i, j, k)%eq_result(idx)%n, idx=1,nc)
+                            write(ioout, ffmt) (1.0/solutions(i, j, k)%eq_result(idx)%n, idx=x,y)
 
                             if (frozen .eqv. .false.) then
                                 write(ioout, thermo_fmt, advance="no") '(dln(V)/dln(P))t', &
-                                    (solutions(i, j, k)%eq_partials(idx)%dlnV_dlnP, idx=1,nc)
-                                write(ioout, ffmt) (solutions(i, j, k)%eq_partials(idx)%dlnV_dlnP, idx=x,y)
+                                    (solutions(i, j, k)%eq_result(idx)%dlnV_dlnP, idx=1,nc)
+                                write(ioout, ffmt) (solutions(i, j, k)%eq_result(idx)%dlnV_dlnP, idx=x,y)
 
                                 write(ioout, thermo_fmt, advance="no") '(dln(V)/dln(T))p', &
-                                     (solutions(i, j, k)%eq_partials(idx)%dlnV_dlnT, idx=1,nc)
-                                write(ioout, ffmt) (solutions(i, j, k)%eq_partials(idx)%dlnV_dlnT, idx=x,y)
+                                     (solutions(i, j, k)%eq_result(idx)%dlnV_dlnT, idx=1,nc)
+                                write(ioout, ffmt) (solutions(i, j, k)%eq_result(idx)%dlnV_dlnT, idx=x,y)
                             end if
 
                             write(ioout, thermo_fmt, advance="no") 'Cp, cal/(g-K)   ', &
-                                (solutions(i, j, k)%eq_soln(idx)%cp_eq/4.184d0, idx=1,nc)
-                            write(ioout, ffmt) (solutions(i, j, k)%eq_soln(idx)%cp_eq/4.184d0, idx=x,y)
+                                (solutions(i, j, k)%eq_result(idx)%cp_eq/4.184d0, idx=1,nc)
+                            write(ioout, ffmt) (solutions(i, j, k)%eq_result(idx)%cp_eq/4.184d0, idx=x,y)
                         end if
 
                         write(ioout, thermo_fmt, advance="no") 'Gamma_s         ', &
-                            (solutions(i, j, k)%eq_partials(idx)%gamma_s, idx=1,nc)
-                        write(ioout, ffmt) (solutions(i, j, k)%eq_partials(idx)%gamma_s, idx=x,y)
+                            (solutions(i, j, k)%eq_result(idx)%gamma_s, idx=1,nc)
+                        write(ioout, ffmt) (solutions(i, j, k)%eq_result(idx)%gamma_s, idx=x,y)
 
                         write(ioout, vsonic_fmt, advance="no") 'Son. Vel., m/s  ', &
                             (solutions(i, j, k)%v_sonic(idx), idx=1,nc)
@@ -2549,56 +3411,56 @@ contains
 
                             ! Viscosity
                             write(ioout, '(A, F13.3)', advance="no") " Visc, Millipoise", &
-                                (solutions(i, j, k)%eq_soln(idx)%viscosity, idx=1,nc)
-                            write(ioout, '(F13.3)') (solutions(i, j, k)%eq_soln(idx)%viscosity, idx=x,y)
+                                (solutions(i, j, k)%eq_result(idx)%viscosity, idx=1,nc)
+                            write(ioout, '(F13.3)') (solutions(i, j, k)%eq_result(idx)%viscosity, idx=x,y)
                             write(ioout, *) ""
 
                             ! Equilibrium properies
                             write(ioout, '(A)') " WITH EQUILIBRIUM REACTIONS"
                             if (prob%output%siunit) then
                                 write(ioout, '(A, F13.4)', advance="no") " Cp, kJ/(kg-K)   ", &
-                                    (solutions(i, j, k)%eq_soln(idx)%cp_eq, idx=1,nc)
-                                write(ioout, '(F13.4)') (solutions(i, j, k)%eq_soln(idx)%cp_eq, idx=x,y)
+                                    (solutions(i, j, k)%eq_result(idx)%cp_eq, idx=1,nc)
+                                write(ioout, '(F13.4)') (solutions(i, j, k)%eq_result(idx)%cp_eq, idx=x,y)
 
                                 write(ioout, '(A, F13.3)', advance="no") " Conductivity    ", &
-                                    (solutions(i, j, k)%eq_soln(idx)%conductivity_eq, idx=1,nc)
-                                write(ioout, '(F13.3)') (solutions(i, j, k)%eq_soln(idx)%conductivity_eq, idx=x,y)
+                                    (solutions(i, j, k)%eq_result(idx)%conductivity_eq, idx=1,nc)
+                                write(ioout, '(F13.3)') (solutions(i, j, k)%eq_result(idx)%conductivity_eq, idx=x,y)
                             else
                                 write(ioout, '(A, F13.4)', advance="no") " Cp, cal/(g-K)   ", &
-                                    (solutions(i, j, k)%eq_soln(idx)%cp_eq/4.184d0, idx=1,nc)
-                                write(ioout, '(F13.4)') (solutions(i, j, k)%eq_soln(idx)%cp_eq/4.184d0, idx=x,y)
+                                    (solutions(i, j, k)%eq_result(idx)%cp_eq/4.184d0, idx=1,nc)
+                                write(ioout, '(F13.4)') (solutions(i, j, k)%eq_result(idx)%cp_eq/4.184d0, idx=x,y)
 
                                 write(ioout, '(A, F13.3)', advance="no") " Conductivity    ", &
-                                    (solutions(i, j, k)%eq_soln(idx)%conductivity_eq/4.184d0, idx=1,nc)
-                                write(ioout, '(F13.3)') (solutions(i, j, k)%eq_soln(idx)%conductivity_eq/4.184d0, idx=x,y)
+                                    (solutions(i, j, k)%eq_result(idx)%conductivity_eq/4.184d0, idx=1,nc)
+                                write(ioout, '(F13.3)') (solutions(i, j, k)%eq_result(idx)%conductivity_eq/4.184d0, idx=x,y)
                             end if
                             write(ioout, '(A, F13.4)', advance="no") " Prandtl Number  ", &
-                                (solutions(i, j, k)%eq_soln(idx)%Pr_eq, idx=1,nc)
-                            write(ioout, '(F13.4)') (solutions(i, j, k)%eq_soln(idx)%Pr_eq, idx=x,y)
+                                (solutions(i, j, k)%eq_result(idx)%Pr_eq, idx=1,nc)
+                            write(ioout, '(F13.4)') (solutions(i, j, k)%eq_result(idx)%Pr_eq, idx=x,y)
                             write(ioout, *) ""
 
                             ! Frozen properties
                             write(ioout, '(A)') " WITH FROZEN REACTIONS"
                             if (prob%output%siunit) then
                                 write(ioout, '(A, F13.4)', advance="no") " Cp, kJ/(kg-K)   ", &
-                                    (solutions(i, j, k)%eq_soln(idx)%cp_fr, idx=1,nc)
-                                write(ioout, '(F13.4)') (solutions(i, j, k)%eq_soln(idx)%cp_fr, idx=x,y)
+                                    (solutions(i, j, k)%eq_result(idx)%cp_fr, idx=1,nc)
+                                write(ioout, '(F13.4)') (solutions(i, j, k)%eq_result(idx)%cp_fr, idx=x,y)
 
                                 write(ioout, '(A, F13.3)', advance="no") " Conductivity    ", &
-                                    (solutions(i, j, k)%eq_soln(idx)%conductivity_fr, idx=1,nc)
-                                write(ioout, '(F13.3)') (solutions(i, j, k)%eq_soln(idx)%conductivity_fr, idx=x,y)
+                                    (solutions(i, j, k)%eq_result(idx)%conductivity_fr, idx=1,nc)
+                                write(ioout, '(F13.3)') (solutions(i, j, k)%eq_result(idx)%conductivity_fr, idx=x,y)
                             else
                                 write(ioout, '(A, F13.4)', advance="no") " Cp, cal/(g-K)   ", &
-                                    (solutions(i, j, k)%eq_soln(idx)%cp_fr/4.184d0, idx=1,nc)
-                                write(ioout, '(F13.4)') (solutions(i, j, k)%eq_soln(idx)%cp_fr/4.184d0, idx=x,y)
+                                    (solutions(i, j, k)%eq_result(idx)%cp_fr/4.184d0, idx=1,nc)
+                                write(ioout, '(F13.4)') (solutions(i, j, k)%eq_result(idx)%cp_fr/4.184d0, idx=x,y)
 
                                 write(ioout, '(A, F13.3)', advance="no") " Conductivity    ", &
-                                    (solutions(i, j, k)%eq_soln(idx)%conductivity_fr/4.184d0, idx=1,nc)
-                                write(ioout, '(F13.3)') (solutions(i, j, k)%eq_soln(idx)%conductivity_fr/4.184d0, idx=x,y)
+                                    (solutions(i, j, k)%eq_result(idx)%conductivity_fr/4.184d0, idx=1,nc)
+                                write(ioout, '(F13.3)') (solutions(i, j, k)%eq_result(idx)%conductivity_fr/4.184d0, idx=x,y)
                             end if
                             write(ioout, '(A, F13.4)', advance="no") " Prandtl Number  ", &
-                                (solutions(i, j, k)%eq_soln(idx)%Pr_fr, idx=1,nc)
-                            write(ioout, '(F13.4)') (solutions(i, j, k)%eq_soln(idx)%Pr_fr, idx=x,y)
+                                (solutions(i, j, k)%eq_result(idx)%Pr_fr, idx=1,nc)
+                            write(ioout, '(F13.4)') (solutions(i, j, k)%eq_result(idx)%Pr_fr, idx=x,y)
                             write(ioout, *) ""
 
                         end if
@@ -2643,13 +3505,13 @@ contains
                             is_trace(ii) = .true.
                             if (is_trace(ii) .eqv. .false.) exit
                             do idx = 1,nc  ! Check the chamber and throat conditions
-                                if (solutions(i, j, k)%eq_soln(idx)%mole_fractions(ii) > trace) then
+                                if (solutions(i, j, k)%eq_result(idx)%mole_fractions(ii) > trace) then
                                     is_trace(ii) = .false.
                                     exit
                                 end if
                             end do
                             do idx = x,y  ! Check the additional exit conditions
-                                if (solutions(i, j, k)%eq_soln(idx)%mole_fractions(ii) > trace) then
+                                if (solutions(i, j, k)%eq_result(idx)%mole_fractions(ii) > trace) then
                                     is_trace(ii) = .false.
                                     exit
                                 end if
@@ -2669,29 +3531,29 @@ contains
                             if (is_trace(ii) .eqv. .false.) then
                                 if (prob%output%mass_fractions) then
                                     if (frozen) then
-                                        if (solutions(i, j, k)%eq_soln(nfrz)%mass_fractions(ii) > trace) then
+                                        if (solutions(i, j, k)%eq_result(nfrz)%mass_fractions(ii) > trace) then
                                             write(ioout, '(1x, A, T19, F13.5)') &
                                                 trim(adjustl(solver%eq_solver%products%species_names(ii))), &
-                                                solutions(i, j, k)%eq_soln(nfrz)%mass_fractions(ii)
+                                                solutions(i, j, k)%eq_result(nfrz)%mass_fractions(ii)
                                         end if
                                     else
                                         write(ioout, '(1x, A, T19, 3(F13.5))', advance="no") &
                                             trim(adjustl(solver%eq_solver%products%species_names(ii))), &
-                                            (solutions(i, j, k)%eq_soln(idx)%mass_fractions(ii), idx=1,nc)
-                                        write(ioout, '(3(F13.5))') (solutions(i, j, k)%eq_soln(idx)%mass_fractions(ii), idx=x,y)
+                                            (solutions(i, j, k)%eq_result(idx)%mass_fractions(ii), idx=1,nc)
+                                        write(ioout, '(3(F13.5))') (solutions(i, j, k)%eq_result(idx)%mass_fractions(ii), idx=x,y)
                                     end if
                                 else
                                     if (frozen) then
-                                        if (solutions(i, j, k)%eq_soln(nfrz)%mole_fractions(ii) > trace) then
+                                        if (solutions(i, j, k)%eq_result(nfrz)%mole_fractions(ii) > trace) then
                                             write(ioout, '(1x, A, T19, F13.5)') &
                                                 trim(adjustl(solver%eq_solver%products%species_names(ii))), &
-                                                solutions(i, j, k)%eq_soln(nfrz)%mole_fractions(ii)
+                                                solutions(i, j, k)%eq_result(nfrz)%mole_fractions(ii)
                                         end if
                                     else
                                         write(ioout, '(1x, A, T19, 3(F13.5))', advance="no") &
                                             trim(adjustl(solver%eq_solver%products%species_names(ii))), &
-                                            (solutions(i, j, k)%eq_soln(idx)%mole_fractions(ii), idx=1,nc)
-                                        write(ioout, '(3(F13.5))') (solutions(i, j, k)%eq_soln(idx)%mole_fractions(ii), idx=x,y)
+                                            (solutions(i, j, k)%eq_result(idx)%mole_fractions(ii), idx=1,nc)
+                                        write(ioout, '(3(F13.5))') (solutions(i, j, k)%eq_result(idx)%mole_fractions(ii), idx=x,y)
                                     end if
                                 end if
                             end if
@@ -2720,6 +3582,370 @@ contains
 
     end subroutine
 
+    function case_name(prob) result(name)
+        ! Problem case name, or an empty string if none was given
+        type(ProblemDB), intent(in) :: prob
+        character(:), allocatable :: name
+        name = ''
+        if (allocated(prob%problem%name)) name = trim(prob%problem%name)
+    end function
+
+    subroutine add_eq_columns(table, products, mass_fractions, transport)
+        ! Declare the EqResult property and composition columns (see set_eq_columns)
+
+        ! Arguments
+        type(ColumnTable), intent(inout) :: table
+        type(Mixture), intent(in) :: products
+        logical, intent(in) :: mass_fractions
+        logical, intent(in) :: transport
+
+        ! Locals
+        integer :: idx
+        character(2) :: prefix
+
+        call table%add_int('converged')
+        call table%add_real('P')
+        call table%add_real('T')
+        call table%add_real('rho')
+        call table%add_real('H')
+        call table%add_real('U')
+        call table%add_real('G')
+        call table%add_real('S')
+        call table%add_real('M')
+        call table%add_real('MW')
+        call table%add_real('cp_eq')
+        call table%add_real('cp_fr')
+        call table%add_real('cv_eq')
+        call table%add_real('cv_fr')
+        if (transport) then
+            call table%add_real('viscosity')
+            call table%add_real('conductivity_eq')
+            call table%add_real('conductivity_fr')
+            call table%add_real('Pr_eq')
+            call table%add_real('Pr_fr')
+        end if
+
+        prefix = 'X:'
+        if (mass_fractions) prefix = 'Y:'
+        do idx = 1, products%num_species
+            call table%add_real(prefix//trim(adjustl(products%species_names(idx))))
+        end do
+
+    end subroutine
+
+    subroutine set_eq_columns(table, row, soln, mass_fractions, transport)
+        ! Fill one row of the columns declared by add_eq_columns (SI units: bar, K, kg/m^3, kJ/kg)
+
+        ! Arguments
+        type(ColumnTable), intent(inout) :: table
+        integer, intent(in) :: row
+        type(EqResult), intent(in) :: soln
+        logical, intent(in) :: mass_fractions
+        logical, intent(in) :: transport
+
+        ! Locals
+        integer :: c, k
+
+        c = table%find('converged')
+        table%columns(c)%i(row) = merge(1, 0, soln%converged)
+        table%columns(c+1)%r(row) = soln%pressure
+        table%columns(c+2)%r(row) = soln%T
+        table%columns(c+3)%r(row) = soln%density
+        table%columns(c+4)%r(row) = soln%enthalpy
+        table%columns(c+5)%r(row) = soln%energy
+        table%columns(c+6)%r(row) = soln%gibbs_energy
+        table%columns(c+7)%r(row) = soln%entropy
+        table%columns(c+8)%r(row) = 1.0d0/soln%n
+        table%columns(c+9)%r(row) = soln%MW
+        table%columns(c+10)%r(row) = soln%cp_eq
+        table%columns(c+11)%r(row) = soln%cp_fr
+        table%columns(c+12)%r(row) = soln%cv_eq
+        table%columns(c+13)%r(row) = soln%cv_fr
+        c = c + 14
+        if (transport) then
+            table%columns(c)%r(row) = soln%viscosity
+            table%columns(c+1)%r(row) = soln%conductivity_eq
+            table%columns(c+2)%r(row) = soln%conductivity_fr
+            table%columns(c+3)%r(row) = soln%Pr_eq
+            table%columns(c+4)%r(row) = soln%Pr_fr
+            c = c + 5
+        end if
+
+        do k = 1, size(soln%mole_fractions)
+            if (mass_fractions) then
+                table%columns(c+k-1)%r(row) = soln%mass_fractions(k)
+            else
+                table%columns(c+k-1)%r(row) = soln%mole_fractions(k)
+            end if
+        end do
+
+    end subroutine
+
+    subroutine thermo_columns(writer, num, prob, solver, results)
+        ! Write an equilibrium problem as a columnar table, one row per schedule point
+
+        ! Arguments
+        type(ColumnWriter), intent(inout) :: writer
+        integer, intent(in) :: num
+        type(ProblemDB), intent(in) :: prob
+        type(EqSolver), intent(in) :: solver
+        type(EqResult), intent(in) :: results(:, :, :)
+
+        ! Locals
+        type(ColumnTable) :: table
+        integer :: i, j, k, row, c
+        real(dp) :: of_ratio, pct_fuel, r_eq, phi_eq
+
+        table = ColumnTable(size(results))
+        call table%add_str('case', max(1, len(case_name(prob))))
+        call table%add_str('type', 3)
+        call table%add_int('i_state1')
+        call table%add_int('i_state2')
+        call table%add_int('i_of')
+        call table%add_real('of_ratio')
+        call table%add_real('pct_fuel')
+        call table%add_real('r_eq')
+        call table%add_real('phi_eq')
+        call table%add_real('dlnV_dlnP')
+        call table%add_real('dlnV_dlnT')
+        call table%add_real('gamma_s')
+        call table%add_real('sonic_velocity')
+        call add_eq_columns(table, solver%products, prob%output%mass_fractions, prob%output%transport)
+
+        row = 0
+        do k = 1, size(results, 3)
+            call compute_fuel_ratios(prob, solver%reactants, k, of_ratio, pct_fuel, r_eq, phi_eq)
+            do j = 1, size(results, 2)
+                do i = 1, size(results, 1)
+                    row = row + 1
+                    table%columns(1)%s(row) = case_name(prob)
+                    table%columns(2)%s(row) = prob%problem%type
+                    table%columns(3)%i(row) = i
+                    table%columns(4)%i(row) = j
+                    table%columns(5)%i(row) = k
+                    table%columns(6)%r(row) = of_ratio
+                    table%columns(7)%r(row) = pct_fuel
+                    table%columns(8)%r(row) = r_eq
+                    table%columns(9)%r(row) = phi_eq
+                    c = 10
+                    table%columns(c)%r(row) = results(i, j, k)%dlnV_dlnP
+                    table%columns(c+1)%r(row) = results(i, j, k)%dlnV_dlnT
+                    table%columns(c+2)%r(row) = results(i, j, k)%gamma_s
+                    table%columns(c+3)%r(row) = &
+                        sqrt(results(i, j, k)%n * R * results(i, j, k)%gamma_s * results(i, j, k)%T)
+                    call set_eq_columns(table, row, results(i, j, k), prob%output%mass_fractions, &
+                                        prob%output%transport)
+                end do
+            end do
+        end do
+
+        call writer%write_table('p'//to_str(num), table)
+
+    end subroutine
+
+    subroutine rocket_columns(writer, num, prob, solver, solutions, suffix)
+        ! Write a rocket problem as a columnar table, one row per station
+
+        ! Arguments
+        type(ColumnWriter), intent(inout) :: writer
+        integer, intent(in) :: num
+        type(ProblemDB), intent(in) :: prob
+        type(RocketSolver), intent(in) :: solver
+        type(RocketResult), intent(in) :: solutions(:, :, :)
+        character(*), intent(in), optional :: suffix  ! Appended to the table name
+
+        ! Locals
+        type(ColumnTable) :: table
+        integer :: i, j, k, s, row, num_rows
+        real(dp) :: of_ratio, pct_fuel, r_eq, phi_eq
+
+        num_rows = sum(solutions%num_pts)
+        table = ColumnTable(num_rows)
+        call table%add_str('case', max(1, len(case_name(prob))))
+        call table%add_int('i_pc')
+        call table%add_int('i_of')
+        call table%add_int('frozen')
+        call table%add_str('station', 8)
+        call table%add_real('of_ratio')
+        call table%add_real('pct_fuel')
+        call table%add_real('r_eq')
+        call table%add_real('phi_eq')
+        call table%add_real('mach')
+        call table%add_real('gamma_s')
+        call table%add_real('sonic_velocity')
+        call table%add_real('ae_at')
+        call table%add_real('c_star')
+        call table%add_real('cf')
+        call table%add_real('i_vac')
+        call table%add_real('i_sp')
+        call add_eq_columns(table, solver%eq_solver%products, prob%output%mass_fractions, prob%output%transport)
+
+        row = 0
+        do k = 1, size(solutions, 3)
+            do j = 1, size(solutions, 2)
+                call compute_fuel_ratios(prob, solver%eq_solver%reactants, j, of_ratio, pct_fuel, r_eq, phi_eq)
+                do i = 1, size(solutions, 1)
+                    associate(soln => solutions(i, j, k))
+                        do s = 1, soln%num_pts
+                            row = row + 1
+                            table%columns(1)%s(row) = case_name(prob)
+                            table%columns(2)%i(row) = i
+                            table%columns(3)%i(row) = j
+                            table%columns(4)%i(row) = merge(1, 0, k == 2 .or. &
+                                (.not. prob%problem%equilibrium .and. prob%problem%frozen))
+                            table%columns(5)%s(row) = soln%station(s)
+                            table%columns(6)%r(row) = of_ratio
+                            table%columns(7)%r(row) = pct_fuel
+                            table%columns(8)%r(row) = r_eq
+                            table%columns(9)%r(row) = phi_eq
+                            table%columns(10)%r(row) = soln%mach(s)
+                            table%columns(11)%r(row) = soln%eq_result(s)%gamma_s
+                            table%columns(12)%r(row) = soln%v_sonic(s)
+                            table%columns(13)%r(row) = soln%ae_at(s)
+                            table%columns(14)%r(row) = soln%c_star(s)
+                            table%columns(15)%r(row) = soln%cf(s)
+                            table%columns(16)%r(row) = soln%i_vac(s)
+                            table%columns(17)%r(row) = soln%i_sp(s)
+                            call set_eq_columns(table, row, soln%eq_result(s), prob%output%mass_fractions, &
+                                                prob%output%transport)
+                        end do
+                    end associate
+                end do
+            end do
+        end do
+
+        if (present(suffix)) then
+            call writer%write_table('p'//to_str(num)//suffix, table)
+        else
+            call writer%write_table('p'//to_str(num), table)
+        end if
+
+    end subroutine
+
+    subroutine shock_columns(writer, num, prob, solver, solutions)
+        ! Write a shock problem as a columnar table, one row per shock point
+
+        ! Arguments
+        type(ColumnWriter), intent(inout) :: writer
+        integer, intent(in) :: num
+        type(ProblemDB), intent(in) :: prob
+        type(ShockSolver), intent(in) :: solver
+        type(ShockResult), intent(in) :: solutions(:, :, :)
+
+        ! Locals
+        type(ColumnTable) :: table
+        integer :: i, j, k, s, row, num_rows
+
+        num_rows = sum(solutions%num_pts)
+        table = ColumnTable(num_rows)
+        call table%add_str('case', max(1, len(case_name(prob))))
+        call table%add_int('i_u1')
+        call table%add_int('i_case')
+        call table%add_int('point')
+        call table%add_real('mach')
+        call table%add_real('u')
+        call table%add_real('sonic_velocity')
+        call add_eq_columns(table, solver%eq_solver%products, prob%output%mass_fractions, prob%output%transport)
+
+        row = 0
+        do k = 1, size(solutions, 3)
+            do j = 1, size(solutions, 2)
+                do i = 1, size(solutions, 1)
+                    associate(soln => solutions(i, j, k))
+                        do s = 1, soln%num_pts
+                            row = row + 1
+                            table%columns(1)%s(row) = case_name(prob)
+                            table%columns(2)%i(row) = i
+                            table%columns(3)%i(row) = k
+                            table%columns(4)%i(row) = s
+                            table%columns(5)%r(row) = soln%mach(s)
+                            table%columns(6)%r(row) = soln%u(s)
+                            table%columns(7)%r(row) = soln%v_sonic(s)
+                            call set_eq_columns(table, row, soln%eq_result(s), prob%output%mass_fractions, &
+                                                prob%output%transport)
+                            ! Shock pressures are tracked on the ShockSolution
+                            table%columns(table%find('P'))%r(row) = soln%pressure(s)
+                        end do
+                    end associate
+                end do
+            end do
+        end do
+
+        call writer%write_table('p'//to_str(num), table)
+
+    end subroutine
+
+    subroutine deton_columns(writer, num, prob, solver, solutions)
+        ! Write a detonation problem as a columnar table, one row per schedule point
+
+        ! Arguments
+        type(ColumnWriter), intent(inout) :: writer
+        integer, intent(in) :: num
+        type(ProblemDB), intent(in) :: prob
+        type(DetonSolver), intent(in) :: solver
+        type(DetonResult), intent(in) :: solutions(:, :, :)
+
+        ! Locals
+        type(ColumnTable) :: table
+        integer :: i, j, k, row
+
+        table = ColumnTable(size(solutions))
+        call table%add_str('case', max(1, len(case_name(prob))))
+        call table%add_int('i_T')
+        call table%add_int('i_P')
+        call table%add_int('i_of')
+        call table%add_real('P1')
+        call table%add_real('T1')
+        call table%add_real('H1')
+        call table%add_real('M1')
+        call table%add_real('gamma1')
+        call table%add_real('sonic_velocity1')
+        call table%add_real('P_P1')
+        call table%add_real('T_T1')
+        call table%add_real('M_M1')
+        call table%add_real('rho_rho1')
+        call table%add_real('mach')
+        call table%add_real('velocity')
+        call table%add_real('sonic_velocity')
+        call table%add_real('gamma_s')
+        call add_eq_columns(table, solver%eq_solver%products, prob%output%mass_fractions, prob%output%transport)
+
+        row = 0
+        do k = 1, size(solutions, 3)
+            do j = 1, size(solutions, 2)
+                do i = 1, size(solutions, 1)
+                    row = row + 1
+                    associate(soln => solutions(i, j, k))
+                        table%columns(1)%s(row) = case_name(prob)
+                        table%columns(2)%i(row) = i
+                        table%columns(3)%i(row) = j
+                        table%columns(4)%i(row) = k
+                        table%columns(5)%r(row) = soln%P1
+                        table%columns(6)%r(row) = soln%T1
+                        table%columns(7)%r(row) = soln%H1
+                        table%columns(8)%r(row) = soln%M1
+                        table%columns(9)%r(row) = soln%gamma1
+                        table%columns(10)%r(row) = soln%v_sonic1
+                        table%columns(11)%r(row) = soln%P_P1
+                        table%columns(12)%r(row) = soln%T_T1
+                        table%columns(13)%r(row) = soln%M_M1
+                        table%columns(14)%r(row) = soln%rho_rho1
+                        table%columns(15)%r(row) = soln%mach
+                        table%columns(16)%r(row) = soln%velocity
+                        table%columns(17)%r(row) = soln%sonic_velocity
+                        table%columns(18)%r(row) = soln%gamma
+                        call set_eq_columns(table, row, soln%eq_result, prob%output%mass_fractions, &
+                                            prob%output%transport)
+                    end associate
+                end do
+            end do
+        end do
+
+        call writer%write_table('p'//to_str(num), table)
+
+    end subroutine
+
+
     subroutine compute_fuel_ratios(prob, reactants, idx, of_ratio, pct_fuel, r_eq, phi_eq)
         ! Compute all of the fuel ratio values (o/f ratio, % fuel, r eq. ratio, phi eq. ratio) at once
 
@@ -2851,15 +4077,15 @@ contains
 
     end subroutine
 
-    function get_eq_species_format(solutions, idx, k, m, n, mass_frac) result(eq_fmt)
+    function get_eq_species_format(results, idx, k, m, n, mass_frac) result(eq_fmt)
         ! Write out the line formatting string for mole or mass fraction output
 
         ! Arguments
-        type(EqSolution), intent(in) :: solutions(:, :, :)
-        integer, intent(in) :: idx  ! Value of index 3 of solutions
+        type(EqResult), intent(in) :: results(:, :, :)
+        integer, intent(in) :: idx  ! Value of index 3 of results
         integer, intent(in) :: k  ! o/f ratio index
-        integer, intent(in) :: m  ! Size of index 1 of solutions
-        integer, intent(in) :: n  ! Size of index 2 of solutions
+        integer, intent(in) :: m  ! Size of index 1 of results
+        integer, intent(in) :: n  ! Size of index 2 of results
         logical, intent(in) :: mass_frac  ! If true, use mass fractions; if false, use mole fractions
 
         ! Result
@@ -2874,9 +4100,9 @@ contains
         do j = 1, n
             do i = 1, m
                 if (mass_frac) then
-                    amount = solutions(i, j, k)%mass_fractions(idx)
+                    amount = results(i, j, k)%mass_fractions(idx)
                 else
-                    amount = solutions(i, j, k)%mole_fractions(idx)
+                    amount = results(i, j, k)%mole_fractions(idx)
                 end if
 
                 if (amount > 1.d-3 .or. amount < 1.d-20) then
@@ -2896,7 +4122,7 @@ contains
         ! Write out the line formatting string for mole or mass fraction output
 
         ! Arguments
-        type(RocketSolution), intent(in) :: solutions(:, :, :)
+        type(RocketResult), intent(in) :: solutions(:, :, :)
         integer, intent(in) :: idx ! Species index
         integer, intent(in) :: i  ! index 1 of solutions
         integer, intent(in) :: j  ! index 2 of solutions
@@ -2929,9 +4155,9 @@ contains
         spec_fmt = '(1x, A, T19'
         if (frozen_) then
             if (mass_frac) then
-                amount = solutions(i, j, k)%eq_soln(nfrz_)%mass_fractions(idx)
+                amount = solutions(i, j, k)%eq_result(nfrz_)%mass_fractions(idx)
             else
-                amount = solutions(i, j, k)%eq_soln(nfrz_)%mole_fractions(idx)
+                amount = solutions(i, j, k)%eq_result(nfrz_)%mole_fractions(idx)
             end if
 
             if (amount > 1.d-3 .or. amount < 1.d-20) then
@@ -2944,9 +4170,9 @@ contains
         else
             do ii = 1, np
                 if (mass_frac) then
-                    amount = solutions(i, j, k)%eq_soln(ii)%mass_fractions(idx)
+                    amount = solutions(i, j, k)%eq_result(ii)%mass_fractions(idx)
                 else
-                    amount = solutions(i, j, k)%eq_soln(ii)%mole_fractions(idx)
+                    amount = solutions(i, j, k)%eq_result(ii)%mole_fractions(idx)
                 end if
 
                 if (amount > 1.d-3 .or. amount < 1.d-20) then
@@ -2966,7 +4192,7 @@ contains
         ! Write out the line formatting string for mole or mass fraction output
 
         ! Arguments
-        type(ShockSolution), intent(in) :: solutions(:, :, :)
+        type(ShockResult), intent(in) :: solutions(:, :, :)
         integer, intent(in) :: idx ! Species index
         integer, intent(in) :: j  ! Should be fixed = 1
         integer, intent(in) :: k  ! eql/frozen index
@@ -2985,9 +4211,9 @@ contains
         spec_fmt = '(1x, A, T18'
         do i = 1, m
             if (mass_frac) then
-                amount = solutions(i, j, k)%eq_soln(n)%mass_fractions(idx)
+                amount = solutions(i, j, k)%eq_result(n)%mass_fractions(idx)
             else
-                amount = solutions(i, j, k)%eq_soln(n)%mole_fractions(idx)
+                amount = solutions(i, j, k)%eq_result(n)%mole_fractions(idx)
             end if
 
             if (amount > 1.d-3 .or. amount < 1.d-20) then
@@ -3006,7 +4232,7 @@ contains
         ! Write out the line formatting string for mole or mass fraction output
 
         ! Arguments
-        type(DetonSolution), intent(in) :: solutions(:, :, :)
+        type(DetonResult), intent(in) :: solutions(:, :, :)
         integer, intent(in) :: idx  ! Value of index 3 of solutions
         integer, intent(in) :: k  ! o/f ratio index
         integer, intent(in) :: m  ! Size of index 1 of solutions
@@ -3025,9 +4251,9 @@ contains
         do j = 1, n
             do i = 1, m
                 if (mass_frac) then
-                    amount = solutions(i, j, k)%eq_soln%mass_fractions(idx)
+                    amount = solutions(i, j, k)%eq_result%mass_fractions(idx)
                 else
-                    amount = solutions(i, j, k)%eq_soln%mole_fractions(idx)
+                    amount = solutions(i, j, k)%eq_result%mole_fractions(idx)
                 end if
 
                 if (amount > 1.d-3 .or. amount < 1.d-20) then
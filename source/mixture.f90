@@ -3,13 +3,14 @@ module cea_mixture
 
     use cea_param, snl=>species_name_len, &
                    enl=>element_name_len
-    use cea_thermo, only: ThermoDB, SpeciesThermo, build_elem_list
+    use cea_thermo, only: ThermoDB, SpeciesThermo, build_elem_list, elem_mask_words
     use cea_input, only: Formula, ReactantInput
     use cea_atomic_data, only: get_atom_valence, get_atom_weight
     use cea_units, only: convert_units_to_si
     use iso_c_binding
+    use iso_fortran_env, only: int64
     use fb_findloc, only: findloc
-    use fb_utils, only: abort, is_empty
+    use fb_utils, only: abort, assert, is_empty
     implicit none
 
 
@@ -42,6 +43,8 @@ module cea_mixture
         ! TODO: Add null terminators to names so they can be used in the C API
         character(snl), allocatable :: species_names(:)
             !! Names of species in the mixture
+        integer, allocatable :: species_ids(:)
+            !! ThermoDB species IDs of the species (0 for a reactant not in the database)
         character(enl), allocatable :: element_names(:)
             !! Names of elements in the mixture
 
@@ -52,7 +55,9 @@ module cea_mixture
     contains
         procedure :: elements_from_species => mixture_elements_from_species
         procedure :: calc_thermo => mixture_calc_thermo
+        procedure :: update_thermo => mixture_update_thermo
         procedure :: get_products => mixture_get_products
+        procedure :: get_product_ids => mixture_get_product_ids
         procedure :: weights_from_of => mixture_weights_from_of
         procedure :: of_from_equivalence => mixture_chem_eq_ratio_to_of_ratio
         procedure :: equivalence_from_of => mixture_of_ratio_to_chem_eq_ratio
@@ -64,6 +69,7 @@ module cea_mixture
         procedure :: per_mole_from_per_weight => mixture_per_mole_from_per_weight
         procedure :: get_valence => mixture_get_valence
         procedure :: element_amounts_from_weights => mixture_element_amounts_from_weights
+        procedure :: set_species_enthalpy => mixture_set_species_enthalpy
 
         generic   :: calc_enthalpy     => mixture_calc_enthalpy_single, &
                                           mixture_calc_enthalpy_multi
@@ -110,18 +116,64 @@ module cea_mixture
             !! Mixture entropy
         real(dp), allocatable :: energy(:)
             !! Mixture internal energy
+        real(dp) :: T_gas = empty_dp
+            !! Temperature at which the gas entries were last evaluated
+        real(dp) :: T_condensed = empty_dp
+            !! Temperature at which the condensed entries were last evaluated
     end type
     interface MixtureThermo
         module procedure :: mixturethermo_init
     end interface
 
+    !-----------------------------------------------------------------------
+    ! ProductCache
+    !-----------------------------------------------------------------------
+    type :: ProductListEntry
+        !! Cached product list for one reactant element set and omit list
+        integer(int64) :: element_mask(elem_mask_words) = 0_int64
+            !! Reactant element bitmask
+        integer, allocatable :: omit_ids(:)
+            !! Omitted product IDs
+        integer, allocatable :: product_ids(:)
+            !! Resulting product IDs
+        integer :: last_used = 0
+            !! Cache clock value at the last lookup (for LRU eviction)
+    end type
+
+    type :: ProductCache
+        !! Cache of mixture_get_product_ids results
+        !!
+        !! Entries are only valid for the ThermoDB they were built from;
+        !! call clear() after loading a different database.
+        integer :: max_entries = 32
+            !! Maximum number of stored lists; least recently used are evicted
+        integer :: num_entries = 0
+            !! Number of lists currently stored
+        type(ProductListEntry), allocatable :: entries(:)
+            !! Entry storage (max_entries)
+        integer :: clock = 0
+            !! Monotonic counter used to timestamp lookups
+        integer :: num_hits = 0
+            !! Lookups answered from the cache
+        integer :: num_misses = 0
+            !! Lookups that scanned the ThermoDB
+    contains
+        procedure :: lookup => ProductCache_lookup
+        procedure :: store => ProductCache_store
+        procedure :: clear => ProductCache_clear
+    end type
+    interface ProductCache
+        module procedure :: ProductCache_init
+    end interface
+
 contains
 
     !-----------------------------------------------------------------------
     ! Mixture Implementation
     !-----------------------------------------------------------------------
     recursive function mixture_init(thermo, species_names, element_names, reactant_names, &
-        input_reactants, omitted_product_names, sort_condensed, ions) result(self)
+        input_reactants, omitted_product_names, sort_condensed, ions, product_cache, &
+        species_ids, reactant_ids, omitted_product_ids) result(self)
         ! Create a Mixture from a subset of species in a ThermoDB
         ! If element_names is specified, it must be a superset of elements in species_names
         ! This allows constructing multiple Mixtures with consistent element lists
@@ -138,6 +190,10 @@ contains
         character(*), intent(in), optional :: omitted_product_names(:)
         logical, intent(in), optional :: sort_condensed
         logical, intent(in), optional :: ions
+        type(ProductCache), intent(inout), optional :: product_cache
+        integer, intent(in), optional :: species_ids(:)   ! ThermoDB species IDs, in place of species_names
+        integer, intent(in), optional :: reactant_ids(:)  ! ThermoDB species IDs, in place of reactant_names
+        integer, intent(in), optional :: omitted_product_ids(:)  ! ThermoDB species IDs, in place of omitted_product_names
 
         ! Result
         type(Mixture) :: self
@@ -145,6 +201,7 @@ contains
         ! Locals
         logical :: sort_condensed_
         logical, allocatable :: found_db(:)
+        integer, allocatable :: ids(:)
         integer :: i, j, k, ns
         character(enl), allocatable :: enames(:,:)
         character(snl), allocatable :: slist(:)
@@ -172,23 +229,41 @@ contains
                 end do
                 slist = names
             end block
+        else if (present(species_ids)) then
+            ids = species_ids
         else if (present(reactant_names)) then
             reactants = Mixture(thermo, reactant_names, ions=ions)
-            slist = reactants%get_products(thermo, omitted_product_names)
+            ids = reactants%get_product_ids(thermo, omitted_product_names, product_cache, omitted_product_ids)
+        else if (present(reactant_ids)) then
+            reactants = Mixture(thermo, species_ids=reactant_ids, ions=ions)
+            ids = reactants%get_product_ids(thermo, omitted_product_names, product_cache, omitted_product_ids)
         else
             call abort("Must specify either species_names or reactant_names")
         end if
 
+        ! Species given by ID need no name search
+        if (allocated(ids)) slist = [(thermo%species_name(ids(i)), i = 1, size(ids))]
+
         ! Populate the species data
         ns = size(slist)
         if (ns == 0) then
             call abort('mixture_init: empty species list')
         end if
-        allocate(self%species(ns))
+        allocate(self%species(ns), self%species_ids(ns))
         allocate(found_db(ns))
         do i = 1,ns
-            self%species(i) = get_species(thermo, slist(i), found_db(i))
-            if (.not. found_db(i)) then
+            if (allocated(ids)) then
+                self%species_ids(i) = ids(i)
+            else if (present(input_reactants)) then
+                self%species_ids(i) = input_reactants(i)%id
+                if (self%species_ids(i) == 0) self%species_ids(i) = thermo%species_id(slist(i))
+            else
+                self%species_ids(i) = thermo%species_id(slist(i))
+            end if
+            found_db(i) = (self%species_ids(i) > 0)
+            if (found_db(i)) then
+                self%species(i) = thermo%species_by_id(self%species_ids(i))
+            else
                 self%species(i)%name = slist(i)
                 self%species(i)%i_phase = 0
                 self%species(i)%num_intervals = 0
@@ -218,6 +293,10 @@ contains
                 pack(self%species_names, .not. self%is_condensed), &
                 pack(self%species_names,       self%is_condensed)  &
             ]
+            self%species_ids = [ &
+                pack(self%species_ids, .not. self%is_condensed), &
+                pack(self%species_ids,       self%is_condensed)  &
+            ]
             self%is_condensed = self%species%is_condensed()
         end if
 
@@ -399,80 +478,104 @@ contains
                 thermo%entropy(ng+n)  = self%species(ng+n)%calc_entropy(temperature)
                 thermo%energy(ng+n)   = self%species(ng+n)%calc_energy(temperature)/temperature
             end do
+            thermo%T_condensed = temperature
         end if
+        thermo%T_gas = temperature
 
     end subroutine
 
-    function mixture_get_products(self, thermo, omit) result(product_names)
+    subroutine mixture_update_thermo(self, thermo, temperature, condensed)
+        ! Same as calc_thermo, but skips the work if the entries were already
+        ! evaluated at this temperature. thermo must only be used with this mixture.
+        class(Mixture), intent(in) :: self
+        type(MixtureThermo), intent(inout) :: thermo
+        real(dp), intent(in) :: temperature
+        logical, intent(in), optional :: condensed
+
+        ! Locals
+        logical :: condensed_
+
+        condensed_ = .true.
+        if (present(condensed)) condensed_ = condensed
+
+        if (self%num_species == thermo%num_species .and. thermo%T_gas == temperature) then
+            if (.not. condensed_ .or. thermo%T_condensed == temperature) return
+        end if
+        call self%calc_thermo(thermo, temperature, condensed_)
+
+    end subroutine
+
+    function mixture_get_products(self, thermo, omit, cache) result(product_names)
         ! Get the list of possible products from the reactants
 
         ! Arguments
         class(Mixture), intent(in) :: self
         type(ThermoDB), intent(in) :: thermo
         character(*), intent(in), optional :: omit(:)
+        type(ProductCache), intent(inout), optional :: cache
 
         ! Return
         character(snl), allocatable :: product_names(:)
 
+        product_names = thermo%product_name_list(self%get_product_ids(thermo, omit, cache))
+
+    end function
+
+    function mixture_get_product_ids(self, thermo, omit, cache, omit_ids) result(product_ids)
+        ! Get the ThermoDB species IDs of the possible products from the reactants
+
+        ! Arguments
+        class(Mixture), intent(in) :: self
+        type(ThermoDB), intent(in) :: thermo
+        character(*), intent(in), optional :: omit(:)
+        type(ProductCache), intent(inout), optional :: cache
+        integer, intent(in), optional :: omit_ids(:)  ! ThermoDB species IDs, in addition to omit
+
+        ! Return
+        integer, allocatable :: product_ids(:)
+
         ! Locals
-        integer :: n, i, j, idx(1), np
-        logical :: is_omitted, is_product
-        real(dp), parameter :: tol = 1.d-10
+        integer :: n, i, np
+        integer(int64) :: mask(elem_mask_words)      ! Reactant elements
+        integer(int64) :: excluded(elem_mask_words)  ! Elements not in the reactants
+        integer, allocatable :: omit_(:)
 
+        ! Omitted names are resolved once; names not in the database omit nothing
         if (present(omit)) then
             call check_name_list_len(omit, snl, 'mixture_get_products omit')
+            allocate(omit_(size(omit)))
+            do i = 1, size(omit)
+                omit_(i) = thermo%species_id(omit(i))
+            end do
+            omit_ = pack(omit_, omit_ > 0)
+        else
+            allocate(omit_(0))
         end if
+        if (present(omit_ids)) omit_ = [omit_, omit_ids]
 
-        np = thermo%num_products
+        mask = thermo%element_mask(self%element_names)
+        excluded = not(mask)
 
-        allocate(product_names(np))
+        if (present(cache)) then
+            if (cache%lookup(mask, omit_, product_ids)) return
+        end if
 
-        ! Get the list of possible products from the elements
+        np = thermo%num_products
+        allocate(product_ids(np))
+
+        ! A product is possible if its formula has no element outside the reactants
+        ! Product IDs are the first num_products species IDs
         n = 0
         do i = 1, np
-            if (.not. allocated(thermo%product_thermo(i)%formula)) then
-                call abort('mixture_get_products: missing formula for product '//trim(thermo%product_name_list(i)))
-            end if
-            if (.not. allocated(thermo%product_thermo(i)%formula%elements)) then
-                call abort('mixture_get_products: missing formula elements for product '//trim(thermo%product_name_list(i)))
-            end if
-            if (.not. allocated(thermo%product_thermo(i)%formula%coefficients)) then
-                call abort('mixture_get_products: missing formula coefficients for product '//trim(thermo%product_name_list(i)))
-            end if
-            if (size(thermo%product_thermo(i)%formula%elements) /= &
-                size(thermo%product_thermo(i)%formula%coefficients)) then
-                call abort('mixture_get_products: formula element/coeff size mismatch for product '// &
-                           trim(thermo%product_name_list(i)))
-            end if
-            ! Exclude "omit" names
-            ! TODO: pop omit name every time it is found to speed up search
-            if (present(omit)) then
-                call check_name_list_len(omit, snl, 'mixture_get_products omit')
-                is_omitted = .false.
-                do j = 1, size(omit)
-                    if (names_match(thermo%product_name_list(i), omit(j))) then
-                        is_omitted = .true.
-                        exit
-                    end if
-                end do
-                if (is_omitted) cycle
-            end if
-
-            ! Check that all elements in this species formula are in the reactant element list
-            is_product = .true.
-            do j = 1, size(thermo%product_thermo(i)%formula%elements)
-                if (abs(thermo%product_thermo(i)%formula%coefficients(j)) < tol) cycle
-                idx = findloc(self%element_names, thermo%product_thermo(i)%formula%elements(j))
-                if (idx(1) == 0) is_product = .false.
-            end do
-
-            if (is_product) then
-                n = n + 1
-                product_names(n) = thermo%product_name_list(i)
-            end if
+            if (any(iand(thermo%product_thermo(i)%element_mask, excluded) /= 0_int64)) cycle
+            if (any(omit_ == i)) cycle
+            n = n + 1
+            product_ids(n) = i
         end do
 
-        product_names = product_names(:n)
+        product_ids = product_ids(:n)
+
+        if (present(cache)) call cache%store(mask, omit_, product_ids)
 
     end function
 
@@ -1146,6 +1249,24 @@ contains
 
     end function
 
+    subroutine mixture_set_species_enthalpy(self, idx, h)
+        ! Fix the enthalpy of species idx at h (J/mol) for all temperatures,
+        ! discarding its thermo fits. Used for assigned reactant enthalpies.
+
+        ! Arguments
+        class(Mixture), intent(inout) :: self
+        integer, intent(in) :: idx
+        real(dp), intent(in) :: h
+
+        call assert(idx >= 1 .and. idx <= self%num_species, 'mixture_set_species_enthalpy: invalid species index')
+
+        self%species(idx)%enthalpy_ref = h
+        self%species(idx)%num_intervals = 0
+        if (allocated(self%species(idx)%T_fit)) deallocate(self%species(idx)%T_fit)
+        if (allocated(self%species(idx)%fits)) deallocate(self%species(idx)%fits)
+
+    end subroutine
+
     function molecular_weight_from_formula(fm) result(molecular_weight)
         ! Compute the molecular weight of a species based on its chemical formula
 
@@ -1183,6 +1304,73 @@ contains
         allocate(self%energy(num_species), source=empty_dp)
     end function
 
+    !-----------------------------------------------------------------------
+    ! ProductCache Implementation
+    !-----------------------------------------------------------------------
+    function ProductCache_init(max_entries) result(self)
+        integer, intent(in), optional :: max_entries
+        type(ProductCache) :: self
+        if (present(max_entries)) self%max_entries = max_entries
+        call assert(self%max_entries > 0, 'ProductCache_init: max_entries must be positive')
+    end function
+
+    subroutine ProductCache_clear(self)
+        ! Drop all stored lists, keeping the statistics
+        class(ProductCache), intent(inout) :: self
+        if (allocated(self%entries)) deallocate(self%entries)
+        self%num_entries = 0
+        self%clock = 0
+    end subroutine
+
+    function ProductCache_lookup(self, element_mask, omit_ids, product_ids) result(found)
+        ! Return the stored product list for a reactant element mask and omit list
+        class(ProductCache), intent(inout) :: self
+        integer(int64), intent(in) :: element_mask(:)
+        integer, intent(in) :: omit_ids(:)
+        integer, allocatable, intent(inout) :: product_ids(:)
+        logical :: found
+        integer :: i
+
+        found = .false.
+        self%clock = self%clock + 1
+        do i = 1, self%num_entries
+            associate(entry => self%entries(i))
+                if (any(entry%element_mask /= element_mask)) cycle
+                if (size(entry%omit_ids) /= size(omit_ids)) cycle
+                if (any(entry%omit_ids /= omit_ids)) cycle
+                entry%last_used = self%clock
+                product_ids = entry%product_ids
+            end associate
+            found = .true.
+            self%num_hits = self%num_hits + 1
+            return
+        end do
+        self%num_misses = self%num_misses + 1
+    end function
+
+    subroutine ProductCache_store(self, element_mask, omit_ids, product_ids)
+        ! Add a product list, evicting the least recently used entry when full
+        class(ProductCache), intent(inout) :: self
+        integer(int64), intent(in) :: element_mask(:)
+        integer, intent(in) :: omit_ids(:)
+        integer, intent(in) :: product_ids(:)
+        integer :: i
+
+        if (.not. allocated(self%entries)) allocate(self%entries(self%max_entries))
+
+        if (self%num_entries < self%max_entries) then
+            self%num_entries = self%num_entries + 1
+            i = self%num_entries
+        else
+            i = minloc(self%entries(:self%num_entries)%last_used, 1)
+        end if
+
+        self%entries(i)%element_mask = element_mask
+        self%entries(i)%omit_ids = omit_ids
+        self%entries(i)%product_ids = product_ids
+        self%entries(i)%last_used = self%clock
+    end subroutine
+
     !-----------------------------------------------------------------------
     ! Helper Functions
     !-----------------------------------------------------------------------
@@ -1217,58 +1405,4 @@ contains
         end if
     end subroutine
 
-    function get_species(thermo, name, found) result(species)
-        ! Search a ThermoDB for a species of a given name
-        ! Linear search for now. Lots of opportunities to be smarter
-        ! TODO: Make this a method on the ThermoDB
-
-        ! Arguments
-        type(ThermoDB), intent(in), target :: thermo
-        character(*), intent(in) :: name
-        logical, intent(out), optional :: found
-
-        ! Return
-        type(SpeciesThermo) :: species
-
-        ! Locals
-        type(SpeciesThermo), pointer :: candidate
-        integer :: i
-
-        if (present(found)) found = .false.
-
-        ! Search products
-        do i = 1,thermo%num_products
-            candidate => thermo%product_thermo(i)
-            if (names_match(name, candidate%name)) then
-                species = candidate
-                if (present(found)) found = .true.
-                return
-            end if
-        end do
-
-        ! Reactant search
-        do i = 1,thermo%num_reactants
-            candidate => thermo%reactant_thermo(i)
-            if (names_match(name, candidate%name)) then
-                species = candidate
-                if (present(found)) found = .true.
-                return
-            end if
-        end do
-
-        ! call log_info('Species '//trim(name)//' not found in ThermoDB')
-
-    end function
-
-    logical function names_match(name, dbname)
-        ! Check if species name matches database entry
-        ! TODO: Remove name decorations in ThermoDB
-        character(*), intent(in) :: name, dbname
-        if (dbname(1:1) == '*') then
-            names_match = (name == dbname(2:))
-        else
-            names_match = (name == dbname)
-        end if
-    end function
-
 end module
@@ -0,0 +1,504 @@
+module cea_optimize
+    !! Mixture ratio optimization of rocket performance
+    !!
+    !! An OfOptimizer finds the oxidant-to-fuel weight ratio that maximizes the
+    !! specific impulse, vacuum specific impulse, or characteristic velocity of a
+    !! rocket problem within a bracket [of_min, of_max]. The unconstrained optimum
+    !! is found with Brent's method (golden section search with parabolic steps).
+    !! Temperature caps at any station are then enforced by moving to the nearest
+    !! feasible constraint boundary on either side of the optimum, located with a
+    !! safeguarded Newton iteration. For a chamber cap the Newton slope is
+    !!
+    !!     dTc/d(o/f) = dT/dw0 . dw/d(o/f) + dT/dh0 dh0/d(o/f)
+    !!
+    !! from EqDerivatives and Mixture%weights_from_of; other stations use secant
+    !! slopes. Every solve starts from the chamber temperature of the nearest
+    !! mixture ratio evaluated so far.
+
+    use cea_param, only: dp, R=>gas_constant
+    use cea_mixture, only: Mixture
+    use cea_equilibrium, only: EqDerivatives, deriv_T, deriv_wrt_state1, deriv_wrt_w0, output_performance
+    use cea_rocket, only: RocketSolver, RocketSolution
+    use fb_logging
+    use fb_utils
+    implicit none
+
+    ! Objectives
+    integer, parameter :: of_opt_isp = 0
+    integer, parameter :: of_opt_ivac = 1
+    integer, parameter :: of_opt_cstar = 2
+
+    type :: OfConstraint
+        !! Upper bound on the temperature at one station
+        integer :: station = 1
+            !! Station index; 1 is the chamber (injector for a finite-area combustor)
+        real(dp) :: T_max = huge(1.0d0)
+            !! Largest allowed temperature [K]
+    end type
+
+    type :: OfOptimizer
+        !! Mixture ratio optimizer
+
+        ! Settings
+        integer :: objective = of_opt_isp
+            !! Maximized quantity at the last station: of_opt_isp, of_opt_ivac, or of_opt_cstar
+        real(dp) :: of_tolerance = 1.0d-4
+            !! Relative tolerance on the optimal mixture ratio
+        real(dp) :: T_tolerance = 0.5d0
+            !! Tolerance on an active temperature cap [K]
+        integer :: max_solves = 60
+            !! Largest number of rocket solves per run
+        type(OfConstraint), allocatable :: constraints(:)
+            !! Temperature caps
+
+        ! Results
+        real(dp) :: of_ratio = 0.0d0
+            !! Optimal mixture ratio
+        real(dp) :: value = 0.0d0
+            !! Objective at the optimal mixture ratio
+        integer :: num_solves = 0
+            !! Number of rocket solves in the last run
+        logical :: constrained = .false.
+            !! True if a temperature cap is active at the optimum
+        logical :: converged = .false.
+            !! True if a feasible optimum was found within max_solves
+        type(RocketSolution) :: solution
+            !! Rocket solution at the optimal mixture ratio
+
+        ! Evaluated points of the last run
+        real(dp), allocatable :: of_points(:)
+            !! Mixture ratios
+        real(dp), allocatable :: values(:)
+            !! Objective values (of_failed_value for unconverged solves)
+        real(dp), allocatable :: excess(:)
+            !! Largest temperature excess over the caps [K]; feasible if <= 0
+        real(dp), allocatable :: slopes(:)
+            !! d(excess)/d(o/f) from EqDerivatives, or huge if not available
+        real(dp), allocatable :: Tc(:)
+            !! Chamber temperatures, for warm starts
+
+    contains
+
+        procedure :: add_constraint => OfOptimizer_add_constraint
+        procedure :: run => OfOptimizer_run
+
+    end type
+    interface OfOptimizer
+        module procedure :: OfOptimizer_init
+    end interface
+
+    real(dp), parameter :: cgold = 0.3819660112501051d0
+        !! Golden section ratio
+    real(dp), parameter :: of_failed_value = -1.0d30
+        !! Objective recorded for an unconverged solve
+
+contains
+
+    function OfOptimizer_init(objective, of_tolerance, max_solves) result(self)
+
+        ! Arguments
+        integer, intent(in), optional :: objective
+        real(dp), intent(in), optional :: of_tolerance
+        integer, intent(in), optional :: max_solves
+
+        ! Result
+        type(OfOptimizer) :: self
+
+        if (present(objective)) self%objective = objective
+        if (present(of_tolerance)) self%of_tolerance = of_tolerance
+        if (present(max_solves)) self%max_solves = max_solves
+        allocate(self%constraints(0))
+
+        call assert(self%objective >= of_opt_isp .and. self%objective <= of_opt_cstar, &
+                    'OfOptimizer_init: invalid objective')
+        call assert(self%of_tolerance > 0.0d0, 'OfOptimizer_init: of_tolerance must be positive')
+        call assert(self%max_solves > 0, 'OfOptimizer_init: max_solves must be positive')
+
+    end function
+
+    subroutine OfOptimizer_add_constraint(self, T_max, station)
+        ! Cap the temperature at a station (default: the chamber)
+
+        ! Arguments
+        class(OfOptimizer), intent(inout) :: self
+        real(dp), intent(in) :: T_max
+        integer, intent(in), optional :: station
+
+        ! Locals
+        type(OfConstraint) :: con
+
+        con%T_max = T_max
+        if (present(station)) con%station = station
+        call assert(con%station >= 1, 'OfOptimizer_add_constraint: station must be positive')
+        call assert(con%T_max > 0.0d0, 'OfOptimizer_add_constraint: T_max must be positive')
+        self%constraints = [self%constraints, con]
+
+    end subroutine
+
+    subroutine OfOptimizer_run(self, solver, oxidant_weights, fuel_weights, of_min, of_max, pc, pi_p, fac, &
+                               subar, supar, mdot, ac_at, n_frz, hc, tc, reactant_temps)
+        ! Find the optimal mixture ratio in [of_min, of_max]. The rocket arguments are those
+        ! of RocketSolver%solve. The chamber enthalpy is hc if given, else it is computed for
+        ! each mixture ratio from reactant_temps; tc assigns the chamber temperature instead.
+
+        ! Arguments
+        class(OfOptimizer), intent(inout) :: self
+        type(RocketSolver), intent(in) :: solver
+        real(dp), intent(in) :: oxidant_weights(:)
+        real(dp), intent(in) :: fuel_weights(:)
+        real(dp), intent(in) :: of_min
+        real(dp), intent(in) :: of_max
+        real(dp), intent(in) :: pc
+        real(dp), intent(in), optional :: pi_p(:)
+        logical,  intent(in), optional :: fac
+        real(dp), intent(in), optional :: subar(:)
+        real(dp), intent(in), optional :: supar(:)
+        real(dp), intent(in), optional :: mdot
+        real(dp), intent(in), optional :: ac_at
+        integer,  intent(in), optional :: n_frz
+        real(dp), intent(in), optional :: hc
+        real(dp), intent(in), optional :: tc
+        real(dp), intent(in), optional :: reactant_temps(:)
+
+        ! Locals
+        type(RocketSolution) :: empty
+        integer :: i_opt, i_left, i_right, i_best
+        logical :: fac_
+
+        call assert(of_min >= 0.0d0 .and. of_max > of_min, 'OfOptimizer_run: invalid mixture ratio bracket')
+        call assert(present(hc) .or. present(tc) .or. present(reactant_temps), &
+                    'OfOptimizer_run: hc, tc, or reactant_temps is required')
+        fac_ = .false.
+        if (present(fac)) fac_ = fac
+
+        self%of_ratio = 0.0d0
+        self%value = 0.0d0
+        self%num_solves = 0
+        self%constrained = .false.
+        self%converged = .false.
+        self%solution = empty
+        self%of_points = [real(dp) ::]
+        self%values = [real(dp) ::]
+        self%excess = [real(dp) ::]
+        self%slopes = [real(dp) ::]
+        self%Tc = [real(dp) ::]
+
+        ! Unconstrained optimum
+        i_opt = brent_max(of_min, of_max)
+        if (i_opt == 0) return
+
+        if (self%excess(i_opt) <= 0.0d0) then
+            i_best = i_opt
+        else
+            ! Nearest feasible boundary on each side of the unconstrained optimum
+            i_left = feasible_boundary(of_min, i_opt)
+            i_right = feasible_boundary(of_max, i_opt)
+            i_best = i_left
+            if (i_right > 0) then
+                if (i_best == 0) then
+                    i_best = i_right
+                else if (self%values(i_right) > self%values(i_best)) then
+                    i_best = i_right
+                end if
+            end if
+            if (i_best == 0) then
+                call log_warning('OfOptimizer: no mixture ratio in the bracket satisfies the temperature caps')
+                return
+            end if
+            self%constrained = .true.
+        end if
+
+        self%of_ratio = self%of_points(i_best)
+        self%value = self%values(i_best)
+        self%converged = self%values(i_best) > of_failed_value .and. self%num_solves <= self%max_solves
+
+        ! Final solve for the reported solution
+        call evaluate(self%of_ratio, self%solution)
+        if (.not. self%solution%converged) self%converged = .false.
+
+        if (log_enabled(log_levels%info)) then
+            call log_info('OfOptimizer: o/f = '//to_str(self%of_ratio)//' after '//to_str(self%num_solves)//' solves')
+        end if
+
+    contains
+
+        integer function brent_max(a0, b0) result(i_x)
+            ! Brent's method on -objective; returns the index of the best point
+            real(dp), intent(in) :: a0, b0
+            real(dp) :: a, b, d, e, p, q, r, tol1, tol2, u, v, w, x, xm, etemp
+            real(dp) :: fu, fv, fw, fx
+            integer :: i_u, i_v, i_w
+
+            a = a0
+            b = b0
+            x = a + cgold*(b - a)
+            w = x
+            v = x
+            i_x = add_point(x)
+            if (i_x == 0) return
+            i_w = i_x
+            i_v = i_x
+            fx = -self%values(i_x)
+            fw = fx
+            fv = fx
+            d = 0.0d0
+            e = 0.0d0
+
+            do
+                xm = 0.5d0*(a + b)
+                tol1 = self%of_tolerance*abs(x) + 1.0d-10
+                tol2 = 2.0d0*tol1
+                if (abs(x - xm) <= (tol2 - 0.5d0*(b - a))) exit
+                if (self%num_solves >= self%max_solves) exit
+
+                if (abs(e) > tol1) then
+                    ! Trial parabolic step
+                    r = (x - w)*(fx - fv)
+                    q = (x - v)*(fx - fw)
+                    p = (x - v)*q - (x - w)*r
+                    q = 2.0d0*(q - r)
+                    if (q > 0.0d0) p = -p
+                    q = abs(q)
+                    etemp = e
+                    e = d
+                    if (abs(p) >= abs(0.5d0*q*etemp) .or. p <= q*(a - x) .or. p >= q*(b - x)) then
+                        e = merge(a - x, b - x, x >= xm)
+                        d = cgold*e
+                    else
+                        d = p/q
+                        u = x + d
+                        if (u - a < tol2 .or. b - u < tol2) d = sign(tol1, xm - x)
+                    end if
+                else
+                    e = merge(a - x, b - x, x >= xm)
+                    d = cgold*e
+                end if
+
+                u = x + merge(d, sign(tol1, d), abs(d) >= tol1)
+                i_u = add_point(u)
+                if (i_u == 0) exit
+                fu = -self%values(i_u)
+
+                if (fu <= fx) then
+                    if (u >= x) then
+                        a = x
+                    else
+                        b = x
+                    end if
+                    v = w; fv = fw; i_v = i_w
+                    w = x; fw = fx; i_w = i_x
+                    x = u; fx = fu; i_x = i_u
+                else
+                    if (u < x) then
+                        a = u
+                    else
+                        b = u
+                    end if
+                    ! Points are compared by index; each solve gets a new one
+                    if (fu <= fw .or. i_w == i_x) then
+                        v = w; fv = fw; i_v = i_w
+                        w = u; fw = fu; i_w = i_u
+                    else if (fu <= fv .or. i_v == i_x .or. i_v == i_w) then
+                        v = u; fv = fu; i_v = i_u
+                    end if
+                end if
+            end do
+
+        end function
+
+        integer function feasible_boundary(end_of, i_in) result(i_b)
+            ! Largest feasible step from the infeasible point i_in toward end_of; 0 if end_of is infeasible
+            real(dp), intent(in) :: end_of
+            integer, intent(in) :: i_in
+            real(dp) :: x_f, x_i, g_f, g_i, x
+            integer :: i_f, i_x, i_n
+
+            i_b = 0
+            i_f = add_point(end_of)
+            if (i_f == 0) return
+            if (self%excess(i_f) > 0.0d0) return
+
+            ! Bracket [feasible, infeasible] on the largest temperature excess
+            x_f = self%of_points(i_f)
+            g_f = self%excess(i_f)
+            x_i = self%of_points(i_in)
+            g_i = self%excess(i_in)
+            i_b = i_f
+            i_n = i_in
+
+            do while (self%num_solves < self%max_solves)
+                if (abs(x_i - x_f) <= self%of_tolerance*abs(x_f) + 1.0d-10) exit
+
+                ! Newton step from the last point if its slope is known, else secant; kept inside the bracket
+                if (abs(self%slopes(i_n)) < huge(1.0d0) .and. abs(self%slopes(i_n)) > tiny(1.0d0)) then
+                    x = self%of_points(i_n) - self%excess(i_n)/self%slopes(i_n)
+                else
+                    x = x_f - g_f*(x_i - x_f)/(g_i - g_f)
+                end if
+                if (.not. (min(x_f, x_i) < x .and. x < max(x_f, x_i))) x = 0.5d0*(x_f + x_i)
+
+                i_x = add_point(x)
+                if (i_x == 0) exit
+                i_n = i_x
+                if (self%excess(i_x) <= 0.0d0) then
+                    x_f = x
+                    g_f = self%excess(i_x)
+                    i_b = i_x
+                    if (g_f >= -self%T_tolerance) exit
+                else
+                    x_i = x
+                    g_i = self%excess(i_x)
+                end if
+            end do
+
+        end function
+
+        integer function add_point(of) result(i)
+            ! Solve at of and record the point; 0 once the solve budget is spent
+            real(dp), intent(in) :: of
+            type(RocketSolution) :: soln
+
+            i = 0
+            if (self%num_solves >= self%max_solves) return
+            call evaluate(of, soln)
+
+            self%of_points = [self%of_points, of]
+            self%Tc = [self%Tc, merge(soln%eq_soln(1)%T, 0.0d0, soln%converged)]
+            if (soln%converged) then
+                self%values = [self%values, objective_value(soln)]
+                call constraint_excess(of, soln)
+            else
+                self%values = [self%values, of_failed_value]
+                self%excess = [self%excess, huge(1.0d0)]
+                self%slopes = [self%slopes, huge(1.0d0)]
+            end if
+            i = size(self%of_points)
+
+        end function
+
+        subroutine evaluate(of, soln)
+            ! Rocket solve at of, warm-started from the nearest converged point
+            real(dp), intent(in) :: of
+            type(RocketSolution), intent(out) :: soln
+            real(dp), allocatable :: weights(:), h, tc_est
+            integer :: k
+
+            weights = solver%eq_solver%reactants%weights_from_of(oxidant_weights, fuel_weights, of)
+            if (present(hc)) then
+                h = hc
+            else if (.not. present(tc)) then
+                h = solver%eq_solver%reactants%calc_enthalpy(weights, reactant_temps)/R
+            end if
+            if (size(self%Tc) > 0) then
+                k = minloc(abs(self%of_points - of), mask=self%Tc > 0.0d0, dim=1)
+                if (k > 0) tc_est = self%Tc(k)
+            end if
+
+            self%num_solves = self%num_solves + 1
+            soln = solver%solve(weights, pc, pi_p, fac=fac, subar=subar, supar=supar, mdot=mdot, ac_at=ac_at, &
+                                n_frz=n_frz, tc_est=tc_est, hc=h, tc=tc)
+            call solver%compute_outputs(soln, output_performance)
+
+        end subroutine
+
+        real(dp) function objective_value(soln) result(f)
+            type(RocketSolution), intent(in) :: soln
+            integer :: ne
+            ne = soln%num_pts
+            select case (self%objective)
+                case (of_opt_ivac)
+                    f = soln%i_vac(ne)
+                case (of_opt_cstar)
+                    f = soln%c_star(ne)
+                case default
+                    f = soln%i_sp(ne)
+            end select
+        end function
+
+        subroutine constraint_excess(of, soln)
+            ! Record the largest temperature excess and, for a chamber cap, its slope
+            real(dp), intent(in) :: of
+            type(RocketSolution), intent(inout) :: soln
+            real(dp) :: g, g_max, slope
+            integer :: k, k_max
+
+            g_max = -huge(1.0d0)
+            k_max = 0
+            do k = 1, size(self%constraints)
+                associate(con => self%constraints(k))
+                    if (con%station > soln%num_pts) cycle
+                    g = soln%eq_soln(con%station)%T - con%T_max
+                    if (g > g_max) then
+                        g_max = g
+                        k_max = k
+                    end if
+                end associate
+            end do
+
+            slope = huge(1.0d0)
+            if (k_max > 0) then
+                if (self%constraints(k_max)%station == 1 .and. .not. fac_ .and. .not. present(tc)) then
+                    slope = chamber_T_slope(of, soln)
+                end if
+            end if
+            self%excess = [self%excess, g_max]
+            self%slopes = [self%slopes, slope]
+
+        end subroutine
+
+        real(dp) function chamber_T_slope(of, soln) result(slope)
+            ! dTc/d(o/f) through the chamber equilibrium derivatives
+            real(dp), intent(in) :: of
+            type(RocketSolution), intent(inout) :: soln
+            type(EqDerivatives) :: derivs
+            real(dp), allocatable :: dw_dof(:), h_j(:)
+            real(dp) :: dh_dof
+            integer :: j
+
+            associate(eq_solver => solver%eq_solver, reac => solver%eq_solver%reactants)
+                derivs = EqDerivatives(eq_solver, soln%eq_soln(1), outputs=deriv_T + deriv_wrt_state1 + deriv_wrt_w0)
+                call derivs%compute_derivatives(eq_solver, soln%eq_soln(1))
+                call derivs%unpack_values(eq_solver, soln%eq_soln(1))
+
+                dw_dof = of_weight_derivative(reac, oxidant_weights, fuel_weights, of)
+                slope = dot_product(derivs%dT_dw0, dw_dof)
+
+                ! The chamber enthalpy moves with the mixture ratio unless it is assigned
+                if (.not. present(hc)) then
+                    allocate(h_j(reac%num_species))
+                    do j = 1, reac%num_species
+                        h_j(j) = reac%species(j)%calc_enthalpy(reactant_temps(j))/reac%species(j)%molecular_weight
+                    end do
+                    dh_dof = dot_product(dw_dof, h_j) / &
+                             sum(reac%weights_from_of(oxidant_weights, fuel_weights, of))
+                    slope = slope + derivs%dT_dstate1*dh_dof
+                end if
+            end associate
+
+        end function
+
+    end subroutine
+
+    function of_weight_derivative(reactants, oxidant_weights, fuel_weights, of_ratio) result(dw_dof)
+        ! d(weights)/d(o/f) of Mixture%weights_from_of
+
+        ! Arguments
+        type(Mixture), intent(in) :: reactants
+        real(dp), intent(in) :: oxidant_weights(:)
+        real(dp), intent(in) :: fuel_weights(:)
+        real(dp), intent(in) :: of_ratio
+
+        ! Result
+        real(dp) :: dw_dof(size(oxidant_weights))
+
+        ! Locals
+        real(dp) :: mw_ox, mw_fu
+
+        mw_ox = dot_product(oxidant_weights, reactants%species(:)%molecular_weight)
+        mw_fu = dot_product(fuel_weights,    reactants%species(:)%molecular_weight)
+        dw_dof = (mw_ox + mw_fu) * (oxidant_weights/sum(oxidant_weights) - fuel_weights/sum(fuel_weights)) &
+                 / (1.0d0 + of_ratio)**2
+
+    end function
+
+end module
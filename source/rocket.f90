@@ -5,8 +5,9 @@ module cea_rocket
                          R=>gas_constant, &
                          snl=>species_name_len
     use cea_mixture, only: Mixture, MixtureThermo
-    use cea_equilibrium, only: EqSolution, EqSolver, EqPartials
+    use cea_equilibrium, only: EqSolution, EqSolver, EqPartials, EqResult, output_all, output_transport, output_performance
     use cea_transport, only: TransportDB
+    use fb_timing, only: profile_enter, profile_leave
     use fb_utils
     implicit none
 
@@ -30,6 +31,7 @@ module cea_rocket
         procedure :: solve_supar_frozen => RocketSolver_solve_supar_frozen
         procedure :: frozen => RocketSolver_frozen
         procedure :: post_process => RocketSolver_post_process
+        procedure :: compute_outputs => RocketSolver_compute_outputs
         procedure :: set_init_state => RocketSolver_set_init_state
 
     end type
@@ -86,11 +88,61 @@ module cea_rocket
         logical :: converged = .false.
             !! Convergence flag
 
+        ! Deferred outputs
+        integer :: pending = 0
+            !! Outputs the solver's mask left uncomputed (output_performance)
+        logical :: fac = .false.
+            !! Finite-area combustor solution; selects the stations post-processing covers
+
     end type
     interface RocketSolution
         module procedure :: RocketSolution_init
     end interface
 
+    type :: RocketResult
+        !! Compact record of the reported rocket outputs
+        !!
+        !! Keeps an EqResult per station in place of the EqSolution and
+        !! EqPartials workspaces, so a sweep can store one record per point.
+        !! The isentropic exponent of each station is eq_result(:)%gamma_s.
+
+        integer :: num_pts = 0
+            !! Number of evaluation points
+        character(8), allocatable :: station(:)
+            !! Name of each evaluation point: infinity, chamber, throat, exit
+        integer :: throat_idx = 0
+            !! Index of the throat station
+        type(EqResult), allocatable :: eq_result(:)
+            !! Equilibrium outputs at each evaluation point
+
+        ! States
+        real(dp), allocatable :: pressure(:)
+            !! Pressure [bar]
+        real(dp), allocatable :: mach(:)
+            !! Mach number
+        real(dp), allocatable :: v_sonic(:)
+            !! Speed of sound [m/s]
+
+        ! Performance parameters
+        real(dp), allocatable :: ae_at(:)
+            !! Area ratio Ae/At
+        real(dp), allocatable :: c_star(:)
+            !! Characteristic velocity [m/s]
+        real(dp), allocatable :: cf(:)
+            !! Thrust coefficient
+        real(dp), allocatable :: i_vac(:)
+            !! Specific impulse (at vacuum) [m/s]
+        real(dp), allocatable :: i_sp(:)
+            !! Specific impulse (ambient pressure) [m/s]
+
+        logical :: converged = .false.
+            !! Convergence flag
+
+    end type
+    interface RocketResult
+        module procedure :: RocketResult_init
+    end interface
+
 contains
 
     !-----------------------------------------------------------------------
@@ -147,6 +199,15 @@ contains
         ! Shorthand
         ng = self%eq_solver%num_gas
 
+        ! Frozen stations report the entropy and transport properties of the freezing point
+        call self%eq_solver%compute_outputs(soln%eq_soln(n_frz))
+        soln%eq_soln(idx)%pending = 0
+        soln%eq_soln(idx)%viscosity = soln%eq_soln(n_frz)%viscosity
+        soln%eq_soln(idx)%conductivity_fr = soln%eq_soln(n_frz)%conductivity_fr
+        soln%eq_soln(idx)%conductivity_eq = soln%eq_soln(n_frz)%conductivity_eq
+        soln%eq_soln(idx)%Pr_fr = soln%eq_soln(n_frz)%Pr_fr
+        soln%eq_soln(idx)%Pr_eq = soln%eq_soln(n_frz)%Pr_eq
+
         ! Set the equilibrium solution values
         soln%eq_soln(idx)%nj = soln%eq_soln(n_frz)%nj
         soln%eq_soln(idx)%n = soln%eq_soln(n_frz)%n
@@ -196,8 +257,8 @@ contains
                     ! TODO(smooth_truncation): smooth gating means species are rarely exactly zero.
                     ! Frozen-mode checks intentionally use a practical-zero tolerance.
                     if (abs(soln%eq_soln(n_frz)%nj(ng+j)) <= approx_zero_tol) cycle
-                    T_low = minval(self%eq_solver%products%species(ng+j)%T_fit(:, 1))
-                    T_high = maxval(self%eq_solver%products%species(ng+j)%T_fit(:, 2))
+                    T_low = self%eq_solver%T_low_c(j)
+                    T_high = self%eq_solver%T_high_c(j)
                     if (soln%eq_soln(idx)%T < (T_low-phase_gap) .or. soln%eq_soln(idx)%T > (T_high+phase_gap)) then
                         in_range = .false.
                         exit
@@ -205,8 +266,10 @@ contains
                 end do
 
                 if (.not. in_range) then
-                    call log_warning("Frozen calculations stopped: temperature is more than 50 K outside "// &
-                        "the range of a condensed species")
+                    if (log_enabled(log_levels%warning)) then
+                        call log_warning("Frozen calculations stopped: temperature is more than 50 K outside "// &
+                            "the range of a condensed species")
+                    end if
                     soln%converged = .false.
                     return
                 end if
@@ -487,8 +550,10 @@ contains
             ! Legacy frozen scheduling: omit assigned pressure ratios lower than
             ! the value at the freeze point.
             if (pi_p(i) < pip_nf) then
-                call log_info('RocketSolver: WARNING!!  FOR FROZEN PERFORMANCE, POINT OMITTED BECAUSE '// &
-                    'ASSIGNED pi/p IS LESS THAN VALUE AT nfz='//to_str(n_frz))
+                if (log_enabled(log_levels%info)) then
+                    call log_info('RocketSolver: WARNING!!  FOR FROZEN PERFORMANCE, POINT OMITTED BECAUSE '// &
+                        'ASSIGNED pi/p IS LESS THAN VALUE AT nfz='//to_str(n_frz))
+                end if
                 cycle
             end if
 
@@ -725,8 +790,10 @@ contains
             ! Frozen scheduling: omit assigned supersonic area ratios
             ! that are not greater than the value at the freeze point.
             if (n_frz >= 3 .and. supar(i) <= soln%ae_at(n_frz)) then
-                call log_info('RocketSolver: WARNING!!  FOR FROZEN PERFORMANCE, POINT OMITTED BECAUSE '// &
-                    'ASSIGNED Ae/At IS LESS THAN OR EQUAL TO VALUE AT nfz='//to_str(n_frz))
+                if (log_enabled(log_levels%info)) then
+                    call log_info('RocketSolver: WARNING!!  FOR FROZEN PERFORMANCE, POINT OMITTED BECAUSE '// &
+                        'ASSIGNED Ae/At IS LESS THAN OR EQUAL TO VALUE AT nfz='//to_str(n_frz))
+                end if
                 cycle
             end if
 
@@ -810,6 +877,7 @@ contains
         logical :: frozen                    ! Flag to determine if frozen composition is used
 
         call log_debug("Starting rocket IAC solve")
+        call profile_enter(self%eq_solver%profile, 'rocket')
 
         ! Set the total number of evaluation points
         num_pts = 2  ! infinity + throat
@@ -867,6 +935,8 @@ contains
         soln%mach(1) = 0.0d0
 
         if (frozen .and. n_frz_ <= 1) then
+            ! Transport replaces the frozen heat capacity this estimate starts from
+            call self%eq_solver%compute_outputs(soln%eq_soln(1), output_transport)
             gamma_s = (soln%eq_soln(1)%cp_fr/(R*1.d-3))/((soln%eq_soln(1)%cp_fr/(R*1.d-3))-soln%eq_soln(1)%n)
             soln%gamma_s(1) = gamma_s
             soln%eq_partials(1)%gamma_s = gamma_s
@@ -894,7 +964,10 @@ contains
         else
             call self%solve_throat(soln, idx, pc, h_inf, state1, reactant_weights, awt)
         end if
-        if (.not. soln%converged) return
+        if (.not. soln%converged) then
+            call profile_leave(self%eq_solver%profile)
+            return
+        end if
         ln_pinf_pt = log(soln%pressure(1)/soln%pressure(2))
 
         ! -----------------------------------------------
@@ -908,7 +981,10 @@ contains
             else
                 call self%solve_pi_p(soln, idx, pc, pi_p, h_inf, state1, reactant_weights)
             end if
-            if (.not. soln%converged) return
+            if (.not. soln%converged) then
+                call profile_leave(self%eq_solver%profile)
+                return
+            end if
         else
             ! If pi_p not present, idx stays at 3 for subsequent sections
             idx = 3
@@ -939,7 +1015,10 @@ contains
             else
                 call self%solve_supar(soln, idx, pc, supar, h_inf, state1, reactant_weights, ln_pinf_pt, awt)
             end if
-            if (.not. soln%converged) return
+            if (.not. soln%converged) then
+                call profile_leave(self%eq_solver%profile)
+                return
+            end if
 
         end if
 
@@ -947,7 +1026,15 @@ contains
         soln%num_pts = idx - 1
 
         ! Compute performance parameters
-        call self%post_process(soln, .false.)
+        soln%fac = .false.
+        soln%pending = 0
+        if (iand(self%eq_solver%outputs, output_performance) /= 0) then
+            call self%post_process(soln, .false.)
+        else
+            soln%pending = output_performance
+        end if
+
+        call profile_leave(self%eq_solver%profile)
 
     end subroutine
 
@@ -1006,6 +1093,7 @@ contains
         ! 5+: exit
 
         call log_debug("Starting rocket FAC solve")
+        call profile_enter(self%eq_solver%profile, 'rocket')
 
         ! Set the total number of evaluation points
         num_pts = 4  ! injector + infinity + combustor + throat
@@ -1211,8 +1299,10 @@ contains
             end if
 
             if (chamber_iter >= max_iter_chamber) then
-                call log_warning('RocketSolver FAC: chamber conditions did not converge within '// &
-                    to_str(max_iter_chamber)//' iterations; continuing with last iterate')
+                if (log_enabled(log_levels%warning)) then
+                    call log_warning('RocketSolver FAC: chamber conditions did not converge within '// &
+                        to_str(max_iter_chamber)//' iterations; continuing with last iterate')
+                end if
                 exit
             end if
 
@@ -1224,7 +1314,10 @@ contains
         if (frozen .and. idx > n_frz_) then
             call self%solve_throat_frozen(soln, idx, n_frz_, p_inf, h_inj, awt)
         end if
-        if (.not. soln%converged) return
+        if (.not. soln%converged) then
+            call profile_leave(self%eq_solver%profile)
+            return
+        end if
 
         ! -----------------------------------------------
         ! Exit conditions: pressure ratio
@@ -1237,7 +1330,10 @@ contains
             else
                 call self%solve_pi_p(soln, idx, pc, pi_p, h_inj, S_ref, reactant_weights)
             end if
-            if (.not. soln%converged) return
+            if (.not. soln%converged) then
+                call profile_leave(self%eq_solver%profile)
+                return
+            end if
         else
             ! If pi_p not present, idx stays at 5 for subsequent sections
             idx = 5
@@ -1273,14 +1369,25 @@ contains
                 call self%solve_supar(soln, idx, soln%pressure(2), supar, h_inj, S_ref, reactant_weights, &
                     ln_pinf_pt, awt)
             end if
-            if (.not. soln%converged) return
+            if (.not. soln%converged) then
+                call profile_leave(self%eq_solver%profile)
+                return
+            end if
         end if
 
         ! Omitted frozen schedule points do not consume output indices.
         soln%num_pts = idx - 1
 
         ! Compute performance parameters
-        call self%post_process(soln, .true.)
+        soln%fac = .true.
+        soln%pending = 0
+        if (iand(self%eq_solver%outputs, output_performance) /= 0) then
+            call self%post_process(soln, .true.)
+        else
+            soln%pending = output_performance
+        end if
+
+        call profile_leave(self%eq_solver%profile)
 
     end subroutine
 
@@ -1371,6 +1478,31 @@ contains
 
     end subroutine
 
+    subroutine RocketSolver_compute_outputs(self, soln, outputs)
+        ! Compute the pending outputs of every station and the performance parameters
+
+        ! Arguments
+        class(RocketSolver) :: self
+        type(RocketSolution), intent(inout) :: soln
+        integer, intent(in), optional :: outputs  ! output_* flags; default output_all
+
+        ! Locals
+        integer :: i, todo
+
+        todo = output_all
+        if (present(outputs)) todo = outputs
+
+        do i = 1, soln%num_pts
+            call self%eq_solver%compute_outputs(soln%eq_soln(i), todo)
+        end do
+
+        if (iand(todo, soln%pending) /= 0) then
+            soln%pending = 0
+            call self%post_process(soln, soln%fac)
+        end if
+
+    end subroutine
+
     subroutine RocketSolver_set_init_state(self, soln, idx)
         ! Set the initial state for the equilibrium solver
 
@@ -1487,4 +1619,34 @@ contains
 
     end function
 
+    !-----------------------------------------------------------------------
+    ! RocketResult
+    !-----------------------------------------------------------------------
+    function RocketResult_init(soln) result(self)
+        ! Copy the reported station outputs of a solved rocket problem.
+        ! Post-process the solution (compute_outputs) first if its mask deferred any.
+        type(RocketResult) :: self
+        type(RocketSolution), intent(in) :: soln
+        integer :: i, n
+
+        n = soln%num_pts
+        self%num_pts = n
+        self%throat_idx = soln%throat_idx
+        self%converged = soln%converged
+        allocate(self%station, source=soln%station(:n))
+        allocate(self%eq_result(n))
+        do i = 1, n
+            self%eq_result(i) = EqResult(soln%eq_soln(i), soln%eq_partials(i))
+        end do
+        self%pressure = soln%pressure(:n)
+        self%mach = soln%mach(:n)
+        self%v_sonic = soln%v_sonic(:n)
+        self%ae_at = soln%ae_at(:n)
+        self%c_star = soln%c_star(:n)
+        self%cf = soln%cf(:n)
+        self%i_vac = soln%i_vac(:n)
+        self%i_sp = soln%i_sp(:n)
+
+    end function
+
 end module
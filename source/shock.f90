@@ -4,8 +4,9 @@ module cea_shock
     use cea_param, only: dp, empty_dp, R=>gas_constant
     use cea_mixture, only: Mixture, MixtureThermo
     use cea_transport, only: TransportDB
-    use cea_equilibrium, only: EqSolution, EqSolver, EqPartials
+    use cea_equilibrium, only: EqSolution, EqSolver, EqPartials, EqResult
     use fb_findloc, only: findloc
+    use fb_timing, only: profile_enter, profile_leave
     use fb_utils
     implicit none
 
@@ -74,6 +75,49 @@ module cea_shock
         module procedure :: ShockSolution_init
     end interface
 
+    type :: ShockResult
+        !! Compact record of the reported shock outputs
+        !!
+        !! Keeps an EqResult per point in place of the EqSolution and
+        !! EqPartials workspaces, so a sweep can store one record per point.
+
+        integer :: num_pts = 0
+            !! Number of evaluation points
+        type(EqResult), allocatable :: eq_result(:)
+            !! Equilibrium outputs at each evaluation point
+
+        ! States
+        real(dp), allocatable :: pressure(:)
+            !! Pressure [bar]
+        real(dp), allocatable :: mach(:)
+            !! Mach
+        real(dp), allocatable :: u(:)
+            !! Gas velocity [m/s]
+        real(dp), allocatable :: v_sonic(:)
+            !! Sonic velocity [m/s]
+
+        ! Solution variables
+        real(dp) :: rho12 = 0.0d0, rho52 = 0.0d0
+            !! Ratios of density across the incident and reflected shocks
+        real(dp) :: p21 = 0.0d0, p52 = 0.0d0
+            !! Pressure ratios across the incident and reflected shocks
+        real(dp) :: t21 = 0.0d0, t52 = 0.0d0
+            !! Temperature ratios across the incident and reflected shocks
+        real(dp) :: M21 = 0.0d0, M52 = 0.0d0
+            !! Mach number ratios across the incident and reflected shocks
+        real(dp) :: v2 = 0.0d0
+            !! Relative velocity of the incident shock [m/s]
+        real(dp) :: u5_p_v2 = 0.0d0
+            !! u5 + v2 [m/s]
+
+        logical :: converged = .false.
+            !! Convergence flag
+
+    end type
+    interface ShockResult
+        module procedure :: ShockResult_init
+    end interface
+
 contains
 
     !-----------------------------------------------------------------------
@@ -244,8 +288,10 @@ contains
             call self%update_solution(soln, X(1), X(2), p21, t21, i)
 
             if (i == 1 .and. .not. soln%converged .and. t21 >= ttmax) then
-                call log_warning("ShockSolver_solve_incident: first-iteration update hit " // &
-                                 "temperature cap; marking incident point as failed.")
+                if (log_enabled(log_levels%warning)) then
+                    call log_warning("ShockSolver_solve_incident: first-iteration update hit " // &
+                                     "temperature cap; marking incident point as failed.")
+                end if
                 soln%eq_soln(idx)%T = 0.0d0
                 soln%pressure(idx) = 0.0d0
                 return
@@ -394,8 +440,10 @@ contains
             call self%update_solution(soln, X(1), X(2), p21, t21, i)
 
             if (i == 1 .and. .not. soln%converged .and. t21 >= ttmax) then
-                call log_warning("ShockSolver_solve_incident_frozen: first-iteration update hit " // &
-                                 "temperature cap; marking incident point as failed.")
+                if (log_enabled(log_levels%warning)) then
+                    call log_warning("ShockSolver_solve_incident_frozen: first-iteration update hit " // &
+                                     "temperature cap; marking incident point as failed.")
+                end if
                 soln%eq_soln(idx)%T = 0.0d0
                 soln%pressure(idx) = 0.0d0
                 return
@@ -531,8 +579,10 @@ contains
             call self%update_solution(soln, X(1), X(2), p52, t52, i)
 
             if (i == 1 .and. .not. soln%converged .and. t52 >= ttmax) then
-                call log_warning("ShockSolver_solve_reflected: first-iteration update hit " // &
-                                 "temperature cap; marking reflected point as failed.")
+                if (log_enabled(log_levels%warning)) then
+                    call log_warning("ShockSolver_solve_reflected: first-iteration update hit " // &
+                                     "temperature cap; marking reflected point as failed.")
+                end if
                 soln%eq_soln(idx)%T = 0.0d0
                 soln%pressure(idx) = 0.0d0
                 return
@@ -677,8 +727,10 @@ contains
             call self%update_solution(soln, X(1), X(2), p52, t52, i)
 
             if (i == 1 .and. .not. soln%converged .and. t52 >= ttmax) then
-                call log_warning("ShockSolver_solve_reflected_frozen: first-iteration update hit " // &
-                                 "temperature cap; marking reflected point as failed.")
+                if (log_enabled(log_levels%warning)) then
+                    call log_warning("ShockSolver_solve_reflected_frozen: first-iteration update hit " // &
+                                     "temperature cap; marking reflected point as failed.")
+                end if
                 soln%eq_soln(idx)%T = 0.0d0
                 soln%pressure(idx) = 0.0d0
                 return
@@ -717,7 +769,7 @@ contains
         ! Solve the moving shock problem
 
         ! Arguments
-        class(ShockSolver), intent(in) :: self
+        class(ShockSolver) :: self
         real(dp), intent(in) :: reactant_weights(:)
         real(dp), intent(in) :: T0                          ! Initial reactant temperature [K]
         real(dp), intent(in) :: P0                          ! Initial reactant pressure [bar]
@@ -791,6 +843,7 @@ contains
 
         ! Initialize the solution
         soln = ShockSolution_init(npts)
+        call profile_enter(self%eq_solver%profile, 'shock')
 
         ! Solve the problem
         ! --------------------------------------------------------------------
@@ -849,6 +902,7 @@ contains
             call self%solve_incident(soln, reactant_weights, T0, P0)
         end if
         if (soln%eq_soln(2)%T <= 0.0d0) then
+            call profile_leave(self%eq_solver%profile)
             return
         end if
         call self%eq_solver%post_process(soln%eq_soln(2))
@@ -861,11 +915,14 @@ contains
                 call self%solve_reflected(soln, reactant_weights, T0, P0)
             end if
             if (soln%eq_soln(3)%T <= 0.0d0) then
+                call profile_leave(self%eq_solver%profile)
                 return
             end if
             call self%eq_solver%post_process(soln%eq_soln(3))
         end if
 
+        call profile_leave(self%eq_solver%profile)
+
     end function
 
     !-----------------------------------------------------------------------
@@ -886,4 +943,37 @@ contains
         allocate(self%v_sonic(num_pts))
     end function
 
+    !-----------------------------------------------------------------------
+    ! ShockResult
+    !-----------------------------------------------------------------------
+    function ShockResult_init(soln) result(self)
+        ! Copy the reported outputs of a solved shock problem
+        type(ShockResult) :: self
+        type(ShockSolution), intent(in) :: soln
+        integer :: i, n
+
+        n = soln%num_pts
+        self%num_pts = n
+        allocate(self%eq_result(n))
+        do i = 1, n
+            self%eq_result(i) = EqResult(soln%eq_soln(i), soln%eq_partials(i))
+        end do
+        self%pressure = soln%pressure(:n)
+        self%mach = soln%mach(:n)
+        self%u = soln%u(:n)
+        self%v_sonic = soln%v_sonic(:n)
+        self%rho12 = soln%rho12
+        self%rho52 = soln%rho52
+        self%p21 = soln%p21
+        self%p52 = soln%p52
+        self%t21 = soln%t21
+        self%t52 = soln%t52
+        self%M21 = soln%M21
+        self%M52 = soln%M52
+        self%v2 = soln%v2
+        self%u5_p_v2 = soln%u5_p_v2
+        self%converged = soln%converged
+
+    end function
+
 end module
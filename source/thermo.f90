@@ -11,14 +11,17 @@ module cea_thermo
     use cea_input, only: Formula
     use cea_fits, only: ThermoFit
     use fb_algorithms, only: sort, unique
+    use fb_findloc, only: findloc
     use fb_utils, only: abort, startswith, to_str, is_empty
     use fb_logging
+    use iso_fortran_env, only: int64
     implicit none
 
     ! Sizing paramters
     integer, parameter :: num_coefs = 9  ! Num. coeffs. for a given thermo fit
     integer, parameter :: num_fit_g = 3  ! Num. fits for each gas species
     integer, parameter :: max_elem_per_species = 5  ! Maximum possible elements in a species formula
+    integer, parameter :: elem_mask_words = 2  ! Words in an element bitmask (64 elements each)
 
     type :: SpeciesThermo
         !! Container for individual species thermo data
@@ -41,6 +44,10 @@ module cea_thermo
         type(ThermoFit), allocatable :: fits(:)
             !! Curve fit coefficients
 
+        ! Element bitmask
+        integer(int64) :: element_mask(elem_mask_words) = 0_int64
+            !! Bit k-1 is set if ThermoDB%element_name_list(k) is in the formula (products only)
+
         ! Reactants only
         real(dp) :: enthalpy_ref = 0.0
             !! Assigned enthalpy
@@ -89,6 +96,13 @@ module cea_thermo
         type(SpeciesThermo), allocatable :: reactant_thermo(:)
             !! Reactant species thermo data
 
+    contains
+        procedure :: element_mask => tdb_element_mask
+        procedure :: num_species_ids => tdb_num_species_ids
+        procedure :: species_id => tdb_species_id
+        procedure :: species_name => tdb_species_name
+        procedure :: species_by_id => tdb_species_by_id
+        procedure :: element_id => tdb_element_id
     end type
     interface ThermoDB
         module procedure :: tdb_init
@@ -107,6 +121,104 @@ contains
         tdb%num_elems     = ne
     end function
 
+    function tdb_element_mask(self, element_names) result(mask)
+        !! Bitmask of the given elements over element_name_list
+        !! Elements that do not appear in any product formula are ignored
+        class(ThermoDB), intent(in) :: self
+        character(*), intent(in) :: element_names(:)
+        integer(int64) :: mask(elem_mask_words)
+        integer :: i, k
+
+        mask = 0_int64
+        do i = 1, size(element_names)
+            k = findloc(self%element_name_list, element_names(i), 1)
+            if (k > 0) mask((k-1)/64+1) = ibset(mask((k-1)/64+1), mod(k-1, 64))
+        end do
+    end function
+
+    ! Species IDs number product_thermo first, then reactant_thermo, so that a name present in
+    ! both lists resolves to its product entry, as the name search in get_species does.
+
+    pure function tdb_num_species_ids(self) result(n)
+        !! Number of valid species IDs
+        class(ThermoDB), intent(in) :: self
+        integer :: n
+        n = self%num_products + self%num_reactants
+    end function
+
+    function tdb_species_id(self, name) result(id)
+        !! Species ID of a name, or 0 if the database has no such species
+        class(ThermoDB), intent(in) :: self
+        character(*), intent(in) :: name
+        integer :: id
+        integer :: i
+
+        do i = 1, self%num_products
+            if (names_match(name, self%product_thermo(i)%name)) then
+                id = i
+                return
+            end if
+        end do
+        do i = 1, self%num_reactants
+            if (names_match(name, self%reactant_thermo(i)%name)) then
+                id = self%num_products + i
+                return
+            end if
+        end do
+        id = 0
+    end function
+
+    function tdb_species_name(self, id) result(name)
+        !! Name of a species ID, without the database "*" decoration
+        class(ThermoDB), intent(in) :: self
+        integer, intent(in) :: id
+        character(sn) :: name
+
+        if (id < 1 .or. id > self%num_species_ids()) then
+            call abort('ThermoDB%species_name: invalid species ID '//to_str(id))
+        end if
+        if (id <= self%num_products) then
+            name = self%product_thermo(id)%name
+        else
+            name = self%reactant_thermo(id - self%num_products)%name
+        end if
+        if (name(1:1) == '*') name = name(2:)
+    end function
+
+    function tdb_species_by_id(self, id) result(species)
+        !! Thermo data of a species ID
+        class(ThermoDB), intent(in) :: self
+        integer, intent(in) :: id
+        type(SpeciesThermo) :: species
+
+        if (id < 1 .or. id > self%num_species_ids()) then
+            call abort('ThermoDB%species_by_id: invalid species ID '//to_str(id))
+        end if
+        if (id <= self%num_products) then
+            species = self%product_thermo(id)
+        else
+            species = self%reactant_thermo(id - self%num_products)
+        end if
+    end function
+
+    function tdb_element_id(self, name) result(id)
+        !! Element ID (index into element_name_list) of a symbol, or 0 if unknown
+        class(ThermoDB), intent(in) :: self
+        character(*), intent(in) :: name
+        integer :: id
+        id = findloc(self%element_name_list, name, 1)
+    end function
+
+    pure logical function names_match(name, dbname)
+        !! Compare a species name with a database entry, ignoring the "*" decoration
+        character(*), intent(in) :: name, dbname
+        if (dbname(1:1) == '*') then
+            names_match = (name == dbname(2:))
+        else
+            names_match = (name == dbname)
+        end if
+    end function
+
     elemental function st_is_condensed(self) result(tf)
         class(SpeciesThermo), intent(in) :: self
         logical :: tf
@@ -503,6 +615,34 @@ contains
 
     end subroutine
 
+    subroutine build_element_masks(species_thermo, name_map, fno, sym_map)
+        ! Set the element bitmask of each species from its records' element indices
+
+        ! Inputs
+        type(SpeciesThermo), intent(inout) :: species_thermo(:)
+        integer, intent(in) :: name_map(:)
+        real(dp), intent(in) :: fno(:, :)
+        integer, intent(in) :: sym_map(:, :)
+
+        ! Locals
+        integer :: i, j, k
+        real(dp), parameter :: tol = 1.d-10
+
+        if (maxval(sym_map) > 64*elem_mask_words) then
+            call abort('build_element_masks: more than '//to_str(64*elem_mask_words)//' elements in the database')
+        end if
+
+        do i = 1, size(name_map)
+            do j = 1, size(sym_map, 2)
+                k = sym_map(i, j)
+                if (k < 1 .or. abs(fno(i, j)) < tol) cycle
+                species_thermo(name_map(i))%element_mask((k-1)/64+1) = &
+                    ibset(species_thermo(name_map(i))%element_mask((k-1)/64+1), mod(k-1, 64))
+            end do
+        end do
+
+    end subroutine
+
     subroutine build_formulas(species_thermo, name_map, sym, fno)
 
         ! Inputs
@@ -756,6 +896,9 @@ contains
         call build_formulas(db%product_thermo, name_map, sym, fno)
         call build_formulas(db%reactant_thermo, reac_name_map, reac_sym, reac_fno)
 
+        ! Build the product element masks
+        call build_element_masks(db%product_thermo, name_map, fno, sym_map)
+
         ! Assign phase values
         do i = 1,size(name_map)
             db%product_thermo(name_map(i))%i_phase = ifaz(i)
@@ -167,7 +167,7 @@ contains
         integer :: n_int_lambda       ! Number of conductivity intervals
 
 
-        call log_info('Reading transport database file: '//filename)
+        if (log_enabled(log_levels%info)) call log_info('Reading transport database file: '//filename)
         open(newunit=fin, file=filename, &
              status="old", action="read", form="unformatted")
 
@@ -0,0 +1,895 @@
+module cea_uncertainty
+    !! Monte Carlo propagation of input uncertainty
+    !!
+    !! A McDriver perturbs state values, reactant weights, and reactant
+    !! enthalpies with uniform, normal, or triangular distributions, solves
+    !! each sample, and folds the outputs into streaming statistics (mean,
+    !! variance, range, and P-squared quantile estimates, Jain and Chlamtac,
+    !! 1985). Samples are not stored.
+    !!
+    !! Sample points are stateless hashes of (seed, sample, input): plain
+    !! random, Latin hypercube with strata drawn from a hashed permutation
+    !! (Kensler, 2013), or a randomly shifted Halton sequence. Samples are
+    !! solved in blocks. Each block is ordered along the first input so that
+    !! consecutive solves warm-start from nearby states, split into
+    !! num_threads contiguous chunks with one solver workspace each (run
+    !! concurrently when built with OpenMP), and accumulated in sample order.
+    !! Results therefore depend only on the seed and the thread count.
+
+    use, intrinsic :: iso_fortran_env, only: int64
+    use cea_param, only: dp, R=>gas_constant, snl=>species_name_len
+    use cea_mixture, only: Mixture
+    use cea_equilibrium, only: EqSolver, EqSolution, output_properties, output_performance
+    use cea_rocket, only: RocketSolver, RocketSolution
+    use fb_algorithms, only: sort
+    use fb_utils
+    implicit none
+
+    ! Perturbed quantities
+    integer, parameter :: mc_state1 = 0
+    integer, parameter :: mc_state2 = 1
+    integer, parameter :: mc_weight = 2
+    integer, parameter :: mc_enthalpy = 3
+
+    ! Distributions
+    integer, parameter :: mc_uniform = 0
+    integer, parameter :: mc_normal = 1
+    integer, parameter :: mc_triangular = 2
+
+    ! Sampling schemes
+    integer, parameter :: mc_random = 0
+    integer, parameter :: mc_lhs = 1
+    integer, parameter :: mc_halton = 2
+
+    integer, parameter :: mc_name_len = snl + 2
+        !! Output name length ('X:' prefix + species name)
+
+    integer(int64), parameter :: mask32 = 4294967295_int64
+    integer, parameter :: halton_primes(32) = [ &
+          2,   3,   5,   7,  11,  13,  17,  19,  23,  29,  31,  37,  41,  43,  47,  53, &
+         59,  61,  67,  71,  73,  79,  83,  89,  97, 101, 103, 107, 109, 113, 127, 131]
+
+    type :: McInput
+        !! One uncertain input
+        integer :: kind = mc_state1
+            !! Perturbed quantity: mc_state1, mc_state2, mc_weight, or mc_enthalpy
+        integer :: index = 0
+            !! Reactant index for mc_weight and mc_enthalpy
+        integer :: distribution = mc_uniform
+            !! Distribution of the perturbation: mc_uniform, mc_normal, or mc_triangular
+        real(dp) :: width = 0.0d0
+            !! Half-width (uniform, triangular) or standard deviation (normal) of the
+            !! perturbation, in the units of the input (enthalpy in J/mol)
+    end type
+
+    type :: McStatistic
+        !! Streaming statistics of one output
+        integer :: count = 0
+            !! Number of accumulated values
+        real(dp) :: mean = 0.0d0
+            !! Running mean
+        real(dp) :: m2 = 0.0d0
+            !! Running sum of squared deviations from the mean (Welford)
+        real(dp) :: min_value = huge(1.0d0)
+            !! Smallest accumulated value
+        real(dp) :: max_value = -huge(1.0d0)
+            !! Largest accumulated value
+        real(dp), allocatable :: p(:)
+            !! Quantile probabilities
+        real(dp), allocatable :: q(:, :)
+            !! P-squared marker heights (5 x size(p))
+        real(dp), allocatable :: pos(:, :)
+            !! P-squared marker positions (5 x size(p))
+    contains
+        procedure :: add => McStatistic_add
+        procedure :: variance => McStatistic_variance
+        procedure :: quantile => McStatistic_quantile
+    end type
+    interface McStatistic
+        module procedure :: McStatistic_init
+    end interface
+
+    type :: McDriver
+        !! Monte Carlo uncertainty propagation driver
+
+        ! Sampling
+        integer :: num_samples = 1000
+            !! Number of samples to solve
+        integer :: sampling = mc_lhs
+            !! Sampling scheme: mc_random, mc_lhs, or mc_halton
+        integer :: seed = 1
+            !! Seed of the sample hashes
+        integer :: num_threads = 1
+            !! Number of solver workspaces (and OpenMP threads); affects results through warm starts
+        integer :: block_size = 1024
+            !! Samples solved between accumulations; bounds the output buffer
+        real(dp), allocatable :: probabilities(:)
+            !! Probabilities of the estimated quantiles
+        type(McInput), allocatable :: inputs(:)
+            !! Uncertain inputs
+
+        ! Results
+        integer :: num_converged = 0
+            !! Number of converged samples in the statistics
+        character(mc_name_len), allocatable :: output_names(:)
+            !! Name of each output
+        type(McStatistic), allocatable :: stats(:)
+            !! Statistics of each output over the converged samples
+
+    contains
+
+        procedure :: add_input => McDriver_add_input
+        procedure :: sample => McDriver_sample
+        procedure :: run_eq => McDriver_run_eq
+        procedure :: run_rocket => McDriver_run_rocket
+        procedure :: num_outputs => McDriver_num_outputs
+
+    end type
+    interface McDriver
+        module procedure :: McDriver_init
+    end interface
+
+contains
+
+    !-----------------------------------------------------------------------
+    ! McDriver
+    !-----------------------------------------------------------------------
+    function McDriver_init(num_samples, sampling, seed, num_threads, probabilities) result(self)
+
+        ! Arguments
+        integer, intent(in) :: num_samples
+        integer, intent(in), optional :: sampling
+        integer, intent(in), optional :: seed
+        integer, intent(in), optional :: num_threads
+        real(dp), intent(in), optional :: probabilities(:)
+
+        ! Result
+        type(McDriver) :: self
+
+        self%num_samples = num_samples
+        if (present(sampling)) self%sampling = sampling
+        if (present(seed)) self%seed = seed
+        if (present(num_threads)) self%num_threads = num_threads
+        if (present(probabilities)) then
+            self%probabilities = probabilities
+        else
+            self%probabilities = [0.05d0, 0.5d0, 0.95d0]
+        end if
+        allocate(self%inputs(0))
+
+        call assert(self%num_samples > 0, 'McDriver_init: num_samples must be positive')
+        call assert(self%sampling >= mc_random .and. self%sampling <= mc_halton, 'McDriver_init: invalid sampling scheme')
+        call assert(self%num_threads > 0, 'McDriver_init: num_threads must be positive')
+        call assert(all(self%probabilities > 0.0d0 .and. self%probabilities < 1.0d0), &
+                    'McDriver_init: quantile probabilities must lie in (0, 1)')
+
+    end function
+
+    subroutine McDriver_add_input(self, kind, distribution, width, index)
+        ! Add an uncertain input; index selects the reactant for mc_weight and mc_enthalpy
+
+        ! Arguments
+        class(McDriver), intent(inout) :: self
+        integer, intent(in) :: kind
+        integer, intent(in) :: distribution
+        real(dp), intent(in) :: width
+        integer, intent(in), optional :: index
+
+        ! Locals
+        type(McInput) :: input
+
+        call assert(kind >= mc_state1 .and. kind <= mc_enthalpy, 'McDriver_add_input: invalid input kind')
+        call assert(distribution >= mc_uniform .and. distribution <= mc_triangular, &
+                    'McDriver_add_input: invalid distribution')
+        call assert(width >= 0.0d0, 'McDriver_add_input: width must be non-negative')
+        if (self%sampling == mc_halton) then
+            call assert(size(self%inputs) < size(halton_primes), 'McDriver_add_input: too many inputs for Halton sampling')
+        end if
+
+        input%kind = kind
+        input%distribution = distribution
+        input%width = width
+        if (present(index)) input%index = index
+        if (kind == mc_weight .or. kind == mc_enthalpy) then
+            call assert(input%index > 0, 'McDriver_add_input: reactant index required for weight and enthalpy inputs')
+        end if
+        self%inputs = [self%inputs, input]
+
+    end subroutine
+
+    function McDriver_sample(self, i) result(delta)
+        ! Perturbation of each input for sample i (1-based)
+
+        ! Arguments
+        class(McDriver), intent(in) :: self
+        integer, intent(in) :: i
+
+        ! Result
+        real(dp) :: delta(size(self%inputs))
+
+        ! Locals
+        integer :: d
+
+        do d = 1, size(self%inputs)
+            delta(d) = self%inputs(d)%width * &
+                       unit_to_deviate(self%inputs(d)%distribution, unit_sample(self, i-1, d))
+        end do
+
+    end function
+
+    function McDriver_num_outputs(self) result(num)
+        class(McDriver), intent(in) :: self
+        integer :: num
+        num = 0
+        if (allocated(self%stats)) num = size(self%stats)
+    end function
+
+    subroutine McDriver_run_eq(self, solver, type, state1, state2, weights, reactant_temps)
+        ! Propagate the inputs through an equilibrium problem. Given reactant_temps, state1
+        ! of an 'hp' problem is recomputed for each sample from the perturbed weights and
+        ! reactant enthalpies, as the CLI does for decks without an h schedule.
+        !
+        ! Outputs: T, P, rho, H, S, M, cp_eq, gamma_s, and the product mole fractions (X:*).
+
+        ! Arguments
+        class(McDriver), intent(inout) :: self
+        type(EqSolver), intent(in) :: solver
+        character(2), intent(in) :: type
+        real(dp), intent(in) :: state1
+        real(dp), intent(in) :: state2
+        real(dp), intent(in) :: weights(:)
+        real(dp), intent(in), optional :: reactant_temps(:)
+
+        ! Locals
+        type(EqSolver), allocatable :: solvers(:)
+        type(EqSolution), allocatable :: solns(:)
+        real(dp), allocatable :: h_nominal(:), y(:, :)
+        logical, allocatable :: converged(:)
+        integer, allocatable :: order(:)
+        logical :: recompute_h
+        integer :: first, last, nb, t, m, i, j
+
+        call check_inputs(self, solver%num_reactants, size(weights))
+        recompute_h = present(reactant_temps) .and. type == 'hp'
+        if (any(self%inputs%kind == mc_enthalpy)) then
+            call assert(recompute_h, 'McDriver_run_eq: enthalpy inputs need an hp problem and reactant temperatures')
+        end if
+
+        call reset_outputs(self, [character(mc_name_len) :: 'T', 'P', 'rho', 'H', 'S', 'M', 'cp_eq', 'gamma_s'], &
+                           solver%products%species_names)
+
+        ! Nominal reactant enthalpies (J/mol) for thermo overrides
+        allocate(h_nominal(solver%num_reactants), source=0.0d0)
+        if (recompute_h) then
+            do j = 1, solver%num_reactants
+                h_nominal(j) = solver%reactants%species(j)%calc_enthalpy(reactant_temps(j))*R/1.0d3
+            end do
+        end if
+
+        ! One solver and solution workspace per thread; the copies share the product data of solver
+        allocate(solvers(self%num_threads), solns(self%num_threads))
+        do t = 1, self%num_threads
+            solvers(t) = solver
+            solns(t) = EqSolution(solver)
+        end do
+        allocate(y(size(self%stats), self%block_size), converged(self%block_size))
+
+        do first = 1, self%num_samples, self%block_size
+            last = min(first + self%block_size - 1, self%num_samples)
+            nb = last - first + 1
+            order = block_order(self, first, last)
+
+            !$omp parallel do num_threads(self%num_threads) schedule(static, 1) private(m, i)
+            do t = 1, self%num_threads
+                do m = chunk_start(t, nb, self%num_threads), chunk_start(t+1, nb, self%num_threads) - 1
+                    i = order(m)
+                    call solve_eq_sample(self, solvers(t), solns(t), type, state1, state2, weights, &
+                                         recompute_h, reactant_temps, h_nominal, first + i - 1, &
+                                         y(:, i), converged(i))
+                end do
+            end do
+            !$omp end parallel do
+
+            call accumulate(self, y(:, :nb), converged(:nb))
+        end do
+
+    end subroutine
+
+    subroutine solve_eq_sample(self, solver, soln, type, state1, state2, weights, recompute_h, &
+                               reactant_temps, h_nominal, i, y, converged)
+        ! Solve sample i on one workspace and extract its outputs
+
+        ! Arguments
+        type(McDriver), intent(in) :: self
+        type(EqSolver), intent(inout) :: solver
+        type(EqSolution), intent(inout) :: soln
+        character(2), intent(in) :: type
+        real(dp), intent(in) :: state1
+        real(dp), intent(in) :: state2
+        real(dp), intent(in) :: weights(:)
+        logical, intent(in) :: recompute_h
+        real(dp), intent(in), optional :: reactant_temps(:)
+        real(dp), intent(in) :: h_nominal(:)
+        integer, intent(in) :: i
+        real(dp), intent(out) :: y(:)
+        logical, intent(out) :: converged
+
+        ! Locals
+        real(dp) :: s1, s2
+        real(dp) :: w(size(weights)), delta(size(self%inputs))
+
+        delta = self%sample(i)
+        w = weights
+        call perturb_reactants(self, solver%reactants, delta, h_nominal, w)
+
+        s1 = state1
+        if (recompute_h) s1 = solver%reactants%calc_enthalpy(w, reactant_temps)/R
+        s2 = state2
+        call perturb_states(self, delta, s1, s2)
+
+        call solver%solve(soln, type, s1, s2, w)
+        converged = soln%converged
+        y = 0.0d0
+        if (.not. converged) return
+        call solver%compute_outputs(soln, output_properties)
+
+        y(1:8) = [soln%T, soln%pressure, soln%density, soln%enthalpy, soln%entropy, &
+                  1.0d0/soln%n, soln%cp_eq, soln%gamma_s]
+        y(9:) = soln%mole_fractions
+
+    end subroutine
+
+    subroutine McDriver_run_rocket(self, solver, weights, pc, pi_p, subar, supar, hc, reactant_temps)
+        ! Propagate the inputs through an infinite-area combustor rocket problem. The chamber
+        ! enthalpy is hc if given, else it is computed for each sample from reactant_temps and
+        ! the perturbed weights and reactant enthalpies. mc_state1 perturbs hc, mc_state2 pc.
+        ! Each workspace passes its last chamber temperature to the next solve as tc_est.
+        !
+        ! Outputs: Tc, then T, P, M, gamma_s, ae_at, c_star, cf, i_sp, i_vac, and the mole
+        ! fractions (X:*) at the last station.
+
+        ! Arguments
+        class(McDriver), intent(inout) :: self
+        type(RocketSolver), intent(in) :: solver
+        real(dp), intent(in) :: weights(:)
+        real(dp), intent(in) :: pc
+        real(dp), intent(in), optional :: pi_p(:)
+        real(dp), intent(in), optional :: subar(:)
+        real(dp), intent(in), optional :: supar(:)
+        real(dp), intent(in), optional :: hc
+        real(dp), intent(in), optional :: reactant_temps(:)
+
+        ! Locals
+        type(RocketSolver), allocatable :: solvers(:)
+        real(dp), allocatable :: h_nominal(:), y(:, :), tc_prev(:)
+        logical, allocatable :: converged(:)
+        integer, allocatable :: order(:)
+        integer :: first, last, nb, t, m, i, j, nr
+
+        nr = solver%eq_solver%num_reactants
+        call check_inputs(self, nr, size(weights))
+        call assert(present(hc) .or. present(reactant_temps), 'McDriver_run_rocket: hc or reactant_temps is required')
+        if (any(self%inputs%kind == mc_enthalpy)) then
+            call assert(.not. present(hc) .and. present(reactant_temps), &
+                        'McDriver_run_rocket: enthalpy inputs need reactant temperatures instead of hc')
+        end if
+
+        call reset_outputs(self, [character(mc_name_len) :: 'Tc', 'T', 'P', 'M', 'gamma_s', 'ae_at', 'c_star', &
+                                  'cf', 'i_sp', 'i_vac'], solver%eq_solver%products%species_names)
+
+        allocate(h_nominal(nr), source=0.0d0)
+        if (present(reactant_temps)) then
+            do j = 1, nr
+                h_nominal(j) = solver%eq_solver%reactants%species(j)%calc_enthalpy(reactant_temps(j))*R/1.0d3
+            end do
+        end if
+
+        ! One solver per thread; the copies share the product data of solver
+        allocate(solvers(self%num_threads), source=solver)
+        allocate(tc_prev(self%num_threads), source=0.0d0)
+        allocate(y(size(self%stats), self%block_size), converged(self%block_size))
+
+        do first = 1, self%num_samples, self%block_size
+            last = min(first + self%block_size - 1, self%num_samples)
+            nb = last - first + 1
+            order = block_order(self, first, last)
+
+            !$omp parallel do num_threads(self%num_threads) schedule(static, 1) private(m, i)
+            do t = 1, self%num_threads
+                do m = chunk_start(t, nb, self%num_threads), chunk_start(t+1, nb, self%num_threads) - 1
+                    i = order(m)
+                    call solve_rocket_sample(self, solvers(t), tc_prev(t), weights, pc, pi_p, subar, supar, &
+                                             hc, reactant_temps, h_nominal, first + i - 1, y(:, i), converged(i))
+                end do
+            end do
+            !$omp end parallel do
+
+            call accumulate(self, y(:, :nb), converged(:nb))
+        end do
+
+    end subroutine
+
+    subroutine solve_rocket_sample(self, solver, tc_prev, weights, pc, pi_p, subar, supar, hc, &
+                                   reactant_temps, h_nominal, i, y, converged)
+        ! Solve rocket sample i on one workspace and extract its outputs
+
+        ! Arguments
+        type(McDriver), intent(in) :: self
+        type(RocketSolver), intent(inout) :: solver
+        real(dp), intent(inout) :: tc_prev
+        real(dp), intent(in) :: weights(:)
+        real(dp), intent(in) :: pc
+        real(dp), intent(in), optional :: pi_p(:)
+        real(dp), intent(in), optional :: subar(:)
+        real(dp), intent(in), optional :: supar(:)
+        real(dp), intent(in), optional :: hc
+        real(dp), intent(in), optional :: reactant_temps(:)
+        real(dp), intent(in) :: h_nominal(:)
+        integer, intent(in) :: i
+        real(dp), intent(out) :: y(:)
+        logical, intent(out) :: converged
+
+        ! Locals
+        type(RocketSolution) :: soln
+        real(dp) :: s1, s2
+        real(dp) :: w(size(weights)), delta(size(self%inputs))
+        integer :: ne
+
+        delta = self%sample(i)
+        w = weights
+        call perturb_reactants(self, solver%eq_solver%reactants, delta, h_nominal, w)
+
+        if (present(hc)) then
+            s1 = hc
+        else
+            s1 = solver%eq_solver%reactants%calc_enthalpy(w, reactant_temps)/R
+        end if
+        s2 = pc
+        call perturb_states(self, delta, s1, s2)
+
+        ! Warm start from the previous chamber temperature of this workspace
+        if (tc_prev > 0.0d0) then
+            call solver%solve_iac(soln, w, s2, pi_p=pi_p, subar=subar, supar=supar, tc_est=tc_prev, hc=s1)
+        else
+            call solver%solve_iac(soln, w, s2, pi_p=pi_p, subar=subar, supar=supar, hc=s1)
+        end if
+        converged = soln%converged
+        y = 0.0d0
+        if (.not. converged) return
+        call solver%compute_outputs(soln, output_performance)
+
+        ne = soln%num_pts
+        tc_prev = soln%eq_soln(1)%T
+        y(1:10) = [soln%eq_soln(1)%T, soln%eq_soln(ne)%T, soln%pressure(ne), 1.0d0/soln%eq_soln(ne)%n, &
+                   soln%eq_partials(ne)%gamma_s, soln%ae_at(ne), soln%c_star(ne), soln%cf(ne), soln%i_sp(ne), soln%i_vac(ne)]
+        y(11:) = soln%eq_soln(ne)%mole_fractions
+
+    end subroutine
+
+    !-----------------------------------------------------------------------
+    ! McDriver helpers
+    !-----------------------------------------------------------------------
+    subroutine check_inputs(self, num_reactants, num_weights)
+        type(McDriver), intent(in) :: self
+        integer, intent(in) :: num_reactants
+        integer, intent(in) :: num_weights
+        integer :: d
+
+        call assert(num_weights == num_reactants, 'McDriver: weights must have one entry per reactant')
+        do d = 1, size(self%inputs)
+            if (self%inputs(d)%kind == mc_weight .or. self%inputs(d)%kind == mc_enthalpy) then
+                call assert(self%inputs(d)%index <= num_reactants, 'McDriver: input reactant index out of range')
+            end if
+        end do
+
+    end subroutine
+
+    subroutine reset_outputs(self, names, species_names)
+        ! Name the outputs and clear the statistics
+        type(McDriver), intent(inout) :: self
+        character(*), intent(in) :: names(:)
+        character(*), intent(in) :: species_names(:)
+        integer :: k
+
+        self%output_names = [character(mc_name_len) :: names, &
+                             ('X:'//trim(adjustl(species_names(k))), k = 1, size(species_names))]
+        if (allocated(self%stats)) deallocate(self%stats)
+        allocate(self%stats(size(self%output_names)))
+        do k = 1, size(self%stats)
+            self%stats(k) = McStatistic(self%probabilities)
+        end do
+        self%num_converged = 0
+
+    end subroutine
+
+    subroutine perturb_reactants(self, reactants, delta, h_nominal, w)
+        ! Apply the weight perturbations and override the perturbed reactant enthalpies
+        type(McDriver), intent(in) :: self
+        type(Mixture), intent(inout) :: reactants
+        real(dp), intent(in) :: delta(:)
+        real(dp), intent(in) :: h_nominal(:)
+        real(dp), intent(inout) :: w(:)
+
+        real(dp) :: h(size(h_nominal))
+        integer :: d, j
+
+        h = h_nominal
+        do d = 1, size(self%inputs)
+            j = self%inputs(d)%index
+            select case (self%inputs(d)%kind)
+                case (mc_weight)
+                    w(j) = max(0.0d0, w(j) + delta(d))
+                case (mc_enthalpy)
+                    h(j) = h(j) + delta(d)
+            end select
+        end do
+        do d = 1, size(self%inputs)
+            if (self%inputs(d)%kind /= mc_enthalpy) cycle
+            j = self%inputs(d)%index
+            call reactants%set_species_enthalpy(j, h(j))
+        end do
+
+    end subroutine
+
+    subroutine perturb_states(self, delta, state1, state2)
+        type(McDriver), intent(in) :: self
+        real(dp), intent(in) :: delta(:)
+        real(dp), intent(inout) :: state1
+        real(dp), intent(inout) :: state2
+        integer :: d
+
+        do d = 1, size(self%inputs)
+            select case (self%inputs(d)%kind)
+                case (mc_state1)
+                    state1 = state1 + delta(d)
+                case (mc_state2)
+                    state2 = state2 + delta(d)
+            end select
+        end do
+
+    end subroutine
+
+    function block_order(self, first, last) result(order)
+        ! Block-local indices of samples first..last, ordered along the first input
+        type(McDriver), intent(in) :: self
+        integer, intent(in) :: first
+        integer, intent(in) :: last
+        integer, allocatable :: order(:)
+
+        real(dp), allocatable :: key(:)
+        integer :: i
+
+        if (size(self%inputs) == 0) then
+            order = [(i, i = 1, last - first + 1)]
+            return
+        end if
+        key = [(unit_sample(self, i-1, 1), i = first, last)]
+        call sort(key, order)
+
+    end function
+
+    pure function chunk_start(t, n, num_chunks) result(m)
+        ! First index of chunk t when n items are split into num_chunks contiguous chunks
+        integer, intent(in) :: t
+        integer, intent(in) :: n
+        integer, intent(in) :: num_chunks
+        integer :: m
+        m = 1 + int((int(t - 1, int64)*n)/num_chunks)
+    end function
+
+    subroutine accumulate(self, y, converged)
+        ! Fold a block of outputs into the statistics in sample order
+        type(McDriver), intent(inout) :: self
+        real(dp), intent(in) :: y(:, :)
+        logical, intent(in) :: converged(:)
+        integer :: i, k
+
+        do i = 1, size(converged)
+            if (.not. converged(i)) cycle
+            self%num_converged = self%num_converged + 1
+            do k = 1, size(self%stats)
+                call self%stats(k)%add(y(k, i))
+            end do
+        end do
+
+    end subroutine
+
+    !-----------------------------------------------------------------------
+    ! Sampling
+    !-----------------------------------------------------------------------
+    function unit_sample(self, s, d) result(u)
+        ! Point in (0, 1) of input d for zero-based sample s
+        type(McDriver), intent(in) :: self
+        integer, intent(in) :: s
+        integer, intent(in) :: d
+        real(dp) :: u
+
+        integer(int64) :: stratum
+
+        select case (self%sampling)
+            case (mc_lhs)
+                stratum = permute(int(s, int64), int(self%num_samples, int64), hash3(0, d, self%seed))
+                u = (real(stratum, dp) + hash_unit(hash3(s, d, self%seed + 1)))/real(self%num_samples, dp)
+            case (mc_halton)
+                u = radical_inverse(s + 1, halton_primes(d)) + hash_unit(hash3(0, d, self%seed))
+                u = u - floor(u)
+            case default
+                u = hash_unit(hash3(s, d, self%seed))
+        end select
+
+    end function
+
+    function unit_to_deviate(distribution, u) result(z)
+        ! Map u in (0, 1) to a deviate of unit width (uniform, triangular) or unit variance (normal)
+        integer, intent(in) :: distribution
+        real(dp), intent(in) :: u
+        real(dp) :: z
+
+        select case (distribution)
+            case (mc_normal)
+                z = inverse_normal_cdf(min(max(u, 1.0d-15), 1.0d0 - 1.0d-15))
+            case (mc_triangular)
+                if (u < 0.5d0) then
+                    z = sqrt(2.0d0*u) - 1.0d0
+                else
+                    z = 1.0d0 - sqrt(2.0d0*(1.0d0 - u))
+                end if
+            case default
+                z = 2.0d0*u - 1.0d0
+        end select
+
+    end function
+
+    function inverse_normal_cdf(p) result(x)
+        ! Standard normal quantile: rational approximation (Acklam) refined by one Halley step
+        real(dp), intent(in) :: p
+        real(dp) :: x
+
+        real(dp), parameter :: a(6) = [-3.969683028665376d+01, 2.209460984245205d+02, -2.759285104469687d+02, &
+                                        1.383577518672690d+02, -3.066479806614716d+01, 2.506628277459239d+00]
+        real(dp), parameter :: b(5) = [-5.447609879822406d+01, 1.615858368580409d+02, -1.556989798598866d+02, &
+                                        6.680131188771972d+01, -1.328068155288572d+01]
+        real(dp), parameter :: c(6) = [-7.784894002430293d-03, -3.223964580411365d-01, -2.400758277161838d+00, &
+                                       -2.549732539343734d+00, 4.374664141464968d+00, 2.938163982698783d+00]
+        real(dp), parameter :: d(4) = [7.784695709041462d-03, 3.224671290700398d-01, 2.445134137142996d+00, &
+                                       3.754408661907416d+00]
+        real(dp), parameter :: p_low = 0.02425d0
+        real(dp) :: q, r, e, u
+
+        if (p < p_low) then
+            q = sqrt(-2.0d0*log(p))
+            x = (((((c(1)*q + c(2))*q + c(3))*q + c(4))*q + c(5))*q + c(6)) / &
+                ((((d(1)*q + d(2))*q + d(3))*q + d(4))*q + 1.0d0)
+        else if (p > 1.0d0 - p_low) then
+            q = sqrt(-2.0d0*log(1.0d0 - p))
+            x = -(((((c(1)*q + c(2))*q + c(3))*q + c(4))*q + c(5))*q + c(6)) / &
+                 ((((d(1)*q + d(2))*q + d(3))*q + d(4))*q + 1.0d0)
+        else
+            q = p - 0.5d0
+            r = q*q
+            x = (((((a(1)*r + a(2))*r + a(3))*r + a(4))*r + a(5))*r + a(6))*q / &
+                (((((b(1)*r + b(2))*r + b(3))*r + b(4))*r + b(5))*r + 1.0d0)
+        end if
+
+        e = 0.5d0*erfc(-x/sqrt(2.0d0)) - p
+        u = e*sqrt(2.0d0*acos(-1.0d0))*exp(0.5d0*x*x)
+        x = x - u/(1.0d0 + 0.5d0*x*u)
+
+    end function
+
+    pure function radical_inverse(i, base) result(r)
+        ! Van der Corput radical inverse of i in the given base
+        integer, intent(in) :: i
+        integer, intent(in) :: base
+        real(dp) :: r
+        integer :: n
+        real(dp) :: f
+
+        r = 0.0d0
+        f = 1.0d0
+        n = i
+        do while (n > 0)
+            f = f/base
+            r = r + f*mod(n, base)
+            n = n/base
+        end do
+
+    end function
+
+    pure function permute(i, l, p) result(j)
+        ! Element i of a pseudo-random permutation of 0..l-1 selected by p (Kensler, 2013)
+        integer(int64), intent(in) :: i
+        integer(int64), intent(in) :: l
+        integer(int64), intent(in) :: p
+        integer(int64) :: j
+        integer(int64) :: w
+
+        w = l - 1
+        w = ior(w, ishft(w, -1))
+        w = ior(w, ishft(w, -2))
+        w = ior(w, ishft(w, -4))
+        w = ior(w, ishft(w, -8))
+        w = ior(w, ishft(w, -16))
+
+        j = i
+        do
+            j = mul32(ieor(j, p), int(z'E170893D', int64))
+            j = ieor(j, ishft(p, -16))
+            j = ieor(j, ishft(iand(j, w), -4))
+            j = mul32(ieor(j, ishft(p, -8)), int(z'0929EB3F', int64))
+            j = ieor(j, ishft(p, -23))
+            j = mul32(ieor(j, ishft(iand(j, w), -1)), ior(1_int64, ishft(p, -27)))
+            j = mul32(j, int(z'6935FA69', int64))
+            j = mul32(ieor(j, ishft(iand(j, w), -11)), int(z'74DCB303', int64))
+            j = mul32(ieor(j, ishft(iand(j, w), -2)), int(z'9E501CC3', int64))
+            j = mul32(ieor(j, ishft(iand(j, w), -2)), int(z'C860A3DF', int64))
+            j = iand(j, w)
+            j = ieor(j, ishft(j, -5))
+            if (j < l) exit
+        end do
+        j = mod(j + p, l)
+
+    end function
+
+    pure function hash3(s, d, seed) result(h)
+        ! 32-bit hash of (sample, input, seed)
+        integer, intent(in) :: s
+        integer, intent(in) :: d
+        integer, intent(in) :: seed
+        integer(int64) :: h
+        integer(int64), parameter :: golden = int(z'9E3779B9', int64)
+
+        h = fmix32(iand(int(seed, int64) + golden, mask32))
+        h = fmix32(iand(ieor(h, int(d, int64)) + golden, mask32))
+        h = fmix32(iand(ieor(h, int(s, int64)) + golden, mask32))
+
+    end function
+
+    pure function hash_unit(h) result(u)
+        ! Map a 32-bit hash to (0, 1)
+        integer(int64), intent(in) :: h
+        real(dp) :: u
+        u = (real(h, dp) + 0.5d0)/4294967296.0d0
+    end function
+
+    pure function fmix32(h0) result(h)
+        ! MurmurHash3 32-bit finalizer
+        integer(int64), intent(in) :: h0
+        integer(int64) :: h
+        h = ieor(h0, ishft(h0, -16))
+        h = mul32(h, int(z'85EBCA6B', int64))
+        h = ieor(h, ishft(h, -13))
+        h = mul32(h, int(z'C2B2AE35', int64))
+        h = ieor(h, ishft(h, -16))
+    end function
+
+    pure function mul32(a, b) result(c)
+        ! Product of two unsigned 32-bit values modulo 2**32, without int64 overflow
+        integer(int64), intent(in) :: a
+        integer(int64), intent(in) :: b
+        integer(int64) :: c
+        c = iand(a*iand(b, 65535_int64) + ishft(iand(a*ishft(b, -16), 65535_int64), 16), mask32)
+    end function
+
+    !-----------------------------------------------------------------------
+    ! McStatistic
+    !-----------------------------------------------------------------------
+    function McStatistic_init(probabilities) result(self)
+        real(dp), intent(in) :: probabilities(:)
+        type(McStatistic) :: self
+
+        allocate(self%p, source=probabilities)
+        allocate(self%q(5, size(probabilities)), source=0.0d0)
+        allocate(self%pos(5, size(probabilities)), source=0.0d0)
+
+    end function
+
+    subroutine McStatistic_add(self, x)
+        ! Accumulate one value
+        class(McStatistic), intent(inout) :: self
+        real(dp), intent(in) :: x
+
+        real(dp) :: delta
+        integer :: j
+
+        self%count = self%count + 1
+        delta = x - self%mean
+        self%mean = self%mean + delta/self%count
+        self%m2 = self%m2 + delta*(x - self%mean)
+        self%min_value = min(self%min_value, x)
+        self%max_value = max(self%max_value, x)
+
+        do j = 1, size(self%p)
+            call p2_add(self%q(:, j), self%pos(:, j), self%p(j), self%count, x)
+        end do
+
+    end subroutine
+
+    function McStatistic_variance(self) result(var)
+        ! Unbiased sample variance
+        class(McStatistic), intent(in) :: self
+        real(dp) :: var
+        var = 0.0d0
+        if (self%count > 1) var = self%m2/(self%count - 1)
+    end function
+
+    function McStatistic_quantile(self, j) result(x)
+        ! Estimate of quantile j (probability p(j))
+        class(McStatistic), intent(in) :: self
+        integer, intent(in) :: j
+        real(dp) :: x
+
+        real(dp), allocatable :: first(:)
+        integer :: k
+
+        x = 0.0d0
+        if (self%count == 0) return
+        if (self%count >= 5) then
+            x = self%q(3, j)
+        else
+            ! Nearest rank among the first few values
+            first = self%q(:self%count, j)
+            call sort(first)
+            k = min(self%count, max(1, ceiling(self%p(j)*self%count)))
+            x = first(k)
+        end if
+
+    end function
+
+    subroutine p2_add(q, pos, p, count, x)
+        ! P-squared update of the five markers tracking quantile p with the count-th value x
+        real(dp), intent(inout) :: q(5)
+        real(dp), intent(inout) :: pos(5)
+        real(dp), intent(in) :: p
+        integer, intent(in) :: count
+        real(dp), intent(in) :: x
+
+        real(dp) :: dn(5), d, s, qp
+        integer :: i, k
+
+        if (count <= 5) then
+            q(count) = x
+            if (count == 5) then
+                call sort(q)
+                pos = [1.0d0, 2.0d0, 3.0d0, 4.0d0, 5.0d0]
+            end if
+            return
+        end if
+
+        ! Locate the cell of x, extending the extreme markers if needed
+        if (x < q(1)) then
+            q(1) = x
+            k = 1
+        else if (x >= q(5)) then
+            q(5) = x
+            k = 4
+        else
+            k = 1
+            do while (x >= q(k+1))
+                k = k + 1
+            end do
+        end if
+        pos(k+1:) = pos(k+1:) + 1.0d0
+
+        ! Move the interior markers toward their desired positions
+        dn = [0.0d0, 0.5d0*p, p, 0.5d0*(1.0d0 + p), 1.0d0]
+        do i = 2, 4
+            d = 1.0d0 + (count - 1)*dn(i) - pos(i)
+            if ((d >= 1.0d0 .and. pos(i+1) - pos(i) > 1.0d0) .or. (d <= -1.0d0 .and. pos(i-1) - pos(i) < -1.0d0)) then
+                s = sign(1.0d0, d)
+                qp = q(i) + s/(pos(i+1) - pos(i-1)) * &
+                     ((pos(i) - pos(i-1) + s)*(q(i+1) - q(i))/(pos(i+1) - pos(i)) + &
+                      (pos(i+1) - pos(i) - s)*(q(i) - q(i-1))/(pos(i) - pos(i-1)))
+                if (q(i-1) < qp .and. qp < q(i+1)) then
+                    q(i) = qp
+                else
+                    k = i + nint(s)
+                    q(i) = q(i) + s*(q(k) - q(i))/(pos(k) - pos(i))
+                end if
+                pos(i) = pos(i) + s
+            end if
+        end do
+
+    end subroutine
+
+end module